@@ -0,0 +1,129 @@
+#ifndef NPA_700_BENCH_H
+#define NPA_700_BENCH_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file bench.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Timing helpers for host benchmarks.
+ *
+ * Each benchmark prints one JSON object per line:
+ * {"bench":"filter","case":"cic3_r16","items":1048576,"ns_per_item":1.23,
+ *  "cycles_per_item":4.56,"check":12345}
+ *
+ * Accuracy and other non-timing results are printed as
+ * {"bench":"flow","case":"sqrt_q8","metric":"max_rel_err","value":3.1e-05}
+ *
+ * Cycles are time stamp counter ticks on x86 and are reported as -1 on other hosts.
+ * Check is a value derived from the results so that the compiler cannot drop the
+ * measured work, and so that runs can be compared for identical output.
+ * Run with "make bench".
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_CYCLES (1)
+#else
+#define BENCH_HAS_CYCLES (0)
+#endif
+
+#define BENCH_REPEATS (5U) //!< Measurements per case, fastest is reported.
+
+/** @brief Measurement of one benchmark run. */
+typedef struct
+{
+    uint64_t ns;     //!< Elapsed wall clock nanoseconds.
+    uint64_t cycles; //!< Elapsed cycles, 0 if not available.
+} bench_time_t;
+
+/** @brief Monotonic time in nanoseconds. */
+static inline uint64_t bench_now_ns (void)
+{
+    struct timespec now;
+    (void) clock_gettime (CLOCK_MONOTONIC, &now);
+    return ( (uint64_t) now.tv_sec * 1000000000U) + (uint64_t) now.tv_nsec;
+}
+
+/** @brief Cycle counter, 0 if not available. */
+static inline uint64_t bench_cycles (void)
+{
+#if BENCH_HAS_CYCLES
+    return __rdtsc();
+#else
+    return 0U;
+#endif
+}
+
+/** @brief Start a measurement. */
+static inline bench_time_t bench_start (void)
+{
+    bench_time_t start;
+    start.ns = bench_now_ns();
+    start.cycles = bench_cycles();
+    return start;
+}
+
+/** @brief End a measurement started with @ref bench_start, return elapsed time. */
+static inline bench_time_t bench_stop (const bench_time_t start)
+{
+    bench_time_t elapsed;
+    elapsed.cycles = bench_cycles() - start.cycles;
+    elapsed.ns = bench_now_ns() - start.ns;
+    return elapsed;
+}
+
+/** @brief Keep the faster of two measurements. */
+static inline bench_time_t bench_min (const bench_time_t best, const bench_time_t run)
+{
+    return ( (0U == best.ns) || (run.ns < best.ns)) ? run : best;
+}
+
+/**
+ * @brief Print result of one case.
+ *
+ * @param[in] bench   Name of benchmark program.
+ * @param[in] name    Name of case.
+ * @param[in] items   Items processed in measurement.
+ * @param[in] elapsed Elapsed time of measurement.
+ * @param[in] check   Value derived from results.
+ */
+static inline void bench_report (const char * const bench, const char * const name,
+                                 const uint64_t items, const bench_time_t elapsed,
+                                 const uint64_t check)
+{
+    const double ns_per_item = (double) elapsed.ns / (double) items;
+    const double cycles_per_item = BENCH_HAS_CYCLES
+                                   ? ( (double) elapsed.cycles / (double) items) : -1.0;
+    printf ("{\"bench\":\"%s\",\"case\":\"%s\",\"items\":%llu,\"ns_per_item\":%.3f,"
+            "\"cycles_per_item\":%.3f,\"check\":%llu}\n",
+            bench, name, (unsigned long long) items, ns_per_item, cycles_per_item,
+            (unsigned long long) check);
+}
+
+/**
+ * @brief Print a non-timing result of one case.
+ *
+ * @param[in] bench  Name of benchmark program.
+ * @param[in] name   Name of case.
+ * @param[in] metric Name of result.
+ * @param[in] value  Value of result.
+ */
+static inline void bench_report_value (const char * const bench, const char * const name,
+                                       const char * const metric, const double value)
+{
+    printf ("{\"bench\":\"%s\",\"case\":\"%s\",\"metric\":\"%s\",\"value\":%.6g}\n",
+            bench, name, metric, value);
+}
+
+/** @} */
+#endif // NPA_700_BENCH_H
@@ -0,0 +1,97 @@
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file bench_filter.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Cycles per input sample of decimation filter kernels.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+#include "npa_700_filter.h"
+
+#include <stdlib.h>
+
+#define NUM_SAMPLES (1U << 20U) //!< Input samples per measurement.
+
+static uint16_t m_input[NUM_SAMPLES];
+static uint16_t m_output[NUM_SAMPLES + 1U];
+
+static void run_case (const char * const name, const npa_filter_cfg_t * const cfg)
+{
+    npa_filter_t filter;
+    bench_time_t best = { 0U, 0U };
+    uint64_t check = 0U;
+
+    if (NPA_SUCCESS != npa_filter_init (&filter, cfg))
+    {
+        fprintf (stderr, "bench_filter: invalid configuration %s\n", name);
+        exit (EXIT_FAILURE);
+    }
+
+    for (uint32_t repeat = 0U; repeat < BENCH_REPEATS; repeat++)
+    {
+        npa_filter_reset (&filter);
+        const bench_time_t start = bench_start();
+        const size_t produced = npa_filter_process (&filter, m_input, NUM_SAMPLES, m_output);
+        best = bench_min (best, bench_stop (start));
+        check = 0U;
+
+        for (size_t ii = 0U; ii < produced; ii++)
+        {
+            check += m_output[ii];
+        }
+    }
+
+    bench_report ("filter", name, NUM_SAMPLES, best, check);
+}
+
+int main (void)
+{
+    // Low-pass taps with unity DC gain.
+    static const int16_t fir8[8U] = { 1024, 3072, 5120, 7168, 7168, 5120, 3072, 1024 };
+    static const int16_t fir32[32U] =
+    {
+        256, 512, 512, 768, 768, 1024, 1024, 1280, 1280, 1280, 1280, 1280, 1280, 1280,
+        1280, 1280, 1280, 1280, 1280, 1280, 1280, 1280, 1280, 1280, 1280, 1024, 1024,
+        768, 768, 512, 512, 256
+    };
+    uint32_t state = 1U;
+
+    // Slow ramp with pseudo-random noise around mid-scale.
+    for (size_t ii = 0U; ii < NUM_SAMPLES; ii++)
+    {
+        state = (state * 1103515245U) + 12345U;
+        m_input[ii] = (uint16_t) (8192U + ( (ii >> 4U) & 0x3FFU) + ( (state >> 20U) & 0x3FU));
+    }
+
+    const npa_filter_cfg_t cases[] =
+    {
+        { .kernel = NPA_FILTER_BOXCAR, .decimation = 16U },
+        { .kernel = NPA_FILTER_CIC, .decimation = 16U, .cic_order = 1U },
+        { .kernel = NPA_FILTER_CIC, .decimation = 16U, .cic_order = 3U },
+        { .kernel = NPA_FILTER_CIC, .decimation = 8U, .cic_order = 4U },
+        { .kernel = NPA_FILTER_FIR, .decimation = 4U, .fir_taps = fir8, .fir_len = 8U },
+        { .kernel = NPA_FILTER_FIR, .decimation = 1U, .fir_taps = fir8, .fir_len = 8U },
+        { .kernel = NPA_FILTER_FIR, .decimation = 16U, .fir_taps = fir32, .fir_len = 32U }
+    };
+    static const char * const names[] =
+    {
+        "boxcar_r16", "cic1_r16", "cic3_r16", "cic4_r8", "fir8_r4", "fir8_r1", "fir32_r16"
+    };
+
+    for (size_t ii = 0U; ii < (sizeof (cases) / sizeof (cases[0])); ii++)
+    {
+        run_case (names[ii], &cases[ii]);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/** @} */
@@ -0,0 +1,149 @@
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file bench_flow.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Accuracy and throughput of integer flow conversion against sqrtf.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+#include "npa_700_flow.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#define NUM_SAMPLES (1U << 20U) //!< Pressures per measurement.
+#define FLOW_K      (2.5F)      //!< Flow per sqrt(mPa) of constant element.
+
+static int32_t m_dp_mpa[NUM_SAMPLES];
+static int32_t m_flow_int[NUM_SAMPLES];
+static float m_dp_pa[NUM_SAMPLES];
+static float m_flow_float[NUM_SAMPLES];
+
+static void fill_input (void)
+{
+    uint32_t state = 1U;
+
+    // Uniform over +-6890 Pa, full scale of 001D.
+    for (size_t ii = 0U; ii < NUM_SAMPLES; ii++)
+    {
+        state = (state * 1103515245U) + 12345U;
+        m_dp_mpa[ii] = (int32_t) (state % 13780001U) - 6890000;
+        m_dp_pa[ii] = (float) m_dp_mpa[ii] / 1000.0F;
+    }
+}
+
+static void bench_sqrtf (void)
+{
+    bench_time_t best = { 0U, 0U };
+    // sqrt(mPa) = sqrt(1000) * sqrt(Pa).
+    const float k_pa = FLOW_K * sqrtf (1000.0F);
+
+    for (uint32_t repeat = 0U; repeat < BENCH_REPEATS; repeat++)
+    {
+        const bench_time_t start = bench_start();
+
+        for (size_t ii = 0U; ii < NUM_SAMPLES; ii++)
+        {
+            const float dp = m_dp_pa[ii];
+            m_flow_float[ii] = copysignf (k_pa * sqrtf (fabsf (dp)), dp);
+        }
+
+        best = bench_min (best, bench_stop (start));
+    }
+
+    uint64_t check = 0U;
+
+    for (size_t ii = 0U; ii < NUM_SAMPLES; ii++)
+    {
+        check += (uint64_t) (int64_t) lrintf (m_flow_float[ii]);
+    }
+
+    bench_report ("flow", "float_sqrtf", NUM_SAMPLES, best, check);
+}
+
+static void bench_int (const char * const name, const npa_flow_t * const flow)
+{
+    bench_time_t best = { 0U, 0U };
+
+    for (uint32_t repeat = 0U; repeat < BENCH_REPEATS; repeat++)
+    {
+        const bench_time_t start = bench_start();
+        (void) npa_flow_convert_batch (flow, m_dp_mpa, NUM_SAMPLES, m_flow_int);
+        best = bench_min (best, bench_stop (start));
+    }
+
+    uint64_t check = 0U;
+
+    for (size_t ii = 0U; ii < NUM_SAMPLES; ii++)
+    {
+        check += (uint64_t) (int64_t) m_flow_int[ii];
+    }
+
+    bench_report ("flow", name, NUM_SAMPLES, best, check);
+}
+
+static void accuracy (const npa_flow_t * const flow)
+{
+    double sqrt_err = 0.0;
+    double flow_err = 0.0;
+
+    // Below 2^16 the 1 LSB rounding of Q8 result dominates relative error.
+    for (uint64_t x = 1U << 16U; x <= UINT32_MAX; x += 1U + (x >> 12U))
+    {
+        const double exact = 256.0 * sqrt ( (double) x);
+        const double err = fabs ( (double) npa_flow_sqrt_q8 ( (uint32_t) x) - exact) / exact;
+        sqrt_err = (err > sqrt_err) ? err : sqrt_err;
+    }
+
+    // Relative to full scale flow, as flow meters are specified.
+    const double full_scale = FLOW_K * sqrt (6890000.0);
+
+    for (size_t ii = 0U; ii < NUM_SAMPLES; ii++)
+    {
+        const double dp = (double) m_dp_mpa[ii];
+        const double exact = copysign (FLOW_K * sqrt (fabs (dp)), dp);
+        const double err = fabs ( (double) m_flow_int[ii] - exact) / full_scale;
+        flow_err = (err > flow_err) ? err : flow_err;
+    }
+
+    bench_report_value ("flow", "sqrt_q8_large", "max_rel_err", sqrt_err);
+    bench_report_value ("flow", "int_1point", "max_fs_err", flow_err);
+}
+
+int main (void)
+{
+    const npa_flow_point_t constant = { 0, (uint32_t) (FLOW_K * 65536.0F) };
+    npa_flow_point_t table[8U];
+    npa_flow_t flow_constant;
+    npa_flow_t flow_table;
+
+    for (size_t ii = 0U; ii < 8U; ii++)
+    {
+        table[ii].dp_mpa = (int32_t) (ii * 1000000U);
+        table[ii].k_q16 = (uint32_t) ( (FLOW_K + ( (float) ii * 0.01F)) * 65536.0F);
+    }
+
+    if ( (NPA_SUCCESS != npa_flow_init (&flow_constant, &constant, 1U, true))
+            || (NPA_SUCCESS != npa_flow_init (&flow_table, table, 8U, true)))
+    {
+        fprintf (stderr, "bench_flow: invalid calibration\n");
+        return EXIT_FAILURE;
+    }
+
+    fill_input();
+    bench_sqrtf();
+    bench_int ("int_8point", &flow_table);
+    bench_int ("int_1point", &flow_constant);
+    accuracy (&flow_constant);
+    return EXIT_SUCCESS;
+}
+
+/** @} */
@@ -0,0 +1,114 @@
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file bench_frames.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Nanoseconds per frame of decoding raw frame buffers.
+ *
+ * Compares a loop of single frame decodes, the scalar buffer kernel and the vector
+ * kernel selected at compile time, and reports speedup of vector kernel over both.
+ * Build with e.g. BENCH_CFLAGS="-Wall -pedantic -std=c11 -O2 -mavx2" to measure AVX2.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+#include "npa_700.h"
+#include "npa_700_frames.h"
+
+#include <stdlib.h>
+
+#define NUM_FRAMES (1U << 16U) //!< Frames per measurement, fits in cache.
+
+static uint8_t m_raw[NUM_FRAMES * NPA_FRAME_LEN_HIRES];
+static float m_pressure[NUM_FRAMES];
+static npa_ret_t m_status[NUM_FRAMES];
+
+typedef npa_ret_t (*decode_fp) (const npa_variant_t model, const uint8_t * const raw_data,
+                                const uint8_t data_len, const size_t num_frames,
+                                float * const pressure_pa, npa_ret_t * const status);
+
+static npa_ret_t decode_loop (const npa_variant_t model, const uint8_t * const raw_data,
+                              const uint8_t data_len, const size_t num_frames,
+                              float * const pressure_pa, npa_ret_t * const status)
+{
+    npa_ret_t status_all = NPA_SUCCESS;
+
+    for (size_t ii = 0U; ii < num_frames; ii++)
+    {
+        status[ii] = npa_decode_frame (model, &raw_data[ii * data_len], data_len,
+                                       &pressure_pa[ii], NULL);
+        status_all |= status[ii];
+    }
+
+    return status_all;
+}
+
+static uint64_t run_case (const char * const name, const decode_fp decode,
+                          const uint8_t data_len)
+{
+    bench_time_t best = { 0U, 0U };
+    uint64_t check = 0U;
+
+    for (uint32_t repeat = 0U; repeat < BENCH_REPEATS; repeat++)
+    {
+        const bench_time_t start = bench_start();
+        (void) decode (NPA_700_001D, m_raw, data_len, NUM_FRAMES, m_pressure, m_status);
+        best = bench_min (best, bench_stop (start));
+        check = 0U;
+
+        for (size_t ii = 0U; ii < NUM_FRAMES; ii++)
+        {
+            check += (uint64_t) (int64_t) m_pressure[ii] + m_status[ii];
+        }
+    }
+
+    bench_report ("frames", name, NUM_FRAMES, best, check);
+    return best.ns;
+}
+
+static void run_len (const uint8_t data_len)
+{
+    char name[32];
+    uint32_t state = 1U;
+
+    // Noisy signal around mid-scale, every 16th frame stale.
+    for (size_t ii = 0U; ii < NUM_FRAMES; ii++)
+    {
+        uint8_t * const frame = &m_raw[ii * data_len];
+        state = (state * 1103515245U) + 12345U;
+        const uint32_t counts = 8192U + ( (state >> 16U) & 0x3FFU);
+        frame[0U] = (uint8_t) ( (counts >> 8U) | ( (0U == (ii & 15U)) ? 0x80U : 0U));
+        frame[1U] = (uint8_t) counts;
+
+        for (uint8_t byte = 2U; byte < data_len; byte++)
+        {
+            frame[byte] = (uint8_t) (state >> 24U);
+        }
+    }
+
+    (void) snprintf (name, sizeof (name), "decode_frame_loop_%u", data_len);
+    const uint64_t loop_ns = run_case (name, &decode_loop, data_len);
+    (void) snprintf (name, sizeof (name), "scalar_%u", data_len);
+    const uint64_t scalar_ns = run_case (name, &npa_decode_frames_scalar, data_len);
+    (void) snprintf (name, sizeof (name), "%s_%u", npa_decode_frames_kernel(), data_len);
+    const uint64_t vector_ns = run_case (name, &npa_decode_frames, data_len);
+    const double vector = (0U == vector_ns) ? 1.0 : (double) vector_ns;
+    (void) snprintf (name, sizeof (name), "frames_%u", data_len);
+    bench_report_value ("frames", name, "speedup_vs_loop", (double) loop_ns / vector);
+    bench_report_value ("frames", name, "speedup_vs_scalar", (double) scalar_ns / vector);
+}
+
+int main (void)
+{
+    run_len (NPA_FRAME_LEN_PRES);
+    run_len (NPA_FRAME_LEN_HIRES);
+    return EXIT_SUCCESS;
+}
+
+/** @} */
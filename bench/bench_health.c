@@ -0,0 +1,122 @@
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file bench_health.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Nanoseconds per read of health monitoring.
+ *
+ * Sensor updates a noisy signal at 1 kHz with jitter and is read twice per update,
+ * so that every other read is stale, with a bus error in 256 reads. All detectors
+ * are enabled and no condition should be raised. Decode of the same reads as 2-byte
+ * frames is the baseline, as every read is decoded anyway. Number of transitions is
+ * the check.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+#include "npa_700.h"
+#include "npa_700_health.h"
+
+#include <stdlib.h>
+
+#define NUM_READS (1U << 16U) //!< Reads per measurement, fits in cache.
+#define PERIOD_US (1000U)     //!< Update period.
+
+static uint8_t m_raw[NUM_READS * NPA_FRAME_LEN_PRES];
+static npa_ret_t m_status[NUM_READS];
+static uint16_t m_counts[NUM_READS];
+static uint32_t m_time_us[NUM_READS];
+static float m_pressure[NUM_READS];
+
+static void generate_reads (void)
+{
+    uint32_t state = 1U;
+    uint32_t now_us = 0U;
+
+    for (uint32_t ii = 0U; ii < NUM_READS; ii++)
+    {
+        state = (state * 1103515245U) + 12345U;
+        now_us += (PERIOD_US / 2U) - 10U + ( (state >> 8U) % 21U);
+        m_counts[ii] = (0U == (ii & 1U))
+                       ? (uint16_t) (NPA_PRES_MIDDLE + ( (state >> 16U) & 0x3FU))
+                       : m_counts[ii - 1U];
+        m_status[ii] = (0U == (ii % 256U)) ? NPA_ERR_NACK
+                       : (0U != (ii & 1U)) ? NPA_WARN_OLD : NPA_SUCCESS;
+        m_time_us[ii] = now_us;
+        m_raw[ii * NPA_FRAME_LEN_PRES] = (uint8_t) ( (m_counts[ii] >> 8U)
+                                         | ( (NPA_WARN_OLD == m_status[ii]) ? 0x80U : 0U));
+        m_raw[ (ii * NPA_FRAME_LEN_PRES) + 1U] = (uint8_t) (m_counts[ii] & 0xFFU);
+    }
+}
+
+static void run_decode (void)
+{
+    bench_time_t best = { 0U, 0U };
+    uint64_t check = 0U;
+
+    for (uint32_t repeat = 0U; repeat < BENCH_REPEATS; repeat++)
+    {
+        const bench_time_t start = bench_start();
+        check = 0U;
+
+        for (uint32_t ii = 0U; ii < NUM_READS; ii++)
+        {
+            check += npa_decode_frame (NPA_700_001D, &m_raw[ii * NPA_FRAME_LEN_PRES],
+                                       NPA_FRAME_LEN_PRES, &m_pressure[ii], NULL);
+        }
+
+        best = bench_min (best, bench_stop (start));
+    }
+
+    bench_report ("health", "decode_frame", NUM_READS, best, check);
+}
+
+static void run_update (void)
+{
+    const npa_health_cfg_t cfg =
+    {
+        .frozen_samples = 20U,
+        .error_weight = 8U,
+        .error_limit = 32U,
+        .sat_samples = 10U,
+        .period_us = PERIOD_US,
+        .period_tolerance_us = 50U,
+        .callback = NULL,
+        .p_context = NULL
+    };
+    npa_health_t health;
+    bench_time_t best = { 0U, 0U };
+    uint64_t check = 0U;
+
+    for (uint32_t repeat = 0U; repeat < BENCH_REPEATS; repeat++)
+    {
+        (void) npa_health_init (&health, &cfg);
+        const bench_time_t start = bench_start();
+
+        for (uint32_t ii = 0U; ii < NUM_READS; ii++)
+        {
+            (void) npa_health_update (&health, m_status[ii], m_counts[ii], m_time_us[ii]);
+        }
+
+        best = bench_min (best, bench_stop (start));
+        check = health.transitions;
+    }
+
+    bench_report ("health", "update", NUM_READS, best, check);
+}
+
+int main (void)
+{
+    generate_reads();
+    run_decode();
+    run_update();
+    return EXIT_SUCCESS;
+}
+
+/** @} */
@@ -0,0 +1,128 @@
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file bench_lut.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Nanoseconds per sample of table and arithmetic conversion.
+ *
+ * Bench is built with table of NPA_700_001D only. Input is either a slow noisy signal,
+ * which touches a few cache lines of the table, or uniformly random counts over the
+ * full range, which misses cache on most loads. On a host with FPU the arithmetic
+ * path is expected to win; the table pays off on targets with software float.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+#include "npa_700.h"
+#include "npa_700_lut.h"
+
+#include <stdlib.h>
+
+#define NUM_SAMPLES (1U << 20U) //!< Samples per measurement.
+
+static uint16_t m_counts[NUM_SAMPLES];
+static float m_pressure[NUM_SAMPLES];
+static npa_ret_t m_status[NUM_SAMPLES];
+
+typedef npa_ret_t (*convert_fp) (const npa_variant_t model, const uint16_t counts,
+                                 float * const pressure_pa);
+
+static uint64_t checksum (void)
+{
+    uint64_t check = 0U;
+
+    for (size_t ii = 0U; ii < NUM_SAMPLES; ii++)
+    {
+        check += (uint64_t) (int64_t) m_pressure[ii];
+    }
+
+    return check;
+}
+
+static void run_single (const char * const name, const npa_variant_t model,
+                        const convert_fp convert)
+{
+    bench_time_t best = { 0U, 0U };
+    uint64_t check = 0U;
+
+    for (uint32_t repeat = 0U; repeat < BENCH_REPEATS; repeat++)
+    {
+        const bench_time_t start = bench_start();
+
+        for (size_t ii = 0U; ii < NUM_SAMPLES; ii++)
+        {
+            m_status[ii] = convert (model, m_counts[ii], &m_pressure[ii]);
+        }
+
+        best = bench_min (best, bench_stop (start));
+        check = checksum();
+    }
+
+    bench_report ("lut", name, NUM_SAMPLES, best, check);
+}
+
+static void run_batch (const char * const name, const npa_variant_t model)
+{
+    bench_time_t best = { 0U, 0U };
+    uint64_t check = 0U;
+
+    for (uint32_t repeat = 0U; repeat < BENCH_REPEATS; repeat++)
+    {
+        const bench_time_t start = bench_start();
+        (void) npa_lut_convert_batch (model, m_counts, NUM_SAMPLES, m_pressure, m_status);
+        best = bench_min (best, bench_stop (start));
+        check = checksum();
+    }
+
+    bench_report ("lut", name, NUM_SAMPLES, best, check);
+}
+
+static void run_input (const char * const input)
+{
+    char name[48];
+    (void) snprintf (name, sizeof (name), "convert_pa_%s", input);
+    run_single (name, NPA_700_001D, &npa_convert_pa);
+    (void) snprintf (name, sizeof (name), "lut_convert_pa_%s", input);
+    run_single (name, NPA_700_001D, &npa_lut_convert_pa);
+    (void) snprintf (name, sizeof (name), "lut_batch_%s", input);
+    run_batch (name, NPA_700_001D);
+    // Model without table falls back to arithmetic.
+    (void) snprintf (name, sizeof (name), "lut_batch_fallback_%s", input);
+    run_batch (name, NPA_700_02WD);
+}
+
+int main (void)
+{
+    uint32_t state = 1U;
+
+    if (!npa_lut_has_table (NPA_700_001D))
+    {
+        fprintf (stderr, "bench_lut: build with NPA_LUT_001D=1\n");
+        return EXIT_FAILURE;
+    }
+
+    for (size_t ii = 0U; ii < NUM_SAMPLES; ii++)
+    {
+        state = (state * 1103515245U) + 12345U;
+        m_counts[ii] = (uint16_t) (8192U + ( (ii >> 8U) & 0x3FFU) + ( (state >> 24U) & 0x3FU));
+    }
+
+    run_input ("signal");
+
+    for (size_t ii = 0U; ii < NUM_SAMPLES; ii++)
+    {
+        state = (state * 1103515245U) + 12345U;
+        m_counts[ii] = (uint16_t) ( (state >> 16U) & NPA_PRES_MAX_SAT);
+    }
+
+    run_input ("random");
+    return EXIT_SUCCESS;
+}
+
+/** @} */
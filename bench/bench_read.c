@@ -0,0 +1,268 @@
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file bench_read.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Nanoseconds per sample of conversion and read paths.
+ *
+ * Conversions are measured for every variant on float, millipascal and Q-format
+ * paths. Reads go through the host simulator, whose bus latency is given on command
+ * line and spent as real time:
+ *
+ *     bench_read [base_us [byte_us]]
+ *
+ * Default latency is 0, which measures driver overhead only.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+#include "npa_700.h"
+#include "npa_700_sim.h"
+
+#include <stdlib.h>
+
+#define NUM_CONVERT  (1U << 20U) //!< Samples per conversion measurement.
+#define NUM_READ     (1U << 16U) //!< Samples per read measurement without latency.
+#define NUM_READ_LAT (1U << 10U) //!< Samples per read measurement with latency.
+#define NUM_SENSORS  (NPA_SIM_MAX_SENSORS) //!< Sensors in batch read.
+#define BASE_ADDR    (0x28U)     //!< Address of first simulated sensor.
+
+static uint16_t m_counts[NUM_CONVERT];
+
+static const char * const m_variant_names[] =
+{
+    "02WD", "05WD", "10WD", "001D", "005D", "015D", "030D"
+};
+
+#define NUM_VARIANTS (sizeof (m_variant_names) / sizeof (m_variant_names[0]))
+
+static const npa_ctx_t m_sensors[NUM_SENSORS] =
+{
+    { npa_sim_write, npa_sim_read, BASE_ADDR + 0U, NPA_700_001D },
+    { npa_sim_write, npa_sim_read, BASE_ADDR + 1U, NPA_700_001D },
+    { npa_sim_write, npa_sim_read, BASE_ADDR + 2U, NPA_700_005D },
+    { npa_sim_write, npa_sim_read, BASE_ADDR + 3U, NPA_700_005D },
+    { npa_sim_write, npa_sim_read, BASE_ADDR + 4U, NPA_700_02WD },
+    { npa_sim_write, npa_sim_read, BASE_ADDR + 5U, NPA_700_02WD },
+    { npa_sim_write, npa_sim_read, BASE_ADDR + 6U, NPA_700_030D },
+    { npa_sim_write, npa_sim_read, BASE_ADDR + 7U, NPA_700_030D }
+};
+
+static void bench_convert (void)
+{
+    char name[32];
+
+    for (size_t variant = 0U; variant < NUM_VARIANTS; variant++)
+    {
+        const npa_variant_t model = (npa_variant_t) variant;
+        bench_time_t best_pa = { 0U, 0U };
+        bench_time_t best_mpa = { 0U, 0U };
+        bench_time_t best_q = { 0U, 0U };
+        double sum_pa = 0.0;
+        int64_t sum_mpa = 0;
+        int64_t sum_q = 0;
+
+        for (uint32_t repeat = 0U; repeat < BENCH_REPEATS; repeat++)
+        {
+            sum_pa = 0.0;
+            sum_mpa = 0;
+            sum_q = 0;
+            bench_time_t start = bench_start();
+
+            for (size_t ii = 0U; ii < NUM_CONVERT; ii++)
+            {
+                float pressure = 0.0F;
+                (void) npa_convert_pa (model, m_counts[ii], &pressure);
+                sum_pa += pressure;
+            }
+
+            best_pa = bench_min (best_pa, bench_stop (start));
+            start = bench_start();
+
+            for (size_t ii = 0U; ii < NUM_CONVERT; ii++)
+            {
+                int32_t pressure = 0;
+                (void) npa_convert_mpa (model, m_counts[ii], &pressure);
+                sum_mpa += pressure;
+            }
+
+            best_mpa = bench_min (best_mpa, bench_stop (start));
+            start = bench_start();
+
+            for (size_t ii = 0U; ii < NUM_CONVERT; ii++)
+            {
+                int32_t pressure = 0;
+                (void) npa_convert_q (model, m_counts[ii], &pressure);
+                sum_q += pressure;
+            }
+
+            best_q = bench_min (best_q, bench_stop (start));
+        }
+
+        (void) snprintf (name, sizeof (name), "convert_pa_%s", m_variant_names[variant]);
+        bench_report ("read", name, NUM_CONVERT, best_pa, (uint64_t) (int64_t) sum_pa);
+        (void) snprintf (name, sizeof (name), "convert_mpa_%s", m_variant_names[variant]);
+        bench_report ("read", name, NUM_CONVERT, best_mpa, (uint64_t) sum_mpa);
+        (void) snprintf (name, sizeof (name), "convert_q_%s", m_variant_names[variant]);
+        bench_report ("read", name, NUM_CONVERT, best_q, (uint64_t) sum_q);
+    }
+}
+
+static void bench_decode (void)
+{
+    bench_time_t best = { 0U, 0U };
+    double sum = 0.0;
+
+    for (uint32_t repeat = 0U; repeat < BENCH_REPEATS; repeat++)
+    {
+        sum = 0.0;
+        const bench_time_t start = bench_start();
+
+        for (size_t ii = 0U; ii < NUM_CONVERT; ii++)
+        {
+            // Status bits vary with counts so that every status path is exercised.
+            const uint8_t frame[NPA_FRAME_LEN_HIRES] =
+            {
+                (uint8_t) ( (m_counts[ii] >> 8U) | ( (ii & 0x3U) << 6U)),
+                (uint8_t) m_counts[ii],
+                0x60U,
+                0x00U
+            };
+            float pressure = 0.0F;
+            float temperature = 0.0F;
+            (void) npa_decode_frame (NPA_700_001D, frame, sizeof (frame), &pressure,
+                                     &temperature);
+            sum += pressure + temperature;
+        }
+
+        best = bench_min (best, bench_stop (start));
+    }
+
+    bench_report ("read", "decode_frame_hires", NUM_CONVERT, best, (uint64_t) (int64_t) sum);
+}
+
+static void bench_reads (const uint32_t samples)
+{
+    bench_time_t best_float = { 0U, 0U };
+    bench_time_t best_mpa = { 0U, 0U };
+    bench_time_t best_handle = { 0U, 0U };
+    bench_time_t best_batch = { 0U, 0U };
+    npa_handle_t handle;
+    double sum_float = 0.0;
+    int64_t sum_mpa = 0;
+    double sum_handle = 0.0;
+    double sum_batch = 0.0;
+    (void) npa_prepare (&m_sensors[0U], &handle);
+
+    for (uint32_t repeat = 0U; repeat < BENCH_REPEATS; repeat++)
+    {
+        sum_float = 0.0;
+        sum_mpa = 0;
+        sum_handle = 0.0;
+        sum_batch = 0.0;
+        bench_time_t start = bench_start();
+
+        for (uint32_t ii = 0U; ii < samples; ii++)
+        {
+            float pressure = 0.0F;
+            (void) npa_read_pressure (&m_sensors[0U], &pressure);
+            sum_float += pressure;
+        }
+
+        best_float = bench_min (best_float, bench_stop (start));
+        start = bench_start();
+
+        for (uint32_t ii = 0U; ii < samples; ii++)
+        {
+            int32_t pressure = 0;
+            (void) npa_read_pressure_mpa (&m_sensors[0U], &pressure);
+            sum_mpa += pressure;
+        }
+
+        best_mpa = bench_min (best_mpa, bench_stop (start));
+        start = bench_start();
+
+        for (uint32_t ii = 0U; ii < samples; ii++)
+        {
+            float pressure = 0.0F;
+            (void) npa_handle_read_pressure (&handle, &pressure);
+            sum_handle += pressure;
+        }
+
+        best_handle = bench_min (best_handle, bench_stop (start));
+        start = bench_start();
+
+        for (uint32_t ii = 0U; ii < (samples / NUM_SENSORS); ii++)
+        {
+            float pressure[NUM_SENSORS];
+            (void) npa_read_pressure_batch (m_sensors, NUM_SENSORS, pressure, NULL);
+
+            for (size_t jj = 0U; jj < NUM_SENSORS; jj++)
+            {
+                sum_batch += pressure[jj];
+            }
+        }
+
+        best_batch = bench_min (best_batch, bench_stop (start));
+    }
+
+    bench_report ("read", "read_pressure", samples, best_float, (uint64_t) (int64_t) sum_float);
+    bench_report ("read", "read_pressure_mpa", samples, best_mpa, (uint64_t) sum_mpa);
+    bench_report ("read", "handle_read_pressure", samples, best_handle,
+                  (uint64_t) (int64_t) sum_handle);
+    bench_report ("read", "read_pressure_batch8", (samples / NUM_SENSORS) * NUM_SENSORS,
+                  best_batch, (uint64_t) (int64_t) sum_batch);
+}
+
+int main (int argc, char ** argv)
+{
+    const uint32_t base_us = (argc > 1) ? (uint32_t) strtoul (argv[1], NULL, 10) : 0U;
+    const uint32_t byte_us = (argc > 2) ? (uint32_t) strtoul (argv[2], NULL, 10) : 0U;
+    uint32_t state = 1U;
+
+    // Uniform over full 14-bit range, including saturated counts.
+    for (size_t ii = 0U; ii < NUM_CONVERT; ii++)
+    {
+        state = (state * 1103515245U) + 12345U;
+        m_counts[ii] = (uint16_t) ( (state >> 16U) & 0x3FFFU);
+    }
+
+    npa_sim_reset();
+
+    for (size_t ii = 0U; ii < NUM_SENSORS; ii++)
+    {
+        const npa_sim_sensor_cfg_t cfg =
+        {
+            .addr = m_sensors[ii].npa_addr,
+            .model = m_sensors[ii].model,
+            .mode = NPA_SIM_FREE_RUNNING,
+            .period_us = 1000U,
+            .pressure_pa = 100.0F,
+            .temperature_c = 25.0F,
+            .noise_counts = 4U,
+            .seed = (uint32_t) ii + 1U
+        };
+
+        if (NPA_SUCCESS != npa_sim_add (&cfg))
+        {
+            fprintf (stderr, "bench_read: simulator setup failed\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    npa_sim_set_bus_latency (base_us, byte_us, true);
+    bench_report_value ("read", "bus", "base_us", (double) base_us);
+    bench_report_value ("read", "bus", "byte_us", (double) byte_us);
+    bench_convert();
+    bench_decode();
+    bench_reads ( ( (0U == base_us) && (0U == byte_us)) ? NUM_READ : NUM_READ_LAT);
+    return EXIT_SUCCESS;
+}
+
+/** @} */
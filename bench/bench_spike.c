@@ -0,0 +1,174 @@
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file bench_spike.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Nanoseconds per sample and detection rate of spike rejection.
+ *
+ * Signal is a slow ramp with +-8 counts of noise and a spike of 500...3000 counts in
+ * one sample of 50. Each window size is timed against a baseline which copies the
+ * window and sorts it by insertion on every sample. Detection is reported as fraction
+ * of injected spikes flagged and fraction of clean samples flagged.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+#include "npa_700.h"
+#include "npa_700_spike.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define NUM_SAMPLES  (1U << 16U) //!< Samples per measurement, fits in cache.
+#define SPIKE_PERIOD (50U)       //!< Samples per injected spike.
+
+static uint16_t m_counts[NUM_SAMPLES];
+static bool m_is_spike[NUM_SAMPLES];
+static uint16_t m_output[NUM_SAMPLES];
+
+static void generate_samples (void)
+{
+    uint32_t state = 1U;
+
+    for (uint32_t ii = 0U; ii < NUM_SAMPLES; ii++)
+    {
+        state = (state * 1103515245U) + 12345U;
+        const uint32_t noise = (state >> 16U) % 17U;
+        uint32_t counts = 4000U + ( (ii >> 4U) & 0x1FFFU) + noise - 8U;
+        m_is_spike[ii] = ( (SPIKE_PERIOD / 2U) == (ii % SPIKE_PERIOD));
+
+        if (m_is_spike[ii])
+        {
+            counts += 500U + ( (state >> 8U) % 2500U);
+        }
+
+        m_counts[ii] = (uint16_t) counts;
+    }
+}
+
+// Median of window by sorting a copy on each sample.
+static uint16_t resort_median (const uint16_t * const history, const uint8_t window)
+{
+    uint16_t sorted[NPA_SPIKE_MAX_WINDOW];
+
+    for (uint8_t ii = 0U; ii < window; ii++)
+    {
+        uint8_t pos = ii;
+
+        while ( (pos > 0U) && (sorted[pos - 1U] > history[ii]))
+        {
+            sorted[pos] = sorted[pos - 1U];
+            pos--;
+        }
+
+        sorted[pos] = history[ii];
+    }
+
+    return sorted[window / 2U];
+}
+
+static void run_resort (const uint8_t window)
+{
+    bench_time_t best = { 0U, 0U };
+    uint64_t check = 0U;
+    char name[32];
+
+    for (uint32_t repeat = 0U; repeat < BENCH_REPEATS; repeat++)
+    {
+        const bench_time_t start = bench_start();
+
+        for (uint32_t ii = 0U; ii < NUM_SAMPLES; ii++)
+        {
+            m_output[ii] = (ii < window) ? m_counts[ii]
+                           : resort_median (&m_counts[ii + 1U - window], window);
+        }
+
+        best = bench_min (best, bench_stop (start));
+        check = 0U;
+
+        for (uint32_t ii = 0U; ii < NUM_SAMPLES; ii++)
+        {
+            check += m_output[ii];
+        }
+    }
+
+    (void) snprintf (name, sizeof (name), "resort_%u", (unsigned) window);
+    bench_report ("spike", name, NUM_SAMPLES, best, check);
+}
+
+static void run_spike (const uint8_t window)
+{
+    const npa_spike_cfg_t cfg =
+    {
+        .window = window,
+        .threshold = 4U,
+        .mad_scale = NPA_SPIKE_SCALE_3SIGMA
+    };
+    npa_spike_t spike;
+    bench_time_t best = { 0U, 0U };
+    uint64_t check = 0U;
+    uint32_t detected = 0U;
+    uint32_t false_alarms = 0U;
+    uint32_t spikes = 0U;
+    char name[32];
+
+    for (uint32_t repeat = 0U; repeat < BENCH_REPEATS; repeat++)
+    {
+        (void) npa_spike_init (&spike, &cfg);
+        const bench_time_t start = bench_start();
+
+        for (uint32_t ii = 0U; ii < NUM_SAMPLES; ii++)
+        {
+            (void) npa_spike_push (&spike, m_counts[ii], NPA_SUCCESS, &m_output[ii]);
+        }
+
+        best = bench_min (best, bench_stop (start));
+        check = 0U;
+
+        for (uint32_t ii = 0U; ii < NUM_SAMPLES; ii++)
+        {
+            check += m_output[ii];
+        }
+    }
+
+    (void) npa_spike_init (&spike, &cfg);
+
+    for (uint32_t ii = 0U; ii < NUM_SAMPLES; ii++)
+    {
+        uint16_t output = 0U;
+        const bool flagged = (NPA_WARN_SPIKE == npa_spike_push (&spike, m_counts[ii],
+                              NPA_SUCCESS, &output));
+        spikes += m_is_spike[ii] ? 1U : 0U;
+        detected += (flagged && m_is_spike[ii]) ? 1U : 0U;
+        false_alarms += (flagged && !m_is_spike[ii]) ? 1U : 0U;
+    }
+
+    (void) snprintf (name, sizeof (name), "hampel_%u", (unsigned) window);
+    bench_report ("spike", name, NUM_SAMPLES, best, check);
+    bench_report_value ("spike", name, "detected",
+                        (double) detected / (double) spikes);
+    bench_report_value ("spike", name, "false_alarm",
+                        (double) false_alarms / (double) (NUM_SAMPLES - spikes));
+}
+
+int main (void)
+{
+    generate_samples();
+
+    for (uint8_t window = NPA_SPIKE_MIN_WINDOW; window <= NPA_SPIKE_MAX_WINDOW;
+            window += 4U)
+    {
+        run_resort (window);
+        run_spike (window);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/** @} */
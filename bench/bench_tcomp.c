@@ -0,0 +1,207 @@
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file bench_tcomp.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Nanoseconds per sample and accuracy of temperature compensation.
+ *
+ * Grid is fitted on the host from a synthetic calibration run with quadratic
+ * temperature drift, then timed on frames of a slow signal. Decode of the same frames
+ * without compensation is the baseline. Accuracy is reported as RMS error of counts
+ * before and after compensation on the calibration run and on a separate validation
+ * run, and as the largest error of integer interpolation against double.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+#include "npa_700.h"
+#include "npa_700_tcomp.h"
+#include "npa_700_tcomp_fit.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#define NUM_FRAMES  (1U << 16U) //!< Frames per measurement, fits in cache.
+#define NUM_SAMPLES (50000U)    //!< Samples of calibration run.
+#define P_SHIFT     (11U)       //!< 9 pressure nodes.
+#define T_SHIFT     (7U)        //!< 17 temperature nodes.
+
+static uint8_t m_raw[NUM_FRAMES * NPA_FRAME_LEN_HIRES];
+static float m_pressure[NUM_FRAMES];
+static npa_tcomp_sample_t m_samples[NUM_SAMPLES];
+static int16_t m_grid[NPA_TCOMP_GRID_LEN (P_SHIFT, T_SHIFT)];
+
+static double drift (const double reference, const double temperature)
+{
+    const double dt = temperature - 800.0;
+    return (0.02 * dt) + (3e-5 * dt * dt) + (1e-6 * dt * (reference - NPA_PRES_MIDDLE));
+}
+
+static void generate_samples (uint32_t state)
+{
+    for (uint32_t ii = 0U; ii < NUM_SAMPLES; ii++)
+    {
+        state = (state * 1103515245U) + 12345U;
+        const double reference = NPA_PRES_MIN_NONSAT + (double) ( (state >> 8U)
+                                 % (NPA_PRES_MAX_NONSAT - NPA_PRES_MIN_NONSAT));
+        state = (state * 1103515245U) + 12345U;
+        const uint16_t temperature = (uint16_t) (400U + ( (state >> 8U) % 1000U));
+        state = (state * 1103515245U) + 12345U;
+        const double noise = (double) ( (state >> 16U) % 3U) - 1.0;
+        m_samples[ii].counts = (uint16_t) lround (reference + drift (reference, temperature)
+                               + noise);
+        m_samples[ii].temperature = temperature;
+        m_samples[ii].reference = (float) reference;
+    }
+}
+
+static double rms_error (const npa_tcomp_t * const tcomp)
+{
+    double sum = 0.0;
+
+    for (uint32_t ii = 0U; ii < NUM_SAMPLES; ii++)
+    {
+        const double error = (double) m_samples[ii].reference
+                             - (double) npa_tcomp_apply (tcomp, m_samples[ii].counts,
+                                     m_samples[ii].temperature);
+        sum += error * error;
+    }
+
+    return sqrt (sum / NUM_SAMPLES);
+}
+
+static double interpolation_error (const npa_tcomp_t * const tcomp)
+{
+    const uint32_t p_nodes = NPA_TCOMP_P_NODES (P_SHIFT);
+    double max_error = 0.0;
+
+    for (uint32_t counts = 0U; counts <= NPA_PRES_MAX_SAT; counts += 7U)
+    {
+        for (uint32_t temperature = 0U; temperature <= NPA_TEMP_MAX_HIRES; temperature += 5U)
+        {
+            const double p_frac = (double) (counts & ( (1U << P_SHIFT) - 1U))
+                                  / (double) (1U << P_SHIFT);
+            const double t_frac = (double) (temperature & ( (1U << T_SHIFT) - 1U))
+                                  / (double) (1U << T_SHIFT);
+            const int16_t * const low = &m_grid[ ( (temperature >> T_SHIFT) * p_nodes)
+                                                 + (counts >> P_SHIFT)];
+            const double expected = ( (1.0 - t_frac) * ( ( (1.0 - p_frac) * low[0U])
+                                      + (p_frac * low[1U])))
+                                    + (t_frac * ( ( (1.0 - p_frac) * low[p_nodes])
+                                            + (p_frac * low[p_nodes + 1U])));
+            const double error = fabs (expected - (double) npa_tcomp_correction (tcomp,
+                                       (uint16_t) counts, (uint16_t) temperature));
+            max_error = (error > max_error) ? error : max_error;
+        }
+    }
+
+    return max_error;
+}
+
+static void run_decode (const char * const name, const npa_tcomp_t * const tcomp)
+{
+    bench_time_t best = { 0U, 0U };
+    uint64_t check = 0U;
+
+    for (uint32_t repeat = 0U; repeat < BENCH_REPEATS; repeat++)
+    {
+        const bench_time_t start = bench_start();
+
+        for (size_t ii = 0U; ii < NUM_FRAMES; ii++)
+        {
+            const uint8_t * const frame = &m_raw[ii * NPA_FRAME_LEN_HIRES];
+            (void) ( (NULL == tcomp)
+                     ? npa_decode_frame (NPA_700_001D, frame, NPA_FRAME_LEN_HIRES,
+                                         &m_pressure[ii], NULL)
+                     : npa_tcomp_decode (tcomp, NPA_700_001D, frame, NPA_FRAME_LEN_HIRES,
+                                         &m_pressure[ii], NULL));
+        }
+
+        best = bench_min (best, bench_stop (start));
+        check = 0U;
+
+        for (size_t ii = 0U; ii < NUM_FRAMES; ii++)
+        {
+            check += (uint64_t) (int64_t) m_pressure[ii];
+        }
+    }
+
+    bench_report ("tcomp", name, NUM_FRAMES, best, check);
+}
+
+static void run_apply (const npa_tcomp_t * const tcomp)
+{
+    bench_time_t best = { 0U, 0U };
+    uint64_t check = 0U;
+
+    for (uint32_t repeat = 0U; repeat < BENCH_REPEATS; repeat++)
+    {
+        const bench_time_t start = bench_start();
+        check = 0U;
+
+        for (uint32_t ii = 0U; ii < NUM_SAMPLES; ii++)
+        {
+            check += npa_tcomp_apply (tcomp, m_samples[ii].counts, m_samples[ii].temperature);
+        }
+
+        best = bench_min (best, bench_stop (start));
+    }
+
+    bench_report ("tcomp", "apply", NUM_SAMPLES, best, check);
+}
+
+int main (void)
+{
+    npa_tcomp_t tcomp;
+    npa_tcomp_fit_result_t result;
+    const npa_tcomp_fit_cfg_t cfg =
+    {
+        .p_shift = P_SHIFT,
+        .t_shift = T_SHIFT,
+        .smoothing = 1.0,
+        .max_iterations = 0U
+    };
+    uint32_t state = 1U;
+    generate_samples (1U);
+    const uint64_t fit_start = bench_now_ns();
+
+    if ( (NPA_SUCCESS != npa_tcomp_fit (&cfg, m_samples, NUM_SAMPLES, m_grid, &result))
+            || (NPA_SUCCESS != npa_tcomp_init (&tcomp, m_grid, P_SHIFT, T_SHIFT)))
+    {
+        fprintf (stderr, "bench_tcomp: fit failed\n");
+        return EXIT_FAILURE;
+    }
+
+    bench_report_value ("tcomp", "fit", "seconds",
+                        (double) (bench_now_ns() - fit_start) / 1e9);
+    bench_report_value ("tcomp", "fit", "iterations", (double) result.iterations);
+    bench_report_value ("tcomp", "calibration", "rms_before", result.rms_before);
+    bench_report_value ("tcomp", "calibration", "rms_after", result.rms_after);
+    generate_samples (2U);
+    bench_report_value ("tcomp", "validation", "rms_after", rms_error (&tcomp));
+    bench_report_value ("tcomp", "interpolation", "max_err_lsb", interpolation_error (&tcomp));
+
+    for (size_t ii = 0U; ii < NUM_FRAMES; ii++)
+    {
+        state = (state * 1103515245U) + 12345U;
+        const uint32_t counts = 8192U + ( (ii >> 6U) & 0x3FFU) + ( (state >> 24U) & 0x3FU);
+        const uint32_t temperature = 400U + ( (ii >> 8U) & 0x3FFU);
+        m_raw[ii * NPA_FRAME_LEN_HIRES] = (uint8_t) (counts >> 8U);
+        m_raw[ (ii * NPA_FRAME_LEN_HIRES) + 1U] = (uint8_t) (counts & 0xFFU);
+        m_raw[ (ii * NPA_FRAME_LEN_HIRES) + 2U] = (uint8_t) (temperature >> 3U);
+        m_raw[ (ii * NPA_FRAME_LEN_HIRES) + 3U] = (uint8_t) ( (temperature & 0x07U) << 5U);
+    }
+
+    run_decode ("decode_frame", NULL);
+    run_decode ("tcomp_decode", &tcomp);
+    run_apply (&tcomp);
+    return EXIT_SUCCESS;
+}
+
+/** @} */
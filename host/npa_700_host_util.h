@@ -0,0 +1,72 @@
+#ifndef NPA_700_HOST_UTIL_H
+#define NPA_700_HOST_UTIL_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_host_util.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Time and float helpers shared by host implementations.
+ *
+ * Times are CLOCK_MONOTONIC nanoseconds. Includer defines _POSIX_C_SOURCE 200809L
+ * before any include, as clock_nanosleep is POSIX.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#define NPA_HOST_NS_PER_US (1000)       //!< Nanoseconds in a microsecond.
+#define NPA_HOST_NS_PER_S  (1000000000) //!< Nanoseconds in a second.
+
+/** @brief Current CLOCK_MONOTONIC time in nanoseconds. */
+static inline int64_t npa_host_monotonic_ns (void)
+{
+    struct timespec now;
+    (void) clock_gettime (CLOCK_MONOTONIC, &now);
+    return ( (int64_t) now.tv_sec * NPA_HOST_NS_PER_S) + now.tv_nsec;
+}
+
+/**
+ * @brief Sleep until an absolute CLOCK_MONOTONIC time.
+ *
+ * @param[in] deadline_ns Time to wake up, returns at once if it has passed.
+ */
+static inline void npa_host_sleep_until (const int64_t deadline_ns)
+{
+    const struct timespec deadline =
+    {
+        .tv_sec = (time_t) (deadline_ns / NPA_HOST_NS_PER_S),
+        .tv_nsec = (long) (deadline_ns % NPA_HOST_NS_PER_S)
+    };
+
+    while (EINTR == clock_nanosleep (CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL))
+    {
+        // Signal handler ran, deadline is absolute so sleep is simply resumed.
+    }
+}
+
+/** @brief Bit pattern of a float. */
+static inline uint32_t npa_host_float_bits (const float value)
+{
+    uint32_t bits;
+    memcpy (&bits, &value, sizeof (bits));
+    return bits;
+}
+
+/** @brief Float of a bit pattern. */
+static inline float npa_host_bits_float (const uint32_t bits)
+{
+    float value;
+    memcpy (&value, &bits, sizeof (value));
+    return value;
+}
+
+/** @} */
+#endif // NPA_700_HOST_UTIL_H
@@ -0,0 +1,415 @@
+// clock_nanosleep
+#define _POSIX_C_SOURCE 200809L
+
+#include "npa_700_linux.h"
+#include "npa_700_host_util.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_linux.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * Deadlines are kept as CLOCK_MONOTONIC nanoseconds and advanced by whole periods,
+ * so rounding of each sleep does not accumulate.
+ */
+
+#define NPA_LINUX_MAX_MSGS  (2U)         //!< Messages of a combined transfer.
+
+static int m_fd = -1;
+static npa_linux_ioctl_fp m_ioctl;
+
+npa_ret_t npa_linux_open (const char * const path)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if (NULL == path)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        npa_linux_close();
+        m_fd = open (path, O_RDWR);
+
+        if (0 > m_fd)
+        {
+            ret_code |= NPA_ERR_FATAL;
+        }
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_linux_attach (const int fd)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if (0 > fd)
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        npa_linux_close();
+        m_fd = fd;
+    }
+
+    return ret_code;
+}
+
+void npa_linux_close (void)
+{
+    if (0 <= m_fd)
+    {
+        (void) close (m_fd);
+        m_fd = -1;
+    }
+}
+
+void npa_linux_set_ioctl (const npa_linux_ioctl_fp hook)
+{
+    m_ioctl = hook;
+}
+
+static npa_ret_t parse_errno (const int error)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (ENXIO == error) || (EREMOTEIO == error))
+    {
+        ret_code |= NPA_ERR_NACK;
+    }
+    else if (ETIMEDOUT == error)
+    {
+        ret_code |= NPA_ERR_TOUT;
+    }
+    else if ( (EAGAIN == error) || (EBUSY == error))
+    {
+        ret_code |= NPA_ERR_BUSY;
+    }
+    else
+    {
+        ret_code |= NPA_ERR_FATAL;
+    }
+
+    return ret_code;
+}
+
+static npa_ret_t transfer (struct i2c_msg * const msgs, const uint32_t num_msgs)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+    struct i2c_rdwr_ioctl_data rdwr =
+    {
+        .msgs = msgs,
+        .nmsgs = num_msgs
+    };
+
+    if (0 > m_fd)
+    {
+        ret_code |= NPA_ERR_FATAL;
+    }
+    else
+    {
+        const int result = (NULL != m_ioctl) ? m_ioctl (m_fd, I2C_RDWR, &rdwr)
+                           : ioctl (m_fd, I2C_RDWR, &rdwr);
+
+        if (0 > result)
+        {
+            ret_code |= parse_errno (errno);
+        }
+        else if ( (uint32_t) result != num_msgs)
+        {
+            ret_code |= NPA_ERR_FATAL;
+        }
+        else
+        {
+            // All messages were transferred.
+        }
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_linux_read (const uint8_t i2c_addr, uint8_t * const data,
+                          const uint8_t data_len)
+{
+    struct i2c_msg msg =
+    {
+        .addr = i2c_addr,
+        .flags = I2C_M_RD,
+        .len = data_len,
+        .buf = data
+    };
+    return transfer (&msg, 1U);
+}
+
+npa_ret_t npa_linux_write (const uint8_t i2c_addr, const uint8_t * const data,
+                           const uint8_t data_len)
+{
+    // Kernel does not modify buffer of a write message.
+    struct i2c_msg msg =
+    {
+        .addr = i2c_addr,
+        .flags = 0U,
+        .len = data_len,
+        .buf = (uint8_t *) (uintptr_t) data
+    };
+    return transfer (&msg, 1U);
+}
+
+npa_ret_t npa_linux_xfer (const uint8_t i2c_addr, const uint8_t * const tx_data,
+                          const uint8_t tx_len, uint8_t * const rx_data,
+                          const uint8_t rx_len)
+{
+    struct i2c_msg msgs[NPA_LINUX_MAX_MSGS];
+    uint32_t num_msgs = 0U;
+
+    if (0U < tx_len)
+    {
+        msgs[num_msgs].addr = i2c_addr;
+        msgs[num_msgs].flags = 0U;
+        msgs[num_msgs].len = tx_len;
+        msgs[num_msgs].buf = (uint8_t *) (uintptr_t) tx_data;
+        num_msgs++;
+    }
+
+    if ( (0U < rx_len) || (0U == num_msgs))
+    {
+        msgs[num_msgs].addr = i2c_addr;
+        msgs[num_msgs].flags = I2C_M_RD;
+        msgs[num_msgs].len = rx_len;
+        msgs[num_msgs].buf = rx_data;
+        num_msgs++;
+    }
+
+    return transfer (msgs, num_msgs);
+}
+
+static void publish_latest (npa_linux_latest_t * const latest,
+                            const npa_sample_t * const sample)
+{
+    const uint32_t sequence = npa_seqlock_write_begin (&latest->sequence);
+    npa_atomic_store_relaxed (&latest->timestamp, sample->timestamp);
+    npa_atomic_store_relaxed (&latest->pressure,
+                              npa_host_float_bits (sample->pressure_pa));
+    npa_atomic_store_relaxed (&latest->temperature,
+                              npa_host_float_bits (sample->temperature_c));
+    npa_atomic_store_relaxed (&latest->status, sample->status);
+    npa_seqlock_write_end (&latest->sequence, sequence);
+}
+
+static void acq_cycle (npa_linux_acq_t * const acq)
+{
+    const npa_linux_acq_cfg_t * const cfg = &acq->cfg;
+
+    for (size_t ii = 0U; ii < cfg->num_sensors; ii++)
+    {
+        npa_sample_t sample = { 0U, 0.0F, 0.0F, NPA_SUCCESS };
+
+        if (cfg->temperature)
+        {
+            sample.status = npa_read_pressure_temp_lowres (&cfg->sensors[ii],
+                            &sample.pressure_pa, &sample.temperature_c);
+        }
+        else
+        {
+            sample.status = npa_read_pressure (&cfg->sensors[ii], &sample.pressure_pa);
+        }
+
+        sample.timestamp = (NULL != cfg->clock) ? cfg->clock()
+                           : (uint32_t) (npa_host_monotonic_ns() / NPA_HOST_NS_PER_US);
+        publish_latest (&cfg->latest[ii], &sample);
+
+        if ( (NULL != cfg->rings) && !npa_ring_push (&cfg->rings[ii], &sample))
+        {
+            npa_atomic_add_single (&acq->dropped, 1U);
+        }
+    }
+}
+
+static void * acq_thread (void * const p_context)
+{
+    npa_linux_acq_t * const acq = (npa_linux_acq_t *) p_context;
+    const int64_t period_ns = (int64_t) acq->cfg.period_us * NPA_HOST_NS_PER_US;
+    int64_t deadline_ns = npa_host_monotonic_ns();
+
+    while (0U == npa_atomic_load_acquire (&acq->stop))
+    {
+        acq_cycle (acq);
+        npa_atomic_add_single (&acq->cycles, 1U);
+        deadline_ns += period_ns;
+        const int64_t now_ns = npa_host_monotonic_ns();
+
+        // Keep phase of deadlines, but do not run missed cycles back to back.
+        if (now_ns >= deadline_ns)
+        {
+            const int64_t missed = ( (now_ns - deadline_ns) / period_ns) + 1;
+            npa_atomic_add_single (&acq->overruns, (uint32_t) missed);
+            deadline_ns += missed * period_ns;
+        }
+
+        npa_host_sleep_until (deadline_ns);
+    }
+
+    return NULL;
+}
+
+npa_ret_t npa_linux_acq_start (npa_linux_acq_t * const acq,
+                               const npa_linux_acq_cfg_t * const cfg)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == acq) || (NULL == cfg) || (NULL == cfg->sensors)
+            || (NULL == cfg->latest))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (0U == cfg->period_us) || (0U == cfg->num_sensors))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        acq->cfg = *cfg;
+        acq->started = false;
+        npa_atomic_store_relaxed (&acq->stop, 0U);
+        npa_atomic_store_relaxed (&acq->cycles, 0U);
+        npa_atomic_store_relaxed (&acq->overruns, 0U);
+        npa_atomic_store_relaxed (&acq->dropped, 0U);
+
+        for (size_t ii = 0U; ii < cfg->num_sensors; ii++)
+        {
+            npa_atomic_store_relaxed (&cfg->latest[ii].sequence, 0U);
+        }
+
+        // Thread creation orders the stores above before the thread starts.
+        if (0 != pthread_create (&acq->thread, NULL, &acq_thread, acq))
+        {
+            ret_code |= NPA_ERR_FATAL;
+        }
+        else
+        {
+            acq->started = true;
+        }
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_linux_acq_stop (npa_linux_acq_t * const acq)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if (NULL == acq)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if (!acq->started)
+    {
+        ret_code |= NPA_ERR_MODE;
+    }
+    else
+    {
+        npa_atomic_store_release (&acq->stop, 1U);
+        (void) pthread_join (acq->thread, NULL);
+        acq->started = false;
+    }
+
+    return ret_code;
+}
+
+/**
+ * @brief Copy latest sample, consistent only if sequence did not change.
+ *
+ * @param[in]  latest   Latest sample to read.
+ * @param[out] sample   Copy of sample.
+ * @param[out] sequence Sequence before copy.
+ * @return true if copy is consistent.
+ */
+static bool try_latest (const npa_linux_latest_t * const latest,
+                        npa_sample_t * const sample, uint32_t * const sequence)
+{
+    const uint32_t before = npa_seqlock_read_begin (&latest->sequence);
+    sample->timestamp = npa_atomic_load_relaxed (&latest->timestamp);
+    sample->pressure_pa =
+        npa_host_bits_float (npa_atomic_load_relaxed (&latest->pressure));
+    sample->temperature_c =
+        npa_host_bits_float (npa_atomic_load_relaxed (&latest->temperature));
+    sample->status = (npa_ret_t) npa_atomic_load_relaxed (&latest->status);
+    *sequence = before;
+    return npa_seqlock_read_valid (&latest->sequence, before);
+}
+
+npa_ret_t npa_linux_acq_latest (const npa_linux_acq_t * const acq, const size_t index,
+                                npa_sample_t * const sample)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == acq) || (NULL == sample))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if (index >= acq->cfg.num_sensors)
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        npa_sample_t copy;
+        uint32_t sequence = 0U;
+        bool consistent = false;
+
+        for (uint32_t tries = 0U; (!consistent) && (tries < NPA_SEQLOCK_TRIES); tries++)
+        {
+            consistent = try_latest (&acq->cfg.latest[index], &copy, &sequence);
+        }
+
+        if (!consistent)
+        {
+            ret_code |= NPA_ERR_BUSY;
+        }
+        else if (0U == sequence)
+        {
+            ret_code |= NPA_WARN_OLD;
+        }
+        else
+        {
+            *sample = copy;
+        }
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_linux_acq_counters (const npa_linux_acq_t * const acq,
+                                  npa_linux_acq_counters_t * const counters)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == acq) || (NULL == counters))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        counters->cycles = npa_atomic_load_acquire (&acq->cycles);
+        counters->overruns = npa_atomic_load_acquire (&acq->overruns);
+        counters->dropped = npa_atomic_load_acquire (&acq->dropped);
+    }
+
+    return ret_code;
+}
+
+/** @} */
@@ -0,0 +1,214 @@
+#ifndef NPA_700_LINUX_H
+#define NPA_700_LINUX_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_linux.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Linux i2c-dev bus and acquisition thread for host rigs and monitor units.
+ *
+ * @ref npa_linux_read, @ref npa_linux_write and @ref npa_linux_xfer have signatures of
+ * @ref npa_read_fp, @ref npa_write_fp and @ref npa_xfer_fp and transfer over an open
+ * /dev/i2c-N with one ioctl(I2C_RDWR) each. The ioctl can be replaced by a hook, so
+ * the backend runs without hardware e.g. on top of the simulator.
+ *
+ * Acquisition thread reads a set of sensors every period, sleeping with
+ * clock_nanosleep to absolute deadlines so that period does not drift by the time
+ * spent reading. If a cycle overruns its deadline, missed cycles are skipped rather
+ * than read back to back. Each sample is published without locks:
+ * - Latest sample of each sensor behind a sequence lock, for any number of readers.
+ * - Optionally pushed to a @ref npa_ring_t per sensor, for one consumer each.
+ *
+ * Bus state is global, as read and write functions have no context. Bus functions
+ * are not thread safe, so sensors on the bus should only be read by one thread, e.g.
+ * the acquisition thread while it runs.
+ */
+
+#include "npa_700.h"
+#include "npa_700_atomic.h"
+#include "npa_700_ring.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Replacement of ioctl for bus transfers.
+ *
+ * Called with I2C_RDWR and a struct i2c_rdwr_ioctl_data, returns like ioctl: number
+ * of messages transferred, or -1 with errno set.
+ *
+ * @param[in]     fd      File descriptor of the bus.
+ * @param[in]     request ioctl request, I2C_RDWR.
+ * @param[in,out] arg     Messages to transfer.
+ */
+typedef int (*npa_linux_ioctl_fp) (const int fd, const unsigned long request,
+                                   void * const arg);
+
+/** @brief Latest sample of a sensor, published with a sequence lock. */
+typedef struct
+{
+    npa_atomic_u32_t sequence;    //!< Odd while sample is written, 0 before first.
+    npa_atomic_u32_t timestamp;   //!< @ref npa_sample_t.timestamp.
+    npa_atomic_u32_t pressure;    //!< Bits of @ref npa_sample_t.pressure_pa.
+    npa_atomic_u32_t temperature; //!< Bits of @ref npa_sample_t.temperature_c.
+    npa_atomic_u32_t status;      //!< @ref npa_sample_t.status.
+} npa_linux_latest_t;
+
+/** @brief Configuration of acquisition thread. */
+typedef struct
+{
+    const npa_ctx_t * sensors;    //!< Sensors to read, in order.
+    size_t num_sensors;           //!< Number of sensors.
+    uint32_t period_us;           //!< Period of reads, non-zero.
+    bool temperature;             //!< Also read temperature, with a 3-byte frame.
+    npa_clock_fp clock;           //!< Clock of timestamps, NULL for CLOCK_MONOTONIC.
+    npa_linux_latest_t * latest;  //!< Latest sample per sensor, num_sensors entries.
+    npa_ring_t * rings;           //!< Initialized queue per sensor, may be NULL.
+} npa_linux_acq_cfg_t;
+
+/** @brief Counters of acquisition thread. */
+typedef struct
+{
+    uint32_t cycles;   //!< Cycles run, each reading all sensors.
+    uint32_t overruns; //!< Cycles skipped because previous one ran late.
+    uint32_t dropped;  //!< Samples not queued because a queue was full.
+} npa_linux_acq_counters_t;
+
+/** @brief Acquisition thread. Start with @ref npa_linux_acq_start. */
+typedef struct
+{
+    npa_linux_acq_cfg_t cfg;     //!< Configuration.
+    pthread_t thread;            //!< Thread, valid while started.
+    bool started;                //!< Thread has been started and not stopped.
+    npa_atomic_u32_t stop;       //!< Non-zero requests thread to exit.
+    npa_atomic_u32_t cycles;     //!< @ref npa_linux_acq_counters_t.cycles.
+    npa_atomic_u32_t overruns;   //!< @ref npa_linux_acq_counters_t.overruns.
+    npa_atomic_u32_t dropped;    //!< @ref npa_linux_acq_counters_t.dropped.
+} npa_linux_acq_t;
+
+/**
+ * @brief Open an I2C bus, closing a previously opened one.
+ *
+ * @param[in] path Path of bus, e.g. "/dev/i2c-1".
+ * @retval NPA_SUCCESS  Bus was opened.
+ * @retval NPA_ERR_NULL Path was NULL.
+ * @retval NPA_ERR_FATAL Bus could not be opened.
+ */
+npa_ret_t npa_linux_open (const char * const path);
+
+/**
+ * @brief Use an already open file descriptor as the bus.
+ *
+ * Descriptor is closed by @ref npa_linux_close, e.g. use a pipe or /dev/null with an
+ * ioctl hook to run without hardware.
+ *
+ * @param[in] fd Open file descriptor.
+ * @retval NPA_SUCCESS   Descriptor is used.
+ * @retval NPA_ERR_PARAM Descriptor is negative.
+ */
+npa_ret_t npa_linux_attach (const int fd);
+
+/** @brief Close the bus. Transfers fail with @ref NPA_ERR_FATAL until reopened. */
+void npa_linux_close (void);
+
+/**
+ * @brief Replace ioctl of bus transfers.
+ *
+ * @param[in] hook Function to call instead of ioctl, NULL restores ioctl.
+ */
+void npa_linux_set_ioctl (const npa_linux_ioctl_fp hook);
+
+/**
+ * @brief Read from bus, signature of @ref npa_read_fp.
+ *
+ * @retval NPA_SUCCESS   Data was read.
+ * @retval NPA_ERR_NACK  Sensor did not acknowledge, ENXIO or EREMOTEIO.
+ * @retval NPA_ERR_TOUT  Transfer timed out, ETIMEDOUT.
+ * @retval NPA_ERR_BUSY  Bus was busy, EAGAIN or EBUSY.
+ * @retval NPA_ERR_FATAL Bus is not open or transfer failed otherwise.
+ */
+npa_ret_t npa_linux_read (const uint8_t i2c_addr, uint8_t * const data,
+                          const uint8_t data_len);
+
+/**
+ * @brief Write to bus, signature of @ref npa_write_fp.
+ *
+ * Errors are as of @ref npa_linux_read.
+ */
+npa_ret_t npa_linux_write (const uint8_t i2c_addr, const uint8_t * const data,
+                           const uint8_t data_len);
+
+/**
+ * @brief Write and then read with a repeated start, signature of @ref npa_xfer_fp.
+ *
+ * Errors are as of @ref npa_linux_read.
+ */
+npa_ret_t npa_linux_xfer (const uint8_t i2c_addr, const uint8_t * const tx_data,
+                          const uint8_t tx_len, uint8_t * const rx_data,
+                          const uint8_t rx_len);
+
+/**
+ * @brief Start acquisition thread.
+ *
+ * First cycle runs immediately. Latest samples are cleared.
+ *
+ * @param[out] acq Thread to start.
+ * @param[in]  cfg Configuration, copied. Sensors, latest and rings must stay valid
+ *                 until thread is stopped.
+ * @retval NPA_SUCCESS   Thread was started.
+ * @retval NPA_ERR_NULL  Thread, configuration, sensors or latest was NULL.
+ * @retval NPA_ERR_PARAM Period or number of sensors is 0.
+ * @retval NPA_ERR_FATAL Thread could not be created.
+ */
+npa_ret_t npa_linux_acq_start (npa_linux_acq_t * const acq,
+                               const npa_linux_acq_cfg_t * const cfg);
+
+/**
+ * @brief Stop acquisition thread and wait for it to exit.
+ *
+ * Thread exits at its next deadline, within one period.
+ *
+ * @param[in,out] acq Thread to stop.
+ * @retval NPA_SUCCESS  Thread was stopped.
+ * @retval NPA_ERR_NULL Thread was NULL.
+ * @retval NPA_ERR_MODE Thread was not running.
+ */
+npa_ret_t npa_linux_acq_stop (npa_linux_acq_t * const acq);
+
+/**
+ * @brief Copy latest sample of a sensor. Safe from any thread.
+ *
+ * @param[in]  acq    Thread.
+ * @param[in]  index  Index of sensor in configuration.
+ * @param[out] sample Latest sample.
+ * @retval NPA_SUCCESS   Sample was copied.
+ * @retval NPA_ERR_NULL  Thread or sample was NULL.
+ * @retval NPA_ERR_PARAM Index is out of range.
+ * @retval NPA_WARN_OLD  No sample has been published yet, sample is not written.
+ * @retval NPA_ERR_BUSY  Sample was updated during each of
+ *                       @ref NPA_SEQLOCK_TRIES attempts.
+ */
+npa_ret_t npa_linux_acq_latest (const npa_linux_acq_t * const acq, const size_t index,
+                                npa_sample_t * const sample);
+
+/**
+ * @brief Read counters of acquisition thread. Safe from any thread.
+ *
+ * @param[in]  acq      Thread.
+ * @param[out] counters Counters.
+ * @retval NPA_SUCCESS  Counters were read.
+ * @retval NPA_ERR_NULL Thread or counters was NULL.
+ */
+npa_ret_t npa_linux_acq_counters (const npa_linux_acq_t * const acq,
+                                  npa_linux_acq_counters_t * const counters);
+
+/** @} */
+#endif // NPA_700_LINUX_H
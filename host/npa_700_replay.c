@@ -0,0 +1,586 @@
+// clock_nanosleep, mmap
+#define _POSIX_C_SOURCE 200809L
+
+#include "npa_700_replay.h"
+#include "npa_700_capture.h"
+#include "npa_700_host_util.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_replay.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * Workers take whole streams from a shared counter, so streams of different length
+ * balance over the pool. Each stream writes only its own outputs, no locking is
+ * needed. Paced replay schedules each record at its captured time since the first
+ * record of the capture, scaled by speed, from a start time shared by all streams.
+ * A worker replaying streams one after another would start later streams behind their
+ * schedule, so paced replay runs one worker per stream.
+ */
+
+#define NPA_REPLAY_DUMP_VERSION (1U)        //!< Version of dump layout.
+
+/** @brief State shared by replay workers. */
+typedef struct
+{
+    npa_replay_index_t * index;   //!< Index being replayed.
+    const uint8_t * data;         //!< Capture.
+    size_t len;                   //!< Length of capture.
+    const npa_replay_cfg_t * cfg; //!< Configuration.
+    int64_t start_ns;             //!< Start of replay, CLOCK_MONOTONIC.
+    uint32_t origin;              //!< Captured time of start of replay.
+    atomic_size_t next;           //!< Next stream to take.
+} replay_job_t;
+
+npa_ret_t npa_replay_map (npa_replay_file_t * const file, const char * const path)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == file) || (NULL == path))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        struct stat info;
+        const int fd = open (path, O_RDONLY);
+        file->data = NULL;
+        file->len = 0U;
+
+        if ( (0 > fd) || (0 != fstat (fd, &info)))
+        {
+            ret_code |= NPA_ERR_FATAL;
+        }
+        else if (0 == info.st_size)
+        {
+            ret_code |= NPA_ERR_PARAM;
+        }
+        else
+        {
+            void * const mapped = mmap (NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE,
+                                        fd, 0);
+
+            if (MAP_FAILED == mapped)
+            {
+                ret_code |= NPA_ERR_FATAL;
+            }
+            else
+            {
+                file->data = (const uint8_t *) mapped;
+                file->len = (size_t) info.st_size;
+            }
+        }
+
+        // Mapping stays valid after descriptor is closed.
+        if (0 <= fd)
+        {
+            (void) close (fd);
+        }
+    }
+
+    return ret_code;
+}
+
+void npa_replay_unmap (npa_replay_file_t * const file)
+{
+    if ( (NULL != file) && (NULL != file->data))
+    {
+        (void) munmap ( (void *) (uintptr_t) file->data, file->len);
+        file->data = NULL;
+        file->len = 0U;
+    }
+}
+
+static npa_replay_stream_t * find_stream (npa_replay_index_t * const index,
+        const npa_capture_header_t * const header)
+{
+    npa_replay_stream_t * found = NULL;
+
+    for (size_t ii = 0U; (NULL == found) && (ii < index->num_streams); ii++)
+    {
+        if ( (header->addr == index->streams[ii].addr)
+                && (header->model == index->streams[ii].model))
+        {
+            found = &index->streams[ii];
+        }
+    }
+
+    if (NULL == found)
+    {
+        npa_replay_stream_t * const streams = realloc (index->streams,
+                                              (index->num_streams + 1U) * sizeof (npa_replay_stream_t));
+
+        if (NULL != streams)
+        {
+            index->streams = streams;
+            found = &streams[index->num_streams];
+            memset (found, 0, sizeof (npa_replay_stream_t));
+            found->addr = header->addr;
+            found->model = header->model;
+            index->num_streams++;
+        }
+    }
+
+    return found;
+}
+
+static bool add_block (npa_replay_stream_t * const stream, const size_t offset,
+                       const npa_capture_header_t * const header)
+{
+    // Grow capacity in powers of two.
+    const size_t num_blocks = stream->num_blocks;
+    bool added = true;
+
+    if (0U == (num_blocks & (num_blocks - 1U)))
+    {
+        size_t * const offsets = realloc (stream->offsets,
+                                          ( (0U == num_blocks) ? 1U : (2U * num_blocks)) * sizeof (size_t));
+        added = (NULL != offsets);
+
+        if (added)
+        {
+            stream->offsets = offsets;
+        }
+    }
+
+    if (added)
+    {
+        stream->offsets[num_blocks] = offset;
+        stream->num_blocks++;
+        stream->num_records += header->count;
+        stream->bytes += header->block_size;
+    }
+
+    return added;
+}
+
+// Offset of next block magic at or after offset, len if none.
+static size_t find_magic (const uint8_t * const data, const size_t len, const size_t offset)
+{
+    const uint8_t magic[4U] =
+    {
+        (uint8_t) (NPA_CAPTURE_MAGIC & 0xFFU),
+        (uint8_t) ( (NPA_CAPTURE_MAGIC >> 8U) & 0xFFU),
+        (uint8_t) ( (NPA_CAPTURE_MAGIC >> 16U) & 0xFFU),
+        (uint8_t) ( (NPA_CAPTURE_MAGIC >> 24U) & 0xFFU)
+    };
+    size_t pos = offset;
+
+    while ( ( (pos + sizeof (magic)) <= len) && (0 != memcmp (&data[pos], magic, sizeof (magic))))
+    {
+        pos++;
+    }
+
+    return ( (pos + sizeof (magic)) <= len) ? pos : len;
+}
+
+npa_ret_t npa_replay_index (npa_replay_index_t * const index, const uint8_t * const data,
+                            const size_t len)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == index) || (NULL == data))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        size_t offset = 0U;
+        memset (index, 0, sizeof (npa_replay_index_t));
+
+        while ( (NPA_SUCCESS == ret_code) && (offset < len))
+        {
+            npa_capture_reader_t reader;
+
+            if (NPA_SUCCESS == npa_capture_open (&reader, &data[offset], len - offset))
+            {
+                npa_replay_stream_t * const stream = find_stream (index, &reader.header);
+
+                if ( (NULL == stream) || !add_block (stream, offset, &reader.header))
+                {
+                    ret_code |= NPA_ERR_FATAL;
+                }
+
+                index->num_records += reader.header.count;
+                offset += reader.header.block_size;
+            }
+            else
+            {
+                index->bad_blocks++;
+                offset = find_magic (data, len, offset + 1U);
+            }
+        }
+
+        if (NPA_SUCCESS != ret_code)
+        {
+            npa_replay_free (index);
+        }
+    }
+
+    return ret_code;
+}
+
+void npa_replay_free (npa_replay_index_t * const index)
+{
+    if (NULL != index)
+    {
+        for (size_t ii = 0U; ii < index->num_streams; ii++)
+        {
+            free (index->streams[ii].offsets);
+            free (index->streams[ii].outputs);
+        }
+
+        free (index->streams);
+        memset (index, 0, sizeof (npa_replay_index_t));
+    }
+}
+
+static void replay_stream (const replay_job_t * const job, npa_replay_stream_t * const stream)
+{
+    const npa_replay_cfg_t * const cfg = job->cfg;
+    npa_filter_t filter;
+    int64_t elapsed_us = 0;
+    uint32_t previous = 0U;
+    size_t out = 0U;
+
+    if (NULL != cfg->filter)
+    {
+        (void) npa_filter_init (&filter, cfg->filter);
+    }
+
+    for (size_t bb = 0U; bb < stream->num_blocks; bb++)
+    {
+        npa_capture_reader_t reader;
+        npa_capture_record_t record;
+        const size_t offset = stream->offsets[bb];
+        (void) npa_capture_open (&reader, &job->data[offset], job->len - offset);
+
+        while ( (out < stream->num_records) && npa_capture_next (&reader, &record))
+        {
+            npa_replay_output_t * const output = &stream->outputs[out];
+
+            if (0.0 < cfg->speed)
+            {
+                // Stream may start after origin, wrap of timestamps cancels out.
+                elapsed_us += (int32_t) (record.timestamp
+                                         - ( (0U == out) ? job->origin : previous));
+                previous = record.timestamp;
+                npa_host_sleep_until (job->start_ns + (int64_t) ( (double) elapsed_us
+                                      * NPA_HOST_NS_PER_US / cfg->speed));
+            }
+
+            output->timestamp = record.timestamp;
+            output->pressure_pa = 0.0F;
+            output->temperature_c = 0.0F;
+            output->status = npa_decode_frame (stream->model, record.raw, record.raw_len,
+                                               &output->pressure_pa, &output->temperature_c);
+            output->filtered = NPA_REPLAY_NO_OUTPUT;
+
+            if (NULL != cfg->filter)
+            {
+                const uint16_t counts = (uint16_t) ( ( (uint16_t) (record.raw[0U] & 0x3FU) << 8U)
+                                                     | record.raw[1U]);
+                (void) npa_filter_push (&filter, counts, &output->filtered);
+            }
+
+            out++;
+        }
+    }
+
+    stream->num_outputs = out;
+}
+
+// Timestamp of first record of first stream, which has the first block of capture.
+static uint32_t capture_origin (const npa_replay_index_t * const index,
+                                const uint8_t * const data, const size_t len)
+{
+    npa_capture_reader_t reader;
+    npa_capture_record_t record;
+    uint32_t origin = 0U;
+
+    if ( (0U < index->num_streams) && (0U < index->streams[0U].num_blocks))
+    {
+        const size_t offset = index->streams[0U].offsets[0U];
+
+        if ( (NPA_SUCCESS == npa_capture_open (&reader, &data[offset], len - offset))
+                && npa_capture_next (&reader, &record))
+        {
+            origin = record.timestamp;
+        }
+    }
+
+    return origin;
+}
+
+static void * replay_worker (void * const p_context)
+{
+    replay_job_t * const job = (replay_job_t *) p_context;
+    bool done = false;
+
+    while (!done)
+    {
+        const size_t taken = atomic_fetch_add_explicit (&job->next, 1U,
+                             memory_order_relaxed);
+        done = (taken >= job->index->num_streams);
+
+        if (!done)
+        {
+            replay_stream (job, &job->index->streams[taken]);
+        }
+    }
+
+    return NULL;
+}
+
+npa_ret_t npa_replay_run (npa_replay_index_t * const index, const uint8_t * const data,
+                          const size_t len, const npa_replay_cfg_t * const cfg,
+                          npa_replay_result_t * const result)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+    npa_filter_t filter;
+
+    if ( (NULL == index) || (NULL == data) || (NULL == cfg) || (NULL == result))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (0.0 > cfg->speed)
+              || ( (NULL != cfg->filter) && (NPA_SUCCESS != npa_filter_init (&filter, cfg->filter))))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        const bool per_stream = (0U == cfg->threads) || (cfg->threads > index->num_streams)
+                                || (0.0 < cfg->speed);
+        const size_t threads = per_stream ? index->num_streams : cfg->threads;
+        pthread_t * const workers = calloc ( (0U == threads) ? 1U : threads, sizeof (pthread_t));
+        replay_job_t job = { index, data, len, cfg, 0, 0U, 0U };
+        size_t started = 0U;
+        memset (result, 0, sizeof (npa_replay_result_t));
+        job.origin = capture_origin (index, data, len);
+
+        for (size_t ii = 0U; (NULL != workers) && (ii < index->num_streams); ii++)
+        {
+            npa_replay_stream_t * const stream = &index->streams[ii];
+            free (stream->outputs);
+            stream->num_outputs = 0U;
+            stream->outputs = calloc ( (0U == stream->num_records) ? 1U : stream->num_records,
+                                       sizeof (npa_replay_output_t));
+
+            if (NULL == stream->outputs)
+            {
+                ret_code |= NPA_ERR_FATAL;
+            }
+        }
+
+        if ( (NULL == workers) || (NPA_SUCCESS != ret_code))
+        {
+            ret_code |= NPA_ERR_FATAL;
+        }
+        else
+        {
+            job.start_ns = npa_host_monotonic_ns();
+
+            for (started = 0U; started < threads; started++)
+            {
+                if (0 != pthread_create (&workers[started], NULL, &replay_worker, &job))
+                {
+                    ret_code |= NPA_ERR_FATAL;
+                    break;
+                }
+            }
+
+            // Workers which did start finish all streams between them.
+            for (size_t ii = 0U; ii < started; ii++)
+            {
+                (void) pthread_join (workers[ii], NULL);
+            }
+
+            result->elapsed_ns = (uint64_t) (npa_host_monotonic_ns() - job.start_ns);
+
+            for (size_t ii = 0U; ii < index->num_streams; ii++)
+            {
+                result->records += index->streams[ii].num_outputs;
+                result->bytes += index->streams[ii].bytes;
+            }
+        }
+
+        free (workers);
+    }
+
+    return ret_code;
+}
+
+static void put_le (uint8_t * const dst, const uint64_t value, const size_t len)
+{
+    for (size_t ii = 0U; ii < len; ii++)
+    {
+        dst[ii] = (uint8_t) ( (value >> (8U * ii)) & 0xFFU);
+    }
+}
+
+static uint64_t get_le (const uint8_t * const src, const size_t len)
+{
+    uint64_t value = 0U;
+
+    for (size_t ii = 0U; ii < len; ii++)
+    {
+        value |= (uint64_t) src[ii] << (8U * ii);
+    }
+
+    return value;
+}
+
+npa_ret_t npa_replay_dump (const npa_replay_index_t * const index, FILE * const stream)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == index) || (NULL == stream))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        uint8_t header[NPA_REPLAY_DUMP_HEADER];
+        uint64_t num_records = 0U;
+
+        for (size_t ii = 0U; ii < index->num_streams; ii++)
+        {
+            num_records += index->streams[ii].num_outputs;
+        }
+
+        put_le (&header[0U], NPA_REPLAY_DUMP_MAGIC, 4U);
+        put_le (&header[4U], NPA_REPLAY_DUMP_VERSION, 4U);
+        put_le (&header[8U], num_records, 8U);
+
+        if (1U != fwrite (header, sizeof (header), 1U, stream))
+        {
+            ret_code |= NPA_ERR_FATAL;
+        }
+
+        for (size_t ii = 0U; (NPA_SUCCESS == ret_code) && (ii < index->num_streams); ii++)
+        {
+            const npa_replay_stream_t * const source = &index->streams[ii];
+
+            for (size_t jj = 0U; (NPA_SUCCESS == ret_code) && (jj < source->num_outputs); jj++)
+            {
+                const npa_replay_output_t * const output = &source->outputs[jj];
+                uint8_t record[NPA_REPLAY_DUMP_RECORD];
+                record[0U] = source->addr;
+                record[1U] = (uint8_t) source->model;
+                put_le (&record[2U], output->status, 2U);
+                put_le (&record[4U], output->timestamp, 4U);
+                put_le (&record[8U], npa_host_float_bits (output->pressure_pa), 4U);
+                put_le (&record[12U], npa_host_float_bits (output->temperature_c), 4U);
+                put_le (&record[16U], output->filtered, 2U);
+
+                if (1U != fwrite (record, sizeof (record), 1U, stream))
+                {
+                    ret_code |= NPA_ERR_FATAL;
+                }
+            }
+        }
+    }
+
+    return ret_code;
+}
+
+// Number of records in dump, or -1 if header or length is invalid.
+static int64_t dump_records (const uint8_t * const dump, const size_t len)
+{
+    int64_t records = -1;
+
+    if ( (NPA_REPLAY_DUMP_HEADER <= len)
+            && (NPA_REPLAY_DUMP_MAGIC == get_le (&dump[0U], 4U))
+            && (NPA_REPLAY_DUMP_VERSION == get_le (&dump[4U], 4U)))
+    {
+        const uint64_t declared = get_le (&dump[8U], 8U);
+
+        if ( ( (len - NPA_REPLAY_DUMP_HEADER) / NPA_REPLAY_DUMP_RECORD) == declared)
+        {
+            records = (int64_t) declared;
+        }
+    }
+
+    return records;
+}
+
+static void report_record (FILE * const report, const char * const name,
+                           const uint8_t * const record)
+{
+    fprintf (report, "  %s addr=0x%02X model=%u status=%u t=%lu p=%.9g T=%.9g f=%u\n",
+             name, record[0U], record[1U], (unsigned) get_le (&record[2U], 2U),
+             (unsigned long) get_le (&record[4U], 4U),
+             (double) npa_host_bits_float ( (uint32_t) get_le (&record[8U], 4U)),
+             (double) npa_host_bits_float ( (uint32_t) get_le (&record[12U], 4U)),
+             (unsigned) get_le (&record[16U], 2U));
+}
+
+npa_ret_t npa_replay_compare (const uint8_t * const a, const size_t a_len,
+                              const uint8_t * const b, const size_t b_len,
+                              FILE * const report, const size_t max_report,
+                              size_t * const differing)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == a) || (NULL == b) || (NULL == differing))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        const int64_t a_records = dump_records (a, a_len);
+        const int64_t b_records = dump_records (b, b_len);
+        *differing = 0U;
+
+        if ( (0 > a_records) || (0 > b_records))
+        {
+            ret_code |= NPA_ERR_PARAM;
+        }
+        else
+        {
+            const size_t common = (size_t) ( (a_records < b_records) ? a_records : b_records);
+
+            for (size_t ii = 0U; ii < common; ii++)
+            {
+                const uint8_t * const a_record = &a[NPA_REPLAY_DUMP_HEADER
+                                                    + (ii * NPA_REPLAY_DUMP_RECORD)];
+                const uint8_t * const b_record = &b[NPA_REPLAY_DUMP_HEADER
+                                                    + (ii * NPA_REPLAY_DUMP_RECORD)];
+
+                if (0 != memcmp (a_record, b_record, NPA_REPLAY_DUMP_RECORD))
+                {
+                    if ( (NULL != report) && (*differing < max_report))
+                    {
+                        fprintf (report, "record %lu:\n", (unsigned long) ii);
+                        report_record (report, "a", a_record);
+                        report_record (report, "b", b_record);
+                    }
+
+                    (*differing)++;
+                }
+            }
+
+            *differing += (size_t) ( (a_records > b_records) ? (a_records - b_records)
+                                     : (b_records - a_records));
+        }
+    }
+
+    return ret_code;
+}
+
+/** @} */
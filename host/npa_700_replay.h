@@ -0,0 +1,189 @@
+#ifndef NPA_700_REPLAY_H
+#define NPA_700_REPLAY_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_replay.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Replay of captured raw frames through the driver on a host.
+ *
+ * Capture file is a sequence of blocks of @ref npa_capture_open, possibly of several
+ * sensors interleaved, and is memory-mapped. Index groups valid blocks into one
+ * stream per sensor address and model; corrupt blocks are counted and skipped.
+ * Replay runs streams on a pool of threads, each stream on one thread in capture
+ * order, through @ref npa_decode_frame and optionally a @ref npa_filter_t on counts.
+ * Replay runs as fast as possible or paced by the captured timestamps, with all streams
+ * on a common time axis from the first record of the capture.
+ *
+ * Outputs can be dumped to a file and two dumps compared bit by bit, e.g. dumps of
+ * the same capture replayed by two builds of the driver.
+ */
+
+#include "npa_700.h"
+#include "npa_700_filter.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define NPA_REPLAY_NO_OUTPUT     (0xFFFFU) //!< Filter had no output at record.
+#define NPA_REPLAY_DUMP_MAGIC    (0x5241504EUL) //!< "NPAR" in little-endian.
+#define NPA_REPLAY_DUMP_HEADER   (16U) //!< Length of dump header.
+#define NPA_REPLAY_DUMP_RECORD   (18U) //!< Length of dump record.
+
+/** @brief Memory-mapped capture file. */
+typedef struct
+{
+    const uint8_t * data; //!< Contents of file.
+    size_t len;           //!< Length of file.
+} npa_replay_file_t;
+
+/** @brief Output of replay for one record. */
+typedef struct
+{
+    uint32_t timestamp;   //!< Timestamp of record.
+    float pressure_pa;    //!< Pressure, converted also if frame had fatal status.
+    float temperature_c;  //!< Temperature, 0 if frame had none.
+    npa_ret_t status;     //!< @ref npa_ret_t of frame.
+    uint16_t filtered;    //!< Filter output, @ref NPA_REPLAY_NO_OUTPUT if none.
+} npa_replay_output_t;
+
+/** @brief Blocks and outputs of one sensor. */
+typedef struct
+{
+    uint8_t addr;                  //!< I2C address of sensor.
+    npa_variant_t model;           //!< Model of sensor.
+    size_t * offsets;              //!< Offsets of blocks in file, capture order.
+    size_t num_blocks;             //!< Number of blocks.
+    size_t num_records;            //!< Number of records in blocks.
+    uint64_t bytes;                //!< Bytes of blocks.
+    npa_replay_output_t * outputs; //!< Outputs of last replay, num_records entries.
+    size_t num_outputs;            //!< Outputs written by last replay.
+} npa_replay_stream_t;
+
+/** @brief Streams of a capture file. Build with @ref npa_replay_index. */
+typedef struct
+{
+    npa_replay_stream_t * streams; //!< Streams, in order of first block.
+    size_t num_streams;            //!< Number of streams.
+    size_t num_records;            //!< Records in all streams.
+    size_t bad_blocks;             //!< Corrupt blocks and unparseable regions skipped.
+} npa_replay_index_t;
+
+/** @brief Configuration of replay. */
+typedef struct
+{
+    size_t threads;                 //!< Worker threads, 0 for one per stream. Paced
+    //!< replay always runs one per stream.
+    double speed;                   //!< Pace relative to capture, 0 for unpaced.
+    const npa_filter_cfg_t * filter; //!< Filter of counts per stream, may be NULL.
+} npa_replay_cfg_t;
+
+/** @brief Totals of a replay. */
+typedef struct
+{
+    uint64_t records;    //!< Records replayed.
+    uint64_t bytes;      //!< Bytes of blocks replayed.
+    uint64_t elapsed_ns; //!< Wall time of replay.
+} npa_replay_result_t;
+
+/**
+ * @brief Map a capture file read-only.
+ *
+ * @param[out] file Mapped file.
+ * @param[in]  path Path of file.
+ * @retval NPA_SUCCESS   File was mapped.
+ * @retval NPA_ERR_NULL  File or path was NULL.
+ * @retval NPA_ERR_PARAM File is empty.
+ * @retval NPA_ERR_FATAL File could not be opened or mapped.
+ */
+npa_ret_t npa_replay_map (npa_replay_file_t * const file, const char * const path);
+
+/**
+ * @brief Unmap a capture file.
+ *
+ * @param[in,out] file File to unmap.
+ */
+void npa_replay_unmap (npa_replay_file_t * const file);
+
+/**
+ * @brief Index blocks of a capture into streams.
+ *
+ * After a corrupt block, scanning resumes at the next occurrence of block magic.
+ *
+ * @param[out] index Index, free with @ref npa_replay_free.
+ * @param[in]  data  Capture.
+ * @param[in]  len   Length of capture.
+ * @retval NPA_SUCCESS   Capture was indexed.
+ * @retval NPA_ERR_NULL  Index or data was NULL.
+ * @retval NPA_ERR_FATAL Out of memory.
+ */
+npa_ret_t npa_replay_index (npa_replay_index_t * const index, const uint8_t * const data,
+                            const size_t len);
+
+/**
+ * @brief Free memory of an index.
+ *
+ * @param[in,out] index Index to free.
+ */
+void npa_replay_free (npa_replay_index_t * const index);
+
+/**
+ * @brief Replay all streams of an index.
+ *
+ * @param[in,out] index  Index, outputs of each stream are written.
+ * @param[in]     data   Capture which was indexed.
+ * @param[in]     len    Length of capture.
+ * @param[in]     cfg    Configuration.
+ * @param[out]    result Totals.
+ * @retval NPA_SUCCESS   Streams were replayed.
+ * @retval NPA_ERR_NULL  An argument was NULL.
+ * @retval NPA_ERR_PARAM Speed is negative or filter configuration is invalid.
+ * @retval NPA_ERR_FATAL Out of memory or threads could not be created.
+ */
+npa_ret_t npa_replay_run (npa_replay_index_t * const index, const uint8_t * const data,
+                          const size_t len, const npa_replay_cfg_t * const cfg,
+                          npa_replay_result_t * const result);
+
+/**
+ * @brief Write outputs of all streams, in stream order.
+ *
+ * @param[in] index  Replayed index.
+ * @param[in] stream File to write to.
+ * @retval NPA_SUCCESS   Dump was written.
+ * @retval NPA_ERR_NULL  Index or stream was NULL.
+ * @retval NPA_ERR_FATAL Write failed.
+ */
+npa_ret_t npa_replay_dump (const npa_replay_index_t * const index, FILE * const stream);
+
+/**
+ * @brief Compare two dumps record by record.
+ *
+ * Records differ if any field differs bitwise. Records missing from the shorter
+ * dump count as differing.
+ *
+ * @param[in] a          First dump.
+ * @param[in] a_len      Length of first dump.
+ * @param[in] b          Second dump.
+ * @param[in] b_len      Length of second dump.
+ * @param[in] report     File to print differing records to, may be NULL.
+ * @param[in] max_report Maximum number of records to print.
+ * @param[out] differing Number of differing records.
+ * @retval NPA_SUCCESS   Dumps were compared.
+ * @retval NPA_ERR_NULL  Dump or differing was NULL.
+ * @retval NPA_ERR_PARAM A dump has invalid header or length.
+ */
+npa_ret_t npa_replay_compare (const uint8_t * const a, const size_t a_len,
+                              const uint8_t * const b, const size_t b_len,
+                              FILE * const report, const size_t max_report,
+                              size_t * const differing);
+
+/** @} */
+#endif // NPA_700_REPLAY_H
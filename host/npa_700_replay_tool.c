@@ -0,0 +1,186 @@
+// getopt
+#define _POSIX_C_SOURCE 200809L
+
+#include "npa_700_replay.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_replay_tool.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * Command line front end of @ref npa_700_replay.h.
+ *
+ * Replay: npa-replay [-j threads] [-s speed] [-f decimation] [-o dump] capture
+ * prints one JSON object of totals, e.g.
+ * {"records":1048576,"streams":4,"bad_blocks":0,"seconds":0.021,"records_per_s":4.9e+07,"mb_per_s":171.2}
+ *
+ * Compare: npa-replay -c a.dump b.dump prints differing records and exits with 1 if
+ * any record differs.
+ */
+
+#define NPA_REPLAY_TOOL_MAX_REPORT (20U) //!< Differing records printed.
+
+static void usage (void)
+{
+    fprintf (stderr,
+             "usage: npa-replay [-j threads] [-s speed] [-f decimation] [-o dump] capture\n"
+             "       npa-replay -c a.dump b.dump\n");
+}
+
+static int compare (const char * const path_a, const char * const path_b)
+{
+    npa_replay_file_t a = { 0 };
+    npa_replay_file_t b = { 0 };
+    size_t differing = 0U;
+    int status = 2;
+
+    if ( (NPA_SUCCESS != npa_replay_map (&a, path_a))
+            || (NPA_SUCCESS != npa_replay_map (&b, path_b)))
+    {
+        fprintf (stderr, "npa-replay: cannot map dumps\n");
+    }
+    else if (NPA_SUCCESS != npa_replay_compare (a.data, a.len, b.data, b.len, stdout,
+             NPA_REPLAY_TOOL_MAX_REPORT, &differing))
+    {
+        fprintf (stderr, "npa-replay: invalid dump\n");
+    }
+    else
+    {
+        printf ("{\"differing\":%lu}\n", (unsigned long) differing);
+        status = (0U == differing) ? 0 : 1;
+    }
+
+    npa_replay_unmap (&a);
+    npa_replay_unmap (&b);
+    return status;
+}
+
+static int replay (const char * const path, const npa_replay_cfg_t * const cfg,
+                   const char * const dump_path)
+{
+    npa_replay_file_t file = { 0 };
+    npa_replay_index_t index = { 0 };
+    npa_replay_result_t result = { 0 };
+    int status = 2;
+
+    if (NPA_SUCCESS != npa_replay_map (&file, path))
+    {
+        fprintf (stderr, "npa-replay: cannot map %s\n", path);
+    }
+    else if (NPA_SUCCESS != npa_replay_index (&index, file.data, file.len))
+    {
+        fprintf (stderr, "npa-replay: cannot index %s\n", path);
+    }
+    else if (NPA_SUCCESS != npa_replay_run (&index, file.data, file.len, cfg, &result))
+    {
+        fprintf (stderr, "npa-replay: replay failed\n");
+    }
+    else
+    {
+        const double seconds = (double) result.elapsed_ns / 1e9;
+        FILE * const dump = (NULL == dump_path) ? NULL : fopen (dump_path, "wb");
+        status = 0;
+        printf ("{\"records\":%llu,\"streams\":%lu,\"bad_blocks\":%lu,\"seconds\":%.6f,"
+                "\"records_per_s\":%.4g,\"mb_per_s\":%.1f}\n",
+                (unsigned long long) result.records, (unsigned long) index.num_streams,
+                (unsigned long) index.bad_blocks, seconds,
+                (0.0 < seconds) ? ( (double) result.records / seconds) : 0.0,
+                (0.0 < seconds) ? ( (double) result.bytes / seconds / 1e6) : 0.0);
+
+        if ( (NULL != dump_path)
+                && ( (NULL == dump) || (NPA_SUCCESS != npa_replay_dump (&index, dump))))
+        {
+            fprintf (stderr, "npa-replay: cannot write %s\n", dump_path);
+            status = 2;
+        }
+
+        if ( (NULL != dump) && (0 != fclose (dump)))
+        {
+            status = 2;
+        }
+    }
+
+    npa_replay_free (&index);
+    npa_replay_unmap (&file);
+    return status;
+}
+
+int main (int argc, char ** argv)
+{
+    npa_filter_cfg_t filter =
+    {
+        .kernel = NPA_FILTER_BOXCAR,
+        .decimation = 1U,
+        .cic_order = 0U,
+        .fir_taps = NULL,
+        .fir_len = 0U
+    };
+    npa_replay_cfg_t cfg = { .threads = 0U, .speed = 0.0, .filter = NULL };
+    const char * dump_path = NULL;
+    bool compare_mode = false;
+    bool valid = true;
+    int status = 2;
+    int opt;
+
+    while (-1 != (opt = getopt (argc, argv, "j:s:f:o:c")))
+    {
+        switch (opt)
+        {
+            case 'j':
+                cfg.threads = (size_t) strtoul (optarg, NULL, 10);
+                break;
+
+            case 's':
+                cfg.speed = strtod (optarg, NULL);
+                break;
+
+            case 'f':
+                filter.decimation = (uint16_t) strtoul (optarg, NULL, 10);
+                cfg.filter = &filter;
+                break;
+
+            case 'o':
+                dump_path = optarg;
+                break;
+
+            case 'c':
+                compare_mode = true;
+                break;
+
+            default:
+                valid = false;
+                break;
+        }
+    }
+
+    if (!valid)
+    {
+        usage();
+    }
+    else if (compare_mode && ( (optind + 2) == argc))
+    {
+        status = compare (argv[optind], argv[optind + 1]);
+    }
+    else if (!compare_mode && ( (optind + 1) == argc))
+    {
+        status = replay (argv[optind], &cfg, dump_path);
+    }
+    else
+    {
+        usage();
+    }
+
+    return status;
+}
+
+/** @} */
@@ -0,0 +1,406 @@
+// clock_gettime
+#define _POSIX_C_SOURCE 200809L
+
+#include "npa_700_sim.h"
+
+#include <string.h>
+#include <time.h>
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_sim.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * Output register of each sensor is refreshed lazily at the start of each transfer,
+ * so the simulation costs nothing between transfers.
+ */
+
+#define NPA_SIM_MAX_COUNTS (0x3FFFU) //!< Largest 14-bit count.
+#define NPA_SIM_FRAME_LEN  (4U)      //!< Longest frame.
+
+/** @brief State of a virtual sensor. */
+typedef struct
+{
+    npa_sim_sensor_cfg_t cfg;  //!< Configuration.
+    bool in_use;               //!< Slot has a sensor.
+    float gain;                //!< Pascals per count of model.
+    uint32_t noise_state;      //!< State of noise generator.
+    uint16_t counts;           //!< Pressure counts in output register.
+    uint16_t temperature;      //!< 11-bit temperature counts in output register.
+    uint32_t last_update;      //!< Index of last free-running update latched.
+    bool converting;           //!< Sleep mode conversion is in progress.
+    uint32_t trigger_us;       //!< Time of sleep mode trigger.
+    bool fresh;                //!< Output register has not been read.
+    uint8_t forced_status;     //!< Injected status bits.
+    uint32_t forced_frames;    //!< Frames left with injected status.
+    npa_ret_t forced_error;    //!< Injected bus error.
+    uint32_t forced_transfers; //!< Transfers left with injected error.
+    uint32_t transfers;        //!< Number of transfers.
+} npa_sim_sensor_t;
+
+static npa_sim_sensor_t m_sensors[NPA_SIM_MAX_SENSORS];
+static uint32_t m_now_us;
+static uint32_t m_base_us;
+static uint32_t m_byte_us;
+static bool m_spin;
+
+static npa_sim_sensor_t * find_sensor (const uint8_t addr)
+{
+    npa_sim_sensor_t * sensor = NULL;
+
+    for (size_t ii = 0U; (ii < NPA_SIM_MAX_SENSORS) && (NULL == sensor); ii++)
+    {
+        if (m_sensors[ii].in_use && (addr == m_sensors[ii].cfg.addr))
+        {
+            sensor = &m_sensors[ii];
+        }
+    }
+
+    return sensor;
+}
+
+void npa_sim_reset (void)
+{
+    memset (m_sensors, 0, sizeof (m_sensors));
+    m_now_us = 0U;
+    m_base_us = 0U;
+    m_byte_us = 0U;
+    m_spin = false;
+}
+
+npa_ret_t npa_sim_add (const npa_sim_sensor_cfg_t * const cfg)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+    npa_sim_sensor_t * slot = NULL;
+    float gain = 0.0F;
+    float offset = 0.0F;
+
+    if (NULL == cfg)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (NULL != find_sensor (cfg->addr)) || (0U == cfg->period_us)
+              || (NPA_SUCCESS != npa_get_scaling (cfg->model, &gain, &offset)))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        for (size_t ii = 0U; (ii < NPA_SIM_MAX_SENSORS) && (NULL == slot); ii++)
+        {
+            if (!m_sensors[ii].in_use)
+            {
+                slot = &m_sensors[ii];
+            }
+        }
+
+        if (NULL == slot)
+        {
+            ret_code |= NPA_ERR_PARAM;
+        }
+        else
+        {
+            memset (slot, 0, sizeof (npa_sim_sensor_t));
+            slot->cfg = *cfg;
+            slot->in_use = true;
+            slot->gain = gain;
+            // Generator must not be stuck at 0.
+            slot->noise_state = (0U == cfg->seed) ? 0x9E3779B9U : cfg->seed;
+            // Nothing has been converted yet, register reads as stale.
+            slot->last_update = 0U;
+        }
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_sim_set_pressure (const uint8_t addr, const float pressure_pa)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+    npa_sim_sensor_t * const sensor = find_sensor (addr);
+
+    if (NULL == sensor)
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        sensor->cfg.pressure_pa = pressure_pa;
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_sim_inject_status (const uint8_t addr, const uint8_t status,
+                                 const uint32_t frames)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+    npa_sim_sensor_t * const sensor = find_sensor (addr);
+
+    if ( (NULL == sensor) || (NPA_SIM_STATUS_DIAG < status))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        sensor->forced_status = status;
+        sensor->forced_frames = frames;
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_sim_inject_error (const uint8_t addr, const npa_ret_t error,
+                                const uint32_t transfers)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+    npa_sim_sensor_t * const sensor = find_sensor (addr);
+
+    if (NULL == sensor)
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        sensor->forced_error = error;
+        sensor->forced_transfers = transfers;
+    }
+
+    return ret_code;
+}
+
+uint32_t npa_sim_transfers (const uint8_t addr)
+{
+    const npa_sim_sensor_t * const sensor = find_sensor (addr);
+    return (NULL == sensor) ? 0U : sensor->transfers;
+}
+
+void npa_sim_set_bus_latency (const uint32_t base_us, const uint32_t byte_us,
+                              const bool spin)
+{
+    m_base_us = base_us;
+    m_byte_us = byte_us;
+    m_spin = spin;
+}
+
+uint32_t npa_sim_now_us (void)
+{
+    return m_now_us;
+}
+
+void npa_sim_advance (const uint32_t us)
+{
+    m_now_us += us;
+}
+
+static void spin_us (const uint32_t us)
+{
+    struct timespec start;
+    struct timespec now;
+    (void) clock_gettime (CLOCK_MONOTONIC, &start);
+    const int64_t end_ns = ( (int64_t) start.tv_sec * 1000000000) + start.tv_nsec
+                           + ( (int64_t) us * 1000);
+    int64_t now_ns = 0;
+
+    do
+    {
+        (void) clock_gettime (CLOCK_MONOTONIC, &now);
+        now_ns = ( (int64_t) now.tv_sec * 1000000000) + now.tv_nsec;
+    } while (now_ns < end_ns);
+}
+
+static void bus_latency (const uint32_t data_len)
+{
+    const uint32_t latency = m_base_us + (data_len * m_byte_us);
+    m_now_us += latency;
+
+    if (m_spin && (0U != latency))
+    {
+        spin_us (latency);
+    }
+}
+
+static int32_t noise (npa_sim_sensor_t * const sensor)
+{
+    int32_t value = 0;
+
+    if (0U != sensor->cfg.noise_counts)
+    {
+        // xorshift32
+        uint32_t state = sensor->noise_state;
+        state ^= state << 13U;
+        state ^= state >> 17U;
+        state ^= state << 5U;
+        sensor->noise_state = state;
+        const uint32_t span = (2U * (uint32_t) sensor->cfg.noise_counts) + 1U;
+        value = (int32_t) (state % span) - (int32_t) sensor->cfg.noise_counts;
+    }
+
+    return value;
+}
+
+static void convert (npa_sim_sensor_t * const sensor, const uint32_t time_us)
+{
+    const float pressure = (NULL != sensor->cfg.waveform)
+                           ? sensor->cfg.waveform (time_us, sensor->cfg.p_context)
+                           : sensor->cfg.pressure_pa;
+    // Inverse of scaling of driver. Ranges are symmetric, 0 Pa is at middle of
+    // non-saturated counts, which is exact unlike offset.
+    const float counts_f = ( (float) (NPA_PRES_MIN_NONSAT + NPA_PRES_MAX_NONSAT) / 2.0F)
+                           + (pressure / sensor->gain);
+    // Clip before converting, pressure may be far out of range.
+    const float clipped = (counts_f < 0.0F) ? 0.0F
+                          : ( (counts_f > (float) NPA_SIM_MAX_COUNTS)
+                              ? (float) NPA_SIM_MAX_COUNTS : counts_f);
+    int32_t counts = (int32_t) (clipped + 0.5F) + noise (sensor);
+    counts = (counts < 0) ? 0 : counts;
+    counts = (counts > (int32_t) NPA_SIM_MAX_COUNTS) ? (int32_t) NPA_SIM_MAX_COUNTS : counts;
+    sensor->counts = (uint16_t) counts;
+    const float temperature = ( (sensor->cfg.temperature_c - NPA_TEMP_MIN_C)
+                                * (float) NPA_TEMP_MAX_HIRES) / NPA_TEMP_SPAN_C;
+    const float temp_clipped = (temperature < 0.0F) ? 0.0F
+                               : ( (temperature > (float) NPA_TEMP_MAX_HIRES)
+                                   ? (float) NPA_TEMP_MAX_HIRES : temperature);
+    sensor->temperature = (uint16_t) (temp_clipped + 0.5F);
+    sensor->fresh = true;
+}
+
+// Latch conversions which have completed by now.
+static void refresh (npa_sim_sensor_t * const sensor)
+{
+    if (NPA_SIM_FREE_RUNNING == sensor->cfg.mode)
+    {
+        const int32_t since_phase = (int32_t) (m_now_us - sensor->cfg.phase_us);
+
+        if (since_phase >= 0)
+        {
+            const uint32_t update = ( (uint32_t) since_phase / sensor->cfg.period_us) + 1U;
+
+            if (update != sensor->last_update)
+            {
+                sensor->last_update = update;
+                convert (sensor, sensor->cfg.phase_us
+                         + ( (update - 1U) * sensor->cfg.period_us));
+            }
+        }
+    }
+    else if (sensor->converting
+             && ( (m_now_us - sensor->trigger_us) >= sensor->cfg.period_us))
+    {
+        sensor->converting = false;
+        convert (sensor, sensor->trigger_us + sensor->cfg.period_us);
+    }
+    else
+    {
+        // Register holds previous conversion.
+    }
+}
+
+static npa_ret_t begin_transfer (npa_sim_sensor_t * const sensor)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if (NULL == sensor)
+    {
+        ret_code |= NPA_ERR_NACK;
+    }
+    else
+    {
+        sensor->transfers++;
+
+        if (0U != sensor->forced_transfers)
+        {
+            sensor->forced_transfers--;
+            ret_code |= sensor->forced_error;
+        }
+    }
+
+    return ret_code;
+}
+
+// Read data phase of a transfer which sensor has acknowledged.
+static void read_frame (npa_sim_sensor_t * const sensor, uint8_t * const data,
+                        const uint8_t data_len)
+{
+    refresh (sensor);
+
+    if ( (0U == data_len) && (NPA_SIM_SLEEP == sensor->cfg.mode))
+    {
+        sensor->converting = true;
+        sensor->trigger_us = m_now_us;
+    }
+    else if ( (0U != data_len) && (NULL != data))
+    {
+        uint8_t status = sensor->fresh ? NPA_SIM_STATUS_NORMAL : NPA_SIM_STATUS_STALE;
+
+        if (0U != sensor->forced_frames)
+        {
+            sensor->forced_frames--;
+            status = sensor->forced_status;
+        }
+
+        const uint8_t frame[NPA_SIM_FRAME_LEN] =
+        {
+            (uint8_t) ( (uint32_t) status << 6U) | (uint8_t) (sensor->counts >> 8U),
+            (uint8_t) (sensor->counts & 0xFFU),
+            (uint8_t) (sensor->temperature >> 3U),
+            (uint8_t) ( (sensor->temperature & 0x07U) << 5U)
+        };
+        memcpy (data, frame, (data_len < NPA_SIM_FRAME_LEN) ? data_len : NPA_SIM_FRAME_LEN);
+        sensor->fresh = false;
+    }
+    else
+    {
+        // Trigger of free-running sensor has no effect.
+    }
+}
+
+npa_ret_t npa_sim_read (const uint8_t i2c_addr, uint8_t * const data,
+                        const uint8_t data_len)
+{
+    npa_sim_sensor_t * const sensor = find_sensor (i2c_addr);
+    const npa_ret_t ret_code = begin_transfer (sensor);
+
+    if (NPA_SUCCESS == ret_code)
+    {
+        read_frame (sensor, data, data_len);
+    }
+
+    bus_latency (data_len);
+    return ret_code;
+}
+
+npa_ret_t npa_sim_write (const uint8_t i2c_addr, const uint8_t * const data,
+                         const uint8_t data_len)
+{
+    (void) data;
+    npa_sim_sensor_t * const sensor = find_sensor (i2c_addr);
+    const npa_ret_t ret_code = begin_transfer (sensor);
+    bus_latency (data_len);
+    return ret_code;
+}
+
+npa_ret_t npa_sim_xfer (const uint8_t i2c_addr, const uint8_t * const tx_data,
+                        const uint8_t tx_len, uint8_t * const rx_data,
+                        const uint8_t rx_len)
+{
+    (void) tx_data;
+    npa_sim_sensor_t * const sensor = find_sensor (i2c_addr);
+    const npa_ret_t ret_code = begin_transfer (sensor);
+
+    if ( (NPA_SUCCESS == ret_code) && (0U != rx_len))
+    {
+        read_frame (sensor, rx_data, rx_len);
+    }
+
+    // Repeated start saves second address phase, cost of bytes is the same.
+    bus_latency ( (uint32_t) tx_len + rx_len);
+    return ret_code;
+}
+
+/** @} */
@@ -0,0 +1,214 @@
+#ifndef NPA_700_SIM_H
+#define NPA_700_SIM_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_sim.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Simulated NPA-700 sensors for host builds.
+ *
+ * @ref npa_sim_read and @ref npa_sim_write have signatures of @ref npa_read_fp and
+ * @ref npa_write_fp and can be placed in @ref npa_ctx_t in place of a real I2C
+ * driver, and @ref npa_sim_xfer in place of an optional combined transfer. Each
+ * virtual sensor answers at its own address.
+ *
+ * Simulation runs on a virtual microsecond clock, @ref npa_sim_now_us, which only
+ * advances by bus latency of transfers and by @ref npa_sim_advance. Optionally bus
+ * latency can also be spent as real time, to measure throughput on a host.
+ *
+ * Virtual sensor models:
+ * - Free-running mode: output register updates every period, reads in between
+ *   return stale status.
+ * - Sleep mode: 0-length read triggers a conversion which completes after period,
+ *   reads before that and repeated reads return stale status.
+ * - Pressure from a constant or a waveform callback, plus uniform noise. Counts clip
+ *   to 14 bits like on the real sensor, so out-of-range pressure saturates.
+ * - Injected status bits, e.g. command mode or diagnostic fault, and injected bus
+ *   errors for a number of transfers.
+ *
+ * State is global, as read and write functions have no context. Simulator is not
+ * thread safe.
+ */
+
+#include "npa_700.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define NPA_SIM_MAX_SENSORS (8U) //!< Maximum number of virtual sensors.
+
+#define NPA_SIM_STATUS_NORMAL  (0U) //!< Status bits of fresh data.
+#define NPA_SIM_STATUS_COMMAND (1U) //!< Status bits of command mode.
+#define NPA_SIM_STATUS_STALE   (2U) //!< Status bits of stale data.
+#define NPA_SIM_STATUS_DIAG    (3U) //!< Status bits of diagnostic condition.
+
+/**
+ * @brief Pressure waveform of a virtual sensor.
+ *
+ * @param[in] time_us   Virtual time of the conversion.
+ * @param[in] p_context Context given in sensor configuration.
+ * @return Pressure in pascals.
+ */
+typedef float (*npa_sim_waveform_fp) (const uint32_t time_us, void * const p_context);
+
+/** @brief Measurement mode of a virtual sensor. */
+typedef enum
+{
+    NPA_SIM_FREE_RUNNING, //!< Converts continuously every period.
+    NPA_SIM_SLEEP         //!< Converts once per trigger, taking period.
+} npa_sim_mode_t;
+
+/** @brief Configuration of a virtual sensor. */
+typedef struct
+{
+    uint8_t addr;                 //!< I2C address, unique among virtual sensors.
+    npa_variant_t model;          //!< Model, sets pressure scale.
+    npa_sim_mode_t mode;          //!< Measurement mode.
+    uint32_t period_us;           //!< Update period or conversion time, non-zero.
+    uint32_t phase_us;            //!< Time of first update of free-running sensor.
+    float pressure_pa;            //!< Pressure if waveform is NULL.
+    float temperature_c;          //!< Temperature.
+    npa_sim_waveform_fp waveform; //!< Pressure waveform, may be NULL.
+    void * p_context;             //!< Context of waveform.
+    uint16_t noise_counts;        //!< Peak of uniform noise added to counts.
+    uint32_t seed;                //!< Seed of noise generator.
+} npa_sim_sensor_cfg_t;
+
+/** @brief Remove all virtual sensors, reset clock and bus latency. */
+void npa_sim_reset (void);
+
+/**
+ * @brief Add a virtual sensor.
+ *
+ * @param[in] cfg Configuration, copied.
+ * @retval NPA_SUCCESS   Sensor was added.
+ * @retval NPA_ERR_NULL  Configuration was NULL.
+ * @retval NPA_ERR_PARAM Address is taken, period is 0, model is invalid or there
+ *                       are already @ref NPA_SIM_MAX_SENSORS sensors.
+ */
+npa_ret_t npa_sim_add (const npa_sim_sensor_cfg_t * const cfg);
+
+/**
+ * @brief Set constant pressure of a virtual sensor.
+ *
+ * @param[in] addr        Address of sensor.
+ * @param[in] pressure_pa New pressure, used from next conversion.
+ * @retval NPA_SUCCESS   Pressure was set.
+ * @retval NPA_ERR_PARAM No sensor at address.
+ */
+npa_ret_t npa_sim_set_pressure (const uint8_t addr, const float pressure_pa);
+
+/**
+ * @brief Force status bits of the next frames of a virtual sensor.
+ *
+ * @param[in] addr   Address of sensor.
+ * @param[in] status Status bits, e.g. @ref NPA_SIM_STATUS_DIAG.
+ * @param[in] frames Number of frames to apply to.
+ * @retval NPA_SUCCESS   Status was injected.
+ * @retval NPA_ERR_PARAM No sensor at address or status is over 2 bits.
+ */
+npa_ret_t npa_sim_inject_status (const uint8_t addr, const uint8_t status,
+                                 const uint32_t frames);
+
+/**
+ * @brief Fail the next transfers of a virtual sensor.
+ *
+ * @param[in] addr      Address of sensor.
+ * @param[in] error     Error returned by bus, e.g. @ref NPA_ERR_NACK.
+ * @param[in] transfers Number of transfers to fail.
+ * @retval NPA_SUCCESS   Error was injected.
+ * @retval NPA_ERR_PARAM No sensor at address.
+ */
+npa_ret_t npa_sim_inject_error (const uint8_t addr, const npa_ret_t error,
+                                const uint32_t transfers);
+
+/**
+ * @brief Number of transfers addressed to a virtual sensor.
+ *
+ * @param[in] addr Address of sensor.
+ * @return Number of reads and writes, 0 if there is no sensor at address.
+ */
+uint32_t npa_sim_transfers (const uint8_t addr);
+
+/**
+ * @brief Set latency of each bus transfer.
+ *
+ * Transfer takes base_us + bytes * byte_us. At 400 kHz I2C a byte takes about 23 us.
+ *
+ * @param[in] base_us Latency of address phase and overhead.
+ * @param[in] byte_us Latency of each data byte.
+ * @param[in] spin    true to also busy-wait the latency in real time.
+ */
+void npa_sim_set_bus_latency (const uint32_t base_us, const uint32_t byte_us,
+                              const bool spin);
+
+/**
+ * @brief Current virtual time, signature of @ref npa_clock_fp.
+ *
+ * @return Virtual time in microseconds.
+ */
+uint32_t npa_sim_now_us (void);
+
+/**
+ * @brief Advance virtual time.
+ *
+ * @param[in] us Microseconds to advance.
+ */
+void npa_sim_advance (const uint32_t us);
+
+/**
+ * @brief Read from a virtual sensor, signature of @ref npa_read_fp.
+ *
+ * 0-length read triggers conversion of a sleep mode sensor.
+ *
+ * @param[in]  i2c_addr Address of sensor.
+ * @param[out] data     Frame, up to 4 bytes are filled.
+ * @param[in]  data_len Length of data.
+ * @retval NPA_SUCCESS  Frame was read.
+ * @retval NPA_ERR_NACK No sensor at address.
+ * @return Injected error otherwise.
+ */
+npa_ret_t npa_sim_read (const uint8_t i2c_addr, uint8_t * const data,
+                        const uint8_t data_len);
+
+/**
+ * @brief Write to a virtual sensor, signature of @ref npa_write_fp.
+ *
+ * Written data is ignored.
+ *
+ * @param[in] i2c_addr Address of sensor.
+ * @param[in] data     Data to write.
+ * @param[in] data_len Length of data.
+ * @retval NPA_SUCCESS  Data was acknowledged.
+ * @retval NPA_ERR_NACK No sensor at address.
+ * @return Injected error otherwise.
+ */
+npa_ret_t npa_sim_write (const uint8_t i2c_addr, const uint8_t * const data,
+                         const uint8_t data_len);
+
+/**
+ * @brief Write to and read from a virtual sensor, signature of @ref npa_xfer_fp.
+ *
+ * Written data is ignored. Counts as one transfer, with one base latency.
+ *
+ * @param[in]  i2c_addr Address of sensor.
+ * @param[in]  tx_data  Data to write.
+ * @param[in]  tx_len   Length of data to write.
+ * @param[out] rx_data  Frame, up to 4 bytes are filled.
+ * @param[in]  rx_len   Length of data to read.
+ * @retval NPA_SUCCESS  Transfer was acknowledged.
+ * @retval NPA_ERR_NACK No sensor at address.
+ * @return Injected error otherwise.
+ */
+npa_ret_t npa_sim_xfer (const uint8_t i2c_addr, const uint8_t * const tx_data,
+                        const uint8_t tx_len, uint8_t * const rx_data,
+                        const uint8_t rx_len);
+
+/** @} */
+#endif // NPA_700_SIM_H
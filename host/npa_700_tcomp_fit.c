@@ -0,0 +1,312 @@
+#include "npa_700_tcomp_fit.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_tcomp_fit.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * Each sample touches four nodes with the same bilinear weights as the integer
+ * interpolation, so the fitted grid is optimal for the compensation which runs on
+ * the target. Corrections are solved in counts and rounded to fixed point last.
+ */
+
+#define NPA_TCOMP_FIT_TOLERANCE (1e-12) //!< Relative squared residual to stop at.
+
+/** @brief Problem being solved. */
+typedef struct
+{
+    const npa_tcomp_fit_cfg_t * cfg;    //!< Configuration.
+    const npa_tcomp_sample_t * samples; //!< Samples.
+    size_t num_samples;                 //!< Number of samples.
+    size_t p_nodes;                     //!< Pressure nodes per row.
+    size_t t_nodes;                     //!< Temperature nodes.
+} fit_problem_t;
+
+// Index of lower left node and weights of the four nodes around a sample.
+static size_t sample_weights (const fit_problem_t * const problem,
+                              const npa_tcomp_sample_t * const sample, double weights[4U])
+{
+    const uint32_t p_shift = problem->cfg->p_shift;
+    const uint32_t t_shift = problem->cfg->t_shift;
+    const uint32_t t_counts = (sample->temperature > NPA_TEMP_MAX_HIRES)
+                              ? NPA_TEMP_MAX_HIRES : sample->temperature;
+    const double p_frac = (double) (sample->counts & ( (1UL << p_shift) - 1U))
+                          / (double) (1UL << p_shift);
+    const double t_frac = (double) (t_counts & ( (1UL << t_shift) - 1U))
+                          / (double) (1UL << t_shift);
+    weights[0U] = (1.0 - p_frac) * (1.0 - t_frac);
+    weights[1U] = p_frac * (1.0 - t_frac);
+    weights[2U] = (1.0 - p_frac) * t_frac;
+    weights[3U] = p_frac * t_frac;
+    return ( (size_t) (t_counts >> t_shift) * problem->p_nodes)
+           + (size_t) (sample->counts >> p_shift);
+}
+
+// out = (A^T A + smoothing * L) x, A the sample weights and L the grid Laplacian.
+static void normal_product (const fit_problem_t * const problem, const double * const x,
+                            double * const out)
+{
+    const size_t p_nodes = problem->p_nodes;
+    const size_t num_nodes = p_nodes * problem->t_nodes;
+    const double smoothing = problem->cfg->smoothing;
+
+    for (size_t ii = 0U; ii < num_nodes; ii++)
+    {
+        out[ii] = 0.0;
+    }
+
+    for (size_t ii = 0U; ii < problem->num_samples; ii++)
+    {
+        double weights[4U];
+        const size_t node = sample_weights (problem, &problem->samples[ii], weights);
+        const size_t nodes[4U] = { node, node + 1U, node + p_nodes, node + p_nodes + 1U };
+        double value = 0.0;
+
+        for (size_t jj = 0U; jj < 4U; jj++)
+        {
+            value += weights[jj] * x[nodes[jj]];
+        }
+
+        for (size_t jj = 0U; jj < 4U; jj++)
+        {
+            out[nodes[jj]] += weights[jj] * value;
+        }
+    }
+
+    for (size_t ii = 0U; ii < num_nodes; ii++)
+    {
+        const bool has_right = ( (ii % p_nodes) + 1U) < p_nodes;
+        const bool has_up = (ii + p_nodes) < num_nodes;
+
+        if (has_right)
+        {
+            const double diff = smoothing * (x[ii] - x[ii + 1U]);
+            out[ii] += diff;
+            out[ii + 1U] -= diff;
+        }
+
+        if (has_up)
+        {
+            const double diff = smoothing * (x[ii] - x[ii + p_nodes]);
+            out[ii] += diff;
+            out[ii + p_nodes] -= diff;
+        }
+    }
+}
+
+static double dot (const double * const a, const double * const b, const size_t len)
+{
+    double sum = 0.0;
+
+    for (size_t ii = 0U; ii < len; ii++)
+    {
+        sum += a[ii] * b[ii];
+    }
+
+    return sum;
+}
+
+// Conjugate gradients from x = 0. Returns number of iterations.
+static uint32_t solve (const fit_problem_t * const problem, double * const x,
+                       double * const residual, double * const direction,
+                       double * const product)
+{
+    const size_t num_nodes = problem->p_nodes * problem->t_nodes;
+    const uint32_t max_iterations = (0U == problem->cfg->max_iterations)
+                                    ? (uint32_t) num_nodes : problem->cfg->max_iterations;
+    uint32_t iterations = 0U;
+
+    for (size_t ii = 0U; ii < num_nodes; ii++)
+    {
+        x[ii] = 0.0;
+        residual[ii] = 0.0;
+    }
+
+    // Right-hand side A^T y.
+    for (size_t ii = 0U; ii < problem->num_samples; ii++)
+    {
+        double weights[4U];
+        const npa_tcomp_sample_t * const sample = &problem->samples[ii];
+        const size_t node = sample_weights (problem, sample, weights);
+        const double error = (double) sample->reference - (double) sample->counts;
+        residual[node] += weights[0U] * error;
+        residual[node + 1U] += weights[1U] * error;
+        residual[node + problem->p_nodes] += weights[2U] * error;
+        residual[node + problem->p_nodes + 1U] += weights[3U] * error;
+    }
+
+    for (size_t ii = 0U; ii < num_nodes; ii++)
+    {
+        direction[ii] = residual[ii];
+    }
+
+    const double initial = dot (residual, residual, num_nodes);
+    double current = initial;
+
+    while ( (iterations < max_iterations) && (current > (NPA_TCOMP_FIT_TOLERANCE * initial)))
+    {
+        normal_product (problem, direction, product);
+        const double curvature = dot (direction, product, num_nodes);
+
+        if (0.0 >= curvature)
+        {
+            // Direction has no data nor smoothing, nothing more to fit.
+            break;
+        }
+
+        const double step = current / curvature;
+
+        for (size_t ii = 0U; ii < num_nodes; ii++)
+        {
+            x[ii] += step * direction[ii];
+            residual[ii] -= step * product[ii];
+        }
+
+        const double next = dot (residual, residual, num_nodes);
+
+        for (size_t ii = 0U; ii < num_nodes; ii++)
+        {
+            direction[ii] = residual[ii] + ( (next / current) * direction[ii]);
+        }
+
+        current = next;
+        iterations++;
+    }
+
+    return iterations;
+}
+
+static bool quantize (const double * const x, const size_t num_nodes, int16_t * const grid)
+{
+    bool clamped = false;
+
+    for (size_t ii = 0U; ii < num_nodes; ii++)
+    {
+        const double value = round (x[ii] * (double) (1UL << NPA_TCOMP_FRAC_BITS));
+
+        if (value > (double) INT16_MAX)
+        {
+            grid[ii] = INT16_MAX;
+            clamped = true;
+        }
+        else if (value < (double) INT16_MIN)
+        {
+            grid[ii] = INT16_MIN;
+            clamped = true;
+        }
+        else
+        {
+            grid[ii] = (int16_t) value;
+        }
+    }
+
+    return clamped;
+}
+
+static void evaluate (const npa_tcomp_fit_cfg_t * const cfg,
+                      const npa_tcomp_sample_t * const samples, const size_t num_samples,
+                      const int16_t * const grid, npa_tcomp_fit_result_t * const result)
+{
+    npa_tcomp_t tcomp;
+    double before = 0.0;
+    double after = 0.0;
+    result->max_after = 0.0;
+    (void) npa_tcomp_init (&tcomp, grid, cfg->p_shift, cfg->t_shift);
+
+    for (size_t ii = 0U; ii < num_samples; ii++)
+    {
+        const double reference = (double) samples[ii].reference;
+        const double error_before = reference - (double) samples[ii].counts;
+        const double error_after = reference - (double) npa_tcomp_apply (&tcomp,
+                                   samples[ii].counts, samples[ii].temperature);
+        before += error_before * error_before;
+        after += error_after * error_after;
+
+        if (fabs (error_after) > result->max_after)
+        {
+            result->max_after = fabs (error_after);
+        }
+    }
+
+    result->rms_before = sqrt (before / (double) num_samples);
+    result->rms_after = sqrt (after / (double) num_samples);
+}
+
+npa_ret_t npa_tcomp_fit (const npa_tcomp_fit_cfg_t * const cfg,
+                         const npa_tcomp_sample_t * const samples, const size_t num_samples,
+                         int16_t * const grid, npa_tcomp_fit_result_t * const result)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == cfg) || (NULL == samples) || (NULL == grid))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (0U == cfg->p_shift) || (NPA_TCOMP_P_BITS < cfg->p_shift)
+              || (0U == cfg->t_shift) || (NPA_TCOMP_T_BITS < cfg->t_shift)
+              || (0.0 > cfg->smoothing) || (0U == num_samples))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        const fit_problem_t problem =
+        {
+            .cfg = cfg,
+            .samples = samples,
+            .num_samples = num_samples,
+            .p_nodes = NPA_TCOMP_P_NODES (cfg->p_shift),
+            .t_nodes = NPA_TCOMP_T_NODES (cfg->t_shift)
+        };
+        const size_t num_nodes = problem.p_nodes * problem.t_nodes;
+        double * const work = calloc (4U * num_nodes, sizeof (double));
+
+        for (size_t ii = 0U; (NULL != work) && (ii < num_samples); ii++)
+        {
+            if (NPA_PRES_MAX_SAT < samples[ii].counts)
+            {
+                ret_code |= NPA_ERR_PARAM;
+            }
+        }
+
+        if (NULL == work)
+        {
+            ret_code |= NPA_ERR_FATAL;
+        }
+        else if (NPA_SUCCESS == ret_code)
+        {
+            const uint32_t iterations = solve (&problem, work, &work[num_nodes],
+                                               &work[2U * num_nodes], &work[3U * num_nodes]);
+
+            if (quantize (work, num_nodes, grid))
+            {
+                ret_code |= NPA_WARN_SAT;
+            }
+
+            if (NULL != result)
+            {
+                evaluate (cfg, samples, num_samples, grid, result);
+                result->iterations = iterations;
+            }
+        }
+        else
+        {
+            // Invalid sample, grid is not written.
+        }
+
+        free (work);
+    }
+
+    return ret_code;
+}
+
+/** @} */
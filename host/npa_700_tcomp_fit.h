@@ -0,0 +1,82 @@
+#ifndef NPA_700_TCOMP_FIT_H
+#define NPA_700_TCOMP_FIT_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_tcomp_fit.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Fitting of temperature compensation grids on a host.
+ *
+ * Calibration run logs raw counts and temperature of the sensor together with a
+ * reference pressure, e.g. from a calibrated manometer or a known zero. Reference is
+ * given in counts, (reference_pa - offset) / gain with scaling of
+ * @ref npa_get_scaling. Fit finds corrections of the grid of @ref npa_tcomp_t which
+ * minimize the squared error of compensated counts over all samples, plus a
+ * smoothing term which penalizes squared differences of neighbouring nodes. The
+ * smoothing term fills nodes which no sample reaches, and keeps sparse regions from
+ * fitting noise.
+ *
+ * The least squares problem is solved by conjugate gradients on the normal
+ * equations without forming them, each iteration is one pass over the samples.
+ */
+
+#include "npa_700.h"
+#include "npa_700_tcomp.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Calibration sample. */
+typedef struct
+{
+    uint16_t counts;      //!< Measured 14-bit pressure counts.
+    uint16_t temperature; //!< Measured 11-bit temperature counts.
+    float reference;      //!< Reference pressure in counts.
+} npa_tcomp_sample_t;
+
+/** @brief Configuration of fit. */
+typedef struct
+{
+    uint8_t p_shift;         //!< Grid spacing of pressure, see @ref npa_tcomp_init.
+    uint8_t t_shift;         //!< Grid spacing of temperature, see @ref npa_tcomp_init.
+    double smoothing;        //!< Weight of squared difference of neighbouring nodes.
+    uint32_t max_iterations; //!< Iterations of solver, 0 for number of nodes.
+} npa_tcomp_fit_cfg_t;
+
+/** @brief Quality of fit, evaluated with integer compensation of the grid. */
+typedef struct
+{
+    double rms_before;   //!< RMS error of uncompensated counts.
+    double rms_after;    //!< RMS error of compensated counts.
+    double max_after;    //!< Largest absolute error of compensated counts.
+    uint32_t iterations; //!< Iterations of solver.
+} npa_tcomp_fit_result_t;
+
+/**
+ * @brief Fit a compensation grid to calibration samples.
+ *
+ * @param[in]  cfg         Configuration.
+ * @param[in]  samples     Calibration samples.
+ * @param[in]  num_samples Number of samples.
+ * @param[out] grid        Corrections, NPA_TCOMP_GRID_LEN (p_shift, t_shift) entries.
+ * @param[out] result      Quality of fit. May be NULL.
+ * @retval NPA_SUCCESS   Grid was fitted.
+ * @retval NPA_WARN_SAT  Grid was fitted, but some corrections did not fit in int16_t
+ *                       and were clamped.
+ * @retval NPA_ERR_NULL  Configuration, samples or grid was NULL.
+ * @retval NPA_ERR_PARAM A shift is out of range, smoothing is negative, there are no
+ *                       samples or counts of a sample do not fit in 14 bits.
+ * @retval NPA_ERR_FATAL Out of memory.
+ */
+npa_ret_t npa_tcomp_fit (const npa_tcomp_fit_cfg_t * const cfg,
+                         const npa_tcomp_sample_t * const samples, const size_t num_samples,
+                         int16_t * const grid, npa_tcomp_fit_result_t * const result);
+
+/** @} */
+#endif // NPA_700_TCOMP_FIT_H
@@ -1,7 +1,11 @@
 #include "npa_700.h"
+#if NPA_STATS
+#include "npa_700_stats.h"
+#endif
 
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 
 /**
  * @addtogroup NPA-700
@@ -15,6 +19,65 @@
  *
  */
 
+#define NPA_BATCH_CHUNK (16U) //!< Number of frames buffered at once in batch read.
+
+// Gain and offset are evaluated at compile time, see NPA_GAIN in npa_700.h.
+#define NPA_SCALING(scale) { NPA_GAIN (scale), NPA_OFFSET (scale) }
+
+/** @brief Float scaling of a sensor model. */
+typedef struct
+{
+    float gain;   //!< Pascals per count.
+    float offset; //!< Pascals at 0 counts.
+} npa_scaling_t;
+
+static const npa_scaling_t m_scaling[] =
+{
+    [NPA_700_02WD] = NPA_SCALING (NPA_02WD_SCALE_PA),
+    [NPA_700_05WD] = NPA_SCALING (NPA_05WD_SCALE_PA),
+    [NPA_700_10WD] = NPA_SCALING (NPA_10WD_SCALE_PA),
+    [NPA_700_001D] = NPA_SCALING (NPA_001D_SCALE_PA),
+    [NPA_700_005D] = NPA_SCALING (NPA_005D_SCALE_PA),
+    [NPA_700_015D] = NPA_SCALING (NPA_015D_SCALE_PA),
+    [NPA_700_030D] = NPA_SCALING (NPA_030D_SCALE_PA)
+};
+
+#define NPA_NUM_VARIANTS (sizeof (m_scaling) / sizeof (m_scaling[0U]))
+
+// Integer gain and offset are evaluated at compile time, see NPA_INT_GAIN in npa_700.h.
+#define NPA_INT_SCALING(scale) { NPA_INT_GAIN (scale), NPA_INT_OFFSET (scale) }
+#define NPA_MPA_SCALING(scale_pa) NPA_INT_SCALING ((uint64_t) (scale_pa) * 1000U)
+#define NPA_Q_SCALING(scale_pa)   NPA_INT_SCALING ((uint64_t) (scale_pa) << NPA_Q_FRAC_BITS)
+
+/** @brief Integer scaling of a sensor model. */
+typedef struct
+{
+    uint64_t gain;   //!< Output units per count pair, scaled by 2^NPA_INT_SHIFT.
+    uint32_t offset; //!< Output units subtracted after scaling.
+} npa_int_scaling_t;
+
+static const npa_int_scaling_t m_mpa_scaling[] =
+{
+    [NPA_700_02WD] = NPA_MPA_SCALING (NPA_02WD_SCALE_PA_INT),
+    [NPA_700_05WD] = NPA_MPA_SCALING (NPA_05WD_SCALE_PA_INT),
+    [NPA_700_10WD] = NPA_MPA_SCALING (NPA_10WD_SCALE_PA_INT),
+    [NPA_700_001D] = NPA_MPA_SCALING (NPA_001D_SCALE_PA_INT),
+    [NPA_700_005D] = NPA_MPA_SCALING (NPA_005D_SCALE_PA_INT),
+    [NPA_700_015D] = NPA_MPA_SCALING (NPA_015D_SCALE_PA_INT),
+    [NPA_700_030D] = NPA_MPA_SCALING (NPA_030D_SCALE_PA_INT)
+};
+
+static const npa_int_scaling_t m_q_scaling[] =
+{
+    [NPA_700_02WD] = NPA_Q_SCALING (NPA_02WD_SCALE_PA_INT),
+    [NPA_700_05WD] = NPA_Q_SCALING (NPA_05WD_SCALE_PA_INT),
+    [NPA_700_10WD] = NPA_Q_SCALING (NPA_10WD_SCALE_PA_INT),
+    [NPA_700_001D] = NPA_Q_SCALING (NPA_001D_SCALE_PA_INT),
+    [NPA_700_005D] = NPA_Q_SCALING (NPA_005D_SCALE_PA_INT),
+    [NPA_700_015D] = NPA_Q_SCALING (NPA_015D_SCALE_PA_INT),
+    [NPA_700_030D] = NPA_Q_SCALING (NPA_030D_SCALE_PA_INT)
+};
+
 /**
  * @brief Validate NPA Context.
  *
@@ -94,84 +157,229 @@ static bool check_saturation (const uint16_t value)
     return saturated;
 }
 
-// Get min/max pressure of given sensor
-static npa_ret_t get_scaling (const npa_variant_t model, float * const Pmax,
-                              float * const Pmin)
+// Get pressure counts from raw data.
+static uint16_t parse_counts (const uint8_t * const raw_data)
+{
+    // Mask status bits out.
+    return (uint16_t) ( ( ( (uint32_t) raw_data[0U] << 8U)
+                          + (uint32_t) raw_data[1U])
+                        & 0x3FFFU);
+}
+
+// Get gain and offset of given sensor.
+static npa_ret_t get_gain_offset (const npa_variant_t model, float * const gain,
+                                  float * const offset)
 {
     npa_ret_t ret_code = NPA_SUCCESS;
 
-    switch (model)
+    if ( (uint32_t) model < NPA_NUM_VARIANTS)
     {
-        case NPA_700_02WD:
-            *Pmax = NPA_02WD_SCALE_PA;
-            *Pmin = -1.0F * NPA_02WD_SCALE_PA;
-            break;
+        *gain = m_scaling[model].gain;
+        *offset = m_scaling[model].offset;
+    }
+    else
+    {
+        *gain = 0.0F;
+        *offset = 0.0F;
+        ret_code |= NPA_ERR_FATAL;
+    }
 
-        case NPA_700_05WD:
-            *Pmax = NPA_05WD_SCALE_PA;
-            *Pmin = -1.0F * NPA_05WD_SCALE_PA;
-            break;
+    return ret_code;
+}
 
-        case NPA_700_10WD:
-            *Pmax = NPA_10WD_SCALE_PA;
-            *Pmin = -1.0F * NPA_10WD_SCALE_PA;
-            break;
+static npa_ret_t parse_value (const uint8_t * const raw_data, const float gain,
+                              const float offset, float * const pressure_pa)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+    const uint16_t OUT_U16 = parse_counts (raw_data);
 
-        case NPA_700_001D:
-            *Pmax = NPA_001D_SCALE_PA;
-            *Pmin = -1.0F * NPA_001D_SCALE_PA;
-            break;
+    if (check_saturation (OUT_U16))
+    {
+        ret_code |= NPA_WARN_SAT;
+    }
 
-        case NPA_700_005D:
-            *Pmax = NPA_005D_SCALE_PA;
-            *Pmin = -1.0F * NPA_005D_SCALE_PA;
-            break;
+    *pressure_pa = ( (float) OUT_U16 * gain) + offset;
+    return ret_code;
+}
 
-        case NPA_700_015D:
-            *Pmax = NPA_015D_SCALE_PA;
-            *Pmin = -1.0F * NPA_015D_SCALE_PA;
-            break;
+static npa_ret_t check_conversion (const npa_variant_t model, const uint16_t counts,
+                                   const void * const pressure)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
 
-        case NPA_700_030D:
-            *Pmax = NPA_030D_SCALE_PA;
-            *Pmin = -1.0F * NPA_030D_SCALE_PA;
-            break;
+    if (NULL == pressure)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( ( (uint32_t) model >= NPA_NUM_VARIANTS) || (NPA_PRES_MAX_SAT < counts))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else if (check_saturation (counts))
+    {
+        ret_code |= NPA_WARN_SAT;
+    }
+    else
+    {
+        // No action needed.
+    }
 
-        default:
-            ret_code |= NPA_ERR_FATAL;
-            break;
+    return ret_code;
+}
+
+// Convert counts to integer pressure, model and counts must be valid.
+static int32_t convert_int (const npa_int_scaling_t * const scaling,
+                            const uint16_t counts)
+{
+    const uint64_t OUT2 = (2U * (uint64_t) counts) + NPA_INT_BIAS;
+    const uint64_t scaled = ( (OUT2 * scaling->gain)
+                              + ( (uint64_t) 1U << (NPA_INT_SHIFT - 1U)))
+                            >> NPA_INT_SHIFT;
+    return (int32_t) ( (int64_t) scaled - (int64_t) scaling->offset);
+}
+
+/**
+ * @brief Read clock of sensor statistics around a transfer.
+ *
+ * @param[in] stats Statistics of sensor, may be NULL.
+ * @return Current time, 0 if statistics are disabled.
+ */
+static inline uint32_t stats_time (const npa_stats_t * const stats)
+{
+#if NPA_STATS
+    return npa_stats_now (stats);
+#else
+    (void) stats;
+    return 0U;
+#endif
+}
+
+/**
+ * @brief Record result of a read to sensor statistics.
+ *
+ * @param[in,out] stats    Statistics of sensor, may be NULL.
+ * @param[in]     status   Result of the read.
+ * @param[in]     start_us Time before transfer from @ref stats_time.
+ * @param[in]     end_us   Time after transfer from @ref stats_time.
+ */
+static inline void stats_record (npa_stats_t * const stats, const npa_ret_t status,
+                                 const uint32_t start_us, const uint32_t end_us)
+{
+#if NPA_STATS
+    npa_stats_record (stats, status, start_us, end_us);
+#else
+    (void) stats;
+    (void) status;
+    (void) start_us;
+    (void) end_us;
+#endif
+}
+
+/** @brief Raw frame read from a sensor and time of its transfer. */
+typedef struct
+{
+    uint8_t data[NPA_FRAME_LEN_HIRES]; //!< Frame, all bits set where not read.
+    uint32_t start_us;                 //!< Time before transfer from @ref stats_time.
+    uint32_t end_us;                   //!< Time after transfer from @ref stats_time.
+} npa_raw_frame_t;
+
+/**
+ * @brief Read a raw frame and parse its status.
+ *
+ * Record the result with @ref stats_record once the frame has been converted.
+ *
+ * @param[in]  read  Read function of sensor.
+ * @param[in]  addr  I2C address of sensor.
+ * @param[in]  stats Statistics of sensor, may be NULL.
+ * @param[in]  len   Length of frame to read, at most @ref NPA_FRAME_LEN_HIRES.
+ * @param[out] frame Frame and time of transfer.
+ * @return Result of transfer and status of frame.
+ */
+static npa_ret_t read_frame (const npa_read_fp read, const uint8_t addr,
+                             const npa_stats_t * const stats, const uint8_t len,
+                             npa_raw_frame_t * const frame)
+{
+    // Initialize raw data as all bits set, as it sets internal error code on
+    // by default.
+    memset (frame->data, 0xFF, sizeof (frame->data));
+    frame->start_us = stats_time (stats);
+    npa_ret_t ret_code = read (addr, frame->data, len);
+    frame->end_us = stats_time (stats);
+    ret_code |= parse_status (frame->data[0U]);
+    return ret_code;
+}
+
+static npa_ret_t read_pressure_int (const npa_ctx_t * const sensor,
+                                    const npa_int_scaling_t * const table,
+                                    int32_t * const pressure)
+{
+    npa_ret_t ret_code = npa_ctx_check (sensor);
+
+    if (NULL == pressure)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+
+    if (NPA_SUCCESS == ret_code)
+    {
+        npa_raw_frame_t frame;
+        ret_code |= read_frame (sensor->read, sensor->npa_addr, sensor->stats,
+                                NPA_FRAME_LEN_PRES, &frame);
+        const uint16_t OUT_U16 = parse_counts (frame.data);
+        const npa_ret_t conversion = check_conversion (sensor->model, OUT_U16, pressure);
+
+        if (0U == (conversion & NPA_ERR_FATAL))
+        {
+            *pressure = convert_int (&table[sensor->model], OUT_U16);
+        }
+
+        ret_code |= conversion;
+        stats_record (sensor->stats, ret_code, frame.start_us, frame.end_us);
     }
 
     return ret_code;
 }
 
-static npa_ret_t parse_value (const npa_variant_t model, const uint8_t * const raw_data,
-                              float * const pressure_pa)
+npa_ret_t npa_prepare (const npa_ctx_t * const sensor, npa_handle_t * const handle)
+{
+    npa_ret_t ret_code = npa_ctx_check (sensor);
+
+    if (NULL == handle)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+
+    if (NPA_SUCCESS == ret_code)
+    {
+        handle->write = sensor->write;
+        handle->read = sensor->read;
+        handle->npa_addr = sensor->npa_addr;
+        handle->model = sensor->model;
+        handle->stats = sensor->stats;
+        ret_code |= get_gain_offset (sensor->model, &handle->gain, &handle->offset);
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_handle_read_pressure (const npa_handle_t * const handle,
+                                    float * const pressure_pa)
 {
     npa_ret_t ret_code = NPA_SUCCESS;
-    // Mask status bits out.
-    const uint16_t OUT_U16 = ( ( (uint32_t) raw_data[0U] << 8U)
-                               + (uint32_t) raw_data[1U])
-                             & 0x3FFFU;
-    // Use floats in calculation
-    float Pmin = 0.0F;
-    float Pmax = 0.0F;
-    const float OUTmax = (float) NPA_PRES_MAX_NONSAT;
-    const float OUTmin = (float) NPA_PRES_MIN_NONSAT;
-    const float OUT = (float) OUT_U16;
 
-    if (check_saturation (OUT_U16))
+    if ( (NULL == handle) || (NULL == pressure_pa))
     {
-        ret_code |= NPA_WARN_SAT;
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        npa_raw_frame_t frame;
+        ret_code |= read_frame (handle->read, handle->npa_addr, handle->stats,
+                                NPA_FRAME_LEN_PRES, &frame);
+        ret_code |= parse_value (frame.data, handle->gain, handle->offset, pressure_pa);
+        stats_record (handle->stats, ret_code, frame.start_us, frame.end_us);
     }
 
-    ret_code |= get_scaling (model, &Pmax, &Pmin);
-    /*
-     * Pressure can be calculated from the sensor output using the following formula:
-     *
-     * P = Pmin + (OUT - OUTmin) / (OUTmax - OUTmin) * (Pmax - Pmin)
-     */
-    *pressure_pa = Pmin + (OUT - OUTmin) / (OUTmax - OUTmin) * (Pmax - Pmin);
     return ret_code;
 }
 
@@ -194,7 +402,56 @@ npa_ret_t npa_sample_trigger (const npa_ctx_t * const sensor)
 
         - Application guide p.15
         */
+        const uint32_t start_us = stats_time (sensor->stats);
         ret_code |= sensor->read (sensor->npa_addr, NULL, 0U);
+        stats_record (sensor->stats, ret_code, start_us, stats_time (sensor->stats));
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_write_read (const npa_ctx_t * const sensor,
+                          const uint8_t * const tx_data, const uint8_t tx_len,
+                          uint8_t * const rx_data, const uint8_t rx_len)
+{
+    npa_ret_t ret_code = npa_ctx_check (sensor);
+
+    if ( ( (0U < tx_len) && (NULL == tx_data)) || ( (0U < rx_len) && (NULL == rx_data)))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (0U == tx_len) && (0U == rx_len))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        // No action needed.
+    }
+
+    if (NPA_SUCCESS == ret_code)
+    {
+        const uint32_t start_us = stats_time (sensor->stats);
+
+        if (NULL != sensor->xfer)
+        {
+            ret_code |= sensor->xfer (sensor->npa_addr, tx_data, tx_len, rx_data, rx_len);
+        }
+        else
+        {
+            if (0U < tx_len)
+            {
+                ret_code |= sensor->write (sensor->npa_addr, tx_data, tx_len);
+            }
+
+            // Reading after a failed command would return unrelated data.
+            if ( (0U < rx_len) && (0U == (ret_code & NPA_ERR_FATAL)))
+            {
+                ret_code |= sensor->read (sensor->npa_addr, rx_data, rx_len);
+            }
+        }
+
+        stats_record (sensor->stats, ret_code, start_us, stats_time (sensor->stats));
     }
 
     return ret_code;
@@ -203,7 +460,8 @@ npa_ret_t npa_sample_trigger (const npa_ctx_t * const sensor)
 npa_ret_t npa_read_pressure (const npa_ctx_t * const sensor,
                              float * const pressure_pa)
 {
-    npa_ret_t ret_code = npa_ctx_check (sensor);
+    npa_handle_t handle;
+    npa_ret_t ret_code = npa_prepare (sensor, &handle);
 
     if (NULL == pressure_pa)
     {
@@ -212,12 +470,317 @@ npa_ret_t npa_read_pressure (const npa_ctx_t * const sensor,
 
     if (NPA_SUCCESS == ret_code)
     {
-        // Initialize raw data as all bits set, as it sets internal error code on
-        // by default.
-        uint8_t raw_data[2U] = { 0xFFU, 0xFFU };
-        ret_code |= sensor->read (sensor->npa_addr, raw_data, sizeof (raw_data));
+        ret_code |= npa_handle_read_pressure (&handle, pressure_pa);
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_read_pressure_mpa (const npa_ctx_t * const sensor,
+                                 int32_t * const pressure_mpa)
+{
+    return read_pressure_int (sensor, m_mpa_scaling, pressure_mpa);
+}
+
+npa_ret_t npa_read_pressure_q (const npa_ctx_t * const sensor,
+                               int32_t * const pressure_q)
+{
+    return read_pressure_int (sensor, m_q_scaling, pressure_q);
+}
+
+npa_ret_t npa_convert_pa (const npa_variant_t model, const uint16_t counts,
+                          float * const pressure_pa)
+{
+    npa_ret_t ret_code = check_conversion (model, counts, pressure_pa);
+
+    if (0U == (ret_code & NPA_ERR_FATAL))
+    {
+        float gain = 0.0F;
+        float offset = 0.0F;
+        ret_code |= get_gain_offset (model, &gain, &offset);
+        *pressure_pa = ( (float) counts * gain) + offset;
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_convert_mpa (const npa_variant_t model, const uint16_t counts,
+                           int32_t * const pressure_mpa)
+{
+    npa_ret_t ret_code = check_conversion (model, counts, pressure_mpa);
+
+    if (0U == (ret_code & NPA_ERR_FATAL))
+    {
+        *pressure_mpa = convert_int (&m_mpa_scaling[model], counts);
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_convert_q (const npa_variant_t model, const uint16_t counts,
+                         int32_t * const pressure_q)
+{
+    npa_ret_t ret_code = check_conversion (model, counts, pressure_q);
+
+    if (0U == (ret_code & NPA_ERR_FATAL))
+    {
+        *pressure_q = convert_int (&m_q_scaling[model], counts);
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_convert_temp (const uint16_t counts, const uint8_t data_len,
+                            float * const temperature_c)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+    const uint16_t full_scale = (NPA_FRAME_LEN_HIRES == data_len) ? NPA_TEMP_MAX_HIRES :
+                                NPA_TEMP_MAX_LOWRES;
+
+    if (NULL == temperature_c)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( ( (NPA_FRAME_LEN_LOWRES != data_len) && (NPA_FRAME_LEN_HIRES != data_len))
+              || (full_scale < counts))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        const float Tgain = NPA_TEMP_SPAN_C / (float) full_scale;
+        *temperature_c = ( (float) counts * Tgain) + NPA_TEMP_MIN_C;
+    }
+
+    return ret_code;
+}
+
+/**
+ * @brief Read and convert up to @ref NPA_BATCH_CHUNK sensors.
+ *
+ * Transfers of sensors sharing a read function are issued back-to-back, after which
+ * all frames are converted in one pass. Scaling is recalculated only when the model
+ * changes between consecutive sensors.
+ *
+ * @param[in]  sensors     Array of sensors to read.
+ * @param[in]  num_sensors Number of sensors, at most @ref NPA_BATCH_CHUNK.
+ * @param[out] pressure_pa Array of pressures in pascals.
+ * @param[out] status      Array of status codes per sensor.
+ */
+static void read_batch_chunk (const npa_ctx_t * const sensors,
+                              const size_t num_sensors,
+                              float * const pressure_pa,
+                              npa_ret_t * const status)
+{
+    npa_raw_frame_t frames[NPA_BATCH_CHUNK];
+    bool valid[NPA_BATCH_CHUNK];
+    bool pending[NPA_BATCH_CHUNK];
+
+    for (size_t ii = 0U; ii < num_sensors; ii++)
+    {
+        status[ii] = npa_ctx_check (&sensors[ii]);
+        valid[ii] = (NPA_SUCCESS == status[ii]);
+        pending[ii] = valid[ii];
+    }
+
+    for (size_t ii = 0U; ii < num_sensors; ii++)
+    {
+        if (pending[ii])
+        {
+            const npa_read_fp bus = sensors[ii].read;
+
+            for (size_t jj = ii; jj < num_sensors; jj++)
+            {
+                if (pending[jj] && (bus == sensors[jj].read))
+                {
+                    status[jj] |= read_frame (bus, sensors[jj].npa_addr, sensors[jj].stats,
+                                              NPA_FRAME_LEN_PRES, &frames[jj]);
+                    pending[jj] = false;
+                }
+            }
+        }
+    }
+
+    bool scaled = false;
+    npa_variant_t scaled_model = NPA_700_02WD;
+    npa_ret_t scaling_status = NPA_SUCCESS;
+    float gain = 0.0F;
+    float offset = 0.0F;
+
+    for (size_t ii = 0U; ii < num_sensors; ii++)
+    {
+        // Sensors with invalid context have not been read.
+        if (valid[ii])
+        {
+            if ( (!scaled) || (scaled_model != sensors[ii].model))
+            {
+                scaling_status = get_gain_offset (sensors[ii].model, &gain, &offset);
+                scaled_model = sensors[ii].model;
+                scaled = true;
+            }
+
+            status[ii] |= scaling_status;
+            status[ii] |= parse_value (frames[ii].data, gain, offset, &pressure_pa[ii]);
+            stats_record (sensors[ii].stats, status[ii], frames[ii].start_us,
+                          frames[ii].end_us);
+        }
+    }
+}
+
+npa_ret_t npa_read_pressure_batch (const npa_ctx_t * const sensors,
+                                   const size_t num_sensors,
+                                   float * const pressure_pa,
+                                   npa_ret_t * const status)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == sensors) || (NULL == pressure_pa))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        for (size_t base = 0U; base < num_sensors; base += NPA_BATCH_CHUNK)
+        {
+            npa_ret_t chunk_status[NPA_BATCH_CHUNK];
+            const size_t chunk_len = ( (num_sensors - base) < NPA_BATCH_CHUNK) ?
+                                     (num_sensors - base) : NPA_BATCH_CHUNK;
+            read_batch_chunk (&sensors[base], chunk_len, &pressure_pa[base], chunk_status);
+
+            for (size_t ii = 0U; ii < chunk_len; ii++)
+            {
+                ret_code |= chunk_status[ii];
+
+                if (NULL != status)
+                {
+                    status[base + ii] = chunk_status[ii];
+                }
+            }
+        }
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_parse_frame (const uint8_t * const raw_data, const uint8_t data_len,
+                           uint16_t * const pressure_counts,
+                           uint16_t * const temperature_counts)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == raw_data) || (NULL == pressure_counts))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (NPA_FRAME_LEN_PRES > data_len) || (NPA_FRAME_LEN_HIRES < data_len))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        uint16_t temperature = 0U;
         ret_code |= parse_status (raw_data[0U]);
-        ret_code |= parse_value (sensor->model, raw_data, pressure_pa);
+        *pressure_counts = parse_counts (raw_data);
+
+        if (check_saturation (*pressure_counts))
+        {
+            ret_code |= NPA_WARN_SAT;
+        }
+
+        if (NPA_FRAME_LEN_HIRES == data_len)
+        {
+            // T[10:3] in third byte, T[2:0] in 3 MSB of fourth byte.
+            temperature = (uint16_t) ( ( (uint32_t) raw_data[2U] << 3U)
+                                       | ( (uint32_t) raw_data[3U] >> 5U));
+        }
+        else if (NPA_FRAME_LEN_LOWRES == data_len)
+        {
+            temperature = raw_data[2U];
+        }
+        else
+        {
+            // No action needed.
+        }
+
+        if (NULL != temperature_counts)
+        {
+            *temperature_counts = temperature;
+        }
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_decode_frame (const npa_variant_t model, const uint8_t * const raw_data,
+                            const uint8_t data_len, float * const pressure_pa,
+                            float * const temperature_c)
+{
+    uint16_t pressure_counts = 0U;
+    uint16_t temperature_counts = 0U;
+    npa_ret_t ret_code = npa_parse_frame (raw_data, data_len, &pressure_counts,
+                                          &temperature_counts);
+
+    if (NULL == pressure_pa)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+
+    // Error codes share the fatal bit, check inputs directly. Frames with fatal status
+    // are converted like npa_read_pressure does.
+    if ( (NULL != raw_data) && (NULL != pressure_pa) && (NPA_FRAME_LEN_PRES <= data_len)
+            && (NPA_FRAME_LEN_HIRES >= data_len))
+    {
+        float gain = 0.0F;
+        float offset = 0.0F;
+        ret_code |= get_gain_offset (model, &gain, &offset);
+        *pressure_pa = ( (float) pressure_counts * gain) + offset;
+
+        if ( (NULL != temperature_c) && (NPA_FRAME_LEN_PRES < data_len))
+        {
+            ret_code |= npa_convert_temp (temperature_counts, data_len, temperature_c);
+        }
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_get_scaling (const npa_variant_t model, float * const gain,
+                           float * const offset)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == gain) || (NULL == offset))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        ret_code |= get_gain_offset (model, gain, offset);
+    }
+
+    return ret_code;
+}
+
+static npa_ret_t read_pressure_temp (const npa_ctx_t * const sensor,
+                                     const uint8_t data_len,
+                                     float * const pressure_pa,
+                                     float * const temperature_c)
+{
+    npa_ret_t ret_code = npa_ctx_check (sensor);
+
+    if ( (NULL == pressure_pa) || (NULL == temperature_c))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+
+    if (NPA_SUCCESS == ret_code)
+    {
+        npa_raw_frame_t frame;
+        ret_code |= read_frame (sensor->read, sensor->npa_addr, sensor->stats, data_len,
+                                &frame);
+        ret_code |= npa_decode_frame (sensor->model, frame.data, data_len, pressure_pa,
+                                      temperature_c);
+        stats_record (sensor->stats, ret_code, frame.start_us, frame.end_us);
     }
 
     return ret_code;
@@ -227,14 +790,14 @@ npa_ret_t npa_read_pressure_temp_lowres (const npa_ctx_t * const sensor,
         float * const pressure_pa,
         float * const temperature_c)
 {
-    return NPA_ERR_IMPL;
+    return read_pressure_temp (sensor, NPA_FRAME_LEN_LOWRES, pressure_pa, temperature_c);
 }
 
 npa_ret_t npa_read_pressure_temp_hires (const npa_ctx_t * const sensor,
                                         float * const pressure_pa,
                                         float * const temperature_c)
 {
-    return NPA_ERR_IMPL;
+    return read_pressure_temp (sensor, NPA_FRAME_LEN_HIRES, pressure_pa, temperature_c);
 }
 
 /** @} */
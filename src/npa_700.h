@@ -22,6 +22,7 @@
  *
  */
 
+#include <stddef.h>
 #include <stdint.h>
 
 /**
@@ -41,9 +42,11 @@
  * 136   | Error: Function is not implemented.
  * 144   | Error: Invalid parameter.
  * 170   | Error: Sensor is in configuration mode.
- * 192   | Error: Internal error in sensor.
+ * 128   | Error: Internal error in sensor.
+ * 192   | Error: Previous operation is still in progress.
  * 1     | Warning: Value is saturated.
  * 2     | Warning: Value is already read.
+ * 4     | Warning: Value was rejected as a spike and replaced.
  */
 typedef uint32_t npa_ret_t;
 
@@ -55,9 +58,11 @@ typedef uint32_t npa_ret_t;
 #define NPA_ERR_IMPL     (NPA_ERR_FATAL + 8U)  //!< Function is not implemented.
 #define NPA_ERR_PARAM    (NPA_ERR_FATAL + 16U) //!< Invalid parameter. 
 #define NPA_ERR_MODE     (NPA_ERR_FATAL + 32U) //!< Invalid mode. 
+#define NPA_ERR_BUSY     (NPA_ERR_FATAL + 64U) //!< Previous operation in progress.
 #define NPA_ERR_INTERNAL (NPA_ERR_FATAL)       //!< Internal error.
 #define NPA_WARN_SAT     (1U)   //!< Value is saturated.
 #define NPA_WARN_OLD     (2U)   //!< Value was already read, not updated.
+#define NPA_WARN_SPIKE   (4U)   //!< Value was rejected as a spike, see npa_700_spike.h.
 
 /*
  * Pressure can be calculated from the sensor output using the following formula:
@@ -71,6 +76,23 @@ typedef uint32_t npa_ret_t;
 #define NPA_PRES_MIN_SAT    (0U)     //!< Minimum saturated pressure counts.
 #define NPA_PRES_MIDDLE     (8192U)  //!< Middle pressure, 0-level.
 
+/*
+ * Temperature can be calculated from the sensor output using the following formula:
+ *
+ * T = Tout / Tmax * 200 - 50,
+ *
+ * where Tmax is 255 for 8-bit and 2047 for 11-bit temperature.
+ */
+
+#define NPA_TEMP_MIN_C      (-50.0F) //!< Temperature at 0 counts.
+#define NPA_TEMP_SPAN_C     (200.0F) //!< Temperature span of the full scale.
+#define NPA_TEMP_MAX_LOWRES (255U)   //!< Full scale of 8-bit temperature counts.
+#define NPA_TEMP_MAX_HIRES  (2047U)  //!< Full scale of 11-bit temperature counts.
+
+#define NPA_FRAME_LEN_PRES   (2U) //!< Length of frame with status and pressure.
+#define NPA_FRAME_LEN_LOWRES (3U) //!< Length of frame with 8-bit temperature.
+#define NPA_FRAME_LEN_HIRES  (4U) //!< Length of frame with 11-bit temperature.
+
 #define NPA_02WD_SCALE_PA   (500.0F)    //!< Maximum scale of NPA_02WD
 #define NPA_05WD_SCALE_PA   (1250.0F)   //!< Maximum scale of NPA_05WD
 #define NPA_10WD_SCALE_PA   (2490.0F)   //!< Maximum scale of NPA_10WD
@@ -79,6 +101,73 @@ typedef uint32_t npa_ret_t;
 #define NPA_015D_SCALE_PA   (103420.0F) //!< Maximum scale of NPA_015D
 #define NPA_030D_SCALE_PA   (206840.0F) //!< Maximum scale of NPA_030D
 
+/*
+ * Everything but OUT in the pressure formula is constant per model, so it reduces to
+ * P = OUT * gain + offset, where gain and offset are evaluated at compile time.
+ */
+#define NPA_GAIN(scale) \
+    ( (2.0F * (scale)) / ( (float) NPA_PRES_MAX_NONSAT - (float) NPA_PRES_MIN_NONSAT))
+#define NPA_OFFSET(scale) \
+    ( (-1.0F * (scale)) - ( (float) NPA_PRES_MIN_NONSAT * NPA_GAIN (scale)))
+
+#define NPA_02WD_SCALE_PA_INT (500U)    //!< Maximum scale of NPA_02WD in integer pascals.
+#define NPA_05WD_SCALE_PA_INT (1250U)   //!< Maximum scale of NPA_05WD in integer pascals.
+#define NPA_10WD_SCALE_PA_INT (2490U)   //!< Maximum scale of NPA_10WD in integer pascals.
+#define NPA_001D_SCALE_PA_INT (6890U)   //!< Maximum scale of NPA_001D in integer pascals.
+#define NPA_005D_SCALE_PA_INT (34470U)  //!< Maximum scale of NPA_005D in integer pascals.
+#define NPA_015D_SCALE_PA_INT (103420U) //!< Maximum scale of NPA_015D in integer pascals.
+#define NPA_030D_SCALE_PA_INT (206840U) //!< Maximum scale of NPA_030D in integer pascals.
+
+/*
+ * Integer conversion.
+ *
+ * With Pmax = -Pmin = S and OUTmax + OUTmin = 16383 the scaling formula becomes
+ *
+ * P = S * (2 * OUT - 16383) / 13107
+ *   = S * (2 * OUT + 9831) / 13107 - 2 * S,
+ *
+ * where the numerator of the first term is always positive. The division is replaced
+ * by a multiplication with gain = ceil (S * 2^32 / 13107) and a shift. Error of the
+ * gain adds less than 1e-5 to the quotient, while the exact quotient is a multiple of
+ * 1/13107 and thus never closer than 1/26214 to a rounding boundary. Result is
+ * therefore exactly the rounded value of the formula for every 14-bit count, which is
+ * also verified exhaustively by unit tests. S is in output units, e.g. millipascals.
+ */
+#define NPA_INT_SHIFT (32U) //!< Fractional bits of integer gain.
+#define NPA_INT_SPAN  (NPA_PRES_MAX_NONSAT - NPA_PRES_MIN_NONSAT) //!< 13107 counts.
+#define NPA_INT_BIAS  ((2U * NPA_INT_SPAN) - (NPA_PRES_MAX_NONSAT + NPA_PRES_MIN_NONSAT))
+#define NPA_INT_GAIN(scale) \
+    ( ( ( (uint64_t) (scale) << NPA_INT_SHIFT) + NPA_INT_SPAN - 1U) / NPA_INT_SPAN)
+#define NPA_INT_OFFSET(scale) (2U * (uint32_t) (scale))
+
+/**
+ * @brief Number of fractional bits in Q-format pressure.
+ *
+ * Pressure is returned in pascals as a signed fixed point value with NPA_Q_FRAC_BITS
+ * fractional bits. The largest value supported is 12, which keeps the full range of
+ * NPA_700_030D within int32_t. Define in build to override.
+ */
+#ifndef NPA_Q_FRAC_BITS
+#define NPA_Q_FRAC_BITS (8U)
+#endif
+#if (NPA_Q_FRAC_BITS > 12U)
+#error "NPA_Q_FRAC_BITS must be at most 12."
+#endif
+
+/**
+ * @brief Update read statistics of sensors.
+ *
+ * Set to 1 in build to update the @ref npa_stats_t of each sensor which has one on
+ * every read. When 0, statistics are compiled out of the read paths and the stats
+ * member of contexts is ignored.
+ */
+#ifndef NPA_STATS
+#define NPA_STATS (0)
+#endif
+
+/** @brief Read statistics of a sensor, see npa_700_stats.h. */
+typedef struct npa_stats_s npa_stats_t;
+
 /**
  * @brief Write data to NPA-700.
  *
@@ -109,6 +198,34 @@ typedef npa_ret_t (*npa_read_fp) (const uint8_t i2c_addr,
                                   uint8_t * const data,
                                   const uint8_t data_len);
 
+/**
+ * @brief Write to and then read from NPA-700 in one bus transaction.
+ *
+ * Optional. Read must follow write with a repeated start instead of a stop, e.g. as
+ * one I2C_RDWR message list on Linux. Either length may be 0 to skip that part.
+ *
+ * @param[in]  i2c_addr I2C Address of the the sensor.
+ * @param[in]  tx_data  Data to write. May be NULL if tx_len is 0.
+ * @param[in]  tx_len   Length of data to write.
+ * @param[out] rx_data  Pointer to which read data is placed. May be NULL if rx_len is 0.
+ * @param[in]  rx_len   Length of data to read.
+ * @return @ref npa_ret_t, as from @ref npa_write_fp and @ref npa_read_fp.
+ */
+typedef npa_ret_t (*npa_xfer_fp) (const uint8_t i2c_addr,
+                                  const uint8_t * const tx_data,
+                                  const uint8_t tx_len,
+                                  uint8_t * const rx_data,
+                                  const uint8_t rx_len);
+
+/**
+ * @brief Read a monotonic clock.
+ *
+ * Clock may wrap around, compare times by unsigned difference.
+ *
+ * @return Current time in microseconds.
+ */
+typedef uint32_t (*npa_clock_fp) (void);
+
 /**
  * @brief Variants of NPA-700.
  *
@@ -133,8 +250,53 @@ typedef struct
     const npa_read_fp read;    //!< I2C read function. Must not be NULL.
     const uint8_t npa_addr;     //!< I2C address of NPA-700.
     const npa_variant_t model;  //!< Model of the sensor used.
+    npa_stats_t * const stats;  //!< Read statistics, may be NULL.
+    const npa_xfer_fp xfer;     //!< Combined write and read, may be NULL.
 } npa_ctx_t;
 
+/**
+ * @brief Prepared sensor handle.
+ *
+ * Handle is built once from a valid @ref npa_ctx_t by @ref npa_prepare. Scaling of the
+ * model is cached as gain and offset so that converting a sample is a single
+ * multiply-add: P = OUT * gain + offset.
+ */
+typedef struct
+{
+    npa_write_fp write;   //!< I2C write function.
+    npa_read_fp read;     //!< I2C read function.
+    uint8_t npa_addr;     //!< I2C address of NPA-700.
+    npa_variant_t model;  //!< Model of the sensor used.
+    float gain;           //!< Pascals per count.
+    float offset;         //!< Pascals at 0 counts.
+    npa_stats_t * stats;  //!< Read statistics, may be NULL.
+} npa_handle_t;
+
+/**
+ * @brief Prepare a sensor handle.
+ *
+ * Validates the context and precomputes scaling of the sensor model.
+ *
+ * @param[in]  sensor Sensor to prepare.
+ * @param[out] handle Handle to initialize.
+ * @return @ref npa_ret_t.
+ */
+npa_ret_t npa_prepare (const npa_ctx_t * const sensor, npa_handle_t * const handle);
+
+/**
+ * @brief Read pressure from a prepared sensor.
+ *
+ * Same as @ref npa_read_pressure without validating the context.
+ *
+ * @param[in]  handle      Prepared sensor to read.
+ * @param[out] pressure_pa Pressure in pascals.
+ * @return @ref npa_ret_t.
+ *
+ * @note Use system float as a type.
+ */
+npa_ret_t npa_handle_read_pressure (const npa_handle_t * const handle,
+                                    float * const pressure_pa);
+
 /**
  * @brief Trigger NPA sampling operation.
  *
@@ -145,6 +307,27 @@ typedef struct
  */
 npa_ret_t npa_sample_trigger (const npa_ctx_t * const sensor);
 
+/**
+ * @brief Write a command to NPA-700 and read its response.
+ *
+ * Uses @ref npa_ctx_t.xfer to transfer both in one transaction if it is set.
+ * Otherwise command is written and response read by separate transfers, and read is
+ * skipped if write fails.
+ *
+ * @param[in]  sensor  Sensor to transfer with.
+ * @param[in]  tx_data Command to write. May be NULL if tx_len is 0.
+ * @param[in]  tx_len  Length of command, 0 to only read.
+ * @param[out] rx_data Pointer to which response is placed. May be NULL if rx_len is 0.
+ * @param[in]  rx_len  Length of response, 0 to only write.
+ * @retval NPA_ERR_NULL  Sensor was not valid or data pointer was NULL, nothing was
+ *                       transferred.
+ * @retval NPA_ERR_PARAM Both lengths were 0, nothing was transferred.
+ * @return @ref npa_ret_t of the transfers.
+ */
+npa_ret_t npa_write_read (const npa_ctx_t * const sensor,
+                          const uint8_t * const tx_data, const uint8_t tx_len,
+                          uint8_t * const rx_data, const uint8_t rx_len);
+
 /**
  * @brief Read pressure from sensor.
  *
@@ -160,6 +343,140 @@ npa_ret_t npa_sample_trigger (const npa_ctx_t * const sensor);
 npa_ret_t npa_read_pressure (const npa_ctx_t * const sensor,
                              float * const pressure_pa);
 
+/**
+ * @brief Read pressure from sensor in integer millipascals.
+ *
+ * Same as @ref npa_read_pressure, but conversion is done in integer arithmetic only.
+ * Result is the exact value of the scaling formula rounded to nearest millipascal.
+ *
+ * @param[in]  sensor       Sensor to read.
+ * @param[out] pressure_mpa Pressure in millipascals.
+ * @return @ref npa_ret_t.
+ */
+npa_ret_t npa_read_pressure_mpa (const npa_ctx_t * const sensor,
+                                 int32_t * const pressure_mpa);
+
+/**
+ * @brief Read pressure from sensor in Q-format pascals.
+ *
+ * Same as @ref npa_read_pressure, but conversion is done in integer arithmetic only.
+ * Result is the exact value of the scaling formula rounded to nearest
+ * 2^-@ref NPA_Q_FRAC_BITS pascals.
+ *
+ * @param[in]  sensor     Sensor to read.
+ * @param[out] pressure_q Pressure in pascals with @ref NPA_Q_FRAC_BITS fractional bits.
+ * @return @ref npa_ret_t.
+ */
+npa_ret_t npa_read_pressure_q (const npa_ctx_t * const sensor,
+                               int32_t * const pressure_q);
+
+/**
+ * @brief Convert pressure counts to pascals.
+ *
+ * @param[in]  model       Model of the sensor.
+ * @param[in]  counts      14-bit pressure counts of the sensor.
+ * @param[out] pressure_pa Pressure in pascals.
+ * @retval NPA_SUCCESS   Value was converted.
+ * @retval NPA_WARN_SAT  Value was converted, but it is saturated.
+ * @retval NPA_ERR_NULL  pressure_pa was NULL.
+ * @retval NPA_ERR_PARAM Model is unknown or counts does not fit in 14 bits.
+ *
+ * @note Use system float as a type.
+ */
+npa_ret_t npa_convert_pa (const npa_variant_t model, const uint16_t counts,
+                          float * const pressure_pa);
+
+/**
+ * @brief Convert pressure counts to integer millipascals.
+ *
+ * @param[in]  model        Model of the sensor.
+ * @param[in]  counts       14-bit pressure counts of the sensor.
+ * @param[out] pressure_mpa Pressure in millipascals.
+ * @return See @ref npa_convert_pa.
+ */
+npa_ret_t npa_convert_mpa (const npa_variant_t model, const uint16_t counts,
+                           int32_t * const pressure_mpa);
+
+/**
+ * @brief Convert pressure counts to Q-format pascals.
+ *
+ * @param[in]  model      Model of the sensor.
+ * @param[in]  counts     14-bit pressure counts of the sensor.
+ * @param[out] pressure_q Pressure in pascals with @ref NPA_Q_FRAC_BITS fractional bits.
+ * @return See @ref npa_convert_pa.
+ */
+npa_ret_t npa_convert_q (const npa_variant_t model, const uint16_t counts,
+                         int32_t * const pressure_q);
+
+/**
+ * @brief Convert temperature counts of a frame to degrees Celsius.
+ *
+ * @param[in]  counts        Temperature counts as parsed by @ref npa_parse_frame.
+ * @param[in]  data_len      Length of frame, @ref NPA_FRAME_LEN_LOWRES or
+ *                           @ref NPA_FRAME_LEN_HIRES.
+ * @param[out] temperature_c Temperature in degrees Celsius.
+ * @retval NPA_SUCCESS   Value was converted.
+ * @retval NPA_ERR_NULL  temperature_c was NULL.
+ * @retval NPA_ERR_PARAM Frame has no temperature or counts exceed its full scale.
+ */
+npa_ret_t npa_convert_temp (const uint16_t counts, const uint8_t data_len,
+                            float * const temperature_c);
+
+/**
+ * @brief Parse a raw frame read from the sensor.
+ *
+ * Status, pressure and temperature are decoded in a single pass over the frame.
+ * This allows decoding data which was read by the application, e.g. with DMA.
+ *
+ * @param[in]  raw_data           Frame read from sensor.
+ * @param[in]  data_len           Length of frame, @ref NPA_FRAME_LEN_PRES,
+ *                                @ref NPA_FRAME_LEN_LOWRES or @ref NPA_FRAME_LEN_HIRES.
+ * @param[out] pressure_counts    14-bit pressure counts.
+ * @param[out] temperature_counts 8-bit or 11-bit temperature counts depending on
+ *                                data_len, 0 if frame has no temperature. May be NULL.
+ * @return @ref npa_ret_t of frame. NPA_ERR_PARAM if data_len is invalid.
+ */
+npa_ret_t npa_parse_frame (const uint8_t * const raw_data, const uint8_t data_len,
+                           uint16_t * const pressure_counts,
+                           uint16_t * const temperature_counts);
+
+/**
+ * @brief Decode a raw frame read from the sensor.
+ *
+ * Same as @ref npa_parse_frame, but converts pressure to pascals and temperature
+ * to celcius.
+ *
+ * @param[in]  model         Model of the sensor.
+ * @param[in]  raw_data      Frame read from sensor.
+ * @param[in]  data_len      Length of frame, see @ref npa_parse_frame.
+ * @param[out] pressure_pa   Pressure in pascals.
+ * @param[out] temperature_c Temperature in celcius. May be NULL. Not written if frame
+ *                           has no temperature.
+ * @return @ref npa_ret_t of frame.
+ *
+ * @note Use system float as a type.
+ */
+npa_ret_t npa_decode_frame (const npa_variant_t model, const uint8_t * const raw_data,
+                            const uint8_t data_len, float * const pressure_pa,
+                            float * const temperature_c);
+
+/**
+ * @brief Get float scaling of a model.
+ *
+ * Pressure in pascals is P = OUT * gain + offset, evaluated as a float multiply
+ * followed by a float add. Decoders outside driver can use the same constants to
+ * produce results identical to @ref npa_decode_frame.
+ *
+ * @param[in]  model  Model of the sensor.
+ * @param[out] gain   Pascals per count.
+ * @param[out] offset Pascals at 0 counts.
+ * @retval NPA_SUCCESS   Scaling was written.
+ * @retval NPA_ERR_NULL  Gain or offset was NULL.
+ * @retval NPA_ERR_FATAL Model is unknown, gain and offset are set to 0.
+ */
+npa_ret_t npa_get_scaling (const npa_variant_t model, float * const gain,
+                           float * const offset);
+
 /**
  * @brief Read pressure and 8-bit temperature from sensor.
  *
@@ -167,7 +484,7 @@ npa_ret_t npa_read_pressure (const npa_ctx_t * const sensor,
  * function triggers new sample and returns stale data. Using lower resolution saves
  * a bit time as 9 bits less are clocked on the bus.
  *
- * @param[out] sensor Sensor to read.
+ * @param[in] sensor Sensor to read.
  * @param[out] pressure_pa   Pressure in pascals.
  * @param[out] temperature_c Temperature in celcius.
  * @return @ref npa_ret_t.
@@ -195,5 +512,28 @@ npa_ret_t npa_read_pressure_temp_hires (const npa_ctx_t * const sensor,
                                         float * const pressure_pa,
                                         float * const temperature_c);
 
+/**
+ * @brief Read pressure from an array of sensors.
+ *
+ * Each context is validated once and the raw frames of all sensors are read before
+ * converting them in a single pass. Sensors sharing a read function are considered to be
+ * on the same bus and their transfers are issued back-to-back, so the transfer order
+ * may differ from the order of the array.
+ *
+ * Pressure of a sensor with invalid context is not written.
+ *
+ * @param[in]  sensors     Array of sensors to read.
+ * @param[in]  num_sensors Number of sensors in array.
+ * @param[out] pressure_pa Array of num_sensors pressures in pascals.
+ * @param[out] status      Array of num_sensors @ref npa_ret_t, one per sensor. May be NULL.
+ * @return @ref npa_ret_t, bitwise OR of status of all sensors.
+ *
+ * @note Use system float as a type.
+ */
+npa_ret_t npa_read_pressure_batch (const npa_ctx_t * const sensors,
+                                   const size_t num_sensors,
+                                   float * const pressure_pa,
+                                   npa_ret_t * const status);
+
 /** @} */
 #endif // NPA_700_H
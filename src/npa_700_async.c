@@ -0,0 +1,147 @@
+#include "npa_700_async.h"
+#if NPA_STATS
+#include "npa_700_stats.h"
+#endif
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_async.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ */
+
+/**
+ * @brief Validate asynchronous NPA Context.
+ *
+ * A valid context must have non-null read and callback pointers and a supported
+ * frame length.
+ *
+ * @param[in] sensor Sensor context to check.
+ * @return @ref npa_ret_t.
+ */
+static npa_ret_t npa_async_ctx_check (const npa_async_ctx_t * const sensor)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if (NULL == sensor)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if (NULL == sensor->read)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if (NULL == sensor->callback)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (NPA_FRAME_LEN_PRES > sensor->data_len)
+              || (NPA_FRAME_LEN_HIRES < sensor->data_len))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        // No action needed.
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_async_init (npa_async_t * const transfer)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if (NULL == transfer)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        transfer->sensor = NULL;
+        transfer->busy = false;
+        transfer->start_us = 0U;
+        memset (transfer->raw_data, 0xFF, sizeof (transfer->raw_data));
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_read_start (const npa_async_ctx_t * const sensor,
+                          npa_async_t * const transfer)
+{
+    npa_ret_t ret_code = npa_async_ctx_check (sensor);
+
+    if (NULL == transfer)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if (transfer->busy)
+    {
+        ret_code |= NPA_ERR_BUSY;
+    }
+    else
+    {
+        // No action needed.
+    }
+
+    if (NPA_SUCCESS == ret_code)
+    {
+        transfer->sensor = sensor;
+        transfer->busy = true;
+        // Initialize raw data as all bits set, as it sets internal error code on
+        // by default.
+        memset (transfer->raw_data, 0xFF, sizeof (transfer->raw_data));
+#if NPA_STATS
+        transfer->start_us = npa_stats_now (sensor->stats);
+#endif
+        ret_code |= sensor->read (sensor->npa_addr, transfer->raw_data, sensor->data_len,
+                                  transfer);
+
+        if (NPA_SUCCESS != ret_code)
+        {
+            // Transfer was not started, there will be no completion.
+            transfer->busy = false;
+        }
+    }
+
+    return ret_code;
+}
+
+void npa_read_complete (npa_async_t * const transfer, const npa_ret_t transfer_status)
+{
+    if ( (NULL != transfer) && transfer->busy)
+    {
+        const npa_async_ctx_t * const sensor = transfer->sensor;
+        float pressure_pa = 0.0F;
+        float temperature_c = 0.0F;
+        npa_ret_t ret_code = transfer_status;
+#if NPA_STATS
+        const uint32_t end_us = npa_stats_now (sensor->stats);
+#endif
+        ret_code |= npa_decode_frame (sensor->model, transfer->raw_data, sensor->data_len,
+                                      &pressure_pa, &temperature_c);
+#if NPA_STATS
+        npa_stats_record (sensor->stats, ret_code, transfer->start_us, end_us);
+#endif
+        // Release transfer before callback so that callback may start next read.
+        transfer->busy = false;
+        sensor->callback (sensor, ret_code, pressure_pa, temperature_c);
+    }
+}
+
+bool npa_read_busy (const npa_async_t * const transfer)
+{
+    return (NULL != transfer) && transfer->busy;
+}
+
+/** @} */
@@ -0,0 +1,131 @@
+#ifndef NPA_700_ASYNC_H
+#define NPA_700_ASYNC_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_async.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Non-blocking reads of NPA-700.
+ *
+ * Application provides a function which starts an I2C transfer and returns
+ * immediately. When the transfer has finished, application calls
+ * @ref npa_read_complete e.g. from I2C or DMA interrupt handler. Driver then decodes
+ * the frame and passes the result to the callback of the sensor.
+ *
+ * Each @ref npa_async_t can have one transfer in progress at a time. Callback may
+ * start the next transfer of the same sensor.
+ */
+
+#include "npa_700.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct npa_async_ctx_s npa_async_ctx_t;
+typedef struct npa_async_s npa_async_t;
+
+/**
+ * @brief Start reading data from NPA-700.
+ *
+ * Function must not wait for the transfer to finish. Once transfer has finished,
+ * platform must call @ref npa_read_complete with given transfer.
+ *
+ * @param[in]  i2c_addr I2C Address of the the sensor.
+ * @param[out] data     Pointer to which read data is placed. Valid until transfer
+ *                      is completed.
+ * @param[in]  data_len Length of data.
+ * @param[in]  transfer Transfer to complete.
+ * @retval 0  Transfer was started.
+ * @return Error code of @ref npa_ret_t if transfer could not be started.
+ */
+typedef npa_ret_t (*npa_read_async_fp) (const uint8_t i2c_addr,
+                                        uint8_t * const data,
+                                        const uint8_t data_len,
+                                        npa_async_t * const transfer);
+
+/**
+ * @brief Handle result of an asynchronous read.
+ *
+ * Called from the context of @ref npa_read_complete.
+ *
+ * @param[in] sensor        Sensor which was read.
+ * @param[in] status        @ref npa_ret_t of transfer and data.
+ * @param[in] pressure_pa   Pressure in pascals.
+ * @param[in] temperature_c Temperature in celcius, 0 if frame has no temperature.
+ */
+typedef void (*npa_async_cb) (const npa_async_ctx_t * const sensor,
+                              const npa_ret_t status,
+                              const float pressure_pa,
+                              const float temperature_c);
+
+/** @brief Structure for interfacing the asynchronous driver with platform. */
+struct npa_async_ctx_s
+{
+    const npa_read_async_fp read; //!< Function starting I2C read. Must not be NULL.
+    const npa_async_cb callback;  //!< Result handler. Must not be NULL.
+    void * const p_context;       //!< Application context, not used by driver.
+    const uint8_t npa_addr;       //!< I2C address of NPA-700.
+    const npa_variant_t model;    //!< Model of the sensor used.
+    const uint8_t data_len;       //!< Frame length, @ref NPA_FRAME_LEN_PRES ...
+                                  //!< @ref NPA_FRAME_LEN_HIRES.
+    npa_stats_t * const stats;    //!< Read statistics, may be NULL.
+};
+
+/** @brief State of an asynchronous transfer. Initialize with @ref npa_async_init. */
+struct npa_async_s
+{
+    const npa_async_ctx_t * sensor;         //!< Sensor being read.
+    volatile bool busy;                     //!< Transfer in progress.
+    uint8_t raw_data[NPA_FRAME_LEN_HIRES];  //!< Transfer buffer.
+    uint32_t start_us;                      //!< Start time for statistics.
+};
+
+/**
+ * @brief Initialize transfer state.
+ *
+ * @param[out] transfer Transfer to initialize.
+ * @return @ref npa_ret_t.
+ */
+npa_ret_t npa_async_init (npa_async_t * const transfer);
+
+/**
+ * @brief Start reading a sensor.
+ *
+ * @param[in]     sensor   Sensor to read.
+ * @param[in,out] transfer Transfer state, must stay valid until completed.
+ * @retval NPA_SUCCESS   Transfer was started.
+ * @retval NPA_ERR_NULL  Sensor, transfer or function pointer of sensor is NULL.
+ * @retval NPA_ERR_PARAM Frame length of sensor is invalid.
+ * @retval NPA_ERR_BUSY  Previous transfer has not completed.
+ * @return Error code returned by read function of sensor.
+ */
+npa_ret_t npa_read_start (const npa_async_ctx_t * const sensor,
+                          npa_async_t * const transfer);
+
+/**
+ * @brief Complete a transfer.
+ *
+ * Decodes the received frame and calls callback of the sensor. Safe to call from
+ * interrupt context.
+ *
+ * @param[in,out] transfer        Transfer which has finished.
+ * @param[in]     transfer_status Result of I2C transfer, @ref npa_ret_t.
+ */
+void npa_read_complete (npa_async_t * const transfer, const npa_ret_t transfer_status);
+
+/**
+ * @brief Check if a transfer is in progress.
+ *
+ * @param[in] transfer Transfer to check.
+ * @return true if transfer has been started and not yet completed.
+ */
+bool npa_read_busy (const npa_async_t * const transfer);
+
+/** @} */
+#endif // NPA_700_ASYNC_H
@@ -0,0 +1,177 @@
+#ifndef NPA_700_ATOMIC_H
+#define NPA_700_ATOMIC_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_atomic.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Minimal 32-bit atomics shared between interrupt and thread contexts.
+ *
+ * Uses C11 atomics when available. Otherwise falls back to volatile accesses and a
+ * full compiler/memory barrier, which is sufficient for aligned 32-bit loads and
+ * stores on single core microcontrollers. The barrier is __sync_synchronize on GCC
+ * compatible compilers; other compilers must define NPA_ATOMIC_BARRIER() as a full
+ * barrier, e.g. __DMB() of CMSIS, or the build fails.
+ *
+ * A group of values with a single writer is published with a sequence lock. Writer
+ * makes sequence odd, updates the values and makes sequence even again. Reader copies
+ * the values and accepts the copy if sequence was the same even value before and
+ * after, otherwise retries up to @ref NPA_SEQLOCK_TRIES times. Values are atomic so
+ * that a copy racing with the writer is only discarded, never undefined.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define NPA_SEQLOCK_TRIES (16U) //!< Attempts of a reader to get a consistent copy.
+
+#if defined (__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) \
+    && !defined (__STDC_NO_ATOMICS__) && !defined (NPA_NO_C11_ATOMICS)
+
+#include <stdatomic.h>
+
+typedef _Atomic uint32_t npa_atomic_u32_t; //!< 32-bit value shared between contexts.
+
+static inline uint32_t npa_atomic_load_acquire (const npa_atomic_u32_t * const value)
+{
+    return atomic_load_explicit (value, memory_order_acquire);
+}
+
+static inline uint32_t npa_atomic_load_relaxed (const npa_atomic_u32_t * const value)
+{
+    return atomic_load_explicit (value, memory_order_relaxed);
+}
+
+static inline void npa_atomic_store_release (npa_atomic_u32_t * const value,
+        const uint32_t new_value)
+{
+    atomic_store_explicit (value, new_value, memory_order_release);
+}
+
+static inline void npa_atomic_store_relaxed (npa_atomic_u32_t * const value,
+        const uint32_t new_value)
+{
+    atomic_store_explicit (value, new_value, memory_order_relaxed);
+}
+
+static inline void npa_atomic_fence (void)
+{
+    atomic_thread_fence (memory_order_seq_cst);
+}
+
+#else
+
+typedef volatile uint32_t npa_atomic_u32_t; //!< 32-bit value shared between contexts.
+
+#if defined (NPA_ATOMIC_BARRIER)
+// Barrier supplied by user.
+#elif defined (__GNUC__)
+#define NPA_ATOMIC_BARRIER() __sync_synchronize() //!< Full compiler/memory barrier.
+#else
+#error "Define NPA_ATOMIC_BARRIER() as a full memory barrier for this compiler."
+#endif
+
+static inline void npa_atomic_fence (void)
+{
+    NPA_ATOMIC_BARRIER();
+}
+
+static inline uint32_t npa_atomic_load_acquire (const npa_atomic_u32_t * const value)
+{
+    const uint32_t loaded = *value;
+    npa_atomic_fence();
+    return loaded;
+}
+
+static inline uint32_t npa_atomic_load_relaxed (const npa_atomic_u32_t * const value)
+{
+    return *value;
+}
+
+static inline void npa_atomic_store_release (npa_atomic_u32_t * const value,
+        const uint32_t new_value)
+{
+    npa_atomic_fence();
+    *value = new_value;
+}
+
+static inline void npa_atomic_store_relaxed (npa_atomic_u32_t * const value,
+        const uint32_t new_value)
+{
+    *value = new_value;
+}
+
+#endif
+
+/**
+ * @brief Add to a value which only the calling context stores to.
+ *
+ * Load and store need not be one operation, readers see either value.
+ */
+static inline void npa_atomic_add_single (npa_atomic_u32_t * const value,
+        const uint32_t addend)
+{
+    npa_atomic_store_relaxed (value, npa_atomic_load_relaxed (value) + addend);
+}
+
+/**
+ * @brief Start an update of values behind a sequence lock. Single writer only.
+ *
+ * @param[in,out] sequence Sequence of lock, odd during update.
+ * @return Sequence before update, give to @ref npa_seqlock_write_end.
+ */
+static inline uint32_t npa_seqlock_write_begin (npa_atomic_u32_t * const sequence)
+{
+    const uint32_t before = npa_atomic_load_relaxed (sequence);
+    npa_atomic_store_relaxed (sequence, before + 1U);
+    // Odd sequence must be visible before any value changes.
+    npa_atomic_fence();
+    return before;
+}
+
+/**
+ * @brief Publish values updated after @ref npa_seqlock_write_begin.
+ *
+ * @param[in,out] sequence Sequence of lock.
+ * @param[in]     before   Return value of @ref npa_seqlock_write_begin.
+ */
+static inline void npa_seqlock_write_end (npa_atomic_u32_t * const sequence,
+        const uint32_t before)
+{
+    npa_atomic_store_release (sequence, before + 2U);
+}
+
+/**
+ * @brief Start a copy of values behind a sequence lock.
+ *
+ * @param[in] sequence Sequence of lock.
+ * @return Sequence before copy, give to @ref npa_seqlock_read_valid.
+ */
+static inline uint32_t npa_seqlock_read_begin (const npa_atomic_u32_t * const sequence)
+{
+    return npa_atomic_load_acquire (sequence);
+}
+
+/**
+ * @brief Check a copy of values made after @ref npa_seqlock_read_begin.
+ *
+ * @param[in] sequence Sequence of lock.
+ * @param[in] before   Return value of @ref npa_seqlock_read_begin.
+ * @return true if copy is consistent, false if it must be retried.
+ */
+static inline bool npa_seqlock_read_valid (const npa_atomic_u32_t * const sequence,
+        const uint32_t before)
+{
+    // Value loads must complete before sequence is checked again.
+    npa_atomic_fence();
+    return (0U == (before & 1U)) && (before == npa_atomic_load_relaxed (sequence));
+}
+
+/** @} */
+#endif // NPA_700_ATOMIC_H
@@ -0,0 +1,156 @@
+#include "npa_700_breath.h"
+
+#include <string.h>
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_breath.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * Volumes are accumulated as flow * microseconds in 64 bits and scaled to volume
+ * units only when read, so there is no rounding error per sample.
+ */
+
+#define NPA_BREATH_US_PER_S (1000000) //!< Microseconds per second.
+
+npa_ret_t npa_breath_init (npa_breath_t * const breath,
+                           const npa_breath_cfg_t * const cfg)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == breath) || (NULL == cfg) || (NULL == cfg->callback))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (0U == cfg->sample_period_us) || (0 >= cfg->insp_threshold)
+              || (0 >= cfg->exp_threshold))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        memset (breath, 0, sizeof (npa_breath_t));
+        breath->cfg = *cfg;
+        breath->phase = NPA_BREATH_WAIT;
+    }
+
+    return ret_code;
+}
+
+static int32_t to_volume (const int64_t flow_us)
+{
+    // Round half away from zero, volumes are non-negative.
+    return (int32_t) ( (flow_us + (NPA_BREATH_US_PER_S / 2)) / NPA_BREATH_US_PER_S);
+}
+
+static void close_breath (npa_breath_t * const breath)
+{
+    npa_breath_summary_t summary;
+    summary.start_sample = breath->breath_start;
+    summary.breath_time_us = (breath->sample - breath->breath_start)
+                             * breath->cfg.sample_period_us;
+    summary.insp_time_us = breath->insp_samples * breath->cfg.sample_period_us;
+    summary.inhaled = to_volume (breath->inhaled);
+    summary.exhaled = to_volume (breath->exhaled);
+    summary.pip_pa = breath->pip_pa;
+    summary.peep_pa = breath->last_pressure_pa;
+    breath->cfg.callback (&summary, breath->cfg.p_context);
+}
+
+static void start_breath (npa_breath_t * const breath, const float pressure_pa)
+{
+    breath->phase = NPA_BREATH_INSPIRATION;
+    breath->phase_samples = 0U;
+    breath->breath_start = breath->sample;
+    breath->insp_samples = 0U;
+    breath->inhaled = 0;
+    breath->exhaled = 0;
+    breath->pip_pa = pressure_pa;
+}
+
+void npa_breath_push (npa_breath_t * const breath, const int32_t flow,
+                      const float pressure_pa, const npa_ret_t status)
+{
+    if ( (NULL != breath) && (NULL != breath->cfg.callback)
+            && (0U == (status & NPA_ERR_FATAL)))
+    {
+        const bool phase_done = breath->phase_samples >= breath->cfg.min_phase_samples;
+
+        switch (breath->phase)
+        {
+            case NPA_BREATH_WAIT:
+                if (flow > breath->cfg.insp_threshold)
+                {
+                    start_breath (breath, pressure_pa);
+                }
+
+                break;
+
+            case NPA_BREATH_INSPIRATION:
+                if (phase_done && (flow < -breath->cfg.exp_threshold))
+                {
+                    breath->phase = NPA_BREATH_EXPIRATION;
+                    breath->phase_samples = 0U;
+                    breath->insp_samples = breath->sample - breath->breath_start;
+                }
+
+                break;
+
+            default:
+                if (phase_done && (flow > breath->cfg.insp_threshold))
+                {
+                    close_breath (breath);
+                    start_breath (breath, pressure_pa);
+                }
+
+                break;
+        }
+
+        if (NPA_BREATH_WAIT != breath->phase)
+        {
+            const int64_t flow_us = (int64_t) flow * breath->cfg.sample_period_us;
+
+            if (flow_us > 0)
+            {
+                breath->inhaled += flow_us;
+            }
+            else
+            {
+                breath->exhaled -= flow_us;
+            }
+
+            if (pressure_pa > breath->pip_pa)
+            {
+                breath->pip_pa = pressure_pa;
+            }
+
+            breath->phase_samples++;
+        }
+
+        breath->last_pressure_pa = pressure_pa;
+    }
+
+    if (NULL != breath)
+    {
+        breath->sample++;
+    }
+}
+
+int32_t npa_breath_volume (const npa_breath_t * const breath)
+{
+    int32_t volume = 0;
+
+    if (NULL != breath)
+    {
+        volume = to_volume (breath->inhaled) - to_volume (breath->exhaled);
+    }
+
+    return volume;
+}
+
+/** @} */
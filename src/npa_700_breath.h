@@ -0,0 +1,125 @@
+#ifndef NPA_700_BREATH_H
+#define NPA_700_BREATH_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_breath.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Incremental breath analysis from flow and airway pressure.
+ *
+ * Analyzer is fed one sample at a time at a fixed sample period, with flow e.g. from
+ * @ref npa_flow_convert and airway pressure from @ref npa_read_pressure. Each sample
+ * takes constant time. Volumes are integrated in integer arithmetic.
+ *
+ * Inspiration starts when flow rises above inspiration threshold and expiration when
+ * flow falls below negative expiration threshold. Flow between the thresholds does
+ * not change phase, and a phase must last at least minimum phase samples before it
+ * can end. A breath is from start of one inspiration to start of the next, and its
+ * summary is passed to callback at the first sample of the next inspiration.
+ *
+ * Flow must be in volume units per second, e.g. calibrate flow element in uL/s to get
+ * volumes in uL.
+ */
+
+#include "npa_700.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief Phase of breath. */
+typedef enum
+{
+    NPA_BREATH_WAIT,        //!< Waiting for first inspiration.
+    NPA_BREATH_INSPIRATION, //!< Flow into patient.
+    NPA_BREATH_EXPIRATION   //!< Flow out of patient.
+} npa_breath_phase_t;
+
+/** @brief Summary of a completed breath. */
+typedef struct
+{
+    uint32_t start_sample;    //!< Index of first sample of inspiration.
+    uint32_t breath_time_us;  //!< Duration of breath.
+    uint32_t insp_time_us;    //!< Duration of inspiration.
+    int32_t inhaled;          //!< Volume of positive flow during breath.
+    int32_t exhaled;          //!< Volume of negative flow during breath, positive.
+    float pip_pa;             //!< Peak inspiratory pressure, maximum during breath.
+    float peep_pa;            //!< Positive end-expiratory pressure, last expiration sample.
+} npa_breath_summary_t;
+
+/**
+ * @brief Handle a completed breath.
+ *
+ * @param[in] summary   Summary of the breath.
+ * @param[in] p_context Context given in configuration.
+ */
+typedef void (*npa_breath_cb) (const npa_breath_summary_t * const summary,
+                               void * const p_context);
+
+/** @brief Configuration of breath analyzer. */
+typedef struct
+{
+    uint32_t sample_period_us;  //!< Time between samples, must be non-zero.
+    int32_t insp_threshold;     //!< Flow above which inspiration starts, positive.
+    int32_t exp_threshold;      //!< Flow below negative of which expiration starts.
+    uint32_t min_phase_samples; //!< Minimum length of phase.
+    npa_breath_cb callback;     //!< Summary handler, must not be NULL.
+    void * p_context;           //!< Application context, not used by analyzer.
+} npa_breath_cfg_t;
+
+/** @brief State of breath analyzer. Initialize with @ref npa_breath_init. */
+typedef struct
+{
+    npa_breath_cfg_t cfg;       //!< Configuration.
+    npa_breath_phase_t phase;   //!< Current phase.
+    uint32_t sample;            //!< Index of next sample.
+    uint32_t phase_samples;     //!< Samples in current phase.
+    uint32_t breath_start;      //!< Index of first sample of current breath.
+    uint32_t insp_samples;      //!< Samples of inspiration of current breath.
+    int64_t inhaled;            //!< Inhaled flow * us of current breath.
+    int64_t exhaled;            //!< Exhaled flow * us of current breath.
+    float pip_pa;               //!< Maximum pressure of current breath.
+    float last_pressure_pa;     //!< Pressure of previous valid sample.
+} npa_breath_t;
+
+/**
+ * @brief Initialize breath analyzer.
+ *
+ * @param[out] breath Analyzer to initialize.
+ * @param[in]  cfg    Configuration, copied to analyzer.
+ * @retval NPA_SUCCESS   Analyzer was initialized.
+ * @retval NPA_ERR_NULL  Analyzer, configuration or callback was NULL.
+ * @retval NPA_ERR_PARAM Sample period or thresholds are not positive.
+ */
+npa_ret_t npa_breath_init (npa_breath_t * const breath,
+                           const npa_breath_cfg_t * const cfg);
+
+/**
+ * @brief Feed one sample to analyzer.
+ *
+ * A sample with a fatal status is not used for detection or integration, but time
+ * still advances by one sample period.
+ *
+ * @param[in,out] breath      Analyzer.
+ * @param[in]     flow        Flow in volume units per second.
+ * @param[in]     pressure_pa Airway pressure.
+ * @param[in]     status      @ref npa_ret_t of the readings.
+ */
+void npa_breath_push (npa_breath_t * const breath, const int32_t flow,
+                      const float pressure_pa, const npa_ret_t status);
+
+/**
+ * @brief Net volume of current breath so far, inhaled minus exhaled.
+ *
+ * @param[in] breath Analyzer.
+ * @return Net volume, 0 before first inspiration.
+ */
+int32_t npa_breath_volume (const npa_breath_t * const breath);
+
+/** @} */
+#endif // NPA_700_BREATH_H
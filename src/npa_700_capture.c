@@ -0,0 +1,413 @@
+#include "npa_700_capture.h"
+
+#include <string.h>
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_capture.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * CRC-32 is the IEEE 802.3 polynomial, reflected, computed a nibble at a time from a
+ * 16-entry table to keep the code small on microcontrollers.
+ */
+
+#define NPA_CAPTURE_OFFSET_MAGIC    (0U)  //!< Offset of magic in header.
+#define NPA_CAPTURE_OFFSET_VERSION  (4U)  //!< Offset of version in header.
+#define NPA_CAPTURE_OFFSET_MODEL    (5U)  //!< Offset of model in header.
+#define NPA_CAPTURE_OFFSET_ADDR     (6U)  //!< Offset of address in header.
+#define NPA_CAPTURE_OFFSET_SIZE     (8U)  //!< Offset of block size in header.
+#define NPA_CAPTURE_OFFSET_COUNT    (10U) //!< Offset of record count in header.
+#define NPA_CAPTURE_OFFSET_PAYLOAD  (12U) //!< Offset of payload length in header.
+#define NPA_CAPTURE_OFFSET_INTERVAL (14U) //!< Offset of base interval in header.
+#define NPA_CAPTURE_OFFSET_SEQUENCE (16U) //!< Offset of sequence number in header.
+#define NPA_CAPTURE_OFFSET_TIME     (20U) //!< Offset of base timestamp in header.
+#define NPA_CAPTURE_OFFSET_COUNTS   (24U) //!< Offset of base counts in header.
+#define NPA_CAPTURE_OFFSET_TEMP     (26U) //!< Offset of base temperature in header.
+#define NPA_CAPTURE_OFFSET_CRC      (28U) //!< Offset of CRC in header.
+
+#define NPA_CAPTURE_TAG_STATUS_MASK (0x03U) //!< Status bits of tag.
+#define NPA_CAPTURE_TAG_LEN_SHIFT   (2U)    //!< Position of frame length in tag.
+#define NPA_CAPTURE_TAG_LEN_MASK    (0x03U) //!< Frame length bits of tag.
+#define NPA_CAPTURE_TAG_RESERVED    (0xF0U) //!< Bits of tag which must be 0.
+#define NPA_CAPTURE_VARINT_MAX      (5U)    //!< Longest varint of 32 bits.
+#define NPA_CAPTURE_PAD             (0xFFU) //!< Padding, erased flash.
+#define NPA_CAPTURE_MAX_INTERVAL    (0xFFFFU) //!< Largest interval in header.
+
+static const uint32_t m_crc_table[16U] =
+{
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+    0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+    0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+};
+
+uint32_t npa_capture_crc32 (const uint32_t crc, const uint8_t * const data,
+                            const size_t len)
+{
+    uint32_t state = ~crc;
+
+    for (size_t ii = 0U; ii < len; ii++)
+    {
+        state ^= data[ii];
+        state = (state >> 4U) ^ m_crc_table[state & 0x0FU];
+        state = (state >> 4U) ^ m_crc_table[state & 0x0FU];
+    }
+
+    return ~state;
+}
+
+static void put_u16 (uint8_t * const dst, const uint16_t value)
+{
+    dst[0U] = (uint8_t) (value & 0xFFU);
+    dst[1U] = (uint8_t) (value >> 8U);
+}
+
+static void put_u32 (uint8_t * const dst, const uint32_t value)
+{
+    put_u16 (dst, (uint16_t) (value & 0xFFFFU));
+    put_u16 (&dst[2U], (uint16_t) (value >> 16U));
+}
+
+static uint16_t get_u16 (const uint8_t * const src)
+{
+    return (uint16_t) (src[0U] | ( (uint16_t) src[1U] << 8U));
+}
+
+static uint32_t get_u32 (const uint8_t * const src)
+{
+    return get_u16 (src) | ( (uint32_t) get_u16 (&src[2U]) << 16U);
+}
+
+// Signed difference in two's complement to unsigned, small magnitudes stay small.
+static uint32_t zigzag (const uint32_t difference)
+{
+    return (difference << 1U) ^ (0U - (difference >> 31U));
+}
+
+static uint32_t unzigzag (const uint32_t value)
+{
+    return (value >> 1U) ^ (0U - (value & 1U));
+}
+
+static size_t put_varint (uint8_t * const dst, const uint32_t value)
+{
+    uint32_t rest = value;
+    size_t len = 0U;
+
+    while (0x80U <= rest)
+    {
+        dst[len] = (uint8_t) ( (rest & 0x7FU) | 0x80U);
+        rest >>= 7U;
+        len++;
+    }
+
+    dst[len] = (uint8_t) rest;
+    return len + 1U;
+}
+
+static bool get_varint (const uint8_t * const src, size_t * const pos, const size_t end,
+                        uint32_t * const value)
+{
+    uint32_t result = 0U;
+    bool done = false;
+
+    for (uint32_t ii = 0U; (!done) && (ii < NPA_CAPTURE_VARINT_MAX) && (*pos < end); ii++)
+    {
+        const uint8_t byte = src[*pos];
+        result |= (uint32_t) (byte & 0x7FU) << (7U * ii);
+        done = (0U == (byte & 0x80U));
+        (*pos)++;
+    }
+
+    *value = result;
+    return done;
+}
+
+npa_ret_t npa_capture_init (npa_capture_t * const capture,
+                            const npa_capture_cfg_t * const cfg)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == capture) || (NULL == cfg) || (NULL == cfg->buffer)
+            || (NULL == cfg->emit))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (NPA_CAPTURE_MIN_BLOCK > cfg->block_size)
+              || (NPA_CAPTURE_MAX_BLOCK < cfg->block_size))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        memset (capture, 0, sizeof (npa_capture_t));
+        capture->cfg = *cfg;
+        capture->block = cfg->buffer;
+        capture->used = NPA_CAPTURE_HEADER_LEN;
+    }
+
+    return ret_code;
+}
+
+/**
+ * @brief Pad, finish and emit current block, then start next one in other buffer.
+ *
+ * @param[in,out] capture Writer with at least one record in block.
+ */
+static void emit_block (npa_capture_t * const capture)
+{
+    uint8_t * const block = capture->block;
+    const size_t block_size = capture->cfg.block_size;
+    const size_t padding = block_size - capture->used;
+    memset (&block[capture->used], NPA_CAPTURE_PAD, padding);
+    uint32_t crc = npa_capture_crc32 (capture->crc, &block[capture->used], padding);
+    memset (block, 0, NPA_CAPTURE_HEADER_LEN);
+    put_u32 (&block[NPA_CAPTURE_OFFSET_MAGIC], NPA_CAPTURE_MAGIC);
+    block[NPA_CAPTURE_OFFSET_VERSION] = NPA_CAPTURE_VERSION;
+    block[NPA_CAPTURE_OFFSET_MODEL] = (uint8_t) capture->cfg.model;
+    block[NPA_CAPTURE_OFFSET_ADDR] = capture->cfg.addr;
+    put_u16 (&block[NPA_CAPTURE_OFFSET_SIZE], (uint16_t) block_size);
+    put_u16 (&block[NPA_CAPTURE_OFFSET_COUNT], capture->count);
+    put_u16 (&block[NPA_CAPTURE_OFFSET_PAYLOAD],
+             (uint16_t) (capture->used - NPA_CAPTURE_HEADER_LEN));
+    put_u16 (&block[NPA_CAPTURE_OFFSET_INTERVAL], (uint16_t) capture->base.interval);
+    put_u32 (&block[NPA_CAPTURE_OFFSET_SEQUENCE], capture->sequence);
+    put_u32 (&block[NPA_CAPTURE_OFFSET_TIME], capture->base.timestamp);
+    put_u16 (&block[NPA_CAPTURE_OFFSET_COUNTS], capture->base.counts);
+    put_u16 (&block[NPA_CAPTURE_OFFSET_TEMP], capture->base.temperature);
+    crc = npa_capture_crc32 (crc, block, NPA_CAPTURE_OFFSET_CRC);
+    put_u32 (&block[NPA_CAPTURE_OFFSET_CRC], crc);
+    capture->cfg.emit (block, block_size, capture->cfg.p_context);
+    capture->block = (block == capture->cfg.buffer) ? &capture->cfg.buffer[block_size]
+                     : capture->cfg.buffer;
+    capture->used = NPA_CAPTURE_HEADER_LEN;
+    capture->count = 0U;
+    capture->crc = 0U;
+    capture->sequence++;
+}
+
+npa_ret_t npa_capture_append (npa_capture_t * const capture, const uint32_t timestamp,
+                              const uint8_t * const raw_data, const uint8_t data_len)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == capture) || (NULL == raw_data))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (NPA_FRAME_LEN_PRES > data_len) || (NPA_FRAME_LEN_HIRES < data_len))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        const bool has_temperature = (NPA_FRAME_LEN_LOWRES <= data_len);
+        const uint16_t counts = (uint16_t) ( ( (uint16_t) (raw_data[0U] & 0x3FU) << 8U)
+                                             | raw_data[1U]);
+        uint16_t temperature = capture->delta.temperature;
+
+        if (has_temperature)
+        {
+            temperature = (uint16_t) ( (uint16_t) raw_data[2U] << 3U);
+
+            if (NPA_FRAME_LEN_HIRES == data_len)
+            {
+                temperature |= (uint16_t) (raw_data[3U] >> 5U);
+            }
+        }
+
+        if ( (capture->used + NPA_CAPTURE_MAX_RECORD) > capture->cfg.block_size)
+        {
+            emit_block (capture);
+        }
+
+        // First record of capture is its own base and encodes as zero deltas.
+        if (!capture->has_delta)
+        {
+            capture->delta.timestamp = timestamp;
+            capture->delta.interval = 0U;
+            capture->delta.counts = counts;
+            capture->delta.temperature = has_temperature ? temperature : 0U;
+            capture->has_delta = true;
+        }
+
+        // Delta state before block goes to header, interval saturated to fit.
+        if (0U == capture->count)
+        {
+            if (NPA_CAPTURE_MAX_INTERVAL < capture->delta.interval)
+            {
+                capture->delta.interval = NPA_CAPTURE_MAX_INTERVAL;
+            }
+
+            capture->base = capture->delta;
+        }
+
+        uint8_t * const record = &capture->block[capture->used];
+        const uint32_t interval = timestamp - capture->delta.timestamp;
+        size_t len = 0U;
+        record[len] = (uint8_t) ( (raw_data[0U] >> 6U)
+                                  | ( (uint32_t) (data_len - NPA_FRAME_LEN_PRES)
+                                      << NPA_CAPTURE_TAG_LEN_SHIFT));
+        len++;
+        len += put_varint (&record[len], zigzag (interval - capture->delta.interval));
+        len += put_varint (&record[len], zigzag ( (uint32_t) counts - capture->delta.counts));
+
+        if (has_temperature)
+        {
+            len += put_varint (&record[len],
+                               zigzag ( (uint32_t) temperature - capture->delta.temperature));
+            capture->delta.temperature = temperature;
+        }
+
+        capture->crc = npa_capture_crc32 (capture->crc, record, len);
+        capture->used += len;
+        capture->count++;
+        capture->delta.timestamp = timestamp;
+        capture->delta.interval = interval;
+        capture->delta.counts = counts;
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_capture_flush (npa_capture_t * const capture)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if (NULL == capture)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if (0U != capture->count)
+    {
+        emit_block (capture);
+    }
+    else
+    {
+        // Nothing to emit.
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_capture_open (npa_capture_reader_t * const reader,
+                            const uint8_t * const block, const size_t block_len)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == reader) || (NULL == block))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if (NPA_CAPTURE_HEADER_LEN > block_len)
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        const uint16_t block_size = get_u16 (&block[NPA_CAPTURE_OFFSET_SIZE]);
+        const uint16_t payload_len = get_u16 (&block[NPA_CAPTURE_OFFSET_PAYLOAD]);
+
+        if ( (NPA_CAPTURE_MAGIC != get_u32 (&block[NPA_CAPTURE_OFFSET_MAGIC]))
+                || (NPA_CAPTURE_VERSION != block[NPA_CAPTURE_OFFSET_VERSION])
+                || (NPA_CAPTURE_MIN_BLOCK > block_size) || (block_len < block_size)
+                || ( (block_size - NPA_CAPTURE_HEADER_LEN) < payload_len))
+        {
+            ret_code |= NPA_ERR_PARAM;
+        }
+        else
+        {
+            uint32_t crc = npa_capture_crc32 (0U, &block[NPA_CAPTURE_HEADER_LEN],
+                                              block_size - NPA_CAPTURE_HEADER_LEN);
+            crc = npa_capture_crc32 (crc, block, NPA_CAPTURE_OFFSET_CRC);
+
+            if (crc != get_u32 (&block[NPA_CAPTURE_OFFSET_CRC]))
+            {
+                ret_code |= NPA_ERR_FATAL;
+            }
+        }
+
+        if (NPA_SUCCESS == ret_code)
+        {
+            reader->header.model = (npa_variant_t) block[NPA_CAPTURE_OFFSET_MODEL];
+            reader->header.addr = block[NPA_CAPTURE_OFFSET_ADDR];
+            reader->header.block_size = block_size;
+            reader->header.count = get_u16 (&block[NPA_CAPTURE_OFFSET_COUNT]);
+            reader->header.payload_len = payload_len;
+            reader->header.sequence = get_u32 (&block[NPA_CAPTURE_OFFSET_SEQUENCE]);
+            reader->block = block;
+            reader->pos = NPA_CAPTURE_HEADER_LEN;
+            reader->remaining = reader->header.count;
+            reader->delta.timestamp = get_u32 (&block[NPA_CAPTURE_OFFSET_TIME]);
+            reader->delta.interval = get_u16 (&block[NPA_CAPTURE_OFFSET_INTERVAL]);
+            reader->delta.counts = get_u16 (&block[NPA_CAPTURE_OFFSET_COUNTS]);
+            reader->delta.temperature = get_u16 (&block[NPA_CAPTURE_OFFSET_TEMP]);
+        }
+    }
+
+    return ret_code;
+}
+
+bool npa_capture_next (npa_capture_reader_t * const reader,
+                       npa_capture_record_t * const record)
+{
+    bool valid = (NULL != reader) && (NULL != record) && (0U != reader->remaining);
+
+    if (valid)
+    {
+        const size_t end = NPA_CAPTURE_HEADER_LEN + reader->header.payload_len;
+        const uint8_t * const block = reader->block;
+        size_t pos = reader->pos;
+        uint32_t interval = 0U;
+        uint32_t counts = 0U;
+        uint32_t temperature = reader->delta.temperature;
+        const uint8_t tag = (pos < end) ? block[pos] : NPA_CAPTURE_PAD;
+        const uint8_t len_code = (tag >> NPA_CAPTURE_TAG_LEN_SHIFT) & NPA_CAPTURE_TAG_LEN_MASK;
+        pos++;
+        valid = (0U == (tag & NPA_CAPTURE_TAG_RESERVED))
+                && ( (NPA_FRAME_LEN_HIRES - NPA_FRAME_LEN_PRES) >= len_code)
+                && get_varint (block, &pos, end, &interval)
+                && get_varint (block, &pos, end, &counts);
+
+        if (valid && (0U != len_code))
+        {
+            valid = get_varint (block, &pos, end, &temperature);
+            temperature = reader->delta.temperature + unzigzag (temperature);
+        }
+
+        if (valid)
+        {
+            interval = reader->delta.interval + unzigzag (interval);
+            counts = reader->delta.counts + unzigzag (counts);
+            reader->delta.timestamp += interval;
+            reader->delta.interval = interval;
+            reader->delta.counts = (uint16_t) counts;
+            reader->delta.temperature = (uint16_t) temperature;
+            reader->pos = pos;
+            reader->remaining--;
+            record->timestamp = reader->delta.timestamp;
+            record->raw_len = (uint8_t) (len_code + NPA_FRAME_LEN_PRES);
+            memset (record->raw, 0, sizeof (record->raw));
+            record->raw[0U] = (uint8_t) ( ( (uint32_t) (tag & NPA_CAPTURE_TAG_STATUS_MASK) << 6U)
+                                          | ( (counts >> 8U) & 0x3FU));
+            record->raw[1U] = (uint8_t) (counts & 0xFFU);
+            record->raw[2U] = (0U != len_code) ? (uint8_t) ( (temperature >> 3U) & 0xFFU) : 0U;
+            record->raw[3U] = (NPA_FRAME_LEN_HIRES == record->raw_len)
+                              ? (uint8_t) ( (temperature & 0x07U) << 5U) : 0U;
+        }
+        else
+        {
+            // Corrupt record ends the block.
+            reader->remaining = 0U;
+        }
+    }
+
+    return valid;
+}
+
+/** @} */
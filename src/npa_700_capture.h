@@ -0,0 +1,217 @@
+#ifndef NPA_700_CAPTURE_H
+#define NPA_700_CAPTURE_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_capture.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Compact binary capture of raw frames.
+ *
+ * Writer packs frames of one sensor into fixed-size blocks which the application
+ * stores as they are, e.g. with one DMA transfer to flash. Each block starts with a
+ * header of model, address, sequence number and the delta state before its first
+ * record, and is protected by CRC-32. Blocks decode independently, so a corrupt block
+ * loses only its own frames. Delta state of the first block is its first record.
+ *
+ * Each record holds status bits, 14-bit pressure counts, temperature counts and
+ * timestamp. Counts and temperature are stored as deltas from the previous record,
+ * timestamp as delta of its interval, each as a zigzag varint. At a steady rate and
+ * slowly changing pressure a 2-byte frame takes 3 bytes and a 4-byte frame 4 bytes,
+ * against 6 and 8 bytes of frame and 32-bit timestamp. Reserved bits of the frame are
+ * not stored and decode as 0.
+ *
+ * Appends take constant time: record is encoded and added to a running CRC. When
+ * the block is full it is padded with 0xFF, finished and given to the emit callback.
+ * Writer alternates between two block buffers, so an emitted block stays untouched
+ * until the next one is emitted.
+ *
+ * Block layout, little-endian:
+ * | Offset | Size | Field                                    |
+ * |--------|------|------------------------------------------|
+ * | 0      | 4    | Magic, @ref NPA_CAPTURE_MAGIC            |
+ * | 4      | 1    | Version, @ref NPA_CAPTURE_VERSION        |
+ * | 5      | 1    | Model, @ref npa_variant_t                |
+ * | 6      | 1    | I2C address                              |
+ * | 7      | 1    | Reserved, 0                              |
+ * | 8      | 2    | Block size                               |
+ * | 10     | 2    | Number of records                        |
+ * | 12     | 2    | Length of payload                        |
+ * | 14     | 2    | Interval before block, saturated         |
+ * | 16     | 4    | Sequence number of block                 |
+ * | 20     | 4    | Timestamp before block                   |
+ * | 24     | 2    | Pressure counts before block             |
+ * | 26     | 2    | Temperature counts before block          |
+ * | 28     | 4    | CRC-32 of bytes 32 to end, then 0 to 28  |
+ * | 32     |      | Records, then 0xFF to end of block       |
+ *
+ * Record is a tag byte of status bits 0-1 and frame length - 2 in bits 2-3, then
+ * varints of timestamp, pressure and, for frames with temperature, temperature.
+ */
+
+#include "npa_700.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define NPA_CAPTURE_MAGIC      (0x4341504EUL) //!< "NPAC" in little-endian.
+#define NPA_CAPTURE_VERSION    (1U)           //!< Version of block layout.
+#define NPA_CAPTURE_HEADER_LEN (32U)          //!< Length of block header.
+#define NPA_CAPTURE_MAX_RECORD (11U)          //!< Longest encoded record.
+#define NPA_CAPTURE_MIN_BLOCK  (64U)          //!< Smallest block size.
+#define NPA_CAPTURE_MAX_BLOCK  (65535U)       //!< Largest block size.
+
+/**
+ * @brief Store a finished block.
+ *
+ * @param[in] block     Block, valid until next block is emitted.
+ * @param[in] block_len Length of block, block size of writer.
+ * @param[in] p_context Context given in configuration.
+ */
+typedef void (*npa_capture_emit_fp) (const uint8_t * const block, const size_t block_len,
+                                     void * const p_context);
+
+/** @brief Configuration of capture writer. */
+typedef struct
+{
+    uint8_t * buffer;         //!< Storage of two blocks, 2 * block_size bytes.
+    size_t block_size;        //!< Size of block, NPA_CAPTURE_MIN_BLOCK...MAX_BLOCK.
+    npa_variant_t model;      //!< Model of sensor.
+    uint8_t addr;             //!< I2C address of sensor.
+    npa_capture_emit_fp emit; //!< Called with each finished block.
+    void * p_context;         //!< Context of emit.
+} npa_capture_cfg_t;
+
+/** @brief Delta state of records, shared by writer and reader. */
+typedef struct
+{
+    uint32_t timestamp;   //!< Timestamp of previous record.
+    uint32_t interval;    //!< Interval before previous record.
+    uint16_t counts;      //!< Pressure counts of previous record.
+    uint16_t temperature; //!< Temperature counts of previous record with temperature.
+} npa_capture_delta_t;
+
+/** @brief Capture writer. Initialize with @ref npa_capture_init. */
+typedef struct
+{
+    npa_capture_cfg_t cfg;     //!< Configuration.
+    uint8_t * block;           //!< Block being filled.
+    size_t used;               //!< Bytes of block used, including header.
+    uint16_t count;            //!< Records in block.
+    uint32_t sequence;         //!< Sequence number of block being filled.
+    uint32_t crc;              //!< Running CRC of payload.
+    npa_capture_delta_t base;  //!< Delta state before first record of block.
+    npa_capture_delta_t delta; //!< Values of previous record.
+    bool has_delta;            //!< At least one record has been appended.
+} npa_capture_t;
+
+/** @brief Header of a block. */
+typedef struct
+{
+    npa_variant_t model;   //!< Model of sensor.
+    uint8_t addr;          //!< I2C address of sensor.
+    uint16_t block_size;   //!< Size of block.
+    uint16_t count;        //!< Number of records.
+    uint16_t payload_len;  //!< Length of records.
+    uint32_t sequence;     //!< Sequence number of block.
+} npa_capture_header_t;
+
+/** @brief Reader of records in a block. Open with @ref npa_capture_open. */
+typedef struct
+{
+    npa_capture_header_t header; //!< Header of block.
+    const uint8_t * block;       //!< Block being read.
+    size_t pos;                  //!< Offset of next record.
+    uint16_t remaining;          //!< Records left.
+    npa_capture_delta_t delta;   //!< Values of previous record.
+} npa_capture_reader_t;
+
+/** @brief Decoded record. */
+typedef struct
+{
+    uint32_t timestamp;                  //!< Timestamp given to append.
+    uint8_t raw[NPA_FRAME_LEN_HIRES];    //!< Frame, reserved bits as 0.
+    uint8_t raw_len;                     //!< Length of frame.
+} npa_capture_record_t;
+
+/**
+ * @brief Initialize capture writer.
+ *
+ * @param[out] capture Writer to initialize.
+ * @param[in]  cfg     Configuration, copied.
+ * @retval NPA_SUCCESS   Writer was initialized.
+ * @retval NPA_ERR_NULL  Writer, configuration, buffer or emit was NULL.
+ * @retval NPA_ERR_PARAM Block size is out of range.
+ */
+npa_ret_t npa_capture_init (npa_capture_t * const capture,
+                            const npa_capture_cfg_t * const cfg);
+
+/**
+ * @brief Append a frame.
+ *
+ * Emits the current block first if the record might not fit.
+ *
+ * @param[in,out] capture   Writer.
+ * @param[in]     timestamp Time of frame in application units, e.g. microseconds.
+ * @param[in]     raw_data  Frame as read from sensor.
+ * @param[in]     data_len  Length of frame, see @ref npa_parse_frame.
+ * @retval NPA_SUCCESS   Frame was appended.
+ * @retval NPA_ERR_NULL  Writer or frame was NULL.
+ * @retval NPA_ERR_PARAM Length of frame is invalid.
+ */
+npa_ret_t npa_capture_append (npa_capture_t * const capture, const uint32_t timestamp,
+                              const uint8_t * const raw_data, const uint8_t data_len);
+
+/**
+ * @brief Emit the current block if it has records.
+ *
+ * @param[in,out] capture Writer.
+ * @retval NPA_SUCCESS  Block was emitted or was empty.
+ * @retval NPA_ERR_NULL Writer was NULL.
+ */
+npa_ret_t npa_capture_flush (npa_capture_t * const capture);
+
+/**
+ * @brief Validate a block and start reading its records.
+ *
+ * @param[out] reader    Reader to open.
+ * @param[in]  block     Block, must stay valid while reading.
+ * @param[in]  block_len Available bytes, at least block size in header.
+ * @retval NPA_SUCCESS   Block is valid.
+ * @retval NPA_ERR_NULL  Reader or block was NULL.
+ * @retval NPA_ERR_PARAM Magic, version or sizes are invalid, or block_len is too
+ *                       short.
+ * @retval NPA_ERR_FATAL CRC does not match.
+ */
+npa_ret_t npa_capture_open (npa_capture_reader_t * const reader,
+                            const uint8_t * const block, const size_t block_len);
+
+/**
+ * @brief Decode next record of a block.
+ *
+ * @param[in,out] reader Reader.
+ * @param[out]    record Decoded record.
+ * @return true if a record was decoded, false at end of block or on corrupt record.
+ */
+bool npa_capture_next (npa_capture_reader_t * const reader,
+                       npa_capture_record_t * const record);
+
+/**
+ * @brief Compute CRC-32 as used in blocks, e.g. to chain captures.
+ *
+ * @param[in] crc  CRC so far, 0 to start.
+ * @param[in] data Data to add.
+ * @param[in] len  Length of data.
+ * @return CRC including data.
+ */
+uint32_t npa_capture_crc32 (const uint32_t crc, const uint8_t * const data,
+                            const size_t len);
+
+/** @} */
+#endif // NPA_700_CAPTURE_H
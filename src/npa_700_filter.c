@@ -0,0 +1,262 @@
+#include "npa_700_filter.h"
+
+#include <string.h>
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_filter.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * CIC integrators wrap around in 32 bits. Combs recover the exact sum as long as the
+ * true output fits in 32 bits, which is guaranteed by 16383 * ratio^order < 2^32.
+ */
+
+#define NPA_FILTER_MAX_COUNTS (0x3FFFU) //!< Largest 14-bit count.
+#define NPA_FILTER_FIR_SHIFT  (15U)     //!< Fractional bits of FIR taps.
+
+static uint32_t cic_gain (const uint16_t decimation, const uint8_t order)
+{
+    uint32_t gain = 1U;
+
+    for (uint8_t stage = 0U; stage < order; stage++)
+    {
+        if (gain > (NPA_FILTER_CIC_MAX_GAIN / decimation))
+        {
+            gain = 0U;
+            break;
+        }
+
+        gain *= decimation;
+    }
+
+    return gain;
+}
+
+npa_ret_t npa_filter_init (npa_filter_t * const filter,
+                           const npa_filter_cfg_t * const cfg)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == filter) || (NULL == cfg))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if (0U == cfg->decimation)
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        uint32_t gain = 1U;
+
+        switch (cfg->kernel)
+        {
+            case NPA_FILTER_BOXCAR:
+                gain = cfg->decimation;
+                break;
+
+            case NPA_FILTER_CIC:
+                if ( (0U == cfg->cic_order) || (NPA_FILTER_CIC_MAX_ORDER < cfg->cic_order))
+                {
+                    ret_code |= NPA_ERR_PARAM;
+                }
+                else
+                {
+                    gain = cic_gain (cfg->decimation, cfg->cic_order);
+                    ret_code |= (0U == gain) ? NPA_ERR_PARAM : NPA_SUCCESS;
+                }
+
+                break;
+
+            case NPA_FILTER_FIR:
+                if (NULL == cfg->fir_taps)
+                {
+                    ret_code |= NPA_ERR_NULL;
+                }
+                else if ( (0U == cfg->fir_len) || (NPA_FILTER_FIR_MAX_TAPS < cfg->fir_len))
+                {
+                    ret_code |= NPA_ERR_PARAM;
+                }
+                else
+                {
+                    // Gain is defined by taps.
+                }
+
+                break;
+
+            default:
+                ret_code |= NPA_ERR_PARAM;
+                break;
+        }
+
+        if (NPA_SUCCESS == ret_code)
+        {
+            filter->cfg = *cfg;
+            filter->gain = gain;
+            npa_filter_reset (filter);
+        }
+    }
+
+    return ret_code;
+}
+
+void npa_filter_reset (npa_filter_t * const filter)
+{
+    if (NULL != filter)
+    {
+        filter->phase = 0U;
+        filter->history_pos = 0U;
+        memset (filter->integrator, 0, sizeof (filter->integrator));
+        memset (filter->comb, 0, sizeof (filter->comb));
+        memset (filter->history, 0, sizeof (filter->history));
+    }
+}
+
+static uint16_t boxcar_output (npa_filter_t * const filter)
+{
+    const uint32_t sum = filter->integrator[0U];
+    filter->integrator[0U] = 0U;
+    return (uint16_t) ( (sum + (filter->gain / 2U)) / filter->gain);
+}
+
+static void cic_integrate (npa_filter_t * const filter, const uint16_t counts)
+{
+    uint32_t value = counts;
+
+    for (uint8_t stage = 0U; stage < filter->cfg.cic_order; stage++)
+    {
+        filter->integrator[stage] += value;
+        value = filter->integrator[stage];
+    }
+}
+
+static uint16_t cic_output (npa_filter_t * const filter)
+{
+    uint32_t value = filter->integrator[filter->cfg.cic_order - 1U];
+
+    for (uint8_t stage = 0U; stage < filter->cfg.cic_order; stage++)
+    {
+        const uint32_t delayed = filter->comb[stage];
+        filter->comb[stage] = value;
+        value -= delayed;
+    }
+
+    // Exact sum fits 32 bits, rounding add may not.
+    return (uint16_t) ( ( (uint64_t) value + (filter->gain / 2U)) / filter->gain);
+}
+
+static uint16_t fir_output (const npa_filter_t * const filter)
+{
+    const int16_t * const taps = filter->cfg.fir_taps;
+    const uint8_t len = filter->cfg.fir_len;
+    int64_t acc = 0;
+    uint8_t tap = 0U;
+
+    // History is circular, newest sample at history_pos. Walk back to start of
+    // buffer, then from end of buffer to avoid modulo per tap.
+    for (int32_t pos = filter->history_pos; pos >= 0; pos--)
+    {
+        acc += (int32_t) taps[tap] * (int32_t) filter->history[pos];
+        tap++;
+    }
+
+    for (int32_t pos = (int32_t) len - 1; tap < len; pos--)
+    {
+        acc += (int32_t) taps[tap] * (int32_t) filter->history[pos];
+        tap++;
+    }
+
+    acc += (int64_t) 1 << (NPA_FILTER_FIR_SHIFT - 1U);
+    int64_t output = (acc < 0) ? 0 : (acc >> NPA_FILTER_FIR_SHIFT);
+
+    if ( (int64_t) NPA_FILTER_MAX_COUNTS < output)
+    {
+        output = NPA_FILTER_MAX_COUNTS;
+    }
+
+    return (uint16_t) output;
+}
+
+bool npa_filter_push (npa_filter_t * const filter, const uint16_t counts,
+                      uint16_t * const output)
+{
+    bool produced = false;
+
+    if ( (NULL != filter) && (NULL != output) && (0U != filter->cfg.decimation))
+    {
+        const uint16_t sample = counts & NPA_FILTER_MAX_COUNTS;
+
+        switch (filter->cfg.kernel)
+        {
+            case NPA_FILTER_BOXCAR:
+                filter->integrator[0U] += sample;
+                break;
+
+            case NPA_FILTER_CIC:
+                cic_integrate (filter, sample);
+                break;
+
+            default:
+                filter->history_pos++;
+
+                if (filter->history_pos >= filter->cfg.fir_len)
+                {
+                    filter->history_pos = 0U;
+                }
+
+                filter->history[filter->history_pos] = sample;
+                break;
+        }
+
+        filter->phase++;
+
+        if (filter->phase >= filter->cfg.decimation)
+        {
+            filter->phase = 0U;
+            produced = true;
+
+            switch (filter->cfg.kernel)
+            {
+                case NPA_FILTER_BOXCAR:
+                    *output = boxcar_output (filter);
+                    break;
+
+                case NPA_FILTER_CIC:
+                    *output = cic_output (filter);
+                    break;
+
+                default:
+                    *output = fir_output (filter);
+                    break;
+            }
+        }
+    }
+
+    return produced;
+}
+
+size_t npa_filter_process (npa_filter_t * const filter, const uint16_t * const counts,
+                           const size_t num_counts, uint16_t * const output)
+{
+    size_t num_output = 0U;
+
+    if ( (NULL != counts) && (NULL != output))
+    {
+        for (size_t ii = 0U; ii < num_counts; ii++)
+        {
+            if (npa_filter_push (filter, counts[ii], &output[num_output]))
+            {
+                num_output++;
+            }
+        }
+    }
+
+    return num_output;
+}
+
+/** @} */
@@ -0,0 +1,111 @@
+#ifndef NPA_700_FILTER_H
+#define NPA_700_FILTER_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_filter.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Streaming oversampling and decimation filter.
+ *
+ * Filters 14-bit pressure counts in integer arithmetic and outputs one filtered
+ * sample per decimation ratio input samples. Output is rounded to counts, so it can
+ * be converted with e.g. @ref npa_convert_pa.
+ *
+ * Kernel         | Cost per input        | Notes
+ * ---------------|-----------------------|---------------------------------------
+ * Boxcar         | 1 add                 | Mean of decimation ratio samples.
+ * CIC            | order adds            | Order 1...4, ratio^order <= 2^18.
+ * FIR            | taps / ratio MACs     | Up to 32 Q15 taps, computed only at output.
+ */
+
+#include "npa_700.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define NPA_FILTER_CIC_MAX_ORDER (4U)         //!< Maximum number of CIC stages.
+#define NPA_FILTER_CIC_MAX_GAIN  (1UL << 18U) //!< Maximum ratio^order of CIC.
+#define NPA_FILTER_FIR_MAX_TAPS  (32U)        //!< Maximum number of FIR taps.
+#define NPA_FILTER_FIR_ONE       (32768)      //!< Unity gain of Q15 FIR tap.
+
+/** @brief Filter kernels. */
+typedef enum
+{
+    NPA_FILTER_BOXCAR, //!< Moving sum over each block of decimation ratio samples.
+    NPA_FILTER_CIC,    //!< Cascaded integrator-comb.
+    NPA_FILTER_FIR     //!< Finite impulse response evaluated at output rate.
+} npa_filter_kernel_t;
+
+/** @brief Filter configuration. */
+typedef struct
+{
+    npa_filter_kernel_t kernel; //!< Filter kernel.
+    uint16_t decimation;        //!< Input samples per output sample, at least 1.
+    uint8_t cic_order;          //!< Number of CIC stages, used by CIC kernel.
+    const int16_t * fir_taps;   //!< Q15 taps, newest sample first, used by FIR kernel.
+    uint8_t fir_len;            //!< Number of FIR taps.
+} npa_filter_cfg_t;
+
+/** @brief Filter state. Initialize with @ref npa_filter_init. */
+typedef struct
+{
+    npa_filter_cfg_t cfg;                          //!< Configuration.
+    uint32_t gain;                                 //!< DC gain of boxcar or CIC.
+    uint16_t phase;                                //!< Inputs since last output.
+    uint32_t integrator[NPA_FILTER_CIC_MAX_ORDER]; //!< Boxcar sum or CIC integrators.
+    uint32_t comb[NPA_FILTER_CIC_MAX_ORDER];       //!< CIC comb delays.
+    uint16_t history[NPA_FILTER_FIR_MAX_TAPS];     //!< FIR input history.
+    uint8_t history_pos;                           //!< Position of newest input.
+} npa_filter_t;
+
+/**
+ * @brief Initialize a filter.
+ *
+ * @param[out] filter Filter to initialize.
+ * @param[in]  cfg    Configuration, copied to filter. FIR taps are not copied.
+ * @retval NPA_SUCCESS   Filter was initialized.
+ * @retval NPA_ERR_NULL  Filter, configuration or taps of FIR filter was NULL.
+ * @retval NPA_ERR_PARAM Configuration is invalid.
+ */
+npa_ret_t npa_filter_init (npa_filter_t * const filter,
+                           const npa_filter_cfg_t * const cfg);
+
+/**
+ * @brief Clear state of a filter, keeping its configuration.
+ *
+ * @param[in,out] filter Filter to reset.
+ */
+void npa_filter_reset (npa_filter_t * const filter);
+
+/**
+ * @brief Push one sample through filter.
+ *
+ * @param[in,out] filter Filter.
+ * @param[in]     counts 14-bit pressure counts.
+ * @param[out]    output Filtered counts, written when function returns true.
+ * @return true if a decimated output was produced.
+ */
+bool npa_filter_push (npa_filter_t * const filter, const uint16_t counts,
+                      uint16_t * const output);
+
+/**
+ * @brief Push a block of samples through filter.
+ *
+ * @param[in,out] filter     Filter.
+ * @param[in]     counts     Input samples.
+ * @param[in]     num_counts Number of input samples.
+ * @param[out]    output     Filtered samples, room for num_counts / decimation + 1.
+ * @return Number of outputs written.
+ */
+size_t npa_filter_process (npa_filter_t * const filter, const uint16_t * const counts,
+                           const size_t num_counts, uint16_t * const output);
+
+/** @} */
+#endif // NPA_700_FILTER_H
@@ -0,0 +1,251 @@
+#include "npa_700_flow.h"
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_flow.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * Square root normalizes input by an even shift to m in [2^30, 2^32), interpolates
+ * sqrt(m) linearly from a table and shifts result back by half of the shift.
+ * Chord of a concave function lies below it, so interpolation error is always
+ * negative. On [1, 4) with step 1/32 the worst case is h^2 / 32 = 3.1e-5 at m = 2^30.
+ */
+
+#define NPA_FLOW_SQRT_SEGMENTS  (96U) //!< Segments of interpolation table.
+#define NPA_FLOW_SQRT_SEG_SHIFT (25U) //!< Width of segment, 2^25.
+#define NPA_FLOW_SQRT_FIRST     (32U) //!< Index of m = 2^30.
+#define NPA_FLOW_SQRT_FRAC_BITS (15U) //!< Interpolation resolution inside segment.
+
+/** @brief round (256 * sqrt ( (32 + i) * 2^25)). */
+static const uint32_t m_sqrt_table[NPA_FLOW_SQRT_SEGMENTS + 1U] =
+{
+    8388608U, 8518672U, 8646779U, 8773016U, 8897462U, 9020192U,
+    9141274U, 9260772U, 9378749U, 9495260U, 9610358U, 9724094U,
+    9836515U, 9947665U, 10057588U, 10166322U, 10273905U, 10380373U,
+    10485760U, 10590098U, 10693419U, 10795751U, 10897121U, 10997558U,
+    11097085U, 11195728U, 11293509U, 11390451U, 11486575U, 11581900U,
+    11676448U, 11770236U, 11863283U, 11955606U, 12047221U, 12138145U,
+    12228392U, 12317979U, 12406919U, 12495225U, 12582912U, 12669992U,
+    12756478U, 12842381U, 12927713U, 13012486U, 13096710U, 13180396U,
+    13263554U, 13346194U, 13428325U, 13509957U, 13591098U, 13671758U,
+    13751945U, 13831667U, 13910933U, 13989749U, 14068123U, 14146064U,
+    14223577U, 14300670U, 14377350U, 14453623U, 14529495U, 14604974U,
+    14680064U, 14754772U, 14829104U, 14903065U, 14976661U, 15049897U,
+    15122778U, 15195310U, 15267497U, 15339344U, 15410857U, 15482039U,
+    15552895U, 15623431U, 15693649U, 15763554U, 15833150U, 15902442U,
+    15971434U, 16040128U, 16108530U, 16176643U, 16244470U, 16312014U,
+    16379281U, 16446272U, 16512991U, 16579442U, 16645628U, 16711551U,
+    16777216U
+};
+
+static uint32_t leading_zeros (const uint32_t x)
+{
+#if defined(__GNUC__)
+    return (uint32_t) __builtin_clz (x);
+#else
+    uint32_t zeros = 0U;
+    uint32_t value = x;
+
+    for (uint32_t step = 16U; step > 0U; step /= 2U)
+    {
+        if (0U == (value >> (32U - step)))
+        {
+            zeros += step;
+            value <<= step;
+        }
+    }
+
+    return zeros;
+#endif
+}
+
+uint32_t npa_flow_sqrt_q8 (const uint32_t x)
+{
+    uint32_t root = 0U;
+
+    if (0U != x)
+    {
+        const uint32_t shift = leading_zeros (x) & ~1U;
+        const uint32_t m = x << shift;
+        const uint32_t index = (m >> NPA_FLOW_SQRT_SEG_SHIFT) - NPA_FLOW_SQRT_FIRST;
+        const uint32_t frac = (m >> (NPA_FLOW_SQRT_SEG_SHIFT - NPA_FLOW_SQRT_FRAC_BITS))
+                              & ( (1U << NPA_FLOW_SQRT_FRAC_BITS) - 1U);
+        const uint32_t base = m_sqrt_table[index];
+        const uint32_t delta = m_sqrt_table[index + 1U] - base;
+        root = base + ( (delta * frac) >> NPA_FLOW_SQRT_FRAC_BITS);
+        const uint32_t half_shift = shift / 2U;
+
+        if (0U != half_shift)
+        {
+            root = (root + (1U << (half_shift - 1U))) >> half_shift;
+        }
+    }
+
+    return root;
+}
+
+npa_ret_t npa_flow_init (npa_flow_t * const flow, const npa_flow_point_t * const points,
+                         const size_t num_points, const bool symmetric)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == flow) || (NULL == points))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (0U == num_points) || (NPA_FLOW_MAX_POINTS < num_points))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        for (size_t ii = 1U; ii < num_points; ii++)
+        {
+            if (points[ii].dp_mpa <= points[ii - 1U].dp_mpa)
+            {
+                ret_code |= NPA_ERR_PARAM;
+            }
+        }
+
+        if (NPA_SUCCESS == ret_code)
+        {
+            // Precompute slopes so that conversion does not need division.
+            for (size_t ii = 0U; ii < num_points; ii++)
+            {
+                flow->points[ii] = points[ii];
+                flow->slope[ii] = 0;
+
+                if ( (ii + 1U) < num_points)
+                {
+                    const int64_t dk = (int64_t) points[ii + 1U].k_q16
+                                       - (int64_t) points[ii].k_q16;
+                    const int64_t ddp = (int64_t) points[ii + 1U].dp_mpa
+                                        - (int64_t) points[ii].dp_mpa;
+                    flow->slope[ii] = (dk * 65536) / ddp;
+                }
+            }
+
+            flow->num_points = num_points;
+            flow->symmetric = symmetric;
+        }
+    }
+
+    return ret_code;
+}
+
+static uint32_t interpolate_k (const npa_flow_t * const flow, const int32_t dp_mpa)
+{
+    const npa_flow_point_t * const points = flow->points;
+    const size_t last = flow->num_points - 1U;
+    uint32_t k = 0U;
+
+    if (dp_mpa <= points[0U].dp_mpa)
+    {
+        k = points[0U].k_q16;
+    }
+    else if (dp_mpa >= points[last].dp_mpa)
+    {
+        k = points[last].k_q16;
+    }
+    else
+    {
+        // Binary search for segment with points[low] < dp <= points[low + 1].
+        size_t low = 0U;
+        size_t high = last;
+
+        while ( (high - low) > 1U)
+        {
+            const size_t mid = (low + high) / 2U;
+
+            if (points[mid].dp_mpa < dp_mpa)
+            {
+                low = mid;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+
+        const int64_t offset = (int64_t) dp_mpa - (int64_t) points[low].dp_mpa;
+        // Interpolated k lies between the two points, so it fits uint32_t.
+        k = (uint32_t) ( (int64_t) points[low].k_q16 + ( (flow->slope[low] * offset) / 65536));
+    }
+
+    return k;
+}
+
+static npa_ret_t convert (const npa_flow_t * const flow, const int32_t dp_mpa,
+                          int32_t * const q)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+    const uint32_t magnitude = (dp_mpa < 0) ? (0U - (uint32_t) dp_mpa) : (uint32_t) dp_mpa;
+    int32_t lookup = dp_mpa;
+
+    if (flow->symmetric)
+    {
+        lookup = ( (uint32_t) INT32_MAX < magnitude) ? INT32_MAX : (int32_t) magnitude;
+    }
+
+    const uint32_t k = interpolate_k (flow, lookup);
+    const uint64_t scaled = ( ( (uint64_t) k * npa_flow_sqrt_q8 (magnitude))
+                              + ( (uint64_t) 1U << (NPA_FLOW_K_FRAC_BITS + 7U)))
+                            >> (NPA_FLOW_K_FRAC_BITS + 8U);
+
+    if ( (uint64_t) INT32_MAX < scaled)
+    {
+        ret_code |= NPA_WARN_SAT;
+        *q = (dp_mpa < 0) ? -INT32_MAX : INT32_MAX;
+    }
+    else
+    {
+        *q = (dp_mpa < 0) ? - (int32_t) scaled : (int32_t) scaled;
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_flow_convert (const npa_flow_t * const flow, const int32_t dp_mpa,
+                            int32_t * const q)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == flow) || (NULL == q))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        ret_code |= convert (flow, dp_mpa, q);
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_flow_convert_batch (const npa_flow_t * const flow,
+                                  const int32_t * const dp_mpa,
+                                  const size_t num_items, int32_t * const q)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == flow) || (NULL == dp_mpa) || (NULL == q))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        for (size_t ii = 0U; ii < num_items; ii++)
+        {
+            ret_code |= convert (flow, dp_mpa[ii], &q[ii]);
+        }
+    }
+
+    return ret_code;
+}
+
+/** @} */
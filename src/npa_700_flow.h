@@ -0,0 +1,107 @@
+#ifndef NPA_700_FLOW_H
+#define NPA_700_FLOW_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_flow.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Differential pressure to flow conversion for orifice and venturi elements.
+ *
+ * Flow is Q = k(dP) * sign(dP) * sqrt(|dP|), where dP is in millipascals as returned
+ * by @ref npa_read_pressure_mpa and k is interpolated linearly from a per-element
+ * calibration table. Unit of flow is set by the calibration, e.g. mL/min.
+ *
+ * Conversion is integer only. Square root is interpolated from a 96-segment table,
+ * see @ref npa_flow_sqrt_q8 for tolerance.
+ */
+
+#include "npa_700.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define NPA_FLOW_MAX_POINTS (16U) //!< Maximum number of calibration points.
+#define NPA_FLOW_K_FRAC_BITS (16U) //!< Fractional bits of flow coefficient.
+
+/** @brief Calibration point of flow element. */
+typedef struct
+{
+    int32_t dp_mpa; //!< Differential pressure of point.
+    uint32_t k_q16; //!< Flow per sqrt(mPa) at point, Q16.16.
+} npa_flow_point_t;
+
+/** @brief Flow element. Initialize with @ref npa_flow_init. */
+typedef struct
+{
+    npa_flow_point_t points[NPA_FLOW_MAX_POINTS]; //!< Calibration, ascending pressure.
+    int64_t slope[NPA_FLOW_MAX_POINTS];           //!< Change of k per mPa, Q16.
+    size_t num_points;                            //!< Number of calibration points.
+    bool symmetric;                               //!< Look up k by |dP|.
+} npa_flow_t;
+
+/**
+ * @brief Square root in Q8 fixed point.
+ *
+ * Result is within 0.004 % + 1 LSB of 256 * sqrt(x) and never exceeds it by
+ * more than 1 LSB.
+ *
+ * @param[in] x Value to take square root of.
+ * @return 256 * sqrt(x).
+ */
+uint32_t npa_flow_sqrt_q8 (const uint32_t x);
+
+/**
+ * @brief Initialize flow element from calibration table.
+ *
+ * Coefficient k is interpolated linearly between points and held constant beyond
+ * first and last point. A single point gives a constant coefficient.
+ *
+ * @param[out] flow       Flow element to initialize.
+ * @param[in]  points     Calibration points in strictly ascending order of pressure,
+ *                        copied to element.
+ * @param[in]  num_points Number of points, 1 ... @ref NPA_FLOW_MAX_POINTS.
+ * @param[in]  symmetric  True to look up k by |dP|, calibration then covers only
+ *                        non-negative pressures. False to look up by signed dP for
+ *                        elements with different forward and reverse coefficients.
+ * @retval NPA_SUCCESS   Element was initialized.
+ * @retval NPA_ERR_NULL  Flow or points was NULL.
+ * @retval NPA_ERR_PARAM Number of points is invalid or points are not ascending.
+ */
+npa_ret_t npa_flow_init (npa_flow_t * const flow, const npa_flow_point_t * const points,
+                         const size_t num_points, const bool symmetric);
+
+/**
+ * @brief Convert differential pressure to flow.
+ *
+ * @param[in]  flow   Flow element.
+ * @param[in]  dp_mpa Differential pressure in millipascals.
+ * @param[out] q      Flow in calibration units.
+ * @retval NPA_SUCCESS  Flow was converted.
+ * @retval NPA_WARN_SAT Flow was out of range of int32_t and was clamped.
+ * @retval NPA_ERR_NULL Flow or q was NULL.
+ */
+npa_ret_t npa_flow_convert (const npa_flow_t * const flow, const int32_t dp_mpa,
+                            int32_t * const q);
+
+/**
+ * @brief Convert a batch of differential pressures to flow.
+ *
+ * @param[in]  flow      Flow element.
+ * @param[in]  dp_mpa    Differential pressures in millipascals.
+ * @param[in]  num_items Number of pressures.
+ * @param[out] q         Flows in calibration units, may alias dp_mpa.
+ * @return Combined @ref npa_ret_t of all conversions.
+ */
+npa_ret_t npa_flow_convert_batch (const npa_flow_t * const flow,
+                                  const int32_t * const dp_mpa,
+                                  const size_t num_items, int32_t * const q);
+
+/** @} */
+#endif // NPA_700_FLOW_H
@@ -0,0 +1,488 @@
+#include "npa_700_frames.h"
+
+#if defined (NPA_NO_SIMD)
+// Scalar kernel only.
+#elif defined (__AVX2__)
+#define NPA_FRAMES_AVX2 (1)
+#include <immintrin.h>
+#elif defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define NPA_FRAMES_SSE2 (1)
+#include <emmintrin.h>
+#elif defined (__ARM_NEON)
+#define NPA_FRAMES_NEON (1)
+#include <arm_neon.h>
+#endif
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_frames.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * Every kernel computes pressure as a float multiply followed by a float add of
+ * the same gain and offset as @ref npa_decode_frame. Counts are below 2^14, so the
+ * conversion to float is exact and results are bit-exact across kernels. Status
+ * codes all fit in 8 bits, which lets kernels build them in narrow lanes.
+ */
+
+#define NPA_FRAMES_STATE_SHIFT (6U)     //!< Status bits in first byte of frame.
+#define NPA_FRAMES_COUNT_MASK  (0x3FFFU) //!< Pressure bits in first two bytes.
+
+/** @brief Status code of 2 status bits of frame, same as parse_status in driver. */
+static const npa_ret_t m_state_code[4U] =
+{
+    NPA_SUCCESS, NPA_ERR_MODE, NPA_WARN_OLD, NPA_ERR_FATAL
+};
+
+/**
+ * @brief Decode frames one at a time.
+ *
+ * @return Bitwise OR of status of decoded frames.
+ */
+static npa_ret_t decode_scalar (const uint8_t * const raw_data, const uint8_t data_len,
+                                const size_t num_frames, const float gain,
+                                const float offset, float * const pressure_pa,
+                                npa_ret_t * const status)
+{
+    npa_ret_t status_all = NPA_SUCCESS;
+
+    for (size_t ii = 0U; ii < num_frames; ii++)
+    {
+        const uint8_t * const frame = &raw_data[ii * data_len];
+        const uint16_t counts = (uint16_t) ( ( ( (uint32_t) frame[0U] << 8U)
+                                               | (uint32_t) frame[1U])
+                                             & NPA_FRAMES_COUNT_MASK);
+        npa_ret_t code = m_state_code[frame[0U] >> NPA_FRAMES_STATE_SHIFT];
+
+        if ( (NPA_PRES_MIN_NONSAT > counts) || (NPA_PRES_MAX_NONSAT < counts))
+        {
+            code |= NPA_WARN_SAT;
+        }
+
+        pressure_pa[ii] = ( (float) counts * gain) + offset;
+        status[ii] = code;
+        status_all |= code;
+    }
+
+    return status_all;
+}
+
+#if defined (NPA_FRAMES_AVX2)
+
+#define NPA_FRAMES_VECTOR (16U) //!< Frames per vector iteration.
+
+/**
+ * @brief Convert 16 frames given as 16-bit counts and state.
+ *
+ * @param[in]     counts      Pressure counts in 16-bit lanes.
+ * @param[in]     state       Status bits in 16-bit lanes.
+ * @param[in,out] status_all  Bitwise OR of status codes.
+ */
+static void finish_avx2 (const __m256i counts, const __m256i state, const __m256 gain,
+                         const __m256 offset, float * const pressure_pa,
+                         npa_ret_t * const status, __m256i * const status_all)
+{
+    const __m256i sat = _mm256_or_si256 (
+                            _mm256_cmpgt_epi16 (_mm256_set1_epi16 (NPA_PRES_MIN_NONSAT),
+                                    counts),
+                            _mm256_cmpgt_epi16 (counts, _mm256_set1_epi16 (NPA_PRES_MAX_NONSAT)));
+    __m256i code = _mm256_and_si256 (sat, _mm256_set1_epi16 (NPA_WARN_SAT));
+    code = _mm256_or_si256 (code,
+                            _mm256_and_si256 (_mm256_cmpeq_epi16 (state, _mm256_set1_epi16 (1)),
+                                    _mm256_set1_epi16 (NPA_ERR_MODE)));
+    code = _mm256_or_si256 (code,
+                            _mm256_and_si256 (_mm256_cmpeq_epi16 (state, _mm256_set1_epi16 (2)),
+                                    _mm256_set1_epi16 (NPA_WARN_OLD)));
+    code = _mm256_or_si256 (code,
+                            _mm256_and_si256 (_mm256_cmpeq_epi16 (state, _mm256_set1_epi16 (3)),
+                                    _mm256_set1_epi16 (NPA_ERR_FATAL)));
+    *status_all = _mm256_or_si256 (*status_all, code);
+    const __m256i counts_lo = _mm256_cvtepu16_epi32 (_mm256_castsi256_si128 (counts));
+    const __m256i counts_hi = _mm256_cvtepu16_epi32 (_mm256_extracti128_si256 (counts, 1));
+    _mm256_storeu_si256 ( (__m256i *) &status[0U],
+                          _mm256_cvtepu16_epi32 (_mm256_castsi256_si128 (code)));
+    _mm256_storeu_si256 ( (__m256i *) &status[8U],
+                          _mm256_cvtepu16_epi32 (_mm256_extracti128_si256 (code, 1)));
+    _mm256_storeu_ps (&pressure_pa[0U],
+                      _mm256_add_ps (_mm256_mul_ps (_mm256_cvtepi32_ps (counts_lo), gain), offset));
+    _mm256_storeu_ps (&pressure_pa[8U],
+                      _mm256_add_ps (_mm256_mul_ps (_mm256_cvtepi32_ps (counts_hi), gain), offset));
+}
+
+/**
+ * @brief Swap bytes of first 16 bits of each 32-bit frame, leaving value in 32 bits.
+ */
+static __m256i frame_word_avx2 (const uint8_t * const frames)
+{
+    const __m256i raw = _mm256_loadu_si256 ( (const __m256i *) frames);
+    const __m256i byte_mask = _mm256_set1_epi32 (0xFF);
+    return _mm256_or_si256 (_mm256_slli_epi32 (_mm256_and_si256 (raw, byte_mask), 8),
+                            _mm256_and_si256 (_mm256_srli_epi32 (raw, 8), byte_mask));
+}
+
+static size_t decode_vector (const uint8_t * const raw_data, const uint8_t data_len,
+                             const size_t num_frames, const float gain,
+                             const float offset, float * const pressure_pa,
+                             npa_ret_t * const status, npa_ret_t * const status_all)
+{
+    const __m256 gain_v = _mm256_set1_ps (gain);
+    const __m256 offset_v = _mm256_set1_ps (offset);
+    const __m256i count_mask = _mm256_set1_epi16 (NPA_FRAMES_COUNT_MASK);
+    __m256i all = _mm256_setzero_si256();
+    size_t ii = 0U;
+
+    if (NPA_FRAME_LEN_PRES == data_len)
+    {
+        for (; (ii + NPA_FRAMES_VECTOR) <= num_frames; ii += NPA_FRAMES_VECTOR)
+        {
+            const __m256i raw = _mm256_loadu_si256 ( (const __m256i *) &raw_data[ii * 2U]);
+            // Frames are big-endian.
+            const __m256i word = _mm256_or_si256 (_mm256_slli_epi16 (raw, 8),
+                                                  _mm256_srli_epi16 (raw, 8));
+            finish_avx2 (_mm256_and_si256 (word, count_mask), _mm256_srli_epi16 (word, 14),
+                         gain_v, offset_v, &pressure_pa[ii], &status[ii], &all);
+        }
+    }
+    else if (NPA_FRAME_LEN_HIRES == data_len)
+    {
+        const __m256i count_mask32 = _mm256_set1_epi32 (NPA_FRAMES_COUNT_MASK);
+
+        for (; (ii + NPA_FRAMES_VECTOR) <= num_frames; ii += NPA_FRAMES_VECTOR)
+        {
+            const __m256i word_a = frame_word_avx2 (&raw_data[ii * 4U]);
+            const __m256i word_b = frame_word_avx2 (&raw_data[ (ii * 4U) + 32U]);
+            // Values are below 2^14, signed pack is exact. Pack works within 128-bit
+            // lanes, permute restores frame order.
+            const __m256i counts = _mm256_permute4x64_epi64 (
+                                       _mm256_packs_epi32 (_mm256_and_si256 (word_a, count_mask32),
+                                               _mm256_and_si256 (word_b, count_mask32)), 0xD8);
+            const __m256i state = _mm256_permute4x64_epi64 (
+                                      _mm256_packs_epi32 (_mm256_srli_epi32 (word_a, 14),
+                                              _mm256_srli_epi32 (word_b, 14)), 0xD8);
+            finish_avx2 (counts, state, gain_v, offset_v, &pressure_pa[ii], &status[ii], &all);
+        }
+    }
+    else
+    {
+        // 3-byte frames are decoded by scalar kernel.
+    }
+
+    uint16_t lanes[16U];
+    _mm256_storeu_si256 ( (__m256i *) lanes, all);
+
+    for (size_t lane = 0U; lane < 16U; lane++)
+    {
+        *status_all |= lanes[lane];
+    }
+
+    return ii;
+}
+
+#elif defined (NPA_FRAMES_SSE2)
+
+#define NPA_FRAMES_VECTOR (8U) //!< Frames per vector iteration.
+
+/**
+ * @brief Convert 8 frames given as 16-bit counts and state.
+ *
+ * @param[in]     counts      Pressure counts in 16-bit lanes.
+ * @param[in]     state       Status bits in 16-bit lanes.
+ * @param[in,out] status_all  Bitwise OR of status codes.
+ */
+static void finish_sse2 (const __m128i counts, const __m128i state, const __m128 gain,
+                         const __m128 offset, float * const pressure_pa,
+                         npa_ret_t * const status, __m128i * const status_all)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i sat = _mm_or_si128 (
+                            _mm_cmplt_epi16 (counts, _mm_set1_epi16 (NPA_PRES_MIN_NONSAT)),
+                            _mm_cmpgt_epi16 (counts, _mm_set1_epi16 (NPA_PRES_MAX_NONSAT)));
+    __m128i code = _mm_and_si128 (sat, _mm_set1_epi16 (NPA_WARN_SAT));
+    code = _mm_or_si128 (code, _mm_and_si128 (_mm_cmpeq_epi16 (state, _mm_set1_epi16 (1)),
+                         _mm_set1_epi16 (NPA_ERR_MODE)));
+    code = _mm_or_si128 (code, _mm_and_si128 (_mm_cmpeq_epi16 (state, _mm_set1_epi16 (2)),
+                         _mm_set1_epi16 (NPA_WARN_OLD)));
+    code = _mm_or_si128 (code, _mm_and_si128 (_mm_cmpeq_epi16 (state, _mm_set1_epi16 (3)),
+                         _mm_set1_epi16 (NPA_ERR_FATAL)));
+    *status_all = _mm_or_si128 (*status_all, code);
+    _mm_storeu_si128 ( (__m128i *) &status[0U], _mm_unpacklo_epi16 (code, zero));
+    _mm_storeu_si128 ( (__m128i *) &status[4U], _mm_unpackhi_epi16 (code, zero));
+    const __m128 counts_lo = _mm_cvtepi32_ps (_mm_unpacklo_epi16 (counts, zero));
+    const __m128 counts_hi = _mm_cvtepi32_ps (_mm_unpackhi_epi16 (counts, zero));
+    _mm_storeu_ps (&pressure_pa[0U], _mm_add_ps (_mm_mul_ps (counts_lo, gain), offset));
+    _mm_storeu_ps (&pressure_pa[4U], _mm_add_ps (_mm_mul_ps (counts_hi, gain), offset));
+}
+
+/**
+ * @brief Swap bytes of first 16 bits of each 32-bit frame, leaving value in 32 bits.
+ */
+static __m128i frame_word_sse2 (const uint8_t * const frames)
+{
+    const __m128i raw = _mm_loadu_si128 ( (const __m128i *) frames);
+    const __m128i byte_mask = _mm_set1_epi32 (0xFF);
+    return _mm_or_si128 (_mm_slli_epi32 (_mm_and_si128 (raw, byte_mask), 8),
+                         _mm_and_si128 (_mm_srli_epi32 (raw, 8), byte_mask));
+}
+
+static size_t decode_vector (const uint8_t * const raw_data, const uint8_t data_len,
+                             const size_t num_frames, const float gain,
+                             const float offset, float * const pressure_pa,
+                             npa_ret_t * const status, npa_ret_t * const status_all)
+{
+    const __m128 gain_v = _mm_set1_ps (gain);
+    const __m128 offset_v = _mm_set1_ps (offset);
+    const __m128i count_mask = _mm_set1_epi16 (NPA_FRAMES_COUNT_MASK);
+    __m128i all = _mm_setzero_si128();
+    size_t ii = 0U;
+
+    if (NPA_FRAME_LEN_PRES == data_len)
+    {
+        for (; (ii + NPA_FRAMES_VECTOR) <= num_frames; ii += NPA_FRAMES_VECTOR)
+        {
+            const __m128i raw = _mm_loadu_si128 ( (const __m128i *) &raw_data[ii * 2U]);
+            // Frames are big-endian.
+            const __m128i word = _mm_or_si128 (_mm_slli_epi16 (raw, 8), _mm_srli_epi16 (raw, 8));
+            finish_sse2 (_mm_and_si128 (word, count_mask), _mm_srli_epi16 (word, 14),
+                         gain_v, offset_v, &pressure_pa[ii], &status[ii], &all);
+        }
+    }
+    else if (NPA_FRAME_LEN_HIRES == data_len)
+    {
+        const __m128i count_mask32 = _mm_set1_epi32 (NPA_FRAMES_COUNT_MASK);
+
+        for (; (ii + NPA_FRAMES_VECTOR) <= num_frames; ii += NPA_FRAMES_VECTOR)
+        {
+            const __m128i word_a = frame_word_sse2 (&raw_data[ii * 4U]);
+            const __m128i word_b = frame_word_sse2 (&raw_data[ (ii * 4U) + 16U]);
+            // Values are below 2^14, signed pack is exact.
+            const __m128i counts = _mm_packs_epi32 (_mm_and_si128 (word_a, count_mask32),
+                                                    _mm_and_si128 (word_b, count_mask32));
+            const __m128i state = _mm_packs_epi32 (_mm_srli_epi32 (word_a, 14),
+                                                   _mm_srli_epi32 (word_b, 14));
+            finish_sse2 (counts, state, gain_v, offset_v, &pressure_pa[ii], &status[ii], &all);
+        }
+    }
+    else
+    {
+        // 3-byte frames are decoded by scalar kernel.
+    }
+
+    uint16_t lanes[8U];
+    _mm_storeu_si128 ( (__m128i *) lanes, all);
+
+    for (size_t lane = 0U; lane < 8U; lane++)
+    {
+        *status_all |= lanes[lane];
+    }
+
+    return ii;
+}
+
+#elif defined (NPA_FRAMES_NEON)
+
+#define NPA_FRAMES_VECTOR (16U) //!< Frames per vector iteration.
+
+/**
+ * @brief Convert 8 frames given as 16-bit counts.
+ */
+static void convert_neon (const uint16x8_t counts, const uint8x8_t code,
+                          const float32x4_t gain, const float32x4_t offset,
+                          float * const pressure_pa, npa_ret_t * const status)
+{
+    const uint16x8_t code16 = vmovl_u8 (code);
+    const float32x4_t counts_lo = vcvtq_f32_u32 (vmovl_u16 (vget_low_u16 (counts)));
+    const float32x4_t counts_hi = vcvtq_f32_u32 (vmovl_u16 (vget_high_u16 (counts)));
+    vst1q_u32 (&status[0U], vmovl_u16 (vget_low_u16 (code16)));
+    vst1q_u32 (&status[4U], vmovl_u16 (vget_high_u16 (code16)));
+    // Separate multiply and add, fused multiply-add would round differently.
+    vst1q_f32 (&pressure_pa[0U], vaddq_f32 (vmulq_f32 (counts_lo, gain), offset));
+    vst1q_f32 (&pressure_pa[4U], vaddq_f32 (vmulq_f32 (counts_hi, gain), offset));
+}
+
+/**
+ * @brief Convert 16 frames given as their first and second bytes.
+ *
+ * @param[in]     first      First bytes of frames: status and pressure MSB.
+ * @param[in]     second     Second bytes of frames: pressure LSB.
+ * @param[in,out] status_all Bitwise OR of status codes.
+ */
+static void finish_neon (const uint8x16_t first, const uint8x16_t second,
+                         const float32x4_t gain, const float32x4_t offset,
+                         float * const pressure_pa, npa_ret_t * const status,
+                         uint8x16_t * const status_all)
+{
+    const uint8x16_t msb = vandq_u8 (first, vdupq_n_u8 (0x3FU));
+    const uint8x16_t state = vshrq_n_u8 (first, NPA_FRAMES_STATE_SHIFT);
+    const uint16x8_t counts_lo = vorrq_u16 (vshll_n_u8 (vget_low_u8 (msb), 8),
+                                            vmovl_u8 (vget_low_u8 (second)));
+    const uint16x8_t counts_hi = vorrq_u16 (vshll_n_u8 (vget_high_u8 (msb), 8),
+                                            vmovl_u8 (vget_high_u8 (second)));
+    const uint16x8_t min = vdupq_n_u16 (NPA_PRES_MIN_NONSAT);
+    const uint16x8_t max = vdupq_n_u16 (NPA_PRES_MAX_NONSAT);
+    const uint8x16_t sat = vcombine_u8 (
+                               vmovn_u16 (vorrq_u16 (vcltq_u16 (counts_lo, min), vcgtq_u16 (counts_lo, max))),
+                               vmovn_u16 (vorrq_u16 (vcltq_u16 (counts_hi, min), vcgtq_u16 (counts_hi, max))));
+    uint8x16_t code = vandq_u8 (sat, vdupq_n_u8 (NPA_WARN_SAT));
+    code = vorrq_u8 (code, vandq_u8 (vceqq_u8 (state, vdupq_n_u8 (1U)),
+                                     vdupq_n_u8 (NPA_ERR_MODE)));
+    code = vorrq_u8 (code, vandq_u8 (vceqq_u8 (state, vdupq_n_u8 (2U)),
+                                     vdupq_n_u8 (NPA_WARN_OLD)));
+    code = vorrq_u8 (code, vandq_u8 (vceqq_u8 (state, vdupq_n_u8 (3U)),
+                                     vdupq_n_u8 (NPA_ERR_FATAL)));
+    *status_all = vorrq_u8 (*status_all, code);
+    convert_neon (counts_lo, vget_low_u8 (code), gain, offset, &pressure_pa[0U],
+                  &status[0U]);
+    convert_neon (counts_hi, vget_high_u8 (code), gain, offset, &pressure_pa[8U],
+                  &status[8U]);
+}
+
+static size_t decode_vector (const uint8_t * const raw_data, const uint8_t data_len,
+                             const size_t num_frames, const float gain,
+                             const float offset, float * const pressure_pa,
+                             npa_ret_t * const status, npa_ret_t * const status_all)
+{
+    const float32x4_t gain_v = vdupq_n_f32 (gain);
+    const float32x4_t offset_v = vdupq_n_f32 (offset);
+    uint8x16_t all = vdupq_n_u8 (0U);
+    size_t ii = 0U;
+
+    if (NPA_FRAME_LEN_PRES == data_len)
+    {
+        for (; (ii + NPA_FRAMES_VECTOR) <= num_frames; ii += NPA_FRAMES_VECTOR)
+        {
+            // De-interleaving load splits frames into first and second bytes.
+            const uint8x16x2_t raw = vld2q_u8 (&raw_data[ii * 2U]);
+            finish_neon (raw.val[0U], raw.val[1U], gain_v, offset_v, &pressure_pa[ii],
+                         &status[ii], &all);
+        }
+    }
+    else if (NPA_FRAME_LEN_HIRES == data_len)
+    {
+        for (; (ii + NPA_FRAMES_VECTOR) <= num_frames; ii += NPA_FRAMES_VECTOR)
+        {
+            const uint8x16x4_t raw = vld4q_u8 (&raw_data[ii * 4U]);
+            finish_neon (raw.val[0U], raw.val[1U], gain_v, offset_v, &pressure_pa[ii],
+                         &status[ii], &all);
+        }
+    }
+    else
+    {
+        // 3-byte frames are decoded by scalar kernel.
+    }
+
+    uint8_t lanes[16U];
+    vst1q_u8 (lanes, all);
+
+    for (size_t lane = 0U; lane < 16U; lane++)
+    {
+        *status_all |= lanes[lane];
+    }
+
+    return ii;
+}
+
+#else
+
+static size_t decode_vector (const uint8_t * const raw_data, const uint8_t data_len,
+                             const size_t num_frames, const float gain,
+                             const float offset, float * const pressure_pa,
+                             npa_ret_t * const status, npa_ret_t * const status_all)
+{
+    (void) raw_data;
+    (void) data_len;
+    (void) num_frames;
+    (void) gain;
+    (void) offset;
+    (void) pressure_pa;
+    (void) status;
+    (void) status_all;
+    return 0U;
+}
+
+#endif
+
+/**
+ * @brief Validate arguments and get scaling of the model.
+ *
+ * @return @ref npa_ret_t, NPA_SUCCESS if frames can be decoded.
+ */
+static npa_ret_t decode_check (const npa_variant_t model, const uint8_t * const raw_data,
+                               const uint8_t data_len, float * const pressure_pa,
+                               npa_ret_t * const status, float * const gain,
+                               float * const offset)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == raw_data) || (NULL == pressure_pa) || (NULL == status))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (NPA_FRAME_LEN_PRES > data_len) || (NPA_FRAME_LEN_HIRES < data_len))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        ret_code |= npa_get_scaling (model, gain, offset);
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_decode_frames (const npa_variant_t model, const uint8_t * const raw_data,
+                             const uint8_t data_len, const size_t num_frames,
+                             float * const pressure_pa, npa_ret_t * const status)
+{
+    float gain = 0.0F;
+    float offset = 0.0F;
+    npa_ret_t ret_code = decode_check (model, raw_data, data_len, pressure_pa, status,
+                                       &gain, &offset);
+
+    if (NPA_SUCCESS == ret_code)
+    {
+        const size_t done = decode_vector (raw_data, data_len, num_frames, gain, offset,
+                                           pressure_pa, status, &ret_code);
+        ret_code |= decode_scalar (&raw_data[done * data_len], data_len, num_frames - done,
+                                   gain, offset, &pressure_pa[done], &status[done]);
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_decode_frames_scalar (const npa_variant_t model,
+                                    const uint8_t * const raw_data,
+                                    const uint8_t data_len, const size_t num_frames,
+                                    float * const pressure_pa, npa_ret_t * const status)
+{
+    float gain = 0.0F;
+    float offset = 0.0F;
+    npa_ret_t ret_code = decode_check (model, raw_data, data_len, pressure_pa, status,
+                                       &gain, &offset);
+
+    if (NPA_SUCCESS == ret_code)
+    {
+        ret_code |= decode_scalar (raw_data, data_len, num_frames, gain, offset,
+                                   pressure_pa, status);
+    }
+
+    return ret_code;
+}
+
+const char * npa_decode_frames_kernel (void)
+{
+#if defined (NPA_FRAMES_AVX2)
+    return "avx2";
+#elif defined (NPA_FRAMES_SSE2)
+    return "sse2";
+#elif defined (NPA_FRAMES_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+/** @} */
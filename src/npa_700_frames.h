@@ -0,0 +1,71 @@
+#ifndef NPA_700_FRAMES_H
+#define NPA_700_FRAMES_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_frames.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Decoding of raw frame buffers, e.g. filled by DMA.
+ *
+ * Frames are stored back-to-back, each frame data_len bytes. Status of each frame is
+ * identical to @ref npa_decode_frame and pressure to @ref npa_convert_pa of the frame
+ * counts. Like read functions, pressure is written also for frames with fatal status.
+ * Temperature is not decoded.
+ *
+ * Vector kernel is selected at compile time: AVX2 if compiler targets it, otherwise
+ * SSE2 on x86 and NEON on ARM. Frames of 3 bytes, tails shorter than one vector and
+ * other targets use the portable scalar kernel. Define NPA_NO_SIMD in build to use
+ * the scalar kernel only.
+ */
+
+#include "npa_700.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Decode a buffer of frames.
+ *
+ * @param[in]  model       Model of the sensor.
+ * @param[in]  raw_data    num_frames frames of data_len bytes.
+ * @param[in]  data_len    Length of each frame, see @ref npa_parse_frame.
+ * @param[in]  num_frames  Number of frames.
+ * @param[out] pressure_pa Array of num_frames pressures in pascals.
+ * @param[out] status      Array of num_frames status codes.
+ * @retval NPA_ERR_NULL  Buffer or an output array was NULL, nothing was decoded.
+ * @retval NPA_ERR_PARAM Frame length is invalid, nothing was decoded.
+ * @retval NPA_ERR_FATAL Model is unknown, nothing was decoded.
+ * @return Bitwise OR of status of all frames.
+ *
+ * @note Use system float as a type.
+ */
+npa_ret_t npa_decode_frames (const npa_variant_t model, const uint8_t * const raw_data,
+                             const uint8_t data_len, const size_t num_frames,
+                             float * const pressure_pa, npa_ret_t * const status);
+
+/**
+ * @brief Decode a buffer of frames with the portable scalar kernel.
+ *
+ * Same as @ref npa_decode_frames, for comparison and on targets without vector
+ * kernel.
+ */
+npa_ret_t npa_decode_frames_scalar (const npa_variant_t model,
+                                    const uint8_t * const raw_data,
+                                    const uint8_t data_len, const size_t num_frames,
+                                    float * const pressure_pa, npa_ret_t * const status);
+
+/**
+ * @brief Name of the vector kernel used by @ref npa_decode_frames.
+ *
+ * @return "avx2", "sse2", "neon" or "scalar".
+ */
+const char * npa_decode_frames_kernel (void);
+
+/** @} */
+#endif // NPA_700_FRAMES_H
@@ -0,0 +1,234 @@
+#include "npa_700_health.h"
+
+#include <string.h>
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_health.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ */
+
+/** @brief Largest interval, Q4 fits 31 bits. */
+#define NPA_HEALTH_MAX_PERIOD_US ( (1UL << 27U) - 1U)
+/** @brief Bits which tell a fatal error is from bus. */
+#define NPA_HEALTH_BUS_ERRORS ( (NPA_ERR_NACK | NPA_ERR_TOUT) & ~NPA_ERR_FATAL)
+
+npa_ret_t npa_health_init (npa_health_t * const health, const npa_health_cfg_t * const cfg)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == health) || (NULL == cfg))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (1U == cfg->frozen_samples) || (NPA_HEALTH_MAX_PERIOD_US < cfg->period_us)
+              || ( (0U != cfg->period_us) && (0U == cfg->period_tolerance_us)))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        memset (health, 0, sizeof (npa_health_t));
+        health->cfg = *cfg;
+    }
+
+    return ret_code;
+}
+
+// Next state of a condition with separate raise and clear tests.
+static uint8_t hysteresis (const uint8_t state, const uint8_t flag, const bool raise,
+                           const bool clear)
+{
+    uint8_t next = state;
+
+    if (raise)
+    {
+        next |= flag;
+    }
+    else if (clear)
+    {
+        next &= (uint8_t) ~flag;
+    }
+    else
+    {
+        // Keep previous state.
+    }
+
+    return next;
+}
+
+static uint16_t count_up (const uint16_t count)
+{
+    return (UINT16_MAX == count) ? UINT16_MAX : (uint16_t) (count + 1U);
+}
+
+static void update_errors (npa_health_t * const health, const bool bus_error,
+                           const bool success)
+{
+    const uint32_t limit = health->cfg.error_limit;
+
+    if (bus_error)
+    {
+        health->error_score += health->cfg.error_weight;
+        // Bounded so that a long burst decays in limit good reads.
+        health->error_score = (health->error_score > limit) ? limit : health->error_score;
+    }
+    else if (success && (0U < health->error_score))
+    {
+        health->error_score--;
+    }
+    else
+    {
+        // Other errors do not tell about the bus.
+    }
+
+    health->state = hysteresis (health->state, NPA_HEALTH_DROPOUT,
+                                (0U != limit) && (health->error_score >= limit),
+                                0U == health->error_score);
+}
+
+static void update_output (npa_health_t * const health, const npa_ret_t status,
+                           const uint16_t counts, const bool fresh)
+{
+    const uint16_t frozen_limit = health->cfg.frozen_samples;
+    const uint16_t sat_limit = health->cfg.sat_samples;
+
+    if (0U != (status & NPA_WARN_SAT))
+    {
+        health->sat_samples = count_up (health->sat_samples);
+    }
+    else
+    {
+        health->sat_samples = 0U;
+    }
+
+    if (!fresh)
+    {
+        // Stale read repeats counts by design.
+    }
+    else if (health->has_fresh && (counts == health->last_counts))
+    {
+        health->same_samples = count_up (health->same_samples);
+    }
+    else
+    {
+        health->same_samples = 1U;
+        health->last_counts = counts;
+    }
+
+    health->state = hysteresis (health->state, NPA_HEALTH_SATURATED,
+                                (0U != sat_limit) && (health->sat_samples >= sat_limit),
+                                0U == health->sat_samples);
+    health->state = hysteresis (health->state, NPA_HEALTH_FROZEN,
+                                (0U != frozen_limit)
+                                && (health->same_samples >= frozen_limit),
+                                1U == health->same_samples);
+}
+
+static void update_rate (npa_health_t * const health, const bool fatal, const bool fresh,
+                         const uint32_t now_us)
+{
+    const uint32_t period = health->cfg.period_us;
+    const uint32_t tolerance = health->cfg.period_tolerance_us;
+    // Interval over a failed read may span several updates and is not measured.
+    const bool measured = health->has_fresh && !health->gap;
+    uint32_t elapsed = now_us - health->fresh_us;
+    elapsed = (NPA_HEALTH_MAX_PERIOD_US < elapsed) ? NPA_HEALTH_MAX_PERIOD_US : elapsed;
+
+    if (fresh && measured && health->has_period)
+    {
+        const int32_t error = (int32_t) (elapsed << NPA_HEALTH_FRAC_BITS)
+                              - (int32_t) health->period_q4;
+        health->period_q4 = (uint32_t) ( (int32_t) health->period_q4
+                                         + (error / (1 << NPA_HEALTH_AVG_SHIFT)));
+    }
+    else if (fresh && measured)
+    {
+        health->period_q4 = elapsed << NPA_HEALTH_FRAC_BITS;
+        health->has_period = true;
+    }
+    else
+    {
+        // No interval.
+    }
+
+    if ( (0U != period) && !fatal && health->has_fresh)
+    {
+        const uint32_t average = health->period_q4 >> NPA_HEALTH_FRAC_BITS;
+        // Open interval since last update bounds period from below.
+        const uint32_t slowest = (fresh || !measured || (elapsed < average))
+                                 ? average : elapsed;
+        const bool slow = slowest > (period + tolerance);
+        const bool fast = health->has_period && ( (average + tolerance) < period);
+        const bool slow_ok = slowest <= (period + (tolerance / 2U));
+        const bool fast_ok = !health->has_period
+                             || ( (average + (tolerance / 2U)) >= period);
+        health->state = hysteresis (health->state, NPA_HEALTH_RATE, slow || fast,
+                                    slow_ok && fast_ok);
+    }
+
+    if (fresh)
+    {
+        health->fresh_us = now_us;
+        health->has_fresh = true;
+        health->gap = false;
+    }
+    else if (fatal)
+    {
+        health->gap = true;
+    }
+    else
+    {
+        // Stale read, interval continues.
+    }
+}
+
+uint8_t npa_health_update (npa_health_t * const health, const npa_ret_t status,
+                           const uint16_t counts, const uint32_t now_us)
+{
+    uint8_t state = 0U;
+
+    if (NULL != health)
+    {
+        const uint8_t previous = health->state;
+        const bool fatal = (0U != (status & NPA_ERR_FATAL));
+        const bool fresh = !fatal && (0U == (status & NPA_WARN_OLD));
+        update_errors (health, fatal && (0U != (status & NPA_HEALTH_BUS_ERRORS)), !fatal);
+
+        if (!fatal)
+        {
+            update_output (health, status, counts, fresh);
+        }
+
+        update_rate (health, fatal, fresh, now_us);
+        state = health->state;
+
+        if (previous != state)
+        {
+            if (UINT32_MAX != health->transitions)
+            {
+                health->transitions++;
+            }
+
+            if (NULL != health->cfg.callback)
+            {
+                health->cfg.callback (state, (uint8_t) (previous ^ state),
+                                      health->cfg.p_context);
+            }
+        }
+    }
+
+    return state;
+}
+
+uint8_t npa_health_state (const npa_health_t * const health)
+{
+    return (NULL == health) ? 0U : health->state;
+}
+
+/** @} */
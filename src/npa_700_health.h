@@ -0,0 +1,125 @@
+#ifndef NPA_700_HEALTH_H
+#define NPA_700_HEALTH_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_health.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Health monitor of a sensor from results of its reads.
+ *
+ * Monitor is updated with status, counts and time of every read of one sensor and
+ * keeps a set of fault conditions, each with its own detector:
+ *
+ * - Frozen: frozen_samples consecutive fresh reads return identical counts. A noisy
+ *   sensor rarely repeats, set limit above longest run of a quiet sensor. Cleared by
+ *   the first fresh read with other counts.
+ * - Dropout: each @ref NPA_ERR_NACK or @ref NPA_ERR_TOUT adds error_weight to an error
+ *   score and each successful read removes 1. Raised when score reaches error_limit
+ *   and cleared when it has decayed back to 0, so an error rate above
+ *   1 / (error_weight + 1) keeps the condition raised.
+ * - Saturated: sat_samples consecutive successful reads are saturated. Cleared by the
+ *   first read which is not.
+ * - Rate: interval between fresh reads, averaged over about 2^NPA_HEALTH_AVG_SHIFT
+ *   intervals, differs from period_us by more than period_tolerance_us. Time since
+ *   last fresh read counts as soon as it exceeds the average, so a sensor which stops
+ *   updating is flagged without waiting for the next update. Cleared when back
+ *   within half of tolerance. An interval with a failed read is not measured, as it
+ *   may span several updates, and leaves the condition as it is.
+ *
+ * Stale reads only advance time, other fatal errors are ignored. A limit of 0
+ * disables its detector. Each update takes constant time, and callback is called
+ * once per update in which any condition was raised or cleared.
+ */
+
+#include "npa_700.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define NPA_HEALTH_FROZEN    (1U) //!< Output is frozen.
+#define NPA_HEALTH_DROPOUT   (2U) //!< Bus errors are frequent.
+#define NPA_HEALTH_SATURATED (4U) //!< Output is persistently saturated.
+#define NPA_HEALTH_RATE      (8U) //!< Update period has drifted.
+#define NPA_HEALTH_AVG_SHIFT (3U) //!< Period averages over about 2^3 updates.
+#define NPA_HEALTH_FRAC_BITS (4U) //!< Fractional bits of period estimate.
+
+/**
+ * @brief Handle a change in conditions.
+ *
+ * @param[in] state     Conditions now active, NPA_HEALTH_ flags.
+ * @param[in] changed   Conditions raised or cleared by this update.
+ * @param[in] p_context Context given in configuration.
+ */
+typedef void (*npa_health_cb) (const uint8_t state, const uint8_t changed,
+                               void * const p_context);
+
+/** @brief Configuration of health monitor. */
+typedef struct
+{
+    uint16_t frozen_samples;      //!< Identical fresh reads to raise frozen, not 1.
+    uint16_t error_weight;        //!< Error score added by a bus error.
+    uint16_t error_limit;         //!< Error score to raise dropout.
+    uint16_t sat_samples;         //!< Consecutive saturated reads to raise saturated.
+    uint32_t period_us;           //!< Expected interval between fresh reads, below 2^27.
+    uint32_t period_tolerance_us; //!< Allowed deviation of interval.
+    npa_health_cb callback;       //!< Change handler, may be NULL.
+    void * p_context;             //!< Application context, not used by monitor.
+} npa_health_cfg_t;
+
+/** @brief State of health monitor. Initialize with @ref npa_health_init. */
+typedef struct
+{
+    npa_health_cfg_t cfg;   //!< Configuration.
+    uint32_t period_q4;     //!< Average interval between fresh reads, Q4 microseconds.
+    uint32_t fresh_us;      //!< Time of last fresh read.
+    uint32_t error_score;   //!< Decaying score of bus errors.
+    uint32_t transitions;   //!< Number of changes in conditions, saturating.
+    uint16_t last_counts;   //!< Counts of last fresh read.
+    uint16_t same_samples;  //!< Consecutive fresh reads with identical counts.
+    uint16_t sat_samples;   //!< Consecutive saturated reads.
+    uint8_t state;          //!< Active conditions, NPA_HEALTH_ flags.
+    bool has_fresh;         //!< At least one fresh read has been seen.
+    bool has_period;        //!< At least one interval has been measured.
+    bool gap;               //!< A read has failed since last fresh read.
+} npa_health_t;
+
+/**
+ * @brief Initialize health monitor with no active conditions.
+ *
+ * @param[out] health Monitor to initialize.
+ * @param[in]  cfg    Configuration, copied to monitor.
+ * @retval NPA_SUCCESS   Monitor was initialized.
+ * @retval NPA_ERR_NULL  Monitor or configuration was NULL.
+ * @retval NPA_ERR_PARAM Frozen limit is 1, period is too long or tolerance is 0 for a
+ *                       set period.
+ */
+npa_ret_t npa_health_init (npa_health_t * const health, const npa_health_cfg_t * const cfg);
+
+/**
+ * @brief Update monitor with result of a read.
+ *
+ * @param[in,out] health Monitor.
+ * @param[in]     status @ref npa_ret_t of the read.
+ * @param[in]     counts Pressure counts of the read, ignored unless successful.
+ * @param[in]     now_us Time of the read.
+ * @return Active conditions, NPA_HEALTH_ flags. 0 if monitor is NULL.
+ */
+uint8_t npa_health_update (npa_health_t * const health, const npa_ret_t status,
+                           const uint16_t counts, const uint32_t now_us);
+
+/**
+ * @brief Active conditions.
+ *
+ * @param[in] health Monitor.
+ * @return NPA_HEALTH_ flags, 0 if monitor is NULL.
+ */
+uint8_t npa_health_state (const npa_health_t * const health);
+
+/** @} */
+#endif // NPA_700_HEALTH_H
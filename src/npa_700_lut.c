@@ -0,0 +1,237 @@
+#include "npa_700_lut.h"
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_lut.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * Entries are constant expressions of the same float multiply and add as the
+ * arithmetic conversion, so the compiler rounds them identically. Tables are
+ * expanded by nested macros, each level repeating the one below four times.
+ */
+
+#ifndef NPA_LUT_02WD
+#define NPA_LUT_02WD (0)
+#endif
+#ifndef NPA_LUT_05WD
+#define NPA_LUT_05WD (0)
+#endif
+#ifndef NPA_LUT_10WD
+#define NPA_LUT_10WD (0)
+#endif
+#ifndef NPA_LUT_001D
+#define NPA_LUT_001D (0)
+#endif
+#ifndef NPA_LUT_005D
+#define NPA_LUT_005D (0)
+#endif
+#ifndef NPA_LUT_015D
+#define NPA_LUT_015D (0)
+#endif
+#ifndef NPA_LUT_030D
+#define NPA_LUT_030D (0)
+#endif
+
+#define NPA_LUT_NUM_VARIANTS (7U) //!< Number of models.
+
+#define NPA_LUT_ENTRY(scale, n) ( ( (float) (n) * NPA_GAIN (scale)) + NPA_OFFSET (scale))
+#define NPA_LUT_4(s, n) \
+    NPA_LUT_ENTRY (s, (n)), NPA_LUT_ENTRY (s, (n) + 1U), \
+    NPA_LUT_ENTRY (s, (n) + 2U), NPA_LUT_ENTRY (s, (n) + 3U)
+#define NPA_LUT_16(s, n) \
+    NPA_LUT_4 (s, (n)), NPA_LUT_4 (s, (n) + 4U), \
+    NPA_LUT_4 (s, (n) + 8U), NPA_LUT_4 (s, (n) + 12U)
+#define NPA_LUT_64(s, n) \
+    NPA_LUT_16 (s, (n)), NPA_LUT_16 (s, (n) + 16U), \
+    NPA_LUT_16 (s, (n) + 32U), NPA_LUT_16 (s, (n) + 48U)
+#define NPA_LUT_256(s, n) \
+    NPA_LUT_64 (s, (n)), NPA_LUT_64 (s, (n) + 64U), \
+    NPA_LUT_64 (s, (n) + 128U), NPA_LUT_64 (s, (n) + 192U)
+#define NPA_LUT_1024(s, n) \
+    NPA_LUT_256 (s, (n)), NPA_LUT_256 (s, (n) + 256U), \
+    NPA_LUT_256 (s, (n) + 512U), NPA_LUT_256 (s, (n) + 768U)
+#define NPA_LUT_4096(s, n) \
+    NPA_LUT_1024 (s, (n)), NPA_LUT_1024 (s, (n) + 1024U), \
+    NPA_LUT_1024 (s, (n) + 2048U), NPA_LUT_1024 (s, (n) + 3072U)
+#define NPA_LUT_TABLE(s) \
+    { \
+        NPA_LUT_4096 (s, 0U), NPA_LUT_4096 (s, 4096U), \
+        NPA_LUT_4096 (s, 8192U), NPA_LUT_4096 (s, 12288U) \
+    }
+
+/*
+ * Saturation bitmap: bit b of word w is set if counts 32 * w + b is below
+ * NPA_PRES_MIN_NONSAT or above NPA_PRES_MAX_NONSAT. Set bit is NPA_WARN_SAT as is.
+ */
+#define NPA_SAT_CLAMP(bits) ( (bits) > 32U ? 32U : (bits))
+#define NPA_SAT_LOW_BITS(base) \
+    ( ( (base) >= NPA_PRES_MIN_NONSAT) ? 0U : NPA_SAT_CLAMP (NPA_PRES_MIN_NONSAT - (base)))
+#define NPA_SAT_HIGH_FIRST(base) \
+    ( ( (base) > NPA_PRES_MAX_NONSAT) ? 0U : NPA_SAT_CLAMP (NPA_PRES_MAX_NONSAT + 1U - (base)))
+#define NPA_SAT_WORD(w) \
+    ( (uint32_t) ( ( (1ULL << NPA_SAT_LOW_BITS ( (w) * 32U)) - 1ULL) \
+                   | (0xFFFFFFFFULL & ~( (1ULL << NPA_SAT_HIGH_FIRST ( (w) * 32U)) - 1ULL))))
+#define NPA_SAT_4(w) \
+    NPA_SAT_WORD ((w)), NPA_SAT_WORD ((w) + 1U), NPA_SAT_WORD ((w) + 2U), NPA_SAT_WORD ((w) + 3U)
+#define NPA_SAT_16(w) \
+    NPA_SAT_4 ((w)), NPA_SAT_4 ((w) + 4U), NPA_SAT_4 ((w) + 8U), NPA_SAT_4 ((w) + 12U)
+#define NPA_SAT_64(w) \
+    NPA_SAT_16 ((w)), NPA_SAT_16 ((w) + 16U), NPA_SAT_16 ((w) + 32U), NPA_SAT_16 ((w) + 48U)
+#define NPA_SAT_256(w) \
+    NPA_SAT_64 ((w)), NPA_SAT_64 ((w) + 64U), NPA_SAT_64 ((w) + 128U), NPA_SAT_64 ((w) + 192U)
+
+static const uint32_t m_saturated[NPA_LUT_SIZE / 32U] =
+{
+    NPA_SAT_256 (0U), NPA_SAT_256 (256U)
+};
+
+#if NPA_LUT_02WD
+static const float m_lut_02wd[NPA_LUT_SIZE] = NPA_LUT_TABLE (NPA_02WD_SCALE_PA);
+#define NPA_LUT_02WD_TABLE (m_lut_02wd)
+#else
+#define NPA_LUT_02WD_TABLE (NULL)
+#endif
+#if NPA_LUT_05WD
+static const float m_lut_05wd[NPA_LUT_SIZE] = NPA_LUT_TABLE (NPA_05WD_SCALE_PA);
+#define NPA_LUT_05WD_TABLE (m_lut_05wd)
+#else
+#define NPA_LUT_05WD_TABLE (NULL)
+#endif
+#if NPA_LUT_10WD
+static const float m_lut_10wd[NPA_LUT_SIZE] = NPA_LUT_TABLE (NPA_10WD_SCALE_PA);
+#define NPA_LUT_10WD_TABLE (m_lut_10wd)
+#else
+#define NPA_LUT_10WD_TABLE (NULL)
+#endif
+#if NPA_LUT_001D
+static const float m_lut_001d[NPA_LUT_SIZE] = NPA_LUT_TABLE (NPA_001D_SCALE_PA);
+#define NPA_LUT_001D_TABLE (m_lut_001d)
+#else
+#define NPA_LUT_001D_TABLE (NULL)
+#endif
+#if NPA_LUT_005D
+static const float m_lut_005d[NPA_LUT_SIZE] = NPA_LUT_TABLE (NPA_005D_SCALE_PA);
+#define NPA_LUT_005D_TABLE (m_lut_005d)
+#else
+#define NPA_LUT_005D_TABLE (NULL)
+#endif
+#if NPA_LUT_015D
+static const float m_lut_015d[NPA_LUT_SIZE] = NPA_LUT_TABLE (NPA_015D_SCALE_PA);
+#define NPA_LUT_015D_TABLE (m_lut_015d)
+#else
+#define NPA_LUT_015D_TABLE (NULL)
+#endif
+#if NPA_LUT_030D
+static const float m_lut_030d[NPA_LUT_SIZE] = NPA_LUT_TABLE (NPA_030D_SCALE_PA);
+#define NPA_LUT_030D_TABLE (m_lut_030d)
+#else
+#define NPA_LUT_030D_TABLE (NULL)
+#endif
+
+/** @brief Table of each model, NULL if not built in. */
+static const float * const m_tables[NPA_LUT_NUM_VARIANTS] =
+{
+    [NPA_700_02WD] = NPA_LUT_02WD_TABLE,
+    [NPA_700_05WD] = NPA_LUT_05WD_TABLE,
+    [NPA_700_10WD] = NPA_LUT_10WD_TABLE,
+    [NPA_700_001D] = NPA_LUT_001D_TABLE,
+    [NPA_700_005D] = NPA_LUT_005D_TABLE,
+    [NPA_700_015D] = NPA_LUT_015D_TABLE,
+    [NPA_700_030D] = NPA_LUT_030D_TABLE
+};
+
+static const float * get_table (const npa_variant_t model)
+{
+    return ( (uint32_t) model < NPA_LUT_NUM_VARIANTS) ? m_tables[model] : NULL;
+}
+
+static npa_ret_t saturation (const uint16_t counts)
+{
+    return (m_saturated[counts >> 5U] >> (counts & 31U)) & NPA_WARN_SAT;
+}
+
+bool npa_lut_has_table (const npa_variant_t model)
+{
+    return NULL != get_table (model);
+}
+
+npa_ret_t npa_lut_convert_pa (const npa_variant_t model, const uint16_t counts,
+                              float * const pressure_pa)
+{
+    const float * const table = get_table (model);
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if (NULL == table)
+    {
+        ret_code |= npa_convert_pa (model, counts, pressure_pa);
+    }
+    else if (NULL == pressure_pa)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if (NPA_PRES_MAX_SAT < counts)
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        *pressure_pa = table[counts];
+        ret_code |= saturation (counts);
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_lut_convert_batch (const npa_variant_t model,
+                                 const uint16_t * const counts, const size_t num_counts,
+                                 float * const pressure_pa, npa_ret_t * const status)
+{
+    const float * const table = get_table (model);
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == counts) || (NULL == pressure_pa))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (uint32_t) model >= NPA_LUT_NUM_VARIANTS)
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        for (size_t ii = 0U; ii < num_counts; ii++)
+        {
+            npa_ret_t entry = NPA_SUCCESS;
+
+            if (NULL == table)
+            {
+                entry |= npa_convert_pa (model, counts[ii], &pressure_pa[ii]);
+            }
+            else if (NPA_PRES_MAX_SAT < counts[ii])
+            {
+                entry |= NPA_ERR_PARAM;
+            }
+            else
+            {
+                pressure_pa[ii] = table[counts[ii]];
+                entry |= saturation (counts[ii]);
+            }
+
+            if (NULL != status)
+            {
+                status[ii] = entry;
+            }
+
+            ret_code |= entry;
+        }
+    }
+
+    return ret_code;
+}
+
+/** @} */
@@ -0,0 +1,80 @@
+#ifndef NPA_700_LUT_H
+#define NPA_700_LUT_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_lut.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Conversion of pressure counts through lookup tables.
+ *
+ * For targets where float multiply-add is slow, e.g. without FPU, counts can be
+ * converted by a single table load. Each table has a float for every 14-bit count,
+ * 64 KiB, generated by the preprocessor from @ref NPA_GAIN and @ref NPA_OFFSET of the
+ * model. Tables are bit-exact with @ref npa_convert_pa, unless compiler contracts its
+ * multiply and add into a fused multiply-add, e.g. GCC -ffp-contract=fast on FPU with
+ * FMA, in which case results may differ by 1 ulp. Saturation depends only on counts,
+ * so it is held in one 2 KiB bitmap shared by all models.
+ *
+ * Tables are built in per model by defining NPA_LUT_02WD ... NPA_LUT_030D to 1, or
+ * all of them with NPA_LUT_ALL. Models without table are converted arithmetically.
+ */
+
+#include "npa_700.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define NPA_LUT_SIZE (NPA_PRES_MAX_SAT + 1U) //!< Entries per table.
+
+#ifdef NPA_LUT_ALL
+#define NPA_LUT_02WD (1)
+#define NPA_LUT_05WD (1)
+#define NPA_LUT_10WD (1)
+#define NPA_LUT_001D (1)
+#define NPA_LUT_005D (1)
+#define NPA_LUT_015D (1)
+#define NPA_LUT_030D (1)
+#endif
+
+/**
+ * @brief Check if table of a model is built in.
+ *
+ * @param[in] model Model of the sensor.
+ * @return true if conversions of the model use a table.
+ */
+bool npa_lut_has_table (const npa_variant_t model);
+
+/**
+ * @brief Convert pressure counts to pascals.
+ *
+ * Same as @ref npa_convert_pa.
+ */
+npa_ret_t npa_lut_convert_pa (const npa_variant_t model, const uint16_t counts,
+                              float * const pressure_pa);
+
+/**
+ * @brief Convert an array of pressure counts to pascals.
+ *
+ * @param[in]  model       Model of the sensor.
+ * @param[in]  counts      Array of 14-bit pressure counts.
+ * @param[in]  num_counts  Number of counts.
+ * @param[out] pressure_pa Array of pressures in pascals.
+ * @param[out] status      Array of status per count as from @ref npa_convert_pa.
+ *                         May be NULL.
+ * @retval NPA_ERR_NULL  counts or pressure_pa was NULL, nothing was converted.
+ * @retval NPA_ERR_PARAM Model is unknown, nothing was converted.
+ * @return Bitwise OR of status of all counts.
+ */
+npa_ret_t npa_lut_convert_batch (const npa_variant_t model,
+                                 const uint16_t * const counts, const size_t num_counts,
+                                 float * const pressure_pa, npa_ret_t * const status);
+
+/** @} */
+#endif // NPA_700_LUT_H
@@ -0,0 +1,179 @@
+#include "npa_700_poll.h"
+
+#include <string.h>
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_poll.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ */
+
+#define NPA_POLL_MAX_PERIOD_US ( (1UL << 27U) - 1U) //!< Largest period, Q4 fits 31 bits.
+
+npa_ret_t npa_poll_init (npa_poll_t * const poll, const npa_poll_cfg_t * const cfg,
+                         const uint32_t now_us)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == poll) || (NULL == cfg))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (0U == cfg->min_period_us) || (cfg->min_period_us > cfg->max_period_us)
+              || (cfg->initial_period_us < cfg->min_period_us)
+              || (cfg->initial_period_us > cfg->max_period_us)
+              || (NPA_POLL_MAX_PERIOD_US < cfg->max_period_us))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        memset (poll, 0, sizeof (npa_poll_t));
+        poll->cfg = *cfg;
+        poll->period_q4 = cfg->initial_period_us << NPA_POLL_FRAC_BITS;
+        poll->read_us = now_us;
+        poll->deadline_us = now_us;
+    }
+
+    return ret_code;
+}
+
+static void clamp_period (npa_poll_t * const poll, const uint32_t estimate)
+{
+    const uint32_t min_q4 = poll->cfg.min_period_us << NPA_POLL_FRAC_BITS;
+    const uint32_t max_q4 = poll->cfg.max_period_us << NPA_POLL_FRAC_BITS;
+    const uint32_t limited = (estimate < min_q4) ? min_q4 : estimate;
+    poll->period_q4 = (limited > max_q4) ? max_q4 : limited;
+}
+
+static void shrink_period (npa_poll_t * const poll)
+{
+    // By the margin of early read, so that a read which just missed its stale
+    // window barely changes estimate.
+    clamp_period (poll, poll->period_q4 - (poll->period_q4 >> NPA_POLL_EARLY_SHIFT));
+}
+
+static void estimate_period (npa_poll_t * const poll, const uint32_t interval_us)
+{
+    const uint32_t period_us = poll->period_q4 >> NPA_POLL_FRAC_BITS;
+    uint32_t estimate = poll->period_q4;
+
+    if ( (interval_us < (period_us / 2U)) || (interval_us > (2U * period_us)))
+    {
+        // Far off, e.g. initial guess was wrong. Restart average from interval.
+        estimate = interval_us << NPA_POLL_FRAC_BITS;
+    }
+    else
+    {
+        const int32_t error = (int32_t) (interval_us << NPA_POLL_FRAC_BITS)
+                              - (int32_t) estimate;
+        estimate = (uint32_t) ( (int32_t) estimate + (error / (1 << NPA_POLL_AVG_SHIFT)));
+    }
+
+    clamp_period (poll, estimate);
+}
+
+uint32_t npa_poll_update (npa_poll_t * const poll, const npa_ret_t status,
+                          const uint32_t now_us)
+{
+    uint32_t deadline = now_us;
+
+    if (NULL != poll)
+    {
+        const uint32_t period_us = poll->period_q4 >> NPA_POLL_FRAC_BITS;
+        poll->reads++;
+
+        if (0U != (status & NPA_ERR_FATAL))
+        {
+            // Nothing learned, try again after one retry step.
+            deadline = now_us + (period_us >> NPA_POLL_RETRY_SHIFT) + 1U;
+        }
+        else if (0U != (status & NPA_WARN_OLD))
+        {
+            const uint8_t streak = (poll->stale_streak < NPA_POLL_RETRY_SHIFT)
+                                   ? poll->stale_streak : NPA_POLL_RETRY_SHIFT;
+            poll->stale_reads++;
+            poll->stale_streak = (UINT8_MAX == poll->stale_streak)
+                                 ? UINT8_MAX : (uint8_t) (poll->stale_streak + 1U);
+            poll->read_us = now_us;
+            deadline = now_us + ( (period_us >> NPA_POLL_RETRY_SHIFT) << streak) + 1U;
+        }
+        else
+        {
+            // Update happened after previous read and at latest now.
+            const bool bracketed = (0U != poll->stale_streak);
+            uint32_t update_us = now_us - ( (now_us - poll->read_us) / 2U);
+
+            if (!bracketed && poll->has_update)
+            {
+                // No stale read since last update, so the sensor may have updated
+                // more than once and the interval is not reliable. Keep expected
+                // phase if it is possible and read a bit earlier next time.
+                const uint32_t expected = poll->update_us + period_us;
+
+                if ( (int32_t) (expected - poll->read_us) <= 0)
+                {
+                    update_us = poll->read_us + 1U;
+                }
+                else if ( (int32_t) (expected - now_us) > 0)
+                {
+                    update_us = now_us;
+                }
+                else
+                {
+                    update_us = expected;
+                }
+
+                shrink_period (poll);
+            }
+            else if (bracketed && poll->has_update && poll->update_bracketed)
+            {
+                estimate_period (poll, update_us - poll->update_us);
+            }
+            else
+            {
+                // Interval is known from next bracketed update.
+            }
+
+            poll->update_bracketed = bracketed;
+            const uint32_t period = poll->period_q4 >> NPA_POLL_FRAC_BITS;
+            poll->has_update = true;
+            poll->update_us = update_us;
+            poll->read_us = now_us;
+            poll->stale_streak = 0U;
+            deadline = update_us + period - (period >> NPA_POLL_EARLY_SHIFT);
+
+            // Read late, e.g. scheduler was busy: next read cannot be in the past.
+            if ( (int32_t) (deadline - now_us) <= 0)
+            {
+                deadline = now_us + (period >> NPA_POLL_RETRY_SHIFT) + 1U;
+            }
+        }
+
+        poll->deadline_us = deadline;
+    }
+
+    return deadline;
+}
+
+bool npa_poll_due (const npa_poll_t * const poll, const uint32_t now_us)
+{
+    return (NULL != poll) && ( (int32_t) (now_us - poll->deadline_us) >= 0);
+}
+
+uint32_t npa_poll_deadline (const npa_poll_t * const poll)
+{
+    return (NULL != poll) ? poll->deadline_us : 0U;
+}
+
+uint32_t npa_poll_period (const npa_poll_t * const poll)
+{
+    return (NULL != poll) ? (poll->period_q4 >> NPA_POLL_FRAC_BITS) : 0U;
+}
+
+/** @} */
@@ -0,0 +1,116 @@
+#ifndef NPA_700_POLL_H
+#define NPA_700_POLL_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_poll.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Adaptive polling of free-running sensors.
+ *
+ * Free-running sensor updates its output at its own period, and reads in between
+ * return @ref NPA_WARN_OLD. Controller learns the update period and phase from the
+ * status of each read and tells when the next read should be made.
+ *
+ * Each fresh read bounds the update to the interval since the previous read. After
+ * a stale read the interval is short and its midpoint is taken as update time.
+ * Period is a moving average of time between such updates; an interval under half or
+ * over twice the estimate replaces the estimate directly. A fresh read without a
+ * stale read before it may have skipped updates, so it shrinks the estimate slightly
+ * instead.
+ *
+ * Next read is made 1/64 period before the expected update, and stale reads are
+ * retried with a step starting at 1/32 period and doubling after each stale read.
+ * Once converged, about two reads are made per update, and fresh data is read
+ * within about 1/16 period of each update.
+ */
+
+#include "npa_700.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define NPA_POLL_EARLY_SHIFT (6U) //!< Read period/2^6 before expected update.
+#define NPA_POLL_RETRY_SHIFT (5U) //!< First retry after period/2^5.
+#define NPA_POLL_AVG_SHIFT   (3U) //!< Period averages over about 2^3 updates.
+#define NPA_POLL_FRAC_BITS   (4U) //!< Fractional bits of period estimate.
+
+/** @brief Configuration of poll controller. */
+typedef struct
+{
+    uint32_t initial_period_us; //!< Period before first estimate.
+    uint32_t min_period_us;     //!< Lower limit of estimate, non-zero.
+    uint32_t max_period_us;     //!< Upper limit of estimate, below 2^27.
+} npa_poll_cfg_t;
+
+/** @brief State of poll controller. Initialize with @ref npa_poll_init. */
+typedef struct
+{
+    npa_poll_cfg_t cfg;     //!< Configuration.
+    uint32_t period_q4;     //!< Estimated update period, Q4 microseconds.
+    uint32_t update_us;     //!< Estimated time of last update.
+    uint32_t read_us;       //!< Time of last read.
+    uint32_t deadline_us;   //!< Time of next read.
+    uint32_t reads;         //!< Number of reads.
+    uint32_t stale_reads;   //!< Number of stale reads.
+    uint8_t stale_streak;   //!< Consecutive stale reads.
+    bool has_update;        //!< At least one fresh read has been seen.
+    bool update_bracketed;  //!< Last update was preceded by a stale read.
+} npa_poll_t;
+
+/**
+ * @brief Initialize poll controller.
+ *
+ * @param[out] poll   Controller to initialize.
+ * @param[in]  cfg    Configuration, copied to controller.
+ * @param[in]  now_us Current time, first read is due immediately.
+ * @retval NPA_SUCCESS   Controller was initialized.
+ * @retval NPA_ERR_NULL  Controller or configuration was NULL.
+ * @retval NPA_ERR_PARAM Period limits are inconsistent.
+ */
+npa_ret_t npa_poll_init (npa_poll_t * const poll, const npa_poll_cfg_t * const cfg,
+                         const uint32_t now_us);
+
+/**
+ * @brief Update controller with status of a read.
+ *
+ * @param[in,out] poll   Controller.
+ * @param[in]     status @ref npa_ret_t of the read.
+ * @param[in]     now_us Time of the read.
+ * @return Time of next read.
+ */
+uint32_t npa_poll_update (npa_poll_t * const poll, const npa_ret_t status,
+                          const uint32_t now_us);
+
+/**
+ * @brief Check if next read is due.
+ *
+ * @param[in] poll   Controller.
+ * @param[in] now_us Current time.
+ * @return true if read should be made now.
+ */
+bool npa_poll_due (const npa_poll_t * const poll, const uint32_t now_us);
+
+/**
+ * @brief Time of next read.
+ *
+ * @param[in] poll Controller.
+ * @return Time of next read.
+ */
+uint32_t npa_poll_deadline (const npa_poll_t * const poll);
+
+/**
+ * @brief Estimated update period of the sensor.
+ *
+ * @param[in] poll Controller.
+ * @return Period in microseconds.
+ */
+uint32_t npa_poll_period (const npa_poll_t * const poll);
+
+/** @} */
+#endif // NPA_700_POLL_H
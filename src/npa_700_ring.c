@@ -0,0 +1,108 @@
+#include "npa_700_ring.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_ring.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * Head and tail are free-running counters, their difference is the number of queued
+ * samples also when counters wrap around.
+ */
+
+#define NPA_RING_MAX_CAPACITY (0x80000000U) //!< Largest capacity, 2^31.
+
+npa_ret_t npa_ring_init (npa_ring_t * const ring, npa_sample_t * const buffer,
+                         const size_t capacity)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == ring) || (NULL == buffer))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (0U == capacity) || (NPA_RING_MAX_CAPACITY < capacity)
+              || (0U != (capacity & (capacity - 1U))))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        ring->buffer = buffer;
+        ring->mask = (uint32_t) capacity - 1U;
+        npa_atomic_store_relaxed (&ring->head, 0U);
+        npa_atomic_store_relaxed (&ring->tail, 0U);
+        npa_atomic_fence();
+    }
+
+    return ret_code;
+}
+
+bool npa_ring_push (npa_ring_t * const ring, const npa_sample_t * const sample)
+{
+    bool pushed = false;
+
+    if ( (NULL != ring) && (NULL != sample))
+    {
+        const uint32_t head = npa_atomic_load_relaxed (&ring->head);
+        // Acquire, consumer must be done with the slot before it is overwritten.
+        const uint32_t tail = npa_atomic_load_acquire (&ring->tail);
+
+        if ( (head - tail) <= ring->mask)
+        {
+            ring->buffer[head & ring->mask] = *sample;
+            // Release, sample must be visible before new head.
+            npa_atomic_store_release (&ring->head, head + 1U);
+            pushed = true;
+        }
+    }
+
+    return pushed;
+}
+
+size_t npa_ring_pop_bulk (npa_ring_t * const ring, npa_sample_t * const samples,
+                          const size_t max_samples)
+{
+    size_t popped = 0U;
+
+    if ( (NULL != ring) && (NULL != samples))
+    {
+        const uint32_t tail = npa_atomic_load_relaxed (&ring->tail);
+        const uint32_t head = npa_atomic_load_acquire (&ring->head);
+        const size_t available = (size_t) (head - tail);
+        popped = (available < max_samples) ? available : max_samples;
+        // Copy in at most two contiguous parts.
+        const size_t start = (size_t) (tail & ring->mask);
+        const size_t to_end = (size_t) ring->mask + 1U - start;
+        const size_t first = (popped < to_end) ? popped : to_end;
+        memcpy (samples, &ring->buffer[start], first * sizeof (npa_sample_t));
+        memcpy (&samples[first], ring->buffer, (popped - first) * sizeof (npa_sample_t));
+        // Release, copies must be done before producer may reuse the slots.
+        npa_atomic_store_release (&ring->tail, tail + (uint32_t) popped);
+    }
+
+    return popped;
+}
+
+size_t npa_ring_count (const npa_ring_t * const ring)
+{
+    size_t count = 0U;
+
+    if (NULL != ring)
+    {
+        const uint32_t tail = npa_atomic_load_acquire (&ring->tail);
+        const uint32_t head = npa_atomic_load_acquire (&ring->head);
+        count = (size_t) (head - tail);
+    }
+
+    return count;
+}
+
+/** @} */
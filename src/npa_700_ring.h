@@ -0,0 +1,90 @@
+#ifndef NPA_700_RING_H
+#define NPA_700_RING_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_ring.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Lock-free sample queue from interrupt context to main loop.
+ *
+ * Single producer, e.g. read completion interrupt, pushes samples which a single
+ * consumer, e.g. control loop, drains without disabling interrupts. Storage is
+ * provided by the application and capacity must be a power of two.
+ */
+
+#include "npa_700.h"
+#include "npa_700_atomic.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Timestamped sample of a sensor. */
+typedef struct
+{
+    uint32_t timestamp;    //!< Time of sample in application units, e.g. microseconds.
+    float pressure_pa;     //!< Pressure in pascals.
+    float temperature_c;   //!< Temperature in celcius.
+    npa_ret_t status;      //!< @ref npa_ret_t of read.
+} npa_sample_t;
+
+/** @brief Sample queue. Initialize with @ref npa_ring_init. */
+typedef struct
+{
+    npa_sample_t * buffer;  //!< Storage of capacity samples.
+    uint32_t mask;          //!< Capacity - 1.
+    npa_atomic_u32_t head;  //!< Count of pushed samples, written only by producer.
+    npa_atomic_u32_t tail;  //!< Count of popped samples, written only by consumer.
+} npa_ring_t;
+
+/**
+ * @brief Initialize an empty queue.
+ *
+ * @param[out] ring     Queue to initialize.
+ * @param[in]  buffer   Storage of queue.
+ * @param[in]  capacity Number of samples in storage, a power of two up to 2^31.
+ * @retval NPA_SUCCESS   Queue was initialized.
+ * @retval NPA_ERR_NULL  Ring or buffer was NULL.
+ * @retval NPA_ERR_PARAM Capacity is not a power of two.
+ */
+npa_ret_t npa_ring_init (npa_ring_t * const ring, npa_sample_t * const buffer,
+                         const size_t capacity);
+
+/**
+ * @brief Push a sample. Call only from producer context.
+ *
+ * @param[in,out] ring   Queue to push to.
+ * @param[in]     sample Sample to copy into queue.
+ * @return true if sample was queued, false if queue is full.
+ */
+bool npa_ring_push (npa_ring_t * const ring, const npa_sample_t * const sample);
+
+/**
+ * @brief Pop up to max_samples samples. Call only from consumer context.
+ *
+ * @param[in,out] ring        Queue to pop from.
+ * @param[out]    samples     Array to copy samples to, oldest first.
+ * @param[in]     max_samples Size of samples array.
+ * @return Number of samples popped.
+ */
+size_t npa_ring_pop_bulk (npa_ring_t * const ring, npa_sample_t * const samples,
+                          const size_t max_samples);
+
+/**
+ * @brief Get number of queued samples.
+ *
+ * Result is exact in consumer and producer contexts, otherwise a snapshot.
+ *
+ * @param[in] ring Queue to check.
+ * @return Number of samples in queue.
+ */
+size_t npa_ring_count (const npa_ring_t * const ring);
+
+/** @} */
+#endif // NPA_700_RING_H
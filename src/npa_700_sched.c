@@ -0,0 +1,194 @@
+#include "npa_700_sched.h"
+
+#include <string.h>
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_sched.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * Times are compared as signed difference of wrapping microsecond counters, so
+ * delays must stay below 2^31 us.
+ */
+
+#define NPA_SCHED_RATE_ONE (65536U) //!< Stale rate of every fetch, Q16.
+
+static bool time_reached (const uint32_t now_us, const uint32_t time_us)
+{
+    return (int32_t) (now_us - time_us) >= 0;
+}
+
+npa_ret_t npa_sched_init (npa_sched_t * const sched, const npa_sched_cfg_t * const cfg,
+                          const npa_ctx_t * const sensors, npa_sched_slot_t * const slots,
+                          const size_t num_sensors)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == sched) || (NULL == cfg) || (NULL == sensors) || (NULL == slots)
+            || (NULL == cfg->now_us) || (NULL == cfg->callback))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (0U == num_sensors) || (cfg->min_delay_us > cfg->max_delay_us)
+              || (cfg->initial_delay_us < cfg->min_delay_us)
+              || (cfg->initial_delay_us > cfg->max_delay_us)
+              || ( (uint32_t) INT32_MAX < cfg->max_delay_us))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        sched->cfg = *cfg;
+        sched->sensors = sensors;
+        sched->slots = slots;
+        sched->num_sensors = num_sensors;
+        sched->pending = 0U;
+        memset (slots, 0, num_sensors * sizeof (npa_sched_slot_t));
+
+        for (size_t ii = 0U; ii < num_sensors; ii++)
+        {
+            slots[ii].delay_us = cfg->initial_delay_us;
+        }
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_sched_start (npa_sched_t * const sched)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if (NULL == sched)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if (0U != sched->pending)
+    {
+        ret_code |= NPA_ERR_BUSY;
+    }
+    else
+    {
+        for (size_t ii = 0U; ii < sched->num_sensors; ii++)
+        {
+            npa_sched_slot_t * const slot = &sched->slots[ii];
+            const npa_ret_t trigger = npa_sample_trigger (&sched->sensors[ii]);
+            slot->trigger_us = sched->cfg.now_us();
+            slot->retries = 0U;
+
+            if (NPA_SUCCESS == trigger)
+            {
+                slot->due_us = slot->trigger_us + slot->delay_us;
+                slot->pending = true;
+                sched->pending++;
+            }
+            else
+            {
+                ret_code |= trigger;
+                sched->cfg.callback (ii, trigger, 0.0F, 0U, sched->cfg.p_context);
+            }
+        }
+    }
+
+    return ret_code;
+}
+
+static void update_rate (npa_sched_slot_t * const slot, const bool stale)
+{
+    const uint32_t sample = stale ? NPA_SCHED_RATE_ONE : 0U;
+    slot->stale_rate_q16 = slot->stale_rate_q16
+                           - (slot->stale_rate_q16 >> NPA_SCHED_RATE_SHIFT)
+                           + (sample >> NPA_SCHED_RATE_SHIFT);
+}
+
+static void fetch (npa_sched_t * const sched, const size_t index)
+{
+    npa_sched_slot_t * const slot = &sched->slots[index];
+    const npa_sched_cfg_t * const cfg = &sched->cfg;
+    float pressure_pa = 0.0F;
+    const npa_ret_t status = npa_read_pressure (&sched->sensors[index], &pressure_pa);
+    const uint32_t now_us = cfg->now_us();
+    const bool stale = (0U == (status & NPA_ERR_FATAL)) && (0U != (status & NPA_WARN_OLD));
+
+    if (0U == (status & NPA_ERR_FATAL))
+    {
+        update_rate (slot, stale);
+    }
+
+    if (stale)
+    {
+        // Conversion was not done: fetch was too early for this sensor.
+        const uint32_t grown = slot->delay_us + (slot->delay_us >> NPA_SCHED_GROW_SHIFT) + 1U;
+        slot->delay_us = (grown > cfg->max_delay_us) ? cfg->max_delay_us : grown;
+    }
+    else if ( (0U == slot->retries) && (0U == (status & NPA_ERR_FATAL)))
+    {
+        const uint32_t shrunk = slot->delay_us - (slot->delay_us >> NPA_SCHED_SHRINK_SHIFT);
+        slot->delay_us = (shrunk < cfg->min_delay_us) ? cfg->min_delay_us : shrunk;
+    }
+    else
+    {
+        // Fresh data after retries or a bus error, keep delay.
+    }
+
+    if (stale && (slot->retries < cfg->max_retries))
+    {
+        slot->retries++;
+        slot->due_us = now_us + (slot->delay_us >> NPA_SCHED_RETRY_SHIFT) + 1U;
+    }
+    else
+    {
+        slot->pending = false;
+        sched->pending--;
+        cfg->callback (index, status, pressure_pa, now_us - slot->trigger_us,
+                       cfg->p_context);
+    }
+}
+
+size_t npa_sched_poll (npa_sched_t * const sched)
+{
+    size_t pending = 0U;
+
+    if (NULL != sched)
+    {
+        for (size_t ii = 0U; ii < sched->num_sensors; ii++)
+        {
+            if (sched->slots[ii].pending
+                    && time_reached (sched->cfg.now_us(), sched->slots[ii].due_us))
+            {
+                fetch (sched, ii);
+            }
+        }
+
+        pending = sched->pending;
+    }
+
+    return pending;
+}
+
+bool npa_sched_next_due (const npa_sched_t * const sched, uint32_t * const due_us)
+{
+    bool found = false;
+
+    if ( (NULL != sched) && (NULL != due_us))
+    {
+        for (size_t ii = 0U; ii < sched->num_sensors; ii++)
+        {
+            const npa_sched_slot_t * const slot = &sched->slots[ii];
+
+            if (slot->pending && ( (!found) || time_reached (*due_us, slot->due_us)))
+            {
+                *due_us = slot->due_us;
+                found = true;
+            }
+        }
+    }
+
+    return found;
+}
+
+/** @} */
@@ -0,0 +1,134 @@
+#ifndef NPA_700_SCHED_H
+#define NPA_700_SCHED_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_sched.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Pipelined trigger and fetch of sleep mode sensors.
+ *
+ * Sleep mode sensors start a conversion on @ref npa_sample_trigger and return stale
+ * data until the conversion is done. Scheduler triggers all sensors back to back so
+ * their conversions overlap, and then fetches each sensor once its fetch delay has
+ * passed since its own trigger.
+ *
+ * Fetch delay is tuned per sensor: a stale fetch, @ref NPA_WARN_OLD, grows the delay
+ * by 1/8 and a fresh fetch on first attempt shrinks it by 1/64. Delay settles just
+ * above the conversion time, with about one stale fetch per eight cycles.
+ *
+ * Scheduler never blocks. Application calls @ref npa_sched_start to begin a cycle and
+ * then @ref npa_sched_poll until no fetches are pending, e.g. from a timer set to
+ * @ref npa_sched_next_due.
+ */
+
+#include "npa_700.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define NPA_SCHED_GROW_SHIFT   (3U) //!< Delay grows by 1/2^3 on stale fetch.
+#define NPA_SCHED_SHRINK_SHIFT (6U) //!< Delay shrinks by 1/2^6 on fresh fetch.
+#define NPA_SCHED_RETRY_SHIFT  (4U) //!< Stale fetch is retried after delay/2^4.
+#define NPA_SCHED_RATE_SHIFT   (4U) //!< Stale rate averages over about 2^4 fetches.
+
+/**
+ * @brief Handle result of a scheduled read.
+ *
+ * @param[in] index       Index of sensor in array given to @ref npa_sched_init.
+ * @param[in] status      @ref npa_ret_t of trigger and fetch.
+ * @param[in] pressure_pa Pressure in pascals.
+ * @param[in] latency_us  Time from trigger to end of successful fetch.
+ * @param[in] p_context   Context given in configuration.
+ */
+typedef void (*npa_sched_cb) (const size_t index, const npa_ret_t status,
+                              const float pressure_pa, const uint32_t latency_us,
+                              void * const p_context);
+
+/** @brief Configuration of scheduler. */
+typedef struct
+{
+    npa_clock_fp now_us;       //!< Clock, must not be NULL.
+    npa_sched_cb callback;     //!< Result handler, must not be NULL.
+    void * p_context;          //!< Application context, not used by scheduler.
+    uint32_t initial_delay_us; //!< Fetch delay before tuning.
+    uint32_t min_delay_us;     //!< Lower limit of tuned delay.
+    uint32_t max_delay_us;     //!< Upper limit of tuned delay.
+    uint8_t max_retries;       //!< Stale fetches retried before giving up.
+} npa_sched_cfg_t;
+
+/** @brief Scheduling state of one sensor. */
+typedef struct
+{
+    uint32_t trigger_us;     //!< Time of last trigger.
+    uint32_t due_us;         //!< Time of next fetch.
+    uint32_t delay_us;       //!< Tuned fetch delay.
+    uint32_t stale_rate_q16; //!< Moving average of stale fetches, Q16.
+    uint8_t retries;         //!< Stale fetches in this cycle.
+    bool pending;            //!< Fetch is pending.
+} npa_sched_slot_t;
+
+/** @brief Scheduler. Initialize with @ref npa_sched_init. */
+typedef struct
+{
+    npa_sched_cfg_t cfg;         //!< Configuration.
+    const npa_ctx_t * sensors;   //!< Scheduled sensors.
+    npa_sched_slot_t * slots;    //!< State of each sensor.
+    size_t num_sensors;          //!< Number of sensors.
+    size_t pending;              //!< Number of pending fetches.
+} npa_sched_t;
+
+/**
+ * @brief Initialize scheduler.
+ *
+ * @param[out] sched       Scheduler to initialize.
+ * @param[in]  cfg         Configuration, copied to scheduler.
+ * @param[in]  sensors     Array of sensors, must stay valid.
+ * @param[in]  slots       Array of slots, one per sensor, must stay valid.
+ * @param[in]  num_sensors Number of sensors.
+ * @retval NPA_SUCCESS   Scheduler was initialized.
+ * @retval NPA_ERR_NULL  A pointer was NULL.
+ * @retval NPA_ERR_PARAM No sensors or delay limits are inconsistent.
+ */
+npa_ret_t npa_sched_init (npa_sched_t * const sched, const npa_sched_cfg_t * const cfg,
+                          const npa_ctx_t * const sensors, npa_sched_slot_t * const slots,
+                          const size_t num_sensors);
+
+/**
+ * @brief Trigger all sensors and schedule their fetches.
+ *
+ * Sensors whose trigger fails are reported to callback immediately.
+ *
+ * @param[in,out] sched Scheduler.
+ * @retval NPA_SUCCESS  Cycle was started.
+ * @retval NPA_ERR_NULL Scheduler was NULL.
+ * @retval NPA_ERR_BUSY Previous cycle has pending fetches.
+ * @return Combined status of failed triggers otherwise.
+ */
+npa_ret_t npa_sched_start (npa_sched_t * const sched);
+
+/**
+ * @brief Fetch sensors which are due.
+ *
+ * @param[in,out] sched Scheduler.
+ * @return Number of fetches still pending.
+ */
+size_t npa_sched_poll (npa_sched_t * const sched);
+
+/**
+ * @brief Time of earliest pending fetch.
+ *
+ * @param[in]  sched  Scheduler.
+ * @param[out] due_us Time of earliest pending fetch.
+ * @return true if a fetch is pending.
+ */
+bool npa_sched_next_due (const npa_sched_t * const sched, uint32_t * const due_us);
+
+/** @} */
+#endif // NPA_700_SCHED_H
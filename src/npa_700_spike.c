@@ -0,0 +1,192 @@
+#include "npa_700_spike.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_spike.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * Deviation limit is computed in 32 bits: MAD is at most 14 bits and scale 16 bits.
+ */
+
+// Index of first sorted sample not less than value.
+static uint8_t lower_bound (const uint16_t * const sorted, const uint8_t count,
+                            const uint16_t value)
+{
+    uint8_t low = 0U;
+    uint8_t high = count;
+
+    while (low < high)
+    {
+        const uint8_t mid = (uint8_t) ( (low + high) / 2U);
+
+        if (sorted[mid] < value)
+        {
+            low = (uint8_t) (mid + 1U);
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+// Grow window by one sample while it fills.
+static void insert (npa_spike_t * const spike, const uint16_t counts)
+{
+    const uint8_t pos = lower_bound (spike->sorted, spike->count, counts);
+    (void) memmove (&spike->sorted[pos + 1U], &spike->sorted[pos],
+                    (size_t) (spike->count - pos) * sizeof (uint16_t));
+    spike->sorted[pos] = counts;
+    spike->history[spike->count] = counts;
+    spike->count++;
+}
+
+// Replace oldest sample of a full window with counts.
+static void slide (npa_spike_t * const spike, const uint16_t counts)
+{
+    const uint8_t window = spike->cfg.window;
+    uint8_t pos = lower_bound (spike->sorted, window, spike->history[spike->oldest]);
+    spike->history[spike->oldest] = counts;
+    spike->oldest = (uint8_t) ( (spike->oldest + 1U) % window);
+
+    // Shift samples between old and new position over the removed one.
+    while ( ( (pos + 1U) < window) && (spike->sorted[pos + 1U] < counts))
+    {
+        spike->sorted[pos] = spike->sorted[pos + 1U];
+        pos++;
+    }
+
+    while ( (pos > 0U) && (spike->sorted[pos - 1U] > counts))
+    {
+        spike->sorted[pos] = spike->sorted[pos - 1U];
+        pos--;
+    }
+
+    spike->sorted[pos] = counts;
+}
+
+// Median of deviations from median of full window.
+static uint16_t median_deviation (const npa_spike_t * const spike)
+{
+    const uint8_t center = spike->cfg.window / 2U;
+    const uint16_t median = spike->sorted[center];
+    uint8_t left = 1U;
+    uint8_t right = 1U;
+    uint16_t deviation = 0U;
+
+    // Deviation of median itself is 0 and first in order, MAD is center steps further.
+    // Each side has center samples, an exhausted side is never taken again.
+    // Selects instead of branches, as the side taken is data dependent.
+    for (uint8_t ii = 0U; ii < center; ii++)
+    {
+        const uint16_t left_dev = (left <= center)
+                                  ? (uint16_t) (median - spike->sorted[center - left])
+                                  : UINT16_MAX;
+        const uint16_t right_dev = (right <= center)
+                                   ? (uint16_t) (spike->sorted[center + right] - median)
+                                   : UINT16_MAX;
+        const bool take_left = (left_dev <= right_dev);
+        deviation = take_left ? left_dev : right_dev;
+        left = (uint8_t) (left + (take_left ? 1U : 0U));
+        right = (uint8_t) (right + (take_left ? 0U : 1U));
+    }
+
+    return deviation;
+}
+
+npa_ret_t npa_spike_init (npa_spike_t * const spike, const npa_spike_cfg_t * const cfg)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == spike) || (NULL == cfg))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (NPA_SPIKE_MIN_WINDOW > cfg->window) || (NPA_SPIKE_MAX_WINDOW < cfg->window)
+              || (0U == (cfg->window & 1U)))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        memset (spike, 0, sizeof (npa_spike_t));
+        spike->cfg = *cfg;
+    }
+
+    return ret_code;
+}
+
+void npa_spike_reset (npa_spike_t * const spike)
+{
+    if (NULL != spike)
+    {
+        spike->count = 0U;
+        spike->oldest = 0U;
+    }
+}
+
+npa_ret_t npa_spike_push (npa_spike_t * const spike, const uint16_t counts,
+                          const npa_ret_t status, uint16_t * const output)
+{
+    npa_ret_t ret_code = status;
+
+    if ( (NULL == spike) || (NULL == output) || (0U == spike->cfg.window))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        const bool usable = (0U == (status & (NPA_ERR_FATAL | NPA_WARN_OLD)));
+        *output = counts;
+
+        if (!usable)
+        {
+            // Not part of signal, passed as it is.
+        }
+        else if (spike->count < spike->cfg.window)
+        {
+            insert (spike, counts);
+        }
+        else
+        {
+            slide (spike, counts);
+            const uint16_t median = npa_spike_median (spike);
+            const uint32_t deviation = (counts > median) ? (uint32_t) (counts - median)
+                                       : (uint32_t) (median - counts);
+            const uint32_t limit = spike->cfg.threshold
+                                   + ( ( (uint32_t) spike->cfg.mad_scale
+                                         * median_deviation (spike)) >> NPA_SPIKE_SCALE_FRAC);
+
+            if (deviation > limit)
+            {
+                *output = median;
+                ret_code |= NPA_WARN_SPIKE;
+
+                if (UINT32_MAX != spike->spikes)
+                {
+                    spike->spikes++;
+                }
+            }
+        }
+    }
+
+    return ret_code;
+}
+
+uint16_t npa_spike_median (const npa_spike_t * const spike)
+{
+    return ( (NULL == spike) || (0U == spike->count)) ? NPA_PRES_MIDDLE
+           : spike->sorted[spike->count / 2U];
+}
+
+/** @} */
@@ -0,0 +1,106 @@
+#ifndef NPA_700_SPIKE_H
+#define NPA_700_SPIKE_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_spike.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Streaming spike rejection of pressure counts.
+ *
+ * Hampel filter over a sliding window of the latest counts, newest sample included.
+ * A sample is a spike if it is further from the median of window than
+ * threshold + mad_scale * MAD, where MAD is the median absolute deviation from
+ * the median. A spike is replaced by the median and flagged with
+ * @ref NPA_WARN_SPIKE. With mad_scale 0 the filter is a median-of-N filter which
+ * replaces only samples further than threshold from median; with both 0 every sample
+ * off the median is replaced, i.e. output is the running median.
+ *
+ * Window is kept sorted incrementally: the oldest sample is found by binary search
+ * and the newest moves into its place by shifting the samples between the two. Cost
+ * per sample is O(window) in the worst case and small for slowly changing signals,
+ * as the two positions are then close to each other. MAD is found by merging
+ * deviations outward from median in window / 2 steps, as both sides of a sorted
+ * window are already sorted by deviation.
+ *
+ * Until the window has filled, samples pass unchanged.
+ */
+
+#include "npa_700.h"
+
+#include <stdint.h>
+
+#define NPA_SPIKE_MIN_WINDOW   (3U)  //!< Smallest window.
+#define NPA_SPIKE_MAX_WINDOW   (31U) //!< Largest window.
+#define NPA_SPIKE_SCALE_FRAC   (4U)  //!< Fractional bits of mad_scale.
+/** @brief Scale of MAD to standard deviation of normal noise, 1.4826, times 3. */
+#define NPA_SPIKE_SCALE_3SIGMA (71U)
+
+/** @brief Configuration of spike filter. */
+typedef struct
+{
+    uint8_t window;     //!< Samples in window, odd, NPA_SPIKE_MIN_WINDOW...MAX_WINDOW.
+    uint16_t threshold; //!< Deviation always accepted, counts.
+    uint16_t mad_scale; //!< Multiple of MAD accepted, NPA_SPIKE_SCALE_FRAC fractional bits.
+} npa_spike_cfg_t;
+
+/** @brief State of spike filter. Initialize with @ref npa_spike_init. */
+typedef struct
+{
+    npa_spike_cfg_t cfg;                      //!< Configuration.
+    uint16_t history[NPA_SPIKE_MAX_WINDOW];   //!< Samples in order of arrival, ring.
+    uint16_t sorted[NPA_SPIKE_MAX_WINDOW];    //!< Samples in ascending order.
+    uint8_t count;                            //!< Samples in window.
+    uint8_t oldest;                           //!< Position of oldest sample in history.
+    uint32_t spikes;                          //!< Rejected samples, saturating.
+} npa_spike_t;
+
+/**
+ * @brief Initialize spike filter.
+ *
+ * @param[out] spike Filter to initialize.
+ * @param[in]  cfg   Configuration, copied to filter.
+ * @retval NPA_SUCCESS   Filter was initialized.
+ * @retval NPA_ERR_NULL  Filter or configuration was NULL.
+ * @retval NPA_ERR_PARAM Window is even or out of range.
+ */
+npa_ret_t npa_spike_init (npa_spike_t * const spike, const npa_spike_cfg_t * const cfg);
+
+/**
+ * @brief Clear window of a filter, keeping its configuration.
+ *
+ * @param[in,out] spike Filter to reset.
+ */
+void npa_spike_reset (npa_spike_t * const spike);
+
+/**
+ * @brief Push one sample through filter.
+ *
+ * Samples with a fatal status or @ref NPA_WARN_OLD are not added to window and pass
+ * unchanged; a repeated stale value would otherwise weigh the median.
+ *
+ * @param[in,out] spike  Filter.
+ * @param[in]     counts 14-bit pressure counts.
+ * @param[in]     status @ref npa_ret_t of the reading.
+ * @param[out]    output Counts, median of window if sample was rejected.
+ * @return status, with @ref NPA_WARN_SPIKE set if sample was rejected.
+ *         NPA_ERR_NULL if filter or output was NULL.
+ */
+npa_ret_t npa_spike_push (npa_spike_t * const spike, const uint16_t counts,
+                          const npa_ret_t status, uint16_t * const output);
+
+/**
+ * @brief Median of current window.
+ *
+ * @param[in] spike Filter.
+ * @return Median, NPA_PRES_MIDDLE if window is empty.
+ */
+uint16_t npa_spike_median (const npa_spike_t * const spike);
+
+/** @} */
+#endif // NPA_700_SPIKE_H
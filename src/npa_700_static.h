@@ -0,0 +1,177 @@
+#ifndef NPA_700_STATIC_H
+#define NPA_700_STATIC_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_static.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Header-only driver specialized at compile time for a single sensor.
+ *
+ * Regular driver selects scaling at runtime from @ref npa_ctx_t. Firmware with a single
+ * sensor can instead include this header, which makes the scaling compile-time
+ * constants and inlines the conversion into the caller. There is no context to
+ * validate and the read function is called directly rather than through a pointer.
+ *
+ * Configure with defines before including this header:
+ * - NPA_STATIC_VARIANT: Model of the sensor, one of @ref npa_variant_t, e.g.
+ *   NPA_STATIC_VARIANT=NPA_700_001D. Required.
+ * - NPA_STATIC_READ: Name of the I2C read function, signature of @ref npa_read_fp.
+ *   Required, the function must be declared before including this header.
+ * - NPA_STATIC_ADDR: I2C address of the sensor. Optional, default 0x28.
+ *
+ * Results are bit-exact with @ref npa_read_pressure and @ref npa_read_pressure_mpa.
+ */
+
+#include "npa_700.h"
+
+#include <stdint.h>
+
+#ifndef NPA_STATIC_VARIANT
+#error "Define NPA_STATIC_VARIANT to one of npa_variant_t to use static driver."
+#endif
+
+#ifndef NPA_STATIC_READ
+#error "Define NPA_STATIC_READ to the I2C read function to use static driver."
+#endif
+
+#ifndef NPA_STATIC_ADDR
+#define NPA_STATIC_ADDR (0x28U) //!< Default address of NPA-700.
+#endif
+
+// Name of each variant in scale definitions of npa_700.h, for token pasting below.
+#define NPA_700_02WD_STATIC_NAME 02WD
+#define NPA_700_05WD_STATIC_NAME 05WD
+#define NPA_700_10WD_STATIC_NAME 10WD
+#define NPA_700_001D_STATIC_NAME 001D
+#define NPA_700_005D_STATIC_NAME 005D
+#define NPA_700_015D_STATIC_NAME 015D
+#define NPA_700_030D_STATIC_NAME 030D
+
+#define NPA_STATIC_PASTE(prefix, name, suffix)  prefix ## name ## suffix
+#define NPA_STATIC_XPASTE(prefix, name, suffix) NPA_STATIC_PASTE (prefix, name, suffix)
+#define NPA_STATIC_NAME NPA_STATIC_XPASTE (, NPA_STATIC_VARIANT, _STATIC_NAME)
+
+/** @brief Scale of the selected variant in pascals. */
+#define NPA_STATIC_SCALE_PA NPA_STATIC_XPASTE (NPA_, NPA_STATIC_NAME, _SCALE_PA)
+
+/** @brief Scale of the selected variant in integer pascals. */
+#define NPA_STATIC_SCALE_PA_INT NPA_STATIC_XPASTE (NPA_, NPA_STATIC_NAME, _SCALE_PA_INT)
+
+/** @brief Pascals per count, P = OUT * gain + offset. */
+#define NPA_STATIC_GAIN NPA_GAIN (NPA_STATIC_SCALE_PA)
+
+/** @brief Pascals at 0 counts, P = OUT * gain + offset. */
+#define NPA_STATIC_OFFSET NPA_OFFSET (NPA_STATIC_SCALE_PA)
+
+/** @brief Millipascals per count pair, see @ref NPA_INT_GAIN. */
+#define NPA_STATIC_GAIN_MPA NPA_INT_GAIN ( (uint64_t) NPA_STATIC_SCALE_PA_INT * 1000U)
+
+/** @brief Millipascals subtracted after scaling, see @ref NPA_INT_OFFSET. */
+#define NPA_STATIC_OFFSET_MPA NPA_INT_OFFSET ( (uint64_t) NPA_STATIC_SCALE_PA_INT * 1000U)
+
+/**
+ * @brief Parse status and pressure counts of a raw frame.
+ *
+ * @param[in]  raw_data First two bytes of frame read from sensor.
+ * @param[out] counts   14-bit pressure counts.
+ * @return @ref npa_ret_t of frame.
+ */
+static inline npa_ret_t npa_static_parse (const uint8_t * const raw_data,
+        uint16_t * const counts)
+{
+    static const npa_ret_t status_codes[4U] =
+    {
+        NPA_SUCCESS,
+        NPA_ERR_MODE,
+        NPA_WARN_OLD,
+        NPA_ERR_FATAL
+    };
+    npa_ret_t ret_code = status_codes[raw_data[0U] >> 6U];
+    *counts = (uint16_t) ( ( ( (uint32_t) raw_data[0U] << 8U)
+                             + (uint32_t) raw_data[1U])
+                           & 0x3FFFU);
+
+    if ( (NPA_PRES_MIN_NONSAT > *counts) || (NPA_PRES_MAX_NONSAT < *counts))
+    {
+        ret_code |= NPA_WARN_SAT;
+    }
+
+    return ret_code;
+}
+
+/**
+ * @brief Trigger NPA sampling operation.
+ *
+ * @return @ref npa_ret_t.
+ */
+static inline npa_ret_t npa_static_sample_trigger (void)
+{
+    return NPA_STATIC_READ (NPA_STATIC_ADDR, NULL, 0U);
+}
+
+/**
+ * @brief Read pressure from sensor.
+ *
+ * @param[out] pressure_pa Pressure in pascals.
+ * @return @ref npa_ret_t.
+ */
+static inline npa_ret_t npa_static_read_pressure (float * const pressure_pa)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if (NULL == pressure_pa)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        // Initialize raw data as all bits set, as it sets internal error code on
+        // by default.
+        uint8_t raw_data[2U] = { 0xFFU, 0xFFU };
+        uint16_t counts = 0U;
+        ret_code |= NPA_STATIC_READ (NPA_STATIC_ADDR, raw_data, sizeof (raw_data));
+        ret_code |= npa_static_parse (raw_data, &counts);
+        *pressure_pa = ( (float) counts * NPA_STATIC_GAIN) + NPA_STATIC_OFFSET;
+    }
+
+    return ret_code;
+}
+
+/**
+ * @brief Read pressure from sensor in integer millipascals.
+ *
+ * @param[out] pressure_mpa Pressure in millipascals.
+ * @return @ref npa_ret_t.
+ */
+static inline npa_ret_t npa_static_read_pressure_mpa (int32_t * const pressure_mpa)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if (NULL == pressure_mpa)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        uint8_t raw_data[2U] = { 0xFFU, 0xFFU };
+        uint16_t counts = 0U;
+        ret_code |= NPA_STATIC_READ (NPA_STATIC_ADDR, raw_data, sizeof (raw_data));
+        ret_code |= npa_static_parse (raw_data, &counts);
+        const uint64_t OUT2 = (2U * (uint64_t) counts) + NPA_INT_BIAS;
+        const uint64_t scaled = ( (OUT2 * NPA_STATIC_GAIN_MPA)
+                                  + ( (uint64_t) 1U << (NPA_INT_SHIFT - 1U)))
+                                >> NPA_INT_SHIFT;
+        *pressure_mpa = (int32_t) ( (int64_t) scaled - (int64_t) NPA_STATIC_OFFSET_MPA);
+    }
+
+    return ret_code;
+}
+
+/** @} */
+#endif // NPA_700_STATIC_H
@@ -0,0 +1,259 @@
+#include "npa_700_stats.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_stats.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * Block is protected by a sequence lock of npa_700_atomic.h, its writer is the
+ * context which reads the sensor.
+ */
+
+static void clear_fields (npa_stats_t * const stats)
+{
+    npa_atomic_store_relaxed (&stats->reads, 0U);
+    npa_atomic_store_relaxed (&stats->nack, 0U);
+    npa_atomic_store_relaxed (&stats->tout, 0U);
+    npa_atomic_store_relaxed (&stats->mode, 0U);
+    npa_atomic_store_relaxed (&stats->fatal, 0U);
+
+    for (size_t ii = 0U; ii < NPA_STATS_NUM_WARNINGS; ii++)
+    {
+        npa_atomic_store_relaxed (&stats->warnings[ii], 0U);
+    }
+
+    npa_atomic_store_relaxed (&stats->latency_count, 0U);
+    npa_atomic_store_relaxed (&stats->latency_min_us, UINT32_MAX);
+    npa_atomic_store_relaxed (&stats->latency_max_us, 0U);
+    npa_atomic_store_relaxed (&stats->latency_sum_lo, 0U);
+    npa_atomic_store_relaxed (&stats->latency_sum_hi, 0U);
+
+    for (size_t ii = 0U; ii < NPA_STATS_HIST_BINS; ii++)
+    {
+        npa_atomic_store_relaxed (&stats->histogram[ii], 0U);
+    }
+}
+
+// Error codes share bits with warnings, bus errors are checked first.
+static void record_status (npa_stats_t * const stats, const npa_ret_t status)
+{
+    const npa_ret_t code = status & ~NPA_ERR_FATAL;
+
+    if (0U == (status & NPA_ERR_FATAL))
+    {
+        for (size_t ii = 0U; ii < NPA_STATS_NUM_WARNINGS; ii++)
+        {
+            if (0U != (status & (1UL << ii)))
+            {
+                npa_atomic_add_single (&stats->warnings[ii], 1U);
+            }
+        }
+    }
+    else if (0U != (code & NPA_ERR_TOUT))
+    {
+        npa_atomic_add_single (&stats->tout, 1U);
+    }
+    else if (0U != (code & NPA_ERR_NACK))
+    {
+        npa_atomic_add_single (&stats->nack, 1U);
+    }
+    else if (0U != (code & NPA_ERR_MODE))
+    {
+        npa_atomic_add_single (&stats->mode, 1U);
+    }
+    else
+    {
+        npa_atomic_add_single (&stats->fatal, 1U);
+    }
+}
+
+static size_t histogram_bin (const uint32_t latency_us)
+{
+    size_t bin = 0U;
+
+    for (uint32_t rest = latency_us; (0U != rest) && (bin < (NPA_STATS_HIST_BINS - 1U));
+            rest >>= 1U)
+    {
+        bin++;
+    }
+
+    return bin;
+}
+
+static void record_latency (npa_stats_t * const stats, const uint32_t latency_us)
+{
+    const uint32_t sum_lo = npa_atomic_load_relaxed (&stats->latency_sum_lo) + latency_us;
+
+    if (sum_lo < latency_us)
+    {
+        npa_atomic_add_single (&stats->latency_sum_hi, 1U);
+    }
+
+    npa_atomic_store_relaxed (&stats->latency_sum_lo, sum_lo);
+    npa_atomic_add_single (&stats->latency_count, 1U);
+    npa_atomic_add_single (&stats->histogram[histogram_bin (latency_us)], 1U);
+
+    if (latency_us < npa_atomic_load_relaxed (&stats->latency_min_us))
+    {
+        npa_atomic_store_relaxed (&stats->latency_min_us, latency_us);
+    }
+
+    if (latency_us > npa_atomic_load_relaxed (&stats->latency_max_us))
+    {
+        npa_atomic_store_relaxed (&stats->latency_max_us, latency_us);
+    }
+}
+
+npa_ret_t npa_stats_init (npa_stats_t * const stats, const npa_clock_fp clock)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if (NULL == stats)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        memset (stats, 0, sizeof (npa_stats_t));
+        stats->clock = clock;
+        clear_fields (stats);
+    }
+
+    return ret_code;
+}
+
+uint32_t npa_stats_now (const npa_stats_t * const stats)
+{
+    return ( (NULL != stats) && (NULL != stats->clock)) ? stats->clock() : 0U;
+}
+
+void npa_stats_record (npa_stats_t * const stats, const npa_ret_t status,
+                       const uint32_t start_us, const uint32_t end_us)
+{
+    if (NULL != stats)
+    {
+        const uint32_t reset_request = npa_atomic_load_acquire (&stats->reset_request);
+        const uint32_t sequence = npa_seqlock_write_begin (&stats->sequence);
+
+        if (reset_request != stats->reset_seen)
+        {
+            stats->reset_seen = reset_request;
+            clear_fields (stats);
+        }
+
+        npa_atomic_add_single (&stats->reads, 1U);
+        record_status (stats, status);
+
+        if (NULL != stats->clock)
+        {
+            record_latency (stats, end_us - start_us);
+        }
+
+        npa_seqlock_write_end (&stats->sequence, sequence);
+    }
+}
+
+/**
+ * @brief Copy fields of block, consistent only if sequence did not change.
+ *
+ * @param[in]  stats    Block to read.
+ * @param[out] snapshot Copy of fields.
+ * @param[out] sum_us   Sum of latencies.
+ * @return true if copy is consistent.
+ */
+static bool try_snapshot (const npa_stats_t * const stats,
+                          npa_stats_snapshot_t * const snapshot,
+                          uint64_t * const sum_us)
+{
+    const uint32_t before = npa_seqlock_read_begin (&stats->sequence);
+    snapshot->reads = npa_atomic_load_relaxed (&stats->reads);
+    snapshot->nack = npa_atomic_load_relaxed (&stats->nack);
+    snapshot->tout = npa_atomic_load_relaxed (&stats->tout);
+    snapshot->mode = npa_atomic_load_relaxed (&stats->mode);
+    snapshot->fatal = npa_atomic_load_relaxed (&stats->fatal);
+
+    for (size_t ii = 0U; ii < NPA_STATS_NUM_WARNINGS; ii++)
+    {
+        snapshot->warnings[ii] = npa_atomic_load_relaxed (&stats->warnings[ii]);
+    }
+
+    snapshot->latency_count = npa_atomic_load_relaxed (&stats->latency_count);
+    snapshot->latency_min_us = npa_atomic_load_relaxed (&stats->latency_min_us);
+    snapshot->latency_max_us = npa_atomic_load_relaxed (&stats->latency_max_us);
+    *sum_us = ( (uint64_t) npa_atomic_load_relaxed (&stats->latency_sum_hi) << 32U)
+              | npa_atomic_load_relaxed (&stats->latency_sum_lo);
+
+    for (size_t ii = 0U; ii < NPA_STATS_HIST_BINS; ii++)
+    {
+        snapshot->histogram[ii] = npa_atomic_load_relaxed (&stats->histogram[ii]);
+    }
+
+    return npa_seqlock_read_valid (&stats->sequence, before);
+}
+
+npa_ret_t npa_stats_snapshot (const npa_stats_t * const stats,
+                              npa_stats_snapshot_t * const snapshot)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == stats) || (NULL == snapshot))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        uint64_t sum_us = 0U;
+        bool consistent = false;
+
+        for (uint32_t tries = 0U; (!consistent) && (tries < NPA_SEQLOCK_TRIES); tries++)
+        {
+            consistent = try_snapshot (stats, snapshot, &sum_us);
+        }
+
+        if (!consistent)
+        {
+            memset (snapshot, 0, sizeof (npa_stats_snapshot_t));
+            ret_code |= NPA_ERR_BUSY;
+        }
+        else if (0U == snapshot->latency_count)
+        {
+            snapshot->latency_min_us = 0U;
+            snapshot->latency_mean_us = 0U;
+        }
+        else
+        {
+            snapshot->latency_mean_us = (uint32_t) (sum_us / snapshot->latency_count);
+        }
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_stats_reset (npa_stats_t * const stats)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if (NULL == stats)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else
+    {
+        // Any value other than the one last seen by writer requests a reset, so
+        // concurrent requests cannot cancel each other.
+        npa_atomic_store_release (&stats->reset_request,
+                                  npa_atomic_load_relaxed (&stats->reset_request) + 1U);
+    }
+
+    return ret_code;
+}
+
+/** @} */
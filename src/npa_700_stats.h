@@ -0,0 +1,148 @@
+#ifndef NPA_700_STATS_H
+#define NPA_700_STATS_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_stats.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Read statistics of a sensor.
+ *
+ * When driver is built with @ref NPA_STATS set to 1, every read of a sensor which has
+ * a statistics block updates it: number of reads, number of failed reads by error,
+ * number of other reads with each warning bit of @ref npa_ret_t set and latency of
+ * the I2C transfer. Latency is measured with the clock given to @ref npa_stats_init;
+ * without a clock only status is counted.
+ *
+ * Error codes share bits with warnings, e.g. @ref NPA_ERR_NACK has the bit of
+ * @ref NPA_WARN_SAT, so a failed read is counted only by its error. A failed read may
+ * also carry warnings of the all-ones frame, so errors are told apart in order
+ * timeout, NACK, mode. A diagnostic status with saturated counts counts as NACK.
+ *
+ * Block has a single writer, the context which reads the sensor. Any other context,
+ * e.g. a diagnostics task, may take a consistent snapshot of the block and request a
+ * reset while reads are in progress. Snapshot retries if a read updates the block
+ * meanwhile, reset is applied by the writer on the next read.
+ */
+
+#include "npa_700.h"
+#include "npa_700_atomic.h"
+
+#include <stdint.h>
+
+#define NPA_STATS_NUM_WARNINGS (7U) //!< Counted warning bits of @ref npa_ret_t.
+#define NPA_STATS_HIST_BINS (16U) //!< Bins of latency histogram.
+
+/**
+ * @brief Statistics block of a sensor. Initialize with @ref npa_stats_init.
+ *
+ * Fields are updated by driver only, read them with @ref npa_stats_snapshot.
+ */
+struct npa_stats_s
+{
+    npa_clock_fp clock;                  //!< Latency clock, may be NULL.
+    npa_atomic_u32_t sequence;           //!< Odd while writer updates the block.
+    npa_atomic_u32_t reset_request;      //!< Incremented to request a reset.
+    uint32_t reset_seen;                 //!< Last reset request applied by writer.
+    npa_atomic_u32_t reads;              //!< Number of reads.
+    npa_atomic_u32_t nack;               //!< Reads failed by @ref NPA_ERR_NACK.
+    npa_atomic_u32_t tout;               //!< Reads failed by @ref NPA_ERR_TOUT.
+    npa_atomic_u32_t mode;               //!< Reads failed by @ref NPA_ERR_MODE.
+    npa_atomic_u32_t fatal;              //!< Reads failed by other fatal errors.
+    npa_atomic_u32_t warnings[NPA_STATS_NUM_WARNINGS]; //!< Reads without fatal error
+    //!< with bit n of status set.
+    npa_atomic_u32_t latency_count;      //!< Number of timed reads.
+    npa_atomic_u32_t latency_min_us;     //!< Shortest latency, UINT32_MAX if none.
+    npa_atomic_u32_t latency_max_us;     //!< Longest latency.
+    npa_atomic_u32_t latency_sum_lo;     //!< Sum of latencies, low word.
+    npa_atomic_u32_t latency_sum_hi;     //!< Sum of latencies, high word.
+    npa_atomic_u32_t histogram[NPA_STATS_HIST_BINS]; //!< Log2 latency histogram.
+};
+
+/**
+ * @brief Consistent copy of a statistics block.
+ *
+ * Bin 0 of histogram counts latencies of 0 us, bin n latencies of 2^(n-1) ...
+ * 2^n - 1 us, and last bin everything from 2^(@ref NPA_STATS_HIST_BINS - 2) us up.
+ */
+typedef struct
+{
+    uint32_t reads;                          //!< Number of reads.
+    uint32_t nack;                           //!< Reads failed by @ref NPA_ERR_NACK.
+    uint32_t tout;                           //!< Reads failed by @ref NPA_ERR_TOUT.
+    uint32_t mode;                           //!< Reads failed by @ref NPA_ERR_MODE.
+    uint32_t fatal;                          //!< Reads failed by other fatal errors.
+    uint32_t warnings[NPA_STATS_NUM_WARNINGS]; //!< Non-failed reads with bit n set.
+    uint32_t latency_count;                  //!< Number of timed reads.
+    uint32_t latency_min_us;                 //!< Shortest latency, 0 if none.
+    uint32_t latency_max_us;                 //!< Longest latency.
+    uint32_t latency_mean_us;                //!< Mean latency, rounded down.
+    uint32_t histogram[NPA_STATS_HIST_BINS]; //!< Log2 latency histogram.
+} npa_stats_snapshot_t;
+
+/**
+ * @brief Initialize a statistics block.
+ *
+ * @param[out] stats Block to initialize.
+ * @param[in]  clock Clock for latency, NULL to count only status.
+ * @retval NPA_SUCCESS  Block was initialized.
+ * @retval NPA_ERR_NULL Block was NULL.
+ */
+npa_ret_t npa_stats_init (npa_stats_t * const stats, const npa_clock_fp clock);
+
+/**
+ * @brief Read clock of a statistics block.
+ *
+ * @param[in] stats Block to read clock of, may be NULL.
+ * @return Current time, 0 if block or clock is NULL.
+ */
+uint32_t npa_stats_now (const npa_stats_t * const stats);
+
+/**
+ * @brief Record a read.
+ *
+ * Called by driver, only from the context which reads the sensor.
+ *
+ * @param[in,out] stats    Block to update, NULL is ignored.
+ * @param[in]     status   Result of the read, @ref npa_ret_t.
+ * @param[in]     start_us Clock before the transfer.
+ * @param[in]     end_us   Clock after the transfer.
+ */
+void npa_stats_record (npa_stats_t * const stats, const npa_ret_t status,
+                       const uint32_t start_us, const uint32_t end_us);
+
+/**
+ * @brief Take a consistent snapshot of a statistics block.
+ *
+ * Safe to call from any context. Fails only if the block is updated during
+ * every one of @ref NPA_SEQLOCK_TRIES attempts, or if the writer has been
+ * interrupted by the caller in the middle of an update.
+ *
+ * @param[in]  stats    Block to read.
+ * @param[out] snapshot Copy of the block.
+ * @retval NPA_SUCCESS  Snapshot was taken.
+ * @retval NPA_ERR_NULL Block or snapshot was NULL.
+ * @retval NPA_ERR_BUSY Block was being updated, try again later.
+ */
+npa_ret_t npa_stats_snapshot (const npa_stats_t * const stats,
+                              npa_stats_snapshot_t * const snapshot);
+
+/**
+ * @brief Request a reset of a statistics block.
+ *
+ * Safe to call from any context. Block is cleared before the next read is recorded,
+ * snapshots taken before that still show old values.
+ *
+ * @param[in,out] stats Block to reset.
+ * @retval NPA_SUCCESS  Reset was requested.
+ * @retval NPA_ERR_NULL Block was NULL.
+ */
+npa_ret_t npa_stats_reset (npa_stats_t * const stats);
+
+/** @} */
+#endif // NPA_700_STATS_H
@@ -0,0 +1,174 @@
+#include "npa_700_tcomp.h"
+
+#include <stdbool.h>
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_tcomp.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * Interpolation weights are the low bits of counts, so a sample costs two shifts,
+ * two masks, four loads and four multiplies. The first stage along pressure fits in
+ * 32 bits, 16-bit correction times 14-bit weight; the second stage along temperature
+ * needs 64 bits for the product. Rounding is half away from zero on magnitude, so
+ * corrections are symmetric for positive and negative grids.
+ */
+
+static int32_t round_shift (const int64_t value, const uint32_t shift)
+{
+    const int64_t half = (shift > 0U) ? (INT64_C (1) << (shift - 1U)) : 0;
+    const int64_t magnitude = (value < 0) ? -value : value;
+    const int32_t rounded = (int32_t) ( (magnitude + half) >> shift);
+    return (value < 0) ? -rounded : rounded;
+}
+
+npa_ret_t npa_tcomp_init (npa_tcomp_t * const tcomp, const int16_t * const grid,
+                          const uint8_t p_shift, const uint8_t t_shift)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == tcomp) || (NULL == grid))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (0U == p_shift) || (NPA_TCOMP_P_BITS < p_shift)
+              || (0U == t_shift) || (NPA_TCOMP_T_BITS < t_shift))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        tcomp->grid = grid;
+        tcomp->p_shift = p_shift;
+        tcomp->t_shift = t_shift;
+        tcomp->p_nodes = NPA_TCOMP_P_NODES (p_shift);
+    }
+
+    return ret_code;
+}
+
+// Bilinear blend of corrections, scaled by 2^(p_shift + t_shift).
+static int64_t interpolate (const npa_tcomp_t * const tcomp, const uint16_t counts,
+                            const uint16_t temperature)
+{
+    const uint32_t p_mask = (1UL << tcomp->p_shift) - 1U;
+    const uint32_t t_mask = (1UL << tcomp->t_shift) - 1U;
+    // Temperature is clamped to 11 bits rather than rejected, it only selects a row.
+    const uint32_t t_counts = (temperature > NPA_TEMP_MAX_HIRES)
+                              ? NPA_TEMP_MAX_HIRES : temperature;
+    const uint32_t p_frac = counts & p_mask;
+    const uint32_t t_frac = t_counts & t_mask;
+    const int16_t * const low = &tcomp->grid[ ( (t_counts >> tcomp->t_shift)
+                                * tcomp->p_nodes) + (counts >> tcomp->p_shift)];
+    const int16_t * const high = &low[tcomp->p_nodes];
+    const int32_t p_span = (int32_t) (1UL << tcomp->p_shift);
+    const int32_t low_row = ( (int32_t) low[0U] * (p_span - (int32_t) p_frac))
+                            + ( (int32_t) low[1U] * (int32_t) p_frac);
+    const int32_t high_row = ( (int32_t) high[0U] * (p_span - (int32_t) p_frac))
+                             + ( (int32_t) high[1U] * (int32_t) p_frac);
+    return ( (int64_t) low_row * (int64_t) ( (1UL << tcomp->t_shift) - t_frac))
+           + ( (int64_t) high_row * (int64_t) t_frac);
+}
+
+static bool is_valid (const npa_tcomp_t * const tcomp, const uint16_t counts)
+{
+    return (NULL != tcomp) && (NULL != tcomp->grid) && (NPA_PRES_MAX_SAT >= counts);
+}
+
+int32_t npa_tcomp_correction (const npa_tcomp_t * const tcomp, const uint16_t counts,
+                              const uint16_t temperature)
+{
+    int32_t correction = 0;
+
+    if (is_valid (tcomp, counts))
+    {
+        correction = round_shift (interpolate (tcomp, counts, temperature),
+                                  (uint32_t) tcomp->p_shift + tcomp->t_shift);
+    }
+
+    return correction;
+}
+
+uint16_t npa_tcomp_apply (const npa_tcomp_t * const tcomp, const uint16_t counts,
+                          const uint16_t temperature)
+{
+    int32_t corrected = (int32_t) counts;
+
+    if (is_valid (tcomp, counts))
+    {
+        // Rounded once from full precision, not from rounded correction.
+        corrected += round_shift (interpolate (tcomp, counts, temperature),
+                                  (uint32_t) tcomp->p_shift + tcomp->t_shift
+                                  + NPA_TCOMP_FRAC_BITS);
+    }
+
+    if (corrected < (int32_t) NPA_PRES_MIN_SAT)
+    {
+        corrected = (int32_t) NPA_PRES_MIN_SAT;
+    }
+    else if (corrected > (int32_t) NPA_PRES_MAX_SAT)
+    {
+        corrected = (int32_t) NPA_PRES_MAX_SAT;
+    }
+    else
+    {
+        // Within 14 bits.
+    }
+
+    return (uint16_t) corrected;
+}
+
+npa_ret_t npa_tcomp_decode (const npa_tcomp_t * const tcomp, const npa_variant_t model,
+                            const uint8_t * const raw_data, const uint8_t data_len,
+                            float * const pressure_pa, float * const temperature_c)
+{
+    uint16_t pressure_counts = 0U;
+    uint16_t temperature_counts = 0U;
+    npa_ret_t ret_code = npa_parse_frame (raw_data, data_len, &pressure_counts,
+                                          &temperature_counts);
+
+    // Error codes share the fatal bit, so validity of inputs is checked directly. Frames
+    // with fatal status are converted like npa_decode_frame does.
+    const bool valid = (NULL != raw_data) && (NULL != tcomp) && (NULL != pressure_pa)
+                       && (NPA_FRAME_LEN_LOWRES <= data_len)
+                       && (NPA_FRAME_LEN_HIRES >= data_len);
+
+    if ( (NULL == tcomp) || (NULL == pressure_pa))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if (NPA_FRAME_LEN_PRES == data_len)
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        // Parse has set NULL or PARAM for invalid frames.
+    }
+
+    if (valid)
+    {
+        const bool hires = (NPA_FRAME_LEN_HIRES == data_len);
+        const uint16_t t_counts = hires ? temperature_counts
+                                  : (uint16_t) (temperature_counts << 3U);
+        float gain = 0.0F;
+        float offset = 0.0F;
+        ret_code |= npa_get_scaling (model, &gain, &offset);
+        *pressure_pa = ( (float) npa_tcomp_apply (tcomp, pressure_counts, t_counts) * gain)
+                       + offset;
+
+        if (NULL != temperature_c)
+        {
+            ret_code |= npa_convert_temp (temperature_counts, data_len, temperature_c);
+        }
+    }
+
+    return ret_code;
+}
+
+/** @} */
@@ -0,0 +1,113 @@
+#ifndef NPA_700_TCOMP_H
+#define NPA_700_TCOMP_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_tcomp.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Temperature compensation of pressure counts.
+ *
+ * Each sensor has a grid of corrections over pressure counts and 11-bit temperature
+ * counts, with nodes every 2^p_shift pressure counts and 2^t_shift temperature
+ * counts, from 0 up to and including full scale. Correction of a sample is bilinear
+ * interpolation between the four nodes around it, in integer arithmetic, and is added
+ * to counts. Corrected counts convert with @ref npa_convert_pa and friends as they
+ * are. Grid is built on a host from calibration runs, see npa_700_tcomp_fit.h.
+ *
+ * Grid is row-major, one row of pressure nodes per temperature node:
+ * grid[(t_node * NPA_TCOMP_P_NODES (p_shift)) + p_node]. Corrections are counts with
+ * @ref NPA_TCOMP_FRAC_BITS fractional bits.
+ *
+ * Temperature of 3-byte frames is 8-bit, shift it left by 3 before use.
+ */
+
+#include "npa_700.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define NPA_TCOMP_FRAC_BITS (4U)  //!< Fractional bits of corrections.
+#define NPA_TCOMP_P_BITS    (14U) //!< Bits of pressure counts.
+#define NPA_TCOMP_T_BITS    (11U) //!< Bits of temperature counts.
+
+/** @brief Number of pressure nodes of a grid. */
+#define NPA_TCOMP_P_NODES(p_shift) ( (1UL << (NPA_TCOMP_P_BITS - (p_shift))) + 1U)
+/** @brief Number of temperature nodes of a grid. */
+#define NPA_TCOMP_T_NODES(t_shift) ( (1UL << (NPA_TCOMP_T_BITS - (t_shift))) + 1U)
+/** @brief Number of corrections in a grid. */
+#define NPA_TCOMP_GRID_LEN(p_shift, t_shift) \
+    (NPA_TCOMP_P_NODES (p_shift) * NPA_TCOMP_T_NODES (t_shift))
+
+/** @brief Compensation of one sensor. Initialize with @ref npa_tcomp_init. */
+typedef struct
+{
+    const int16_t * grid; //!< Corrections, NPA_TCOMP_GRID_LEN entries. Not copied.
+    uint8_t p_shift;      //!< Log2 of pressure counts between nodes, 1...14.
+    uint8_t t_shift;      //!< Log2 of temperature counts between nodes, 1...11.
+    uint32_t p_nodes;     //!< Pressure nodes per row.
+} npa_tcomp_t;
+
+/**
+ * @brief Initialize compensation.
+ *
+ * @param[out] tcomp   Compensation to initialize.
+ * @param[in]  grid    Corrections, must stay valid while compensation is used.
+ * @param[in]  p_shift Log2 of pressure counts between nodes, 1...14.
+ * @param[in]  t_shift Log2 of temperature counts between nodes, 1...11.
+ * @retval NPA_SUCCESS   Compensation was initialized.
+ * @retval NPA_ERR_NULL  Compensation or grid was NULL.
+ * @retval NPA_ERR_PARAM A shift is out of range.
+ */
+npa_ret_t npa_tcomp_init (npa_tcomp_t * const tcomp, const int16_t * const grid,
+                          const uint8_t p_shift, const uint8_t t_shift);
+
+/**
+ * @brief Correction at a sample.
+ *
+ * @param[in] tcomp       Compensation.
+ * @param[in] counts      14-bit pressure counts.
+ * @param[in] temperature 11-bit temperature counts.
+ * @return Correction in counts with @ref NPA_TCOMP_FRAC_BITS fractional bits,
+ *         rounded to nearest, 0 if tcomp is NULL or counts do not fit in 14 bits.
+ */
+int32_t npa_tcomp_correction (const npa_tcomp_t * const tcomp, const uint16_t counts,
+                              const uint16_t temperature);
+
+/**
+ * @brief Compensate pressure counts.
+ *
+ * @param[in] tcomp       Compensation.
+ * @param[in] counts      14-bit pressure counts.
+ * @param[in] temperature 11-bit temperature counts.
+ * @return Counts plus correction rounded to nearest count, clamped to
+ *         NPA_PRES_MIN_SAT...NPA_PRES_MAX_SAT.
+ */
+uint16_t npa_tcomp_apply (const npa_tcomp_t * const tcomp, const uint16_t counts,
+                          const uint16_t temperature);
+
+/**
+ * @brief Decode a raw frame with temperature and compensate its pressure.
+ *
+ * Same as @ref npa_decode_frame, but pressure is converted from compensated counts.
+ *
+ * @param[in]  tcomp         Compensation.
+ * @param[in]  model         Model of the sensor.
+ * @param[in]  raw_data      Frame read from sensor.
+ * @param[in]  data_len      @ref NPA_FRAME_LEN_LOWRES or @ref NPA_FRAME_LEN_HIRES.
+ * @param[out] pressure_pa   Compensated pressure in pascals.
+ * @param[out] temperature_c Temperature in celcius. May be NULL.
+ * @return @ref npa_ret_t of frame and conversion. NPA_ERR_PARAM if frame has no
+ *         temperature, NPA_ERR_NULL if a pointer was NULL.
+ */
+npa_ret_t npa_tcomp_decode (const npa_tcomp_t * const tcomp, const npa_variant_t model,
+                            const uint8_t * const raw_data, const uint8_t data_len,
+                            float * const pressure_pa, float * const temperature_c);
+
+/** @} */
+#endif // NPA_700_TCOMP_H
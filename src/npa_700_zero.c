@@ -0,0 +1,243 @@
+#include "npa_700_zero.h"
+
+#include <string.h>
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_zero.c
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * Baseline and short average are fixed point counts, 14 integer bits and
+ * NPA_ZERO_FRAC_BITS fractional bits fit in int32_t. Moving averages divide the
+ * difference instead of shifting it, as right shift of a negative value is
+ * implementation-defined. Truncation toward zero biases the estimate by less than
+ * one fractional step.
+ */
+
+#define NPA_ZERO_ONE           (INT32_C (1) << NPA_ZERO_FRAC_BITS) //!< One count.
+#define NPA_ZERO_AVERAGE_SHIFT (2U) //!< Short average moves 1/4 toward sample.
+
+static int32_t to_fixed (const uint16_t counts)
+{
+    return (int32_t) counts * NPA_ZERO_ONE;
+}
+
+static bool is_plausible (const npa_zero_t * const zero, const int32_t level)
+{
+    const int32_t middle = to_fixed (NPA_PRES_MIDDLE);
+    const int32_t max_offset = to_fixed (zero->cfg.max_offset);
+    return (level >= (middle - max_offset)) && (level <= (middle + max_offset));
+}
+
+static void set_baseline (npa_zero_t * const zero, const int32_t baseline)
+{
+    zero->baseline = baseline;
+    // Baseline is positive, adding half rounds to nearest.
+    zero->offset = ( (baseline + (NPA_ZERO_ONE / 2)) / NPA_ZERO_ONE)
+                   - (int32_t) NPA_PRES_MIDDLE;
+    zero->zeroed = true;
+}
+
+static uint32_t saved_check (const npa_zero_saved_t * const saved)
+{
+    return ~ (saved->magic + (uint32_t) saved->baseline + saved->updates);
+}
+
+npa_ret_t npa_zero_init (npa_zero_t * const zero, const npa_zero_cfg_t * const cfg)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == zero) || (NULL == cfg))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (NPA_ZERO_MAX_SHIFT < cfg->weight_shift) || (0U == cfg->band)
+              || (0U == cfg->max_offset) || (0U == cfg->quiet_samples))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        memset (zero, 0, sizeof (npa_zero_t));
+        zero->cfg = *cfg;
+        zero->baseline = to_fixed (NPA_PRES_MIDDLE);
+    }
+
+    return ret_code;
+}
+
+uint16_t npa_zero_push (npa_zero_t * const zero, const uint16_t counts,
+                        const npa_ret_t status)
+{
+    uint16_t corrected = counts;
+
+    if ( (NULL != zero) && (0U != zero->cfg.quiet_samples))
+    {
+        const int32_t sample = to_fixed (counts);
+
+        if (NPA_SUCCESS != status)
+        {
+            zero->quiet = 0U;
+        }
+        else if (!zero->has_average)
+        {
+            zero->average = sample;
+            zero->has_average = true;
+        }
+        else
+        {
+            const int32_t band = to_fixed (zero->cfg.band);
+            const int32_t deviation = sample - zero->average;
+            zero->average += deviation / (INT32_C (1) << NPA_ZERO_AVERAGE_SHIFT);
+
+            if ( (deviation > band) || (deviation < -band) || !is_plausible (zero, sample))
+            {
+                zero->quiet = 0U;
+            }
+            else if (zero->quiet < zero->cfg.quiet_samples)
+            {
+                zero->quiet++;
+            }
+            else
+            {
+                // Quiet run is long enough, sensor is at no-flow.
+            }
+
+            if (zero->quiet < zero->cfg.quiet_samples)
+            {
+                // Not at no-flow, baseline is kept.
+            }
+            else if (!zero->zeroed)
+            {
+                set_baseline (zero, zero->average);
+                zero->updates = 1U;
+            }
+            else
+            {
+                set_baseline (zero, zero->baseline
+                              + ( (sample - zero->baseline)
+                                  / (INT32_C (1) << zero->cfg.weight_shift)));
+
+                if (UINT32_MAX != zero->updates)
+                {
+                    zero->updates++;
+                }
+            }
+        }
+
+        corrected = npa_zero_apply (zero, counts);
+    }
+
+    return corrected;
+}
+
+uint16_t npa_zero_apply (const npa_zero_t * const zero, const uint16_t counts)
+{
+    int32_t corrected = (int32_t) counts;
+
+    if ( (NULL != zero) && zero->zeroed)
+    {
+        corrected -= zero->offset;
+
+        if (corrected < (int32_t) NPA_PRES_MIN_SAT)
+        {
+            corrected = (int32_t) NPA_PRES_MIN_SAT;
+        }
+        else if (corrected > (int32_t) NPA_PRES_MAX_SAT)
+        {
+            corrected = (int32_t) NPA_PRES_MAX_SAT;
+        }
+        else
+        {
+            // Within 14 bits.
+        }
+    }
+
+    return (uint16_t) corrected;
+}
+
+int32_t npa_zero_offset (const npa_zero_t * const zero)
+{
+    return ( (NULL != zero) && zero->zeroed) ? zero->offset : 0;
+}
+
+npa_ret_t npa_zero_tare (npa_zero_t * const zero)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if (NULL == zero)
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if (!zero->has_average)
+    {
+        ret_code |= NPA_ERR_MODE;
+    }
+    else if (!is_plausible (zero, zero->average))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        set_baseline (zero, zero->average);
+
+        if (UINT32_MAX != zero->updates)
+        {
+            zero->updates++;
+        }
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_zero_save (const npa_zero_t * const zero, npa_zero_saved_t * const saved)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == zero) || (NULL == saved))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if (!zero->zeroed)
+    {
+        ret_code |= NPA_ERR_MODE;
+    }
+    else
+    {
+        saved->magic = NPA_ZERO_MAGIC;
+        saved->baseline = zero->baseline;
+        saved->updates = zero->updates;
+        saved->check = saved_check (saved);
+    }
+
+    return ret_code;
+}
+
+npa_ret_t npa_zero_restore (npa_zero_t * const zero, const npa_zero_saved_t * const saved)
+{
+    npa_ret_t ret_code = NPA_SUCCESS;
+
+    if ( (NULL == zero) || (NULL == saved))
+    {
+        ret_code |= NPA_ERR_NULL;
+    }
+    else if ( (NPA_ZERO_MAGIC != saved->magic) || (saved_check (saved) != saved->check)
+              || !is_plausible (zero, saved->baseline))
+    {
+        ret_code |= NPA_ERR_PARAM;
+    }
+    else
+    {
+        set_baseline (zero, saved->baseline);
+        zero->updates = saved->updates;
+    }
+
+    return ret_code;
+}
+
+/** @} */
@@ -0,0 +1,150 @@
+#ifndef NPA_700_ZERO_H
+#define NPA_700_ZERO_H
+
+/**
+ * @addtogroup NPA-700
+ * @{
+ */
+/**
+ * @file npa_700_zero.h
+ * @author Otso Jousimaa <otso@ojousima.net>
+ * @date 2026-10-17
+ * @copyright Otso Jousimaa, License Apache 2.0.
+ *
+ * @brief Streaming auto-zero of pressure counts.
+ *
+ * Estimator follows the zero level of one sensor while it is read and corrects
+ * counts by the offset of zero level from @ref NPA_PRES_MIDDLE, so the corrected
+ * counts convert with @ref npa_convert_pa and friends as they are. Each sample takes
+ * constant time.
+ *
+ * A sample is quiet if it is within activity band of a short moving average and
+ * within maximum offset of @ref NPA_PRES_MIDDLE. After quiet samples in a row the
+ * sensor is taken to be at no-flow, and every further quiet sample updates baseline
+ * by an exponentially weighted moving average. Steady non-zero pressure within
+ * maximum offset is indistinguishable from drift, so keep maximum offset at the
+ * expected drift of the sensor.
+ *
+ * Until the first no-flow period, or @ref npa_zero_restore of a saved baseline,
+ * counts are not corrected. The first no-flow period sets baseline directly.
+ */
+
+#include "npa_700.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define NPA_ZERO_FRAC_BITS   (16U)          //!< Fractional bits of baseline.
+#define NPA_ZERO_MAX_SHIFT   (15U)          //!< Maximum weight shift of baseline.
+#define NPA_ZERO_MAGIC       (0x5A41504EUL) //!< "NPAZ" in little-endian.
+
+/** @brief Configuration of auto-zero. */
+typedef struct
+{
+    uint8_t weight_shift;   //!< Baseline moves 2^-weight_shift toward quiet sample.
+    uint16_t band;          //!< Activity band around short average, counts.
+    uint16_t max_offset;    //!< Largest zero offset from NPA_PRES_MIDDLE, counts.
+    uint16_t quiet_samples; //!< Quiet samples in a row before baseline updates.
+} npa_zero_cfg_t;
+
+/** @brief State of auto-zero of one sensor. Initialize with @ref npa_zero_init. */
+typedef struct
+{
+    npa_zero_cfg_t cfg;   //!< Configuration.
+    int32_t baseline;     //!< Zero level in counts, NPA_ZERO_FRAC_BITS fractional bits.
+    int32_t average;      //!< Short average of counts, same format.
+    int32_t offset;       //!< Correction subtracted from counts.
+    uint16_t quiet;       //!< Quiet samples in a row, saturates at quiet_samples.
+    uint32_t updates;     //!< Updates of baseline, saturating.
+    bool has_average;     //!< At least one sample has been pushed.
+    bool zeroed;          //!< Baseline has been set.
+} npa_zero_t;
+
+/** @brief Baseline stored by the application, e.g. in non-volatile memory. */
+typedef struct
+{
+    uint32_t magic;    //!< @ref NPA_ZERO_MAGIC.
+    int32_t baseline;  //!< Zero level in counts, NPA_ZERO_FRAC_BITS fractional bits.
+    uint32_t updates;  //!< Updates of baseline.
+    uint32_t check;    //!< Complement of sum of the other fields.
+} npa_zero_saved_t;
+
+/**
+ * @brief Initialize auto-zero.
+ *
+ * @param[out] zero Estimator to initialize.
+ * @param[in]  cfg  Configuration, copied to estimator.
+ * @retval NPA_SUCCESS   Estimator was initialized.
+ * @retval NPA_ERR_NULL  Estimator or configuration was NULL.
+ * @retval NPA_ERR_PARAM Weight shift is over NPA_ZERO_MAX_SHIFT, or band, maximum
+ *                       offset or quiet samples is 0.
+ */
+npa_ret_t npa_zero_init (npa_zero_t * const zero, const npa_zero_cfg_t * const cfg);
+
+/**
+ * @brief Feed one sample and correct it.
+ *
+ * Only samples with status NPA_SUCCESS update the estimate; saturated, stale and
+ * failed samples are corrected but break a quiet run.
+ *
+ * @param[in,out] zero   Estimator.
+ * @param[in]     counts 14-bit pressure counts.
+ * @param[in]     status @ref npa_ret_t of the reading.
+ * @return Corrected counts, see @ref npa_zero_apply.
+ */
+uint16_t npa_zero_push (npa_zero_t * const zero, const uint16_t counts,
+                        const npa_ret_t status);
+
+/**
+ * @brief Correct counts by current offset without updating the estimate.
+ *
+ * @param[in] zero   Estimator.
+ * @param[in] counts 14-bit pressure counts.
+ * @return Counts minus offset, clamped to NPA_PRES_MIN_SAT...NPA_PRES_MAX_SAT.
+ */
+uint16_t npa_zero_apply (const npa_zero_t * const zero, const uint16_t counts);
+
+/**
+ * @brief Current offset of zero level from @ref NPA_PRES_MIDDLE.
+ *
+ * @param[in] zero Estimator.
+ * @return Offset in counts, 0 until baseline is set.
+ */
+int32_t npa_zero_offset (const npa_zero_t * const zero);
+
+/**
+ * @brief Set baseline to short average of latest samples, e.g. on user request.
+ *
+ * @param[in,out] zero Estimator.
+ * @retval NPA_SUCCESS   Baseline was set.
+ * @retval NPA_ERR_NULL  Estimator was NULL.
+ * @retval NPA_ERR_MODE  No sample has been pushed.
+ * @retval NPA_ERR_PARAM Average is over maximum offset from middle, not set.
+ */
+npa_ret_t npa_zero_tare (npa_zero_t * const zero);
+
+/**
+ * @brief Save baseline of estimator.
+ *
+ * @param[in]  zero  Estimator.
+ * @param[out] saved Saved baseline.
+ * @retval NPA_SUCCESS  Baseline was saved.
+ * @retval NPA_ERR_NULL Estimator or saved was NULL.
+ * @retval NPA_ERR_MODE Baseline has not been set, nothing was saved.
+ */
+npa_ret_t npa_zero_save (const npa_zero_t * const zero, npa_zero_saved_t * const saved);
+
+/**
+ * @brief Restore a saved baseline, e.g. after reboot.
+ *
+ * @param[in,out] zero  Estimator, initialized.
+ * @param[in]     saved Saved baseline.
+ * @retval NPA_SUCCESS   Baseline was restored.
+ * @retval NPA_ERR_NULL  Estimator or saved was NULL.
+ * @retval NPA_ERR_PARAM Magic or check does not match, or baseline is over maximum
+ *                       offset from middle. Estimator is unchanged.
+ */
+npa_ret_t npa_zero_restore (npa_zero_t * const zero, const npa_zero_saved_t * const saved);
+
+/** @} */
+#endif // NPA_700_ZERO_H
@@ -11,4 +11,15 @@ npa_ret_t i2c_write (const uint8_t i2c_addr,
 npa_ret_t i2c_read (const uint8_t i2c_addr,
                     uint8_t * const data,
                     const uint8_t data_len);
+
+npa_ret_t i2c_xfer (const uint8_t i2c_addr,
+                    const uint8_t * const tx_data,
+                    const uint8_t tx_len,
+                    uint8_t * const rx_data,
+                    const uint8_t rx_len);
+
+// Second bus for multi-sensor transfers
+npa_ret_t i2c2_read (const uint8_t i2c_addr,
+                     uint8_t * const data,
+                     const uint8_t data_len);
 #endif
\ No newline at end of file
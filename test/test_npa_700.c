@@ -4,6 +4,7 @@
 
 #include "mock_i2c.h"
 
+#include <stdbool.h>
 #include <string.h>
 
 #define NPA_ADDR       (0x28U)  //!< Default address of NPA-700.
@@ -164,6 +165,15 @@ static const npa_ctx_t m_sensor_030d =
   M_030D_MAX_NONSAT \
 }
 
+#define NUM_BATCH (20U) //!< Number of sensors in batch test.
+#define M_BATCH_SENSOR \
+{ \
+    .write = &i2c_write, \
+    .read = &i2c_read, \
+    .npa_addr = NPA_ADDR, \
+    .model = NPA_700_001D \
+}
+
 static const npa_ctx_t * const m_sensors[7] =
 {
     &m_sensor_02wd,
@@ -186,6 +196,47 @@ static const float m_expected_values[NUM_SENSORS][NUM_VALUES] =
     M_030D_VALUES
 };
 
+static const uint32_t m_scales_pa_int[NUM_SENSORS] =
+{
+    NPA_02WD_SCALE_PA_INT,
+    NPA_05WD_SCALE_PA_INT,
+    NPA_10WD_SCALE_PA_INT,
+    NPA_001D_SCALE_PA_INT,
+    NPA_005D_SCALE_PA_INT,
+    NPA_015D_SCALE_PA_INT,
+    NPA_030D_SCALE_PA_INT
+};
+
+// Reference for integer conversion: round (scale * (2 * counts - 16383) / 13107).
+static int64_t reference_int (const uint64_t scale, const uint16_t counts)
+{
+    const int64_t den = (int64_t) (NPA_PRES_MAX_NONSAT - NPA_PRES_MIN_NONSAT);
+    const int64_t num = (int64_t) scale * ( (2 * (int64_t) counts)
+                                            - (int64_t) NPA_PRES_MAX_SAT);
+    int64_t quot = num / den;
+    const int64_t rem = num % den;
+
+    if ( (2 * rem) >= den)
+    {
+        quot++;
+    }
+    else if ( (-2 * rem) >= den)
+    {
+        quot--;
+    }
+    else
+    {
+        // No action needed.
+    }
+
+    return quot;
+}
+
+static bool is_saturated (const uint16_t counts)
+{
+    return (NPA_PRES_MIN_NONSAT > counts) || (NPA_PRES_MAX_NONSAT < counts);
+}
+
 void setUp (void)
 {
 }
@@ -219,6 +270,75 @@ void test_npa_700_sample_trigger (void)
     TEST_ASSERT (NPA_SUCCESS == ret_code);
 }
 
+void test_npa_700_write_read (void)
+{
+    const uint8_t command[] = { 0xA0U, 0x00U, 0x00U };
+    const uint8_t response[] = { 0x5AU, 0x12U, 0x34U };
+    uint8_t rx_data[sizeof (response)] = { 0U };
+    i2c_write_ExpectWithArrayAndReturn (NPA_ADDR, command, sizeof (command),
+                                        sizeof (command), NPA_SUCCESS);
+    i2c_read_ExpectAndReturn (NPA_ADDR, rx_data, sizeof (rx_data), NPA_SUCCESS);
+    i2c_read_ReturnArrayThruPtr_data (response, sizeof (response));
+    npa_ret_t ret_code = npa_write_read (&m_sensor_valid, command, sizeof (command),
+                                         rx_data, sizeof (rx_data));
+    TEST_ASSERT (NPA_SUCCESS == ret_code);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY (response, rx_data, sizeof (response));
+    // Response is not read if command was not acknowledged.
+    i2c_write_ExpectWithArrayAndReturn (NPA_ADDR, command, sizeof (command),
+                                        sizeof (command), NPA_ERR_NACK);
+    ret_code = npa_write_read (&m_sensor_valid, command, sizeof (command),
+                               rx_data, sizeof (rx_data));
+    TEST_ASSERT (NPA_ERR_NACK == ret_code);
+    // Write only.
+    i2c_write_ExpectWithArrayAndReturn (NPA_ADDR, command, sizeof (command),
+                                        sizeof (command), NPA_SUCCESS);
+    ret_code = npa_write_read (&m_sensor_valid, command, sizeof (command), NULL, 0U);
+    TEST_ASSERT (NPA_SUCCESS == ret_code);
+}
+
+void test_npa_700_write_read_xfer (void)
+{
+    const npa_ctx_t sensor =
+    {
+        .write = &i2c_write,
+        .read = &i2c_read,
+        .npa_addr = NPA_ADDR,
+        .model = NPA_700_001D,
+        .xfer = &i2c_xfer
+    };
+    const uint8_t command[] = { 0xA0U, 0x00U, 0x00U };
+    const uint8_t response[] = { 0x5AU, 0x12U, 0x34U };
+    uint8_t rx_data[sizeof (response)] = { 0U };
+    i2c_xfer_ExpectWithArrayAndReturn (NPA_ADDR, command, sizeof (command),
+                                       sizeof (command), rx_data, sizeof (rx_data),
+                                       sizeof (rx_data), NPA_SUCCESS);
+    i2c_xfer_ReturnArrayThruPtr_rx_data (response, sizeof (response));
+    npa_ret_t ret_code = npa_write_read (&sensor, command, sizeof (command), rx_data,
+                                         sizeof (rx_data));
+    TEST_ASSERT (NPA_SUCCESS == ret_code);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY (response, rx_data, sizeof (response));
+    i2c_xfer_ExpectAndReturn (NPA_ADDR, NULL, 0U, rx_data, sizeof (rx_data),
+                              NPA_ERR_TOUT);
+    ret_code = npa_write_read (&sensor, NULL, 0U, rx_data, sizeof (rx_data));
+    TEST_ASSERT (NPA_ERR_TOUT == ret_code);
+}
+
+void test_npa_700_write_read_invalid (void)
+{
+    const uint8_t command[] = { 0xA0U };
+    uint8_t rx_data[2U];
+    TEST_ASSERT (NPA_ERR_NULL == npa_write_read (NULL, command, sizeof (command), rx_data,
+                 sizeof (rx_data)));
+    TEST_ASSERT (NPA_ERR_NULL == npa_write_read (&m_sensor_read_null, command,
+                 sizeof (command), rx_data, sizeof (rx_data)));
+    TEST_ASSERT (NPA_ERR_NULL == npa_write_read (&m_sensor_valid, NULL, sizeof (command),
+                 rx_data, sizeof (rx_data)));
+    TEST_ASSERT (NPA_ERR_NULL == npa_write_read (&m_sensor_valid, command,
+                 sizeof (command), NULL, sizeof (rx_data)));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_write_read (&m_sensor_valid, command, 0U, rx_data,
+                 0U));
+}
+
 /**
  * @brief Read pressure from sensor.
  *
@@ -276,6 +396,355 @@ void test_npa_700_read_pressure (void)
     ret_code = npa_read_pressure (NULL, &pressure_pa);
     TEST_ASSERT (NPA_ERR_NULL == ret_code);
 }
+
+void test_npa_700_prepare (void)
+{
+    npa_handle_t handle;
+    const npa_ctx_t invalid_model =
+    {
+        .write = &i2c_write,
+        .read = &i2c_read,
+        .npa_addr = NPA_ADDR,
+        .model = (npa_variant_t) NUM_SENSORS
+    };
+    npa_ret_t ret_code = npa_prepare (NULL, &handle);
+    TEST_ASSERT (NPA_ERR_NULL == ret_code);
+    ret_code = npa_prepare (&m_sensor_read_null, &handle);
+    TEST_ASSERT (NPA_ERR_NULL == ret_code);
+    ret_code = npa_prepare (&m_sensor_valid, NULL);
+    TEST_ASSERT (NPA_ERR_NULL == ret_code);
+    ret_code = npa_prepare (&invalid_model, &handle);
+    TEST_ASSERT (NPA_ERR_FATAL == ret_code);
+    ret_code = npa_prepare (&m_sensor_valid, &handle);
+    TEST_ASSERT (NPA_SUCCESS == ret_code);
+    TEST_ASSERT (&i2c_read == handle.read);
+    TEST_ASSERT (&i2c_write == handle.write);
+    TEST_ASSERT (NPA_ADDR == handle.npa_addr);
+    TEST_ASSERT (NPA_700_001D == handle.model);
+}
+
+void test_npa_700_handle_read_pressure (void)
+{
+    const uint8_t * const binaries[NUM_VALUES] =
+    {
+        min_nonsat_binary,
+        mid_binary,
+        max_nonsat_binary
+    };
+    npa_handle_t handle;
+    float pressure_pa;
+    npa_ret_t ret_code;
+
+    for (size_t sindex = 0U; sindex < NUM_SENSORS; sindex++)
+    {
+        ret_code = npa_prepare (m_sensors[sindex], &handle);
+        TEST_ASSERT (NPA_SUCCESS == ret_code);
+
+        for (size_t vindex = 0U; vindex < NUM_VALUES; vindex++)
+        {
+            uint8_t expect[2] = { 0xFF, 0xFF };
+            i2c_read_ExpectWithArrayAndReturn (m_sensors[sindex]->npa_addr, expect, 2U, 2U,
+                                               NPA_SUCCESS);
+            i2c_read_ReturnArrayThruPtr_data (binaries[vindex], 2U);
+            ret_code = npa_handle_read_pressure (&handle, &pressure_pa);
+            TEST_ASSERT (NPA_SUCCESS == ret_code);
+            TEST_ASSERT_FLOAT_WITHIN (m_expected_values[sindex][NUM_VALUES - 1U] / 4096.0F,
+                                      m_expected_values[sindex][vindex], pressure_pa);
+        }
+    }
+
+    ret_code = npa_handle_read_pressure (&handle, NULL);
+    TEST_ASSERT (NPA_ERR_NULL == ret_code);
+    ret_code = npa_handle_read_pressure (NULL, &pressure_pa);
+    TEST_ASSERT (NPA_ERR_NULL == ret_code);
+}
+
+void test_npa_700_convert_mpa (void)
+{
+    for (size_t sindex = 0U; sindex < NUM_SENSORS; sindex++)
+    {
+        const npa_variant_t model = m_sensors[sindex]->model;
+        // Float path has 24-bit mantissa, allow a few LSBs of full scale.
+        const float tolerance = m_expected_values[sindex][NUM_VALUES - 1U] / 1048576.0F;
+
+        for (uint16_t counts = 0U; counts <= NPA_PRES_MAX_SAT; counts++)
+        {
+            int32_t pressure_mpa = 0;
+            float pressure_pa = 0.0F;
+            const npa_ret_t expect = is_saturated (counts) ? NPA_WARN_SAT : NPA_SUCCESS;
+            npa_ret_t ret_code = npa_convert_mpa (model, counts, &pressure_mpa);
+            TEST_ASSERT (expect == ret_code);
+            TEST_ASSERT (reference_int (m_scales_pa_int[sindex] * 1000U, counts)
+                         == (int64_t) pressure_mpa);
+            ret_code = npa_convert_pa (model, counts, &pressure_pa);
+            TEST_ASSERT (expect == ret_code);
+            TEST_ASSERT_FLOAT_WITHIN (tolerance + 0.001F, pressure_pa,
+                                      (float) pressure_mpa / 1000.0F);
+        }
+    }
+}
+
+void test_npa_700_convert_q (void)
+{
+    for (size_t sindex = 0U; sindex < NUM_SENSORS; sindex++)
+    {
+        const npa_variant_t model = m_sensors[sindex]->model;
+        const uint64_t scale = (uint64_t) m_scales_pa_int[sindex] << NPA_Q_FRAC_BITS;
+        const float tolerance = m_expected_values[sindex][NUM_VALUES - 1U] / 1048576.0F;
+
+        for (uint16_t counts = 0U; counts <= NPA_PRES_MAX_SAT; counts++)
+        {
+            int32_t pressure_q = 0;
+            float pressure_pa = 0.0F;
+            const npa_ret_t expect = is_saturated (counts) ? NPA_WARN_SAT : NPA_SUCCESS;
+            npa_ret_t ret_code = npa_convert_q (model, counts, &pressure_q);
+            TEST_ASSERT (expect == ret_code);
+            TEST_ASSERT (reference_int (scale, counts) == (int64_t) pressure_q);
+            ret_code = npa_convert_pa (model, counts, &pressure_pa);
+            TEST_ASSERT (expect == ret_code);
+            TEST_ASSERT_FLOAT_WITHIN (tolerance + (1.0F / (float) (1U << NPA_Q_FRAC_BITS)),
+                                      pressure_pa,
+                                      (float) pressure_q / (float) (1U << NPA_Q_FRAC_BITS));
+        }
+    }
+}
+
+void test_npa_700_convert_invalid (void)
+{
+    int32_t pressure_int;
+    float pressure_pa;
+    TEST_ASSERT (NPA_ERR_NULL == npa_convert_mpa (NPA_700_001D, NPA_PRES_MIDDLE, NULL));
+    TEST_ASSERT (NPA_ERR_NULL == npa_convert_q (NPA_700_001D, NPA_PRES_MIDDLE, NULL));
+    TEST_ASSERT (NPA_ERR_NULL == npa_convert_pa (NPA_700_001D, NPA_PRES_MIDDLE, NULL));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_convert_mpa (NPA_700_001D, NPA_PRES_MAX_SAT + 1U,
+                 &pressure_int));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_convert_q ( (npa_variant_t) NUM_SENSORS,
+                 NPA_PRES_MIDDLE, &pressure_int));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_convert_pa ( (npa_variant_t) NUM_SENSORS,
+                 NPA_PRES_MIDDLE, &pressure_pa));
+}
+
+void test_npa_700_convert_temp (void)
+{
+    float temperature_c;
+    TEST_ASSERT (NPA_SUCCESS == npa_convert_temp (0U, NPA_FRAME_LEN_HIRES, &temperature_c));
+    TEST_ASSERT (NPA_TEMP_MIN_C == temperature_c);
+    TEST_ASSERT (NPA_SUCCESS == npa_convert_temp (NPA_TEMP_MAX_HIRES, NPA_FRAME_LEN_HIRES,
+                 &temperature_c));
+    TEST_ASSERT_FLOAT_WITHIN (0.001F, NPA_TEMP_MIN_C + NPA_TEMP_SPAN_C, temperature_c);
+    TEST_ASSERT (NPA_SUCCESS == npa_convert_temp (NPA_TEMP_MAX_LOWRES, NPA_FRAME_LEN_LOWRES,
+                 &temperature_c));
+    TEST_ASSERT_FLOAT_WITHIN (0.001F, NPA_TEMP_MIN_C + NPA_TEMP_SPAN_C, temperature_c);
+    TEST_ASSERT (NPA_ERR_PARAM == npa_convert_temp (NPA_TEMP_MAX_LOWRES + 1U,
+                 NPA_FRAME_LEN_LOWRES, &temperature_c));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_convert_temp (0U, NPA_FRAME_LEN_PRES, &temperature_c));
+    TEST_ASSERT (NPA_ERR_NULL == npa_convert_temp (0U, NPA_FRAME_LEN_HIRES, NULL));
+}
+
+void test_npa_700_read_pressure_int (void)
+{
+    uint8_t expect[2] = { 0xFF, 0xFF };
+    int32_t pressure_mpa;
+    int32_t pressure_q;
+    i2c_read_ExpectWithArrayAndReturn (NPA_ADDR, expect, 2U, 2U, NPA_SUCCESS);
+    i2c_read_ReturnArrayThruPtr_data (max_nonsat_binary, 2U);
+    npa_ret_t ret_code = npa_read_pressure_mpa (&m_sensor_001d, &pressure_mpa);
+    TEST_ASSERT (NPA_SUCCESS == ret_code);
+    TEST_ASSERT ( (int32_t) (NPA_001D_SCALE_PA_INT * 1000U) == pressure_mpa);
+    i2c_read_ExpectWithArrayAndReturn (NPA_ADDR, expect, 2U, 2U, NPA_SUCCESS);
+    i2c_read_ReturnArrayThruPtr_data (min_nonsat_binary, 2U);
+    ret_code = npa_read_pressure_q (&m_sensor_001d, &pressure_q);
+    TEST_ASSERT (NPA_SUCCESS == ret_code);
+    TEST_ASSERT ( (-1 * (int32_t) (NPA_001D_SCALE_PA_INT << NPA_Q_FRAC_BITS)) == pressure_q);
+    ret_code = npa_read_pressure_mpa (&m_sensor_001d, NULL);
+    TEST_ASSERT (NPA_ERR_NULL == ret_code);
+    ret_code = npa_read_pressure_q (NULL, &pressure_q);
+    TEST_ASSERT (NPA_ERR_NULL == ret_code);
+}
+
+void test_npa_700_read_pressure_temp (void)
+{
+    // Mid pressure, 25 C: 11-bit 768 = 0x300, 8-bit 96 = 0x60.
+    const uint8_t hires_binary[] = { 0x20U, 0x00U, 0x60U, 0x00U };
+    const uint8_t max_hires_binary[] = { 0x39U, 0x99U, 0xFFU, 0xE0U };
+    uint8_t expect[4] = { 0xFF, 0xFF, 0xFF, 0xFF };
+    float pressure_pa;
+    float temperature_c;
+    i2c_read_ExpectWithArrayAndReturn (NPA_ADDR, expect, 3U, 3U, NPA_SUCCESS);
+    i2c_read_ReturnArrayThruPtr_data (hires_binary, 3U);
+    npa_ret_t ret_code = npa_read_pressure_temp_lowres (&m_sensor_001d, &pressure_pa,
+                         &temperature_c);
+    TEST_ASSERT (NPA_SUCCESS == ret_code);
+    TEST_ASSERT_FLOAT_WITHIN (M_001D_MAX_NONSAT / 4096.0F, M_001D_MIDDLE, pressure_pa);
+    TEST_ASSERT_FLOAT_WITHIN (200.0F / 255.0F, 25.0F, temperature_c);
+    i2c_read_ExpectWithArrayAndReturn (NPA_ADDR, expect, 4U, 4U, NPA_SUCCESS);
+    i2c_read_ReturnArrayThruPtr_data (hires_binary, 4U);
+    ret_code = npa_read_pressure_temp_hires (&m_sensor_001d, &pressure_pa, &temperature_c);
+    TEST_ASSERT (NPA_SUCCESS == ret_code);
+    TEST_ASSERT_FLOAT_WITHIN (M_001D_MAX_NONSAT / 4096.0F, M_001D_MIDDLE, pressure_pa);
+    TEST_ASSERT_FLOAT_WITHIN (200.0F / 2047.0F, 25.0F, temperature_c);
+    i2c_read_ExpectWithArrayAndReturn (NPA_ADDR, expect, 4U, 4U, NPA_SUCCESS);
+    i2c_read_ReturnArrayThruPtr_data (max_hires_binary, 4U);
+    ret_code = npa_read_pressure_temp_hires (&m_sensor_001d, &pressure_pa, &temperature_c);
+    TEST_ASSERT (NPA_SUCCESS == ret_code);
+    TEST_ASSERT_FLOAT_WITHIN (M_001D_MAX_NONSAT / 4096.0F, M_001D_MAX_NONSAT, pressure_pa);
+    TEST_ASSERT_FLOAT_WITHIN (0.001F, 150.0F, temperature_c);
+    ret_code = npa_read_pressure_temp_hires (&m_sensor_001d, &pressure_pa, NULL);
+    TEST_ASSERT (NPA_ERR_NULL == ret_code);
+    ret_code = npa_read_pressure_temp_lowres (&m_sensor_001d, NULL, &temperature_c);
+    TEST_ASSERT (NPA_ERR_NULL == ret_code);
+    ret_code = npa_read_pressure_temp_lowres (NULL, &pressure_pa, &temperature_c);
+    TEST_ASSERT (NPA_ERR_NULL == ret_code);
+}
+
+void test_npa_700_parse_frame (void)
+{
+    const uint8_t stale_binary[] = { 0x80U, 0x00U, 0xABU, 0xC0U };
+    uint16_t pressure_counts;
+    uint16_t temperature_counts;
+    npa_ret_t ret_code = npa_parse_frame (stale_binary, 4U, &pressure_counts,
+                                          &temperature_counts);
+    TEST_ASSERT ( (NPA_WARN_OLD | NPA_WARN_SAT) == ret_code);
+    TEST_ASSERT (0U == pressure_counts);
+    TEST_ASSERT ( ( (0xABU << 3U) | 0x06U) == temperature_counts);
+    ret_code = npa_parse_frame (stale_binary, 3U, &pressure_counts, &temperature_counts);
+    TEST_ASSERT ( (NPA_WARN_OLD | NPA_WARN_SAT) == ret_code);
+    TEST_ASSERT (0xABU == temperature_counts);
+    ret_code = npa_parse_frame (mid_binary, 2U, &pressure_counts, &temperature_counts);
+    TEST_ASSERT (NPA_SUCCESS == ret_code);
+    TEST_ASSERT (NPA_PRES_MIDDLE == pressure_counts);
+    TEST_ASSERT (0U == temperature_counts);
+    ret_code = npa_parse_frame (mid_binary, 2U, &pressure_counts, NULL);
+    TEST_ASSERT (NPA_SUCCESS == ret_code);
+    ret_code = npa_parse_frame (mid_binary, 1U, &pressure_counts, NULL);
+    TEST_ASSERT (NPA_ERR_PARAM == ret_code);
+    ret_code = npa_parse_frame (stale_binary, 5U, &pressure_counts, NULL);
+    TEST_ASSERT (NPA_ERR_PARAM == ret_code);
+    ret_code = npa_parse_frame (NULL, 2U, &pressure_counts, NULL);
+    TEST_ASSERT (NPA_ERR_NULL == ret_code);
+    ret_code = npa_parse_frame (mid_binary, 2U, NULL, NULL);
+    TEST_ASSERT (NPA_ERR_NULL == ret_code);
+}
+
+void test_npa_700_decode_frame (void)
+{
+    float pressure_pa;
+    float temperature_c = 1.0F;
+    float expected_pa;
+
+    for (size_t sindex = 0U; sindex < NUM_SENSORS; sindex++)
+    {
+        npa_ret_t ret_code = npa_decode_frame (m_sensors[sindex]->model, max_nonsat_binary,
+                                               2U, &pressure_pa, &temperature_c);
+        TEST_ASSERT (NPA_SUCCESS == ret_code);
+        (void) npa_convert_pa (m_sensors[sindex]->model, NPA_PRES_MAX_NONSAT, &expected_pa);
+        TEST_ASSERT (expected_pa == pressure_pa);
+        // 2-byte frame has no temperature.
+        TEST_ASSERT (1.0F == temperature_c);
+    }
+
+    TEST_ASSERT (NPA_ERR_NULL == npa_decode_frame (NPA_700_001D, mid_binary, 2U, NULL,
+                 NULL));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_decode_frame (NPA_700_001D, mid_binary, 0U,
+                 &pressure_pa, NULL));
+    TEST_ASSERT (NPA_ERR_FATAL == npa_decode_frame ( (npa_variant_t) NUM_SENSORS,
+                 mid_binary, 2U, &pressure_pa, NULL));
+}
+
+void test_npa_700_decode_frame_fatal_status (void)
+{
+    const uint8_t diagnostic_binary[] = { 0xDFU, 0xFFU };
+    const uint8_t mode_binary[] = { 0x60U, 0x00U };
+    float pressure_pa = 1000.0F;
+    float expected_pa;
+    // Pressure is written as in npa_read_pressure, status tells it is not valid.
+    TEST_ASSERT (NPA_ERR_FATAL == npa_decode_frame (NPA_700_001D, diagnostic_binary, 2U,
+                 &pressure_pa, NULL));
+    (void) npa_convert_pa (NPA_700_001D, 0x1FFFU, &expected_pa);
+    TEST_ASSERT (expected_pa == pressure_pa);
+    pressure_pa = 1000.0F;
+    TEST_ASSERT (NPA_ERR_MODE == npa_decode_frame (NPA_700_001D, mode_binary, 2U,
+                 &pressure_pa, NULL));
+    (void) npa_convert_pa (NPA_700_001D, NPA_PRES_MIDDLE, &expected_pa);
+    TEST_ASSERT (expected_pa == pressure_pa);
+}
+
+void test_npa_700_read_pressure_batch (void)
+{
+    const npa_ctx_t sensors[4] =
+    {
+        { .write = &i2c_write, .read = &i2c_read, .npa_addr = NPA_ADDR, .model = NPA_700_02WD },
+        { .write = &i2c_write, .read = &i2c2_read, .npa_addr = NPA_ADDR, .model = NPA_700_001D },
+        { .write = &i2c_write, .read = NULL, .npa_addr = NPA_ADDR, .model = NPA_700_001D },
+        { .write = &i2c_write, .read = &i2c_read, .npa_addr = NPA_ADDR + 1U, .model = NPA_700_030D }
+    };
+    float pressure_pa[4] = { 1.0F, 1.0F, 1.0F, 1.0F };
+    npa_ret_t status[4];
+    uint8_t expect[2] = { 0xFF, 0xFF };
+    // Transfers on same bus are grouped together.
+    i2c_read_ExpectWithArrayAndReturn (NPA_ADDR, expect, 2U, 2U, NPA_SUCCESS);
+    i2c_read_ReturnArrayThruPtr_data (min_nonsat_binary, 2U);
+    i2c_read_ExpectWithArrayAndReturn (NPA_ADDR + 1U, expect, 2U, 2U, NPA_SUCCESS);
+    i2c_read_ReturnArrayThruPtr_data (max_nonsat_binary, 2U);
+    i2c2_read_ExpectWithArrayAndReturn (NPA_ADDR, expect, 2U, 2U, NPA_SUCCESS);
+    i2c2_read_ReturnArrayThruPtr_data (mid_binary, 2U);
+    npa_ret_t ret_code = npa_read_pressure_batch (sensors, 4U, pressure_pa, status);
+    TEST_ASSERT (NPA_ERR_NULL == ret_code);
+    TEST_ASSERT (NPA_SUCCESS == status[0U]);
+    TEST_ASSERT (NPA_SUCCESS == status[1U]);
+    TEST_ASSERT (NPA_ERR_NULL == status[2U]);
+    TEST_ASSERT (NPA_SUCCESS == status[3U]);
+    TEST_ASSERT_FLOAT_WITHIN (M_02WD_MAX_NONSAT / 4096.0F, M_02WD_MIN_NONSAT,
+                              pressure_pa[0U]);
+    TEST_ASSERT_FLOAT_WITHIN (M_001D_MAX_NONSAT / 4096.0F, M_001D_MIDDLE,
+                              pressure_pa[1U]);
+    TEST_ASSERT (1.0F == pressure_pa[2U]);
+    TEST_ASSERT_FLOAT_WITHIN (M_030D_MAX_NONSAT / 4096.0F, M_030D_MAX_NONSAT,
+                              pressure_pa[3U]);
+}
+
+void test_npa_700_read_pressure_batch_chunks (void)
+{
+    // Larger than internal buffer of the driver.
+    const npa_ctx_t sensors[NUM_BATCH] =
+    {
+        M_BATCH_SENSOR, M_BATCH_SENSOR, M_BATCH_SENSOR, M_BATCH_SENSOR, M_BATCH_SENSOR,
+        M_BATCH_SENSOR, M_BATCH_SENSOR, M_BATCH_SENSOR, M_BATCH_SENSOR, M_BATCH_SENSOR,
+        M_BATCH_SENSOR, M_BATCH_SENSOR, M_BATCH_SENSOR, M_BATCH_SENSOR, M_BATCH_SENSOR,
+        M_BATCH_SENSOR, M_BATCH_SENSOR, M_BATCH_SENSOR, M_BATCH_SENSOR, M_BATCH_SENSOR
+    };
+    float pressure_pa[NUM_BATCH];
+    uint8_t expect[2] = { 0xFF, 0xFF };
+    const uint8_t sat_binary[] = { 0x3FU, 0xFFU };
+
+    for (size_t ii = 0U; ii < NUM_BATCH; ii++)
+    {
+        i2c_read_ExpectWithArrayAndReturn (NPA_ADDR, expect, 2U, 2U, NPA_SUCCESS);
+
+        if ( (NUM_BATCH - 1U) == ii)
+        {
+            i2c_read_ReturnArrayThruPtr_data (sat_binary, 2U);
+        }
+        else
+        {
+            i2c_read_ReturnArrayThruPtr_data (mid_binary, 2U);
+        }
+    }
+
+    npa_ret_t ret_code = npa_read_pressure_batch (sensors, NUM_BATCH, pressure_pa, NULL);
+    TEST_ASSERT (NPA_WARN_SAT == ret_code);
+
+    for (size_t ii = 0U; ii < (NUM_BATCH - 1U); ii++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN (M_001D_MAX_NONSAT / 4096.0F, M_001D_MIDDLE,
+                                  pressure_pa[ii]);
+    }
+
+    ret_code = npa_read_pressure_batch (NULL, NUM_BATCH, pressure_pa, NULL);
+    TEST_ASSERT (NPA_ERR_NULL == ret_code);
+    ret_code = npa_read_pressure_batch (sensors, NUM_BATCH, NULL, NULL);
+    TEST_ASSERT (NPA_ERR_NULL == ret_code);
+}
 /**
  * @brief Read pressure and 8-bit temperature from sensor.
  *
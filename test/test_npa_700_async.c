@@ -0,0 +1,209 @@
+#include "unity.h"
+
+#include "npa_700_async.h"
+#include "npa_700.h"
+
+#include <string.h>
+
+#define NPA_ADDR (0x28U)  //!< Default address of NPA-700.
+
+static const uint8_t mid_binary[]   = { 0x20U, 0x00U, 0x60U, 0x00U };
+static const uint8_t stale_binary[] = { 0xB9U, 0x99U, 0x60U, 0x00U };
+
+// Mock asynchronous bus: stores the transfer until test completes it.
+static npa_async_t * m_bus_transfer;
+static uint8_t * m_bus_data;
+static uint8_t m_bus_len;
+static uint8_t m_bus_addr;
+static uint32_t m_bus_starts;
+static npa_ret_t m_bus_start_status;
+
+// Results of callback.
+static uint32_t m_cb_calls;
+static npa_ret_t m_cb_status;
+static float m_cb_pressure;
+static float m_cb_temperature;
+static const npa_async_ctx_t * m_cb_sensor;
+static bool m_cb_restart;
+
+static npa_ret_t bus_read_async (const uint8_t i2c_addr,
+                                 uint8_t * const data,
+                                 const uint8_t data_len,
+                                 npa_async_t * const transfer)
+{
+    m_bus_transfer = transfer;
+    m_bus_data = data;
+    m_bus_len = data_len;
+    m_bus_addr = i2c_addr;
+    m_bus_starts++;
+    return m_bus_start_status;
+}
+
+// Simulates interrupt at the end of transfer.
+static void bus_complete (const uint8_t * const frame, const npa_ret_t status)
+{
+    if (NPA_SUCCESS == status)
+    {
+        memcpy (m_bus_data, frame, m_bus_len);
+    }
+
+    npa_read_complete (m_bus_transfer, status);
+}
+
+static void read_cb (const npa_async_ctx_t * const sensor,
+                     const npa_ret_t status,
+                     const float pressure_pa,
+                     const float temperature_c)
+{
+    m_cb_calls++;
+    m_cb_sensor = sensor;
+    m_cb_status = status;
+    m_cb_pressure = pressure_pa;
+    m_cb_temperature = temperature_c;
+
+    if (m_cb_restart)
+    {
+        m_cb_restart = false;
+        TEST_ASSERT (NPA_SUCCESS == npa_read_start (sensor, m_bus_transfer));
+    }
+}
+
+static const npa_async_ctx_t m_sensor_hires =
+{
+    .read = &bus_read_async,
+    .callback = &read_cb,
+    .p_context = NULL,
+    .npa_addr = NPA_ADDR,
+    .model = NPA_700_001D,
+    .data_len = NPA_FRAME_LEN_HIRES
+};
+
+static const npa_async_ctx_t m_sensor_pres =
+{
+    .read = &bus_read_async,
+    .callback = &read_cb,
+    .p_context = NULL,
+    .npa_addr = NPA_ADDR + 1U,
+    .model = NPA_700_02WD,
+    .data_len = NPA_FRAME_LEN_PRES
+};
+
+static npa_async_t m_transfer;
+
+void setUp (void)
+{
+    m_bus_transfer = NULL;
+    m_bus_data = NULL;
+    m_bus_len = 0U;
+    m_bus_addr = 0U;
+    m_bus_starts = 0U;
+    m_bus_start_status = NPA_SUCCESS;
+    m_cb_calls = 0U;
+    m_cb_status = NPA_SUCCESS;
+    m_cb_pressure = -1.0F;
+    m_cb_temperature = -1.0F;
+    m_cb_sensor = NULL;
+    m_cb_restart = false;
+    TEST_ASSERT (NPA_SUCCESS == npa_async_init (&m_transfer));
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_async_null (void)
+{
+    const npa_async_ctx_t no_callback =
+    {
+        .read = &bus_read_async,
+        .callback = NULL,
+        .p_context = NULL,
+        .npa_addr = NPA_ADDR,
+        .model = NPA_700_001D,
+        .data_len = NPA_FRAME_LEN_PRES
+    };
+    const npa_async_ctx_t bad_len =
+    {
+        .read = &bus_read_async,
+        .callback = &read_cb,
+        .p_context = NULL,
+        .npa_addr = NPA_ADDR,
+        .model = NPA_700_001D,
+        .data_len = 5U
+    };
+    TEST_ASSERT (NPA_ERR_NULL == npa_async_init (NULL));
+    TEST_ASSERT (NPA_ERR_NULL == npa_read_start (NULL, &m_transfer));
+    TEST_ASSERT (NPA_ERR_NULL == npa_read_start (&m_sensor_hires, NULL));
+    TEST_ASSERT (NPA_ERR_NULL == npa_read_start (&no_callback, &m_transfer));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_read_start (&bad_len, &m_transfer));
+    TEST_ASSERT (0U == m_bus_starts);
+    TEST_ASSERT_FALSE (npa_read_busy (NULL));
+    // Completing idle transfer is ignored.
+    npa_read_complete (&m_transfer, NPA_SUCCESS);
+    npa_read_complete (NULL, NPA_SUCCESS);
+    TEST_ASSERT (0U == m_cb_calls);
+}
+
+void test_npa_700_async_read (void)
+{
+    npa_ret_t ret_code = npa_read_start (&m_sensor_hires, &m_transfer);
+    TEST_ASSERT (NPA_SUCCESS == ret_code);
+    TEST_ASSERT (1U == m_bus_starts);
+    TEST_ASSERT (NPA_ADDR == m_bus_addr);
+    TEST_ASSERT (NPA_FRAME_LEN_HIRES == m_bus_len);
+    TEST_ASSERT (&m_transfer == m_bus_transfer);
+    TEST_ASSERT_TRUE (npa_read_busy (&m_transfer));
+    // Second read cannot start before first completes.
+    ret_code = npa_read_start (&m_sensor_hires, &m_transfer);
+    TEST_ASSERT (NPA_ERR_BUSY == ret_code);
+    TEST_ASSERT (1U == m_bus_starts);
+    TEST_ASSERT (0U == m_cb_calls);
+    bus_complete (mid_binary, NPA_SUCCESS);
+    TEST_ASSERT_FALSE (npa_read_busy (&m_transfer));
+    TEST_ASSERT (1U == m_cb_calls);
+    TEST_ASSERT (&m_sensor_hires == m_cb_sensor);
+    TEST_ASSERT (NPA_SUCCESS == m_cb_status);
+    TEST_ASSERT_FLOAT_WITHIN (NPA_001D_SCALE_PA / 4096.0F, 0.0F, m_cb_pressure);
+    TEST_ASSERT_FLOAT_WITHIN (200.0F / 2047.0F, 25.0F, m_cb_temperature);
+}
+
+void test_npa_700_async_status (void)
+{
+    float expected_pa;
+    TEST_ASSERT (NPA_SUCCESS == npa_read_start (&m_sensor_pres, &m_transfer));
+    TEST_ASSERT (NPA_FRAME_LEN_PRES == m_bus_len);
+    bus_complete (stale_binary, NPA_SUCCESS);
+    TEST_ASSERT (NPA_WARN_OLD == m_cb_status);
+    (void) npa_convert_pa (NPA_700_02WD, 0x3999U, &expected_pa);
+    TEST_ASSERT (expected_pa == m_cb_pressure);
+    TEST_ASSERT (0.0F == m_cb_temperature);
+    // Failed transfer leaves buffer in its initial, all bits set state.
+    TEST_ASSERT (NPA_SUCCESS == npa_read_start (&m_sensor_pres, &m_transfer));
+    bus_complete (NULL, NPA_ERR_NACK);
+    TEST_ASSERT (2U == m_cb_calls);
+    TEST_ASSERT (NPA_ERR_NACK == (m_cb_status & NPA_ERR_NACK));
+    TEST_ASSERT_FALSE (npa_read_busy (&m_transfer));
+}
+
+void test_npa_700_async_start_error (void)
+{
+    m_bus_start_status = NPA_ERR_TOUT;
+    TEST_ASSERT (NPA_ERR_TOUT == npa_read_start (&m_sensor_hires, &m_transfer));
+    TEST_ASSERT_FALSE (npa_read_busy (&m_transfer));
+    m_bus_start_status = NPA_SUCCESS;
+    TEST_ASSERT (NPA_SUCCESS == npa_read_start (&m_sensor_hires, &m_transfer));
+    TEST_ASSERT (0U == m_cb_calls);
+}
+
+void test_npa_700_async_restart_from_callback (void)
+{
+    m_cb_restart = true;
+    TEST_ASSERT (NPA_SUCCESS == npa_read_start (&m_sensor_hires, &m_transfer));
+    bus_complete (mid_binary, NPA_SUCCESS);
+    TEST_ASSERT (1U == m_cb_calls);
+    TEST_ASSERT (2U == m_bus_starts);
+    TEST_ASSERT_TRUE (npa_read_busy (&m_transfer));
+    bus_complete (mid_binary, NPA_SUCCESS);
+    TEST_ASSERT (2U == m_cb_calls);
+    TEST_ASSERT_FALSE (npa_read_busy (&m_transfer));
+}
@@ -0,0 +1,241 @@
+#include "unity.h"
+
+#include "npa_700.h"
+#include "npa_700_breath.h"
+
+#include <string.h>
+
+#define PERIOD_US    (10000U) //!< 100 Hz sampling.
+#define INSP_SAMPLES (100U)   //!< Samples of inspiration in synthetic breath.
+#define EXP_SAMPLES  (200U)   //!< Samples of expiration in synthetic breath.
+#define INSP_FLOW    (5000)   //!< Inspiratory flow, uL/s.
+#define EXP_FLOW     (-2500)  //!< Expiratory flow, uL/s.
+#define PEEP_PA      (500.0F) //!< Baseline pressure.
+#define THRESHOLD    (200)    //!< Phase thresholds, uL/s.
+#define MAX_SUMMARY  (8U)     //!< Summaries stored by callback.
+
+static npa_breath_t m_breath;
+static npa_breath_summary_t m_summary[MAX_SUMMARY];
+static uint32_t m_num_summary;
+static int m_context;
+
+static void breath_cb (const npa_breath_summary_t * const summary,
+                       void * const p_context)
+{
+    TEST_ASSERT (&m_context == p_context);
+
+    if (m_num_summary < MAX_SUMMARY)
+    {
+        m_summary[m_num_summary] = *summary;
+    }
+
+    m_num_summary++;
+}
+
+static const npa_breath_cfg_t m_cfg =
+{
+    .sample_period_us = PERIOD_US,
+    .insp_threshold = THRESHOLD,
+    .exp_threshold = THRESHOLD,
+    .min_phase_samples = 10U,
+    .callback = breath_cb,
+    .p_context = &m_context
+};
+
+// Square flow, pressure ramps up during inspiration and drops to PEEP.
+static void square_breath (void)
+{
+    for (uint32_t ii = 0U; ii < INSP_SAMPLES; ii++)
+    {
+        npa_breath_push (&m_breath, INSP_FLOW, PEEP_PA + (15.0F * (float) ii), NPA_SUCCESS);
+    }
+
+    for (uint32_t ii = 0U; ii < EXP_SAMPLES; ii++)
+    {
+        npa_breath_push (&m_breath, EXP_FLOW, PEEP_PA, NPA_SUCCESS);
+    }
+}
+
+// Noise around zero flow, inside thresholds.
+static void idle (const uint32_t samples)
+{
+    for (uint32_t ii = 0U; ii < samples; ii++)
+    {
+        const int32_t noise = (0U == (ii & 1U)) ? (THRESHOLD - 1) : (-THRESHOLD + 1);
+        npa_breath_push (&m_breath, noise, PEEP_PA, NPA_SUCCESS);
+    }
+}
+
+void setUp (void)
+{
+    memset (m_summary, 0, sizeof (m_summary));
+    m_num_summary = 0U;
+    TEST_ASSERT (NPA_SUCCESS == npa_breath_init (&m_breath, &m_cfg));
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_breath_init (void)
+{
+    npa_breath_cfg_t cfg = m_cfg;
+    TEST_ASSERT (NPA_ERR_NULL == npa_breath_init (NULL, &cfg));
+    TEST_ASSERT (NPA_ERR_NULL == npa_breath_init (&m_breath, NULL));
+    cfg.callback = NULL;
+    TEST_ASSERT (NPA_ERR_NULL == npa_breath_init (&m_breath, &cfg));
+    cfg = m_cfg;
+    cfg.sample_period_us = 0U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_breath_init (&m_breath, &cfg));
+    cfg = m_cfg;
+    cfg.insp_threshold = 0;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_breath_init (&m_breath, &cfg));
+    cfg = m_cfg;
+    cfg.exp_threshold = -1;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_breath_init (&m_breath, &cfg));
+    TEST_ASSERT (0 == npa_breath_volume (NULL));
+    npa_breath_push (NULL, INSP_FLOW, PEEP_PA, NPA_SUCCESS);
+}
+
+void test_npa_700_breath_square (void)
+{
+    idle (50U);
+    TEST_ASSERT (NPA_BREATH_WAIT == m_breath.phase);
+
+    for (uint32_t breath = 0U; breath < 3U; breath++)
+    {
+        square_breath();
+    }
+
+    // Third breath closes only when the fourth starts.
+    TEST_ASSERT (2U == m_num_summary);
+    npa_breath_push (&m_breath, INSP_FLOW, PEEP_PA, NPA_SUCCESS);
+    TEST_ASSERT (3U == m_num_summary);
+
+    for (uint32_t breath = 0U; breath < 3U; breath++)
+    {
+        const npa_breath_summary_t * const summary = &m_summary[breath];
+        TEST_ASSERT (50U + (breath * (INSP_SAMPLES + EXP_SAMPLES)) == summary->start_sample);
+        TEST_ASSERT ( (INSP_SAMPLES + EXP_SAMPLES) * PERIOD_US == summary->breath_time_us);
+        TEST_ASSERT (INSP_SAMPLES * PERIOD_US == summary->insp_time_us);
+        TEST_ASSERT (5000 == summary->inhaled);
+        TEST_ASSERT (5000 == summary->exhaled);
+        TEST_ASSERT_EQUAL_FLOAT (PEEP_PA + (15.0F * (INSP_SAMPLES - 1U)), summary->pip_pa);
+        TEST_ASSERT_EQUAL_FLOAT (PEEP_PA, summary->peep_pa);
+    }
+}
+
+void test_npa_700_breath_volume_in_progress (void)
+{
+    TEST_ASSERT (0 == npa_breath_volume (&m_breath));
+
+    for (uint32_t ii = 0U; ii < INSP_SAMPLES; ii++)
+    {
+        npa_breath_push (&m_breath, INSP_FLOW, PEEP_PA, NPA_SUCCESS);
+        TEST_ASSERT ( (int32_t) (ii + 1U) * 50 == npa_breath_volume (&m_breath));
+    }
+
+    for (uint32_t ii = 0U; ii < EXP_SAMPLES; ii++)
+    {
+        npa_breath_push (&m_breath, EXP_FLOW, PEEP_PA, NPA_SUCCESS);
+    }
+
+    TEST_ASSERT (0 == npa_breath_volume (&m_breath));
+    TEST_ASSERT (NPA_BREATH_EXPIRATION == m_breath.phase);
+    TEST_ASSERT (0U == m_num_summary);
+}
+
+void test_npa_700_breath_hysteresis (void)
+{
+    square_breath();
+    // Flow reverses briefly early in inspiration and rises briefly early in
+    // expiration, neither lasts past minimum phase.
+    npa_breath_push (&m_breath, INSP_FLOW, PEEP_PA, NPA_SUCCESS);
+    TEST_ASSERT (1U == m_num_summary);
+    npa_breath_push (&m_breath, EXP_FLOW, PEEP_PA, NPA_SUCCESS);
+    TEST_ASSERT (NPA_BREATH_INSPIRATION == m_breath.phase);
+
+    for (uint32_t ii = 0U; ii < 20U; ii++)
+    {
+        npa_breath_push (&m_breath, INSP_FLOW, PEEP_PA, NPA_SUCCESS);
+    }
+
+    npa_breath_push (&m_breath, EXP_FLOW, PEEP_PA, NPA_SUCCESS);
+    TEST_ASSERT (NPA_BREATH_EXPIRATION == m_breath.phase);
+    npa_breath_push (&m_breath, INSP_FLOW, PEEP_PA, NPA_SUCCESS);
+    TEST_ASSERT (NPA_BREATH_EXPIRATION == m_breath.phase);
+    idle (100U);
+    TEST_ASSERT (NPA_BREATH_EXPIRATION == m_breath.phase);
+    TEST_ASSERT (1U == m_num_summary);
+}
+
+void test_npa_700_breath_fatal_samples (void)
+{
+    npa_breath_push (&m_breath, INSP_FLOW, PEEP_PA, NPA_SUCCESS);
+
+    // Invalid readings are dropped, but time advances.
+    for (uint32_t ii = 0U; ii < 10U; ii++)
+    {
+        npa_breath_push (&m_breath, EXP_FLOW * 100, 1.0e6F, NPA_ERR_TOUT);
+    }
+
+    for (uint32_t ii = 1U; ii < INSP_SAMPLES; ii++)
+    {
+        npa_breath_push (&m_breath, INSP_FLOW, PEEP_PA, NPA_SUCCESS);
+    }
+
+    for (uint32_t ii = 0U; ii < EXP_SAMPLES; ii++)
+    {
+        npa_breath_push (&m_breath, EXP_FLOW, PEEP_PA, NPA_SUCCESS);
+    }
+
+    npa_breath_push (&m_breath, INSP_FLOW, PEEP_PA, NPA_SUCCESS);
+    TEST_ASSERT (1U == m_num_summary);
+    TEST_ASSERT ( (INSP_SAMPLES + EXP_SAMPLES + 10U) * PERIOD_US
+                  == m_summary[0U].breath_time_us);
+    TEST_ASSERT (5000 == m_summary[0U].inhaled);
+    TEST_ASSERT (5000 == m_summary[0U].exhaled);
+    TEST_ASSERT_EQUAL_FLOAT (PEEP_PA, m_summary[0U].pip_pa);
+}
+
+void test_npa_700_breath_triangle (void)
+{
+    // Flow rises and falls linearly, peaks 6000 and -3000 uL/s.
+    int64_t inhaled = 0;
+    int64_t exhaled = 0;
+
+    for (uint32_t breath = 0U; breath < 4U; breath++)
+    {
+        for (int32_t ii = -60; ii < 60; ii++)
+        {
+            const int32_t flow = 6000 - (100 * ( (ii < 0) ? -ii : ii));
+            inhaled += (breath < 3U) ? flow : 0;
+            npa_breath_push (&m_breath, flow, PEEP_PA + (float) flow / 10.0F, NPA_SUCCESS);
+        }
+
+        for (int32_t ii = -120; ii < 120; ii++)
+        {
+            const int32_t flow = -3000 + (25 * ( (ii < 0) ? -ii : ii));
+            exhaled -= (breath < 3U) ? flow : 0;
+            npa_breath_push (&m_breath, flow, PEEP_PA, NPA_SUCCESS);
+        }
+    }
+
+    TEST_ASSERT (3U == m_num_summary);
+    int64_t sum_inhaled = 0;
+    int64_t sum_exhaled = 0;
+
+    for (uint32_t breath = 0U; breath < 3U; breath++)
+    {
+        // Breath starts when flow first exceeds threshold.
+        TEST_ASSERT (360U * PERIOD_US == m_summary[breath].breath_time_us);
+        TEST_ASSERT_EQUAL_FLOAT (PEEP_PA + 600.0F, m_summary[breath].pip_pa);
+        sum_inhaled += m_summary[breath].inhaled;
+        sum_exhaled += m_summary[breath].exhaled;
+    }
+
+    // Exact integrals less the sub-threshold tails before first breath and after
+    // last summary, within rounding of one unit per breath.
+    TEST_ASSERT_INT_WITHIN (3, inhaled / 100, sum_inhaled);
+    TEST_ASSERT_INT_WITHIN (3, exhaled / 100, sum_exhaled);
+}
@@ -0,0 +1,201 @@
+#include "unity.h"
+
+#include "npa_700.h"
+#include "npa_700_capture.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#define BLOCK_SIZE  (256U)  //!< Block size of tests.
+#define NUM_FRAMES  (2000U) //!< Frames per capture.
+#define MAX_BLOCKS  (64U)   //!< Blocks stored by emit.
+#define SENSOR_ADDR (0x28U) //!< Address in block headers.
+
+static uint8_t m_buffer[2U * BLOCK_SIZE];
+static uint8_t m_blocks[MAX_BLOCKS][BLOCK_SIZE];
+static const uint8_t * m_emitted[MAX_BLOCKS];
+static size_t m_num_blocks;
+static uint8_t m_frames[NUM_FRAMES][NPA_FRAME_LEN_HIRES];
+static uint8_t m_lens[NUM_FRAMES];
+static uint32_t m_timestamps[NUM_FRAMES];
+static npa_capture_t m_capture;
+
+static void store_block (const uint8_t * const block, const size_t block_len,
+                         void * const p_context)
+{
+    (void) p_context;
+    TEST_ASSERT (BLOCK_SIZE == block_len);
+    TEST_ASSERT (MAX_BLOCKS > m_num_blocks);
+    memcpy (m_blocks[m_num_blocks], block, block_len);
+    m_emitted[m_num_blocks] = block;
+    m_num_blocks++;
+}
+
+static npa_capture_cfg_t capture_cfg (void)
+{
+    const npa_capture_cfg_t cfg =
+    {
+        .buffer = m_buffer,
+        .block_size = BLOCK_SIZE,
+        .model = NPA_700_001D,
+        .addr = SENSOR_ADDR,
+        .emit = &store_block,
+        .p_context = NULL
+    };
+    return cfg;
+}
+
+// Noisy pressure, jittered timestamps starting just before wrap, mixed frame lengths.
+static void generate_frames (const bool mixed_lengths)
+{
+    uint32_t state = 1U;
+    uint32_t timestamp = 0xFFFFF000UL;
+    uint32_t counts = 8192U;
+    uint32_t temperature = 1024U;
+
+    for (uint32_t ii = 0U; ii < NUM_FRAMES; ii++)
+    {
+        state = (state * 1103515245U) + 12345U;
+        const uint32_t noise = (state >> 16U);
+        counts = (counts + (noise & 0x07U) - 3U) & 0x3FFFU;
+        temperature = (temperature + ( (noise >> 3U) & 0x01U)) & 0x7FFU;
+        timestamp += 1000U + ( (noise >> 4U) & 0x0FU);
+        m_timestamps[ii] = timestamp;
+        m_lens[ii] = mixed_lengths ? (uint8_t) (NPA_FRAME_LEN_PRES + ( (noise >> 8U) % 3U))
+                     : NPA_FRAME_LEN_HIRES;
+        m_frames[ii][0U] = (uint8_t) ( ( (noise >> 10U) & 0xC0U) | (counts >> 8U));
+        m_frames[ii][1U] = (uint8_t) (counts & 0xFFU);
+        m_frames[ii][2U] = (uint8_t) (temperature >> 3U);
+        // Reserved bits of 4-byte frame are set and must not matter.
+        m_frames[ii][3U] = (uint8_t) ( ( (temperature & 0x07U) << 5U) | 0x1FU);
+    }
+}
+
+static size_t capture_frames (void)
+{
+    for (uint32_t ii = 0U; ii < NUM_FRAMES; ii++)
+    {
+        TEST_ASSERT (NPA_SUCCESS == npa_capture_append (&m_capture, m_timestamps[ii],
+                     m_frames[ii], m_lens[ii]));
+    }
+
+    TEST_ASSERT (NPA_SUCCESS == npa_capture_flush (&m_capture));
+    return m_num_blocks;
+}
+
+void setUp (void)
+{
+    const npa_capture_cfg_t cfg = capture_cfg();
+    m_num_blocks = 0U;
+    TEST_ASSERT (NPA_SUCCESS == npa_capture_init (&m_capture, &cfg));
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_capture_crc32 (void)
+{
+    const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    TEST_ASSERT (0xCBF43926UL == npa_capture_crc32 (0U, check, sizeof (check)));
+    // Chained computation equals one pass.
+    TEST_ASSERT (0xCBF43926UL == npa_capture_crc32 (npa_capture_crc32 (0U, check, 4U),
+                 &check[4U], sizeof (check) - 4U));
+}
+
+void test_npa_700_capture_round_trip (void)
+{
+    npa_capture_reader_t reader;
+    npa_capture_record_t record;
+    uint32_t frame = 0U;
+    generate_frames (true);
+    const size_t num_blocks = capture_frames();
+
+    for (size_t ii = 0U; ii < num_blocks; ii++)
+    {
+        TEST_ASSERT (NPA_SUCCESS == npa_capture_open (&reader, m_blocks[ii], BLOCK_SIZE));
+        TEST_ASSERT (NPA_700_001D == reader.header.model);
+        TEST_ASSERT (SENSOR_ADDR == reader.header.addr);
+        TEST_ASSERT (ii == reader.header.sequence);
+
+        while (npa_capture_next (&reader, &record))
+        {
+            TEST_ASSERT (NUM_FRAMES > frame);
+            TEST_ASSERT (m_timestamps[frame] == record.timestamp);
+            TEST_ASSERT (m_lens[frame] == record.raw_len);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY (m_frames[frame], record.raw,
+                                           (NPA_FRAME_LEN_HIRES == m_lens[frame])
+                                           ? 3U : m_lens[frame]);
+
+            if (NPA_FRAME_LEN_HIRES == m_lens[frame])
+            {
+                TEST_ASSERT ( (m_frames[frame][3U] & 0xE0U) == record.raw[3U]);
+            }
+
+            frame++;
+        }
+
+        TEST_ASSERT (0U == reader.remaining);
+    }
+
+    TEST_ASSERT (NUM_FRAMES == frame);
+    // Emitted blocks alternate between the two halves of buffer.
+    TEST_ASSERT (m_emitted[0U] == m_buffer);
+    TEST_ASSERT (m_emitted[1U] == &m_buffer[BLOCK_SIZE]);
+    TEST_ASSERT (m_emitted[2U] == m_buffer);
+}
+
+void test_npa_700_capture_compact (void)
+{
+    npa_capture_reader_t reader;
+    size_t payload = 0U;
+    generate_frames (false);
+    const size_t num_blocks = capture_frames();
+
+    for (size_t ii = 0U; ii < num_blocks; ii++)
+    {
+        TEST_ASSERT (NPA_SUCCESS == npa_capture_open (&reader, m_blocks[ii], BLOCK_SIZE));
+        payload += reader.header.payload_len;
+    }
+
+    // 4-byte frame and timestamp take 8 bytes as they are, 4 as a record.
+    TEST_ASSERT (payload <= ( (NUM_FRAMES * 4U) + NPA_CAPTURE_MAX_RECORD));
+    TEST_ASSERT ( (num_blocks * BLOCK_SIZE) <= (NUM_FRAMES * 5U));
+}
+
+void test_npa_700_capture_corrupt (void)
+{
+    npa_capture_reader_t reader;
+    generate_frames (true);
+    (void) capture_frames();
+    m_blocks[0U][NPA_CAPTURE_HEADER_LEN + 5U] ^= 0x10U;
+    TEST_ASSERT (NPA_ERR_FATAL == npa_capture_open (&reader, m_blocks[0U], BLOCK_SIZE));
+    m_blocks[1U][0U] ^= 0x01U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_capture_open (&reader, m_blocks[1U], BLOCK_SIZE));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_capture_open (&reader, m_blocks[2U],
+                 BLOCK_SIZE - 1U));
+    TEST_ASSERT (NPA_ERR_NULL == npa_capture_open (&reader, NULL, BLOCK_SIZE));
+    TEST_ASSERT (NPA_SUCCESS == npa_capture_open (&reader, m_blocks[2U], BLOCK_SIZE));
+}
+
+void test_npa_700_capture_invalid (void)
+{
+    npa_capture_cfg_t cfg = capture_cfg();
+    const uint8_t frame[NPA_FRAME_LEN_HIRES] = { 0x20U, 0x00U, 0x80U, 0x00U };
+    TEST_ASSERT (NPA_ERR_NULL == npa_capture_init (NULL, &cfg));
+    TEST_ASSERT (NPA_ERR_NULL == npa_capture_init (&m_capture, NULL));
+    cfg.block_size = NPA_CAPTURE_MIN_BLOCK - 1U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_capture_init (&m_capture, &cfg));
+    cfg.block_size = BLOCK_SIZE;
+    cfg.emit = NULL;
+    TEST_ASSERT (NPA_ERR_NULL == npa_capture_init (&m_capture, &cfg));
+    cfg = capture_cfg();
+    TEST_ASSERT (NPA_SUCCESS == npa_capture_init (&m_capture, &cfg));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_capture_append (&m_capture, 0U, frame, 1U));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_capture_append (&m_capture, 0U, frame, 5U));
+    TEST_ASSERT (NPA_ERR_NULL == npa_capture_append (&m_capture, 0U, NULL, 2U));
+    // Empty block is not emitted.
+    TEST_ASSERT (NPA_SUCCESS == npa_capture_flush (&m_capture));
+    TEST_ASSERT (0U == m_num_blocks);
+    TEST_ASSERT (NPA_ERR_NULL == npa_capture_flush (NULL));
+}
@@ -0,0 +1,237 @@
+#include "unity.h"
+
+#include "npa_700.h"
+#include "npa_700_filter.h"
+
+#include <string.h>
+
+#define NUM_INPUT (1024U) //!< Samples in reference comparisons.
+
+static uint16_t m_input[NUM_INPUT];
+static npa_filter_t m_filter;
+
+// Deterministic pseudo-random 14-bit samples.
+static void fill_input (void)
+{
+    uint32_t state = 12345U;
+
+    for (size_t ii = 0U; ii < NUM_INPUT; ii++)
+    {
+        state = (state * 1103515245U) + 12345U;
+        m_input[ii] = (uint16_t) ( (state >> 16U) & 0x3FFFU);
+    }
+}
+
+// Direct form CIC: order cascaded moving sums of length ratio at input rate.
+static uint16_t reference_cic (const size_t last, const uint16_t ratio,
+                               const uint8_t order)
+{
+    static int64_t stage_in[NUM_INPUT];
+    static int64_t stage_out[NUM_INPUT];
+    int64_t gain = 1;
+
+    for (size_t ii = 0U; ii <= last; ii++)
+    {
+        stage_in[ii] = m_input[ii];
+    }
+
+    for (uint8_t stage = 0U; stage < order; stage++)
+    {
+        for (size_t ii = 0U; ii <= last; ii++)
+        {
+            stage_out[ii] = 0;
+
+            for (size_t kk = 0U; (kk < ratio) && (kk <= ii); kk++)
+            {
+                stage_out[ii] += stage_in[ii - kk];
+            }
+        }
+
+        memcpy (stage_in, stage_out, (last + 1U) * sizeof (int64_t));
+        gain *= ratio;
+    }
+
+    return (uint16_t) ( (stage_in[last] + (gain / 2)) / gain);
+}
+
+void setUp (void)
+{
+    fill_input();
+    memset (&m_filter, 0, sizeof (m_filter));
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_filter_init (void)
+{
+    static const int16_t taps[2U] = { 16384, 16384 };
+    npa_filter_cfg_t cfg = { .kernel = NPA_FILTER_CIC, .decimation = 8U, .cic_order = 3U };
+    TEST_ASSERT (NPA_ERR_NULL == npa_filter_init (NULL, &cfg));
+    TEST_ASSERT (NPA_ERR_NULL == npa_filter_init (&m_filter, NULL));
+    TEST_ASSERT (NPA_SUCCESS == npa_filter_init (&m_filter, &cfg));
+    cfg.decimation = 0U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_filter_init (&m_filter, &cfg));
+    // 2^18 is largest gain.
+    cfg.decimation = 64U;
+    TEST_ASSERT (NPA_SUCCESS == npa_filter_init (&m_filter, &cfg));
+    cfg.decimation = 65U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_filter_init (&m_filter, &cfg));
+    cfg.cic_order = 0U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_filter_init (&m_filter, &cfg));
+    cfg.cic_order = NPA_FILTER_CIC_MAX_ORDER + 1U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_filter_init (&m_filter, &cfg));
+    cfg.kernel = NPA_FILTER_FIR;
+    cfg.decimation = 2U;
+    TEST_ASSERT (NPA_ERR_NULL == npa_filter_init (&m_filter, &cfg));
+    cfg.fir_taps = taps;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_filter_init (&m_filter, &cfg));
+    cfg.fir_len = NPA_FILTER_FIR_MAX_TAPS + 1U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_filter_init (&m_filter, &cfg));
+    cfg.fir_len = 2U;
+    TEST_ASSERT (NPA_SUCCESS == npa_filter_init (&m_filter, &cfg));
+    cfg.kernel = (npa_filter_kernel_t) 3;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_filter_init (&m_filter, &cfg));
+    // Boxcar accepts full range of ratio.
+    cfg.kernel = NPA_FILTER_BOXCAR;
+    cfg.decimation = UINT16_MAX;
+    TEST_ASSERT (NPA_SUCCESS == npa_filter_init (&m_filter, &cfg));
+}
+
+void test_npa_700_filter_uninitialized (void)
+{
+    uint16_t output = 0U;
+    TEST_ASSERT_FALSE (npa_filter_push (&m_filter, 1000U, &output));
+    TEST_ASSERT_FALSE (npa_filter_push (NULL, 1000U, &output));
+    TEST_ASSERT (0U == npa_filter_process (&m_filter, m_input, NUM_INPUT, NULL));
+}
+
+void test_npa_700_filter_boxcar (void)
+{
+    const npa_filter_cfg_t cfg = { .kernel = NPA_FILTER_BOXCAR, .decimation = 4U };
+    uint16_t output[NUM_INPUT / 4U + 1U];
+    TEST_ASSERT (NPA_SUCCESS == npa_filter_init (&m_filter, &cfg));
+    TEST_ASSERT (NUM_INPUT / 4U == npa_filter_process (&m_filter, m_input, NUM_INPUT,
+                 output));
+
+    for (size_t ii = 0U; ii < (NUM_INPUT / 4U); ii++)
+    {
+        const uint32_t sum = (uint32_t) m_input[4U * ii] + m_input[ (4U * ii) + 1U]
+                             + m_input[ (4U * ii) + 2U] + m_input[ (4U * ii) + 3U];
+        TEST_ASSERT_EQUAL_UINT16 ( (sum + 2U) / 4U, output[ii]);
+    }
+}
+
+void test_npa_700_filter_cic_reference (void)
+{
+    static const uint16_t ratios[] = { 1U, 2U, 5U, 16U };
+    uint16_t output[NUM_INPUT + 1U];
+
+    for (uint8_t order = 1U; order <= NPA_FILTER_CIC_MAX_ORDER; order++)
+    {
+        for (size_t rr = 0U; rr < (sizeof (ratios) / sizeof (ratios[0])); rr++)
+        {
+            const npa_filter_cfg_t cfg =
+            {
+                .kernel = NPA_FILTER_CIC,
+                .decimation = ratios[rr],
+                .cic_order = order
+            };
+            TEST_ASSERT (NPA_SUCCESS == npa_filter_init (&m_filter, &cfg));
+            const size_t produced = npa_filter_process (&m_filter, m_input, 128U, output);
+            TEST_ASSERT (128U / ratios[rr] == produced);
+
+            for (size_t ii = 0U; ii < produced; ii++)
+            {
+                const size_t last = ( (ii + 1U) * ratios[rr]) - 1U;
+                TEST_ASSERT_EQUAL_UINT16 (reference_cic (last, ratios[rr], order), output[ii]);
+            }
+        }
+    }
+}
+
+void test_npa_700_filter_cic_full_scale (void)
+{
+    const npa_filter_cfg_t cfg = { .kernel = NPA_FILTER_CIC, .decimation = 64U, .cic_order = 3U };
+    uint16_t output = 0U;
+    size_t produced = 0U;
+    TEST_ASSERT (NPA_SUCCESS == npa_filter_init (&m_filter, &cfg));
+
+    // Integrators wrap many times, output settles to input after order blocks.
+    for (uint32_t ii = 0U; ii < 100000U; ii++)
+    {
+        if (npa_filter_push (&m_filter, 0x3FFFU, &output))
+        {
+            produced++;
+
+            if (produced >= cfg.cic_order)
+            {
+                TEST_ASSERT_EQUAL_UINT16 (0x3FFFU, output);
+            }
+        }
+    }
+
+    npa_filter_reset (&m_filter);
+
+    for (uint32_t ii = 0U; ii < 64U; ii++)
+    {
+        produced = npa_filter_push (&m_filter, 0x3FFFU, &output) ? 1U : 0U;
+    }
+
+    // First output after reset only sees part of the impulse response.
+    TEST_ASSERT (1U == produced);
+    TEST_ASSERT (0x3FFFU > output);
+}
+
+void test_npa_700_filter_fir_reference (void)
+{
+    static const int16_t taps[5U] = { 2048, 8192, 12288, 8192, 2048 };
+    const npa_filter_cfg_t cfg =
+    {
+        .kernel = NPA_FILTER_FIR,
+        .decimation = 3U,
+        .fir_taps = taps,
+        .fir_len = 5U
+    };
+    uint16_t output[NUM_INPUT / 3U + 1U];
+    TEST_ASSERT (NPA_SUCCESS == npa_filter_init (&m_filter, &cfg));
+    const size_t produced = npa_filter_process (&m_filter, m_input, NUM_INPUT, output);
+    TEST_ASSERT (NUM_INPUT / 3U == produced);
+
+    for (size_t ii = 0U; ii < produced; ii++)
+    {
+        const size_t last = ( (ii + 1U) * 3U) - 1U;
+        int64_t acc = 0;
+
+        for (size_t kk = 0U; (kk < 5U) && (kk <= last); kk++)
+        {
+            acc += (int64_t) taps[kk] * m_input[last - kk];
+        }
+
+        TEST_ASSERT_EQUAL_UINT16 ( (acc + 16384) >> 15, output[ii]);
+    }
+}
+
+void test_npa_700_filter_fir_clamp (void)
+{
+    static const int16_t taps[2U] = { 32767, 32767 };
+    static const int16_t negative[1U] = { -32768 };
+    npa_filter_cfg_t cfg =
+    {
+        .kernel = NPA_FILTER_FIR,
+        .decimation = 1U,
+        .fir_taps = taps,
+        .fir_len = 2U
+    };
+    uint16_t output = 0U;
+    TEST_ASSERT (NPA_SUCCESS == npa_filter_init (&m_filter, &cfg));
+    TEST_ASSERT_TRUE (npa_filter_push (&m_filter, 0x3FFFU, &output));
+    TEST_ASSERT_TRUE (npa_filter_push (&m_filter, 0x3FFFU, &output));
+    TEST_ASSERT_EQUAL_UINT16 (0x3FFFU, output);
+    cfg.fir_taps = negative;
+    cfg.fir_len = 1U;
+    TEST_ASSERT (NPA_SUCCESS == npa_filter_init (&m_filter, &cfg));
+    TEST_ASSERT_TRUE (npa_filter_push (&m_filter, 0x3FFFU, &output));
+    TEST_ASSERT_EQUAL_UINT16 (0U, output);
+}
@@ -0,0 +1,160 @@
+#include "unity.h"
+
+#include "npa_700.h"
+#include "npa_700_flow.h"
+
+#include <string.h>
+
+#define K_Q16(k) ( (uint32_t) ( (k) * 65536.0))
+
+static npa_flow_t m_flow;
+
+// Check stated tolerance of square root without libm.
+static bool sqrt_in_tolerance (const uint32_t x)
+{
+    const uint64_t target = (uint64_t) x << 16U;
+    const uint64_t root = npa_flow_sqrt_q8 (x);
+    // Never more than 1 LSB above.
+    const bool not_over = (0U == root) || ( ( (root - 1U) * (root - 1U)) <= target);
+    // At most 0.004 % + 1 LSB below.
+    const double upper = ( (double) root + 1.0) * 1.00004;
+    const bool not_under = (upper * upper) >= (double) target;
+    return not_over && not_under;
+}
+
+void setUp (void)
+{
+    memset (&m_flow, 0, sizeof (m_flow));
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_flow_sqrt (void)
+{
+    TEST_ASSERT (0U == npa_flow_sqrt_q8 (0U));
+    TEST_ASSERT (256U == npa_flow_sqrt_q8 (1U));
+    TEST_ASSERT (256U * 1000U == npa_flow_sqrt_q8 (1000000U));
+    TEST_ASSERT (1U << 23U == npa_flow_sqrt_q8 (1U << 30U));
+
+    for (uint32_t x = 0U; x < 70000U; x++)
+    {
+        TEST_ASSERT_TRUE (sqrt_in_tolerance (x));
+    }
+
+    for (uint64_t x = 70000U; x <= UINT32_MAX; x += (x >> 10U))
+    {
+        TEST_ASSERT_TRUE (sqrt_in_tolerance ( (uint32_t) x));
+    }
+
+    TEST_ASSERT_TRUE (sqrt_in_tolerance (UINT32_MAX));
+}
+
+void test_npa_700_flow_init (void)
+{
+    npa_flow_point_t points[NPA_FLOW_MAX_POINTS + 1U] = { { 0, 0U } };
+    TEST_ASSERT (NPA_ERR_NULL == npa_flow_init (NULL, points, 1U, true));
+    TEST_ASSERT (NPA_ERR_NULL == npa_flow_init (&m_flow, NULL, 1U, true));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_flow_init (&m_flow, points, 0U, true));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_flow_init (&m_flow, points,
+                 NPA_FLOW_MAX_POINTS + 1U, true));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_flow_init (&m_flow, points, 2U, true));
+    points[1U].dp_mpa = 1000;
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_init (&m_flow, points, 2U, true));
+    points[2U].dp_mpa = 500;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_flow_init (&m_flow, points, 3U, true));
+}
+
+void test_npa_700_flow_constant_k (void)
+{
+    const npa_flow_point_t point = { 0, K_Q16 (2.5) };
+    int32_t q = 0;
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_init (&m_flow, &point, 1U, true));
+    TEST_ASSERT (NPA_ERR_NULL == npa_flow_convert (NULL, 0, &q));
+    TEST_ASSERT (NPA_ERR_NULL == npa_flow_convert (&m_flow, 0, NULL));
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_convert (&m_flow, 0, &q));
+    TEST_ASSERT (0 == q);
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_convert (&m_flow, 1000000, &q));
+    TEST_ASSERT (2500 == q);
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_convert (&m_flow, -1000000, &q));
+    TEST_ASSERT (-2500 == q);
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_convert (&m_flow, 40000, &q));
+    TEST_ASSERT (500 == q);
+}
+
+void test_npa_700_flow_interpolation (void)
+{
+    const npa_flow_point_t points[3U] =
+    {
+        { 10000, K_Q16 (1.0) },
+        { 1000000, K_Q16 (2.0) },
+        { 4000000, K_Q16 (4.0) }
+    };
+    int32_t q = 0;
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_init (&m_flow, points, 3U, true));
+    // Below first point k is held.
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_convert (&m_flow, 2500, &q));
+    TEST_ASSERT (50 == q);
+    // At calibration points.
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_convert (&m_flow, 1000000, &q));
+    TEST_ASSERT (2000 == q);
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_convert (&m_flow, -4000000, &q));
+    TEST_ASSERT (-8000 == q);
+    // Midway between last points k = 3.0, sqrt (2500000) = 1581.14.
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_convert (&m_flow, 2500000, &q));
+    TEST_ASSERT_INT32_WITHIN (1, 4743, q);
+    // Above last point k is held.
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_convert (&m_flow, 9000000, &q));
+    TEST_ASSERT (12000 == q);
+}
+
+void test_npa_700_flow_asymmetric (void)
+{
+    const npa_flow_point_t points[2U] =
+    {
+        { -1000000, K_Q16 (1.0) },
+        { 1000000, K_Q16 (3.0) }
+    };
+    int32_t q = 0;
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_init (&m_flow, points, 2U, false));
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_convert (&m_flow, -1000000, &q));
+    TEST_ASSERT (-1000 == q);
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_convert (&m_flow, 1000000, &q));
+    TEST_ASSERT (3000 == q);
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_convert (&m_flow, 0, &q));
+    TEST_ASSERT (0 == q);
+}
+
+void test_npa_700_flow_saturation (void)
+{
+    const npa_flow_point_t point = { 0, UINT32_MAX };
+    int32_t q = 0;
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_init (&m_flow, &point, 1U, true));
+    TEST_ASSERT (NPA_WARN_SAT == npa_flow_convert (&m_flow, INT32_MAX, &q));
+    TEST_ASSERT (INT32_MAX == q);
+    TEST_ASSERT (NPA_WARN_SAT == npa_flow_convert (&m_flow, INT32_MIN, &q));
+    TEST_ASSERT (-INT32_MAX == q);
+}
+
+void test_npa_700_flow_batch (void)
+{
+    const npa_flow_point_t points[2U] =
+    {
+        { 0, K_Q16 (1.0) },
+        { 1000000, K_Q16 (2.0) }
+    };
+    int32_t values[5U] = { -1000000, -10000, 0, 250000, 1000000 };
+    int32_t expected[5U];
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_init (&m_flow, points, 2U, true));
+
+    for (size_t ii = 0U; ii < 5U; ii++)
+    {
+        TEST_ASSERT (NPA_SUCCESS == npa_flow_convert (&m_flow, values[ii], &expected[ii]));
+    }
+
+    TEST_ASSERT (NPA_ERR_NULL == npa_flow_convert_batch (&m_flow, NULL, 5U, values));
+    // In place.
+    TEST_ASSERT (NPA_SUCCESS == npa_flow_convert_batch (&m_flow, values, 5U, values));
+    TEST_ASSERT_EQUAL_INT32_ARRAY (expected, values, 5U);
+}
@@ -0,0 +1,155 @@
+#include "unity.h"
+
+#include "npa_700.h"
+#include "npa_700_frames.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#define NUM_WORDS  (65536U) //!< Every combination of status and 14-bit pressure.
+#define NUM_MODELS (7U)     //!< Number of supported variants.
+
+static uint8_t m_raw[ (NUM_WORDS * NPA_FRAME_LEN_HIRES) + 1U];
+static float m_pressure[NUM_WORDS];
+static float m_pressure_scalar[NUM_WORDS];
+static npa_ret_t m_status[NUM_WORDS];
+static npa_ret_t m_status_scalar[NUM_WORDS];
+
+// First two bytes of frame ii are ii, remaining bytes are temperature noise.
+static void fill_frames (uint8_t * const raw, const uint8_t data_len)
+{
+    uint32_t state = 1U;
+
+    for (uint32_t ii = 0U; ii < NUM_WORDS; ii++)
+    {
+        uint8_t * const frame = &raw[ii * data_len];
+        frame[0U] = (uint8_t) (ii >> 8U);
+        frame[1U] = (uint8_t) ii;
+
+        for (uint8_t byte = 2U; byte < data_len; byte++)
+        {
+            state = (state * 1103515245U) + 12345U;
+            frame[byte] = (uint8_t) (state >> 24U);
+        }
+    }
+}
+
+/**
+ * Check every frame of decoded buffer against single frame decoder and pressure
+ * conversion. Pressure is compared bit by bit, also for frames with fatal status for
+ * which single frame decoder does not write pressure.
+ */
+static void check_frames (const npa_variant_t model, const uint8_t * const raw,
+                          const uint8_t data_len, const size_t num_frames,
+                          const npa_ret_t status_all)
+{
+    npa_ret_t expected_all = NPA_SUCCESS;
+    bool exact = true;
+
+    for (size_t ii = 0U; ii < num_frames; ii++)
+    {
+        const uint8_t * const frame = &raw[ii * data_len];
+        const uint16_t counts = (uint16_t) ( ( (frame[0U] << 8U) | frame[1U]) & 0x3FFFU);
+        float pressure_pa = 0.0F;
+        float unused_pa = 0.0F;
+        const npa_ret_t status = npa_decode_frame (model, frame, data_len, &unused_pa, NULL);
+        (void) npa_convert_pa (model, counts, &pressure_pa);
+        expected_all |= status;
+        exact = exact && (status == m_status[ii]) && (status == m_status_scalar[ii])
+                && (0 == memcmp (&pressure_pa, &m_pressure[ii], sizeof (float)))
+                && (0 == memcmp (&pressure_pa, &m_pressure_scalar[ii], sizeof (float)));
+    }
+
+    TEST_ASSERT_TRUE (exact);
+    TEST_ASSERT (expected_all == status_all);
+}
+
+static void decode_and_check (const npa_variant_t model, const uint8_t * const raw,
+                              const uint8_t data_len, const size_t num_frames)
+{
+    memset (m_pressure, 0, sizeof (m_pressure));
+    memset (m_status, 0, sizeof (m_status));
+    const npa_ret_t status_all = npa_decode_frames (model, raw, data_len, num_frames,
+                                 m_pressure, m_status);
+    const npa_ret_t status_scalar = npa_decode_frames_scalar (model, raw, data_len,
+                                    num_frames, m_pressure_scalar, m_status_scalar);
+    TEST_ASSERT (status_scalar == status_all);
+    check_frames (model, raw, data_len, num_frames, status_all);
+}
+
+void setUp (void)
+{
+    memset (m_raw, 0, sizeof (m_raw));
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_frames_errors (void)
+{
+    float pressure_pa = -1.0F;
+    npa_ret_t status = NPA_SUCCESS;
+    TEST_ASSERT (NPA_ERR_NULL == npa_decode_frames (NPA_700_001D, NULL, 2U, 1U,
+                 &pressure_pa, &status));
+    TEST_ASSERT (NPA_ERR_NULL == npa_decode_frames (NPA_700_001D, m_raw, 2U, 1U, NULL,
+                 &status));
+    TEST_ASSERT (NPA_ERR_NULL == npa_decode_frames (NPA_700_001D, m_raw, 2U, 1U,
+                 &pressure_pa, NULL));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_decode_frames (NPA_700_001D, m_raw, 1U, 1U,
+                 &pressure_pa, &status));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_decode_frames_scalar (NPA_700_001D, m_raw, 5U, 1U,
+                 &pressure_pa, &status));
+    TEST_ASSERT (NPA_ERR_FATAL == npa_decode_frames ( (npa_variant_t) NUM_MODELS, m_raw,
+                 2U, 1U, &pressure_pa, &status));
+    TEST_ASSERT (-1.0F == pressure_pa);
+    TEST_ASSERT (NPA_SUCCESS == status);
+    // Empty buffer is valid.
+    TEST_ASSERT (NPA_SUCCESS == npa_decode_frames (NPA_700_001D, m_raw, 2U, 0U,
+                 &pressure_pa, &status));
+    TEST_ASSERT_NOT_NULL (npa_decode_frames_kernel());
+    TEST_ASSERT (NPA_ERR_NULL == npa_get_scaling (NPA_700_001D, NULL, &pressure_pa));
+    TEST_ASSERT (NPA_ERR_NULL == npa_get_scaling (NPA_700_001D, &pressure_pa, NULL));
+}
+
+void test_npa_700_frames_full_range_pres (void)
+{
+    fill_frames (m_raw, NPA_FRAME_LEN_PRES);
+
+    for (uint32_t model = 0U; model < NUM_MODELS; model++)
+    {
+        decode_and_check ( (npa_variant_t) model, m_raw, NPA_FRAME_LEN_PRES, NUM_WORDS);
+    }
+}
+
+void test_npa_700_frames_full_range_temp (void)
+{
+    fill_frames (m_raw, NPA_FRAME_LEN_HIRES);
+    decode_and_check (NPA_700_02WD, m_raw, NPA_FRAME_LEN_HIRES, NUM_WORDS);
+    decode_and_check (NPA_700_030D, m_raw, NPA_FRAME_LEN_HIRES, NUM_WORDS);
+    fill_frames (m_raw, NPA_FRAME_LEN_LOWRES);
+    decode_and_check (NPA_700_001D, m_raw, NPA_FRAME_LEN_LOWRES, NUM_WORDS);
+}
+
+void test_npa_700_frames_tails (void)
+{
+    // Unaligned buffer and every length around vector widths.
+    fill_frames (&m_raw[1U], NPA_FRAME_LEN_HIRES);
+
+    for (size_t num_frames = 0U; num_frames < 70U; num_frames++)
+    {
+        const size_t first = (num_frames * 997U) % (NUM_WORDS - num_frames);
+        decode_and_check (NPA_700_005D, &m_raw[1U + (first * NPA_FRAME_LEN_HIRES)],
+                          NPA_FRAME_LEN_HIRES, num_frames);
+        decode_and_check (NPA_700_005D, &m_raw[1U + (first * NPA_FRAME_LEN_PRES)],
+                          NPA_FRAME_LEN_PRES, num_frames);
+    }
+
+    // Arrays are not written past the last frame.
+    m_pressure[17U] = -1.0F;
+    m_status[17U] = NPA_ERR_INTERNAL;
+    (void) npa_decode_frames (NPA_700_001D, m_raw, NPA_FRAME_LEN_PRES, 17U, m_pressure,
+                              m_status);
+    TEST_ASSERT (-1.0F == m_pressure[17U]);
+    TEST_ASSERT (NPA_ERR_INTERNAL == m_status[17U]);
+}
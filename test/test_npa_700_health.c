@@ -0,0 +1,230 @@
+#include "unity.h"
+
+#include "npa_700.h"
+#include "npa_700_health.h"
+
+#include <string.h>
+
+#define PERIOD_US    (1000U) //!< Expected update period.
+#define TOLERANCE_US (100U)  //!< Allowed drift of period.
+
+static npa_health_t m_health;
+static uint32_t m_now_us;
+static uint16_t m_counts;
+static uint8_t m_state;
+static uint8_t m_changed;
+static uint32_t m_num_cb;
+static int m_context;
+
+static void health_cb (const uint8_t state, const uint8_t changed, void * const p_context)
+{
+    TEST_ASSERT (&m_context == p_context);
+    m_state = state;
+    m_changed = changed;
+    m_num_cb++;
+}
+
+static const npa_health_cfg_t m_cfg =
+{
+    .frozen_samples = 5U,
+    .error_weight = 4U,
+    .error_limit = 16U,
+    .sat_samples = 3U,
+    .period_us = PERIOD_US,
+    .period_tolerance_us = TOLERANCE_US,
+    .callback = health_cb,
+    .p_context = &m_context
+};
+
+// Fresh read with new counts after interval.
+static uint8_t fresh (const uint32_t interval_us)
+{
+    m_now_us += interval_us;
+    m_counts++;
+    return npa_health_update (&m_health, NPA_SUCCESS, m_counts, m_now_us);
+}
+
+// Read with given status and counts at the expected period.
+static uint8_t read_status (const npa_ret_t status, const uint16_t counts)
+{
+    m_now_us += PERIOD_US;
+    return npa_health_update (&m_health, status, counts, m_now_us);
+}
+
+void setUp (void)
+{
+    // Start close to wrap to check time arithmetic.
+    m_now_us = UINT32_MAX - 2500U;
+    m_counts = NPA_PRES_MIDDLE;
+    m_num_cb = 0U;
+    m_state = 0U;
+    m_changed = 0U;
+    TEST_ASSERT (NPA_SUCCESS == npa_health_init (&m_health, &m_cfg));
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_health_frozen (void)
+{
+    for (uint32_t ii = 0U; ii < 20U; ii++)
+    {
+        TEST_ASSERT (0U == fresh (PERIOD_US));
+    }
+
+    for (uint32_t ii = 0U; ii < 4U; ii++)
+    {
+        TEST_ASSERT (0U == read_status (NPA_SUCCESS, 100U));
+        // Stale reads repeat counts and neither count nor clear.
+        m_now_us -= PERIOD_US / 2U;
+        TEST_ASSERT (0U == read_status (NPA_WARN_OLD, 100U));
+        m_now_us -= PERIOD_US / 2U;
+    }
+
+    TEST_ASSERT (NPA_HEALTH_FROZEN == read_status (NPA_SUCCESS, 100U));
+    TEST_ASSERT (1U == m_num_cb);
+    TEST_ASSERT (NPA_HEALTH_FROZEN == m_changed);
+    TEST_ASSERT (NPA_HEALTH_FROZEN == read_status (NPA_SUCCESS, 100U));
+    TEST_ASSERT (NPA_HEALTH_FROZEN == read_status (NPA_ERR_NACK, 0U));
+    TEST_ASSERT (1U == m_num_cb);
+    TEST_ASSERT (0U == read_status (NPA_SUCCESS, 101U));
+    TEST_ASSERT (2U == m_num_cb);
+    TEST_ASSERT (NPA_HEALTH_FROZEN == m_changed);
+    TEST_ASSERT (0U == m_state);
+    TEST_ASSERT (2U == m_health.transitions);
+}
+
+void test_npa_700_health_dropout (void)
+{
+    // Error rate of 1/10 decays faster than it accumulates.
+    for (uint32_t ii = 0U; ii < 200U; ii++)
+    {
+        const npa_ret_t status = (0U == (ii % 10U)) ? NPA_ERR_TOUT : NPA_SUCCESS;
+        TEST_ASSERT (0U == read_status (status, (uint16_t) (NPA_PRES_MIDDLE + ii)));
+    }
+
+    // Errors not from bus are ignored.
+    for (uint32_t ii = 0U; ii < 100U; ii++)
+    {
+        TEST_ASSERT (0U == read_status (NPA_ERR_MODE, 0U));
+    }
+
+    for (uint32_t ii = 0U; ii < 3U; ii++)
+    {
+        TEST_ASSERT (0U == read_status (NPA_ERR_NACK, 0U));
+    }
+
+    TEST_ASSERT (NPA_HEALTH_DROPOUT == read_status (NPA_ERR_TOUT, 0U));
+    TEST_ASSERT (NPA_HEALTH_DROPOUT == m_changed);
+
+    // Score is bounded by limit, cleared after limit good reads.
+    for (uint32_t ii = 0U; ii < 100U; ii++)
+    {
+        (void) read_status (NPA_ERR_NACK, 0U);
+    }
+
+    for (uint32_t ii = 0U; ii < 15U; ii++)
+    {
+        TEST_ASSERT (NPA_HEALTH_DROPOUT == fresh (PERIOD_US));
+    }
+
+    TEST_ASSERT (0U == fresh (PERIOD_US));
+    TEST_ASSERT (2U == m_num_cb);
+}
+
+void test_npa_700_health_saturated (void)
+{
+    TEST_ASSERT (0U == read_status (NPA_WARN_SAT, NPA_PRES_MAX_SAT));
+    TEST_ASSERT (0U == read_status (NPA_WARN_SAT, NPA_PRES_MAX_SAT - 1U));
+    TEST_ASSERT (0U == fresh (PERIOD_US));
+    TEST_ASSERT (0U == read_status (NPA_WARN_SAT, NPA_PRES_MAX_SAT - 2U));
+    TEST_ASSERT (0U == read_status (NPA_WARN_SAT, NPA_PRES_MAX_SAT - 3U));
+    TEST_ASSERT (NPA_HEALTH_SATURATED == read_status (NPA_WARN_SAT, NPA_PRES_MAX_SAT - 4U));
+    m_now_us -= PERIOD_US / 2U;
+    TEST_ASSERT (NPA_HEALTH_SATURATED == read_status (NPA_WARN_SAT | NPA_WARN_OLD,
+                 NPA_PRES_MAX_SAT - 4U));
+    TEST_ASSERT (0U == fresh (PERIOD_US / 2U));
+    TEST_ASSERT (2U == m_num_cb);
+}
+
+void test_npa_700_health_rate (void)
+{
+    uint32_t updates = 0U;
+
+    for (uint32_t ii = 0U; ii < 50U; ii++)
+    {
+        // Jitter inside tolerance.
+        const uint32_t interval = (0U == (ii & 1U)) ? (PERIOD_US - 80U) : (PERIOD_US + 80U);
+        TEST_ASSERT (0U == fresh (interval));
+    }
+
+    // Slow drift is detected after average has moved.
+    while (0U == fresh (PERIOD_US + 300U))
+    {
+        updates++;
+    }
+
+    TEST_ASSERT ( (updates > 0U) && (updates < 8U));
+    TEST_ASSERT (NPA_HEALTH_RATE == m_changed);
+    updates = 0U;
+
+    while (0U != fresh (PERIOD_US))
+    {
+        updates++;
+    }
+
+    TEST_ASSERT (updates < 30U);
+    updates = 0U;
+
+    while (0U == fresh (PERIOD_US - 300U))
+    {
+        updates++;
+    }
+
+    TEST_ASSERT ( (updates > 0U) && (updates < 8U));
+
+    while (0U != fresh (PERIOD_US))
+    {
+    }
+
+    // Stalled sensor is detected by stale reads, before its next update.
+    m_now_us += PERIOD_US + TOLERANCE_US;
+    TEST_ASSERT (0U == npa_health_update (&m_health, NPA_WARN_OLD, m_counts, m_now_us));
+    m_now_us += 1U;
+    TEST_ASSERT (NPA_HEALTH_RATE == npa_health_update (&m_health, NPA_WARN_OLD, m_counts,
+                 m_now_us));
+    // Failed read keeps condition, and next fresh read starts a new interval.
+    m_now_us += 100000U;
+    TEST_ASSERT (NPA_HEALTH_RATE == npa_health_update (&m_health, NPA_ERR_TOUT, 0U,
+                 m_now_us));
+    TEST_ASSERT (0U == fresh (PERIOD_US));
+    TEST_ASSERT (0U == fresh (PERIOD_US));
+}
+
+void test_npa_700_health_invalid (void)
+{
+    npa_health_cfg_t cfg = m_cfg;
+    cfg.frozen_samples = 1U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_health_init (&m_health, &cfg));
+    cfg = m_cfg;
+    cfg.period_tolerance_us = 0U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_health_init (&m_health, &cfg));
+    cfg.period_us = 1UL << 27U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_health_init (&m_health, &cfg));
+    TEST_ASSERT (NPA_ERR_NULL == npa_health_init (NULL, &m_cfg));
+    TEST_ASSERT (NPA_ERR_NULL == npa_health_init (&m_health, NULL));
+    TEST_ASSERT (0U == npa_health_update (NULL, NPA_ERR_NACK, 0U, 0U));
+    TEST_ASSERT (0U == npa_health_state (NULL));
+    // All detectors disabled, no callback.
+    memset (&cfg, 0, sizeof (cfg));
+    TEST_ASSERT (NPA_SUCCESS == npa_health_init (&m_health, &cfg));
+
+    for (uint32_t ii = 0U; ii < 100U; ii++)
+    {
+        TEST_ASSERT (0U == read_status (NPA_ERR_NACK, 0U));
+        TEST_ASSERT (0U == read_status (NPA_WARN_SAT, NPA_PRES_MAX_SAT));
+    }
+
+    TEST_ASSERT (0U == npa_health_state (&m_health));
+}
@@ -0,0 +1,261 @@
+// nanosleep
+#define _POSIX_C_SOURCE 200809L
+
+#include "unity.h"
+
+#include "npa_700.h"
+#include "npa_700_linux.h"
+#include "npa_700_ring.h"
+#include "npa_700_sim.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SIM_ADDR    (0x28U) //!< Address of first virtual sensor.
+#define NUM_SENSORS (2U)    //!< Sensors read by acquisition thread.
+#define RING_SIZE   (256U)  //!< Samples per queue.
+#define PERIOD_US   (1000U) //!< Acquisition period.
+
+static const npa_ctx_t m_sensors[NUM_SENSORS] =
+{
+    {
+        .write = npa_linux_write,
+        .read = npa_linux_read,
+        .npa_addr = SIM_ADDR,
+        .model = NPA_700_001D,
+        .xfer = npa_linux_xfer
+    },
+    {
+        .write = npa_linux_write,
+        .read = npa_linux_read,
+        .npa_addr = SIM_ADDR + 1U,
+        .model = NPA_700_001D,
+        .xfer = npa_linux_xfer
+    }
+};
+
+static npa_linux_latest_t m_latest[NUM_SENSORS];
+static npa_ring_t m_rings[NUM_SENSORS];
+static npa_sample_t m_buffers[NUM_SENSORS][RING_SIZE];
+static npa_sample_t m_popped[RING_SIZE];
+static struct i2c_msg m_last_msgs[2U];
+static uint32_t m_last_nmsgs;
+static int m_fail_errno;
+
+// Stand-in of i2c-dev, serves messages from the simulator.
+static int sim_ioctl (const int fd, const unsigned long request, void * const arg)
+{
+    const struct i2c_rdwr_ioctl_data * const rdwr = (const struct i2c_rdwr_ioctl_data *) arg;
+    const struct i2c_msg * const msgs = rdwr->msgs;
+    npa_ret_t status = NPA_SUCCESS;
+    int result = (int) rdwr->nmsgs;
+    TEST_ASSERT (0 <= fd);
+    TEST_ASSERT (I2C_RDWR == request);
+    m_last_nmsgs = rdwr->nmsgs;
+    memcpy (m_last_msgs, msgs, rdwr->nmsgs * sizeof (struct i2c_msg));
+
+    if (2U == rdwr->nmsgs)
+    {
+        status = npa_sim_xfer ( (uint8_t) msgs[0].addr, msgs[0].buf, (uint8_t) msgs[0].len,
+                                msgs[1].buf, (uint8_t) msgs[1].len);
+    }
+    else if (0U != (msgs[0].flags & I2C_M_RD))
+    {
+        status = npa_sim_read ( (uint8_t) msgs[0].addr, msgs[0].buf, (uint8_t) msgs[0].len);
+    }
+    else
+    {
+        status = npa_sim_write ( (uint8_t) msgs[0].addr, msgs[0].buf, (uint8_t) msgs[0].len);
+    }
+
+    if (0 != m_fail_errno)
+    {
+        errno = m_fail_errno;
+        result = -1;
+    }
+    else if (NPA_ERR_NACK == status)
+    {
+        errno = ENXIO;
+        result = -1;
+    }
+    else
+    {
+        // Transfer succeeded.
+    }
+
+    return result;
+}
+
+static void sleep_ms (const uint32_t ms)
+{
+    const struct timespec duration = { 0, (long) ms * 1000000L };
+    (void) nanosleep (&duration, NULL);
+}
+
+void setUp (void)
+{
+    npa_sim_sensor_cfg_t cfg;
+    npa_sim_reset();
+    memset (&cfg, 0, sizeof (cfg));
+    cfg.model = NPA_700_001D;
+    cfg.mode = NPA_SIM_FREE_RUNNING;
+    cfg.period_us = PERIOD_US;
+    cfg.temperature_c = 25.0F;
+
+    for (uint8_t ii = 0U; ii < NUM_SENSORS; ii++)
+    {
+        cfg.addr = (uint8_t) (SIM_ADDR + ii);
+        cfg.pressure_pa = 100.0F * (float) (ii + 1U);
+        TEST_ASSERT (NPA_SUCCESS == npa_sim_add (&cfg));
+        TEST_ASSERT (NPA_SUCCESS == npa_ring_init (&m_rings[ii], m_buffers[ii], RING_SIZE));
+    }
+
+    m_fail_errno = 0;
+    m_last_nmsgs = 0U;
+    npa_linux_set_ioctl (&sim_ioctl);
+    TEST_ASSERT (NPA_SUCCESS == npa_linux_attach (open ("/dev/null", O_RDWR)));
+}
+
+void tearDown (void)
+{
+    npa_linux_close();
+    npa_linux_set_ioctl (NULL);
+}
+
+void test_npa_700_linux_bus (void)
+{
+    const uint8_t command[] = { 0xA0U, 0x00U, 0x00U };
+    uint8_t data[4U] = { 0U };
+    float pressure_pa = 0.0F;
+    TEST_ASSERT (NPA_SUCCESS == npa_read_pressure (&m_sensors[0U], &pressure_pa));
+    TEST_ASSERT_FLOAT_WITHIN (1.0F, 100.0F, pressure_pa);
+    TEST_ASSERT (1U == m_last_nmsgs);
+    TEST_ASSERT (SIM_ADDR == m_last_msgs[0].addr);
+    TEST_ASSERT (I2C_M_RD == m_last_msgs[0].flags);
+    TEST_ASSERT (2U == m_last_msgs[0].len);
+    TEST_ASSERT (NPA_SUCCESS == npa_linux_write (SIM_ADDR, command, sizeof (command)));
+    TEST_ASSERT (0U == m_last_msgs[0].flags);
+    TEST_ASSERT (sizeof (command) == m_last_msgs[0].len);
+    // Command and fetch go out as one message list.
+    TEST_ASSERT (NPA_SUCCESS == npa_write_read (&m_sensors[1U], command, sizeof (command),
+                 data, sizeof (data)));
+    TEST_ASSERT (2U == m_last_nmsgs);
+    TEST_ASSERT (0U == m_last_msgs[0].flags);
+    TEST_ASSERT (I2C_M_RD == m_last_msgs[1].flags);
+    TEST_ASSERT (sizeof (data) == m_last_msgs[1].len);
+    TEST_ASSERT (0U != data[1U]);
+    TEST_ASSERT (NPA_SUCCESS == npa_sample_trigger (&m_sensors[0U]));
+    TEST_ASSERT (0U == m_last_msgs[0].len);
+}
+
+void test_npa_700_linux_errors (void)
+{
+    uint8_t data[2U];
+    TEST_ASSERT (NPA_ERR_NACK == npa_linux_read (0x10U, data, sizeof (data)));
+    m_fail_errno = EREMOTEIO;
+    TEST_ASSERT (NPA_ERR_NACK == npa_linux_read (SIM_ADDR, data, sizeof (data)));
+    m_fail_errno = ETIMEDOUT;
+    TEST_ASSERT (NPA_ERR_TOUT == npa_linux_read (SIM_ADDR, data, sizeof (data)));
+    m_fail_errno = EBUSY;
+    TEST_ASSERT (NPA_ERR_BUSY == npa_linux_write (SIM_ADDR, data, sizeof (data)));
+    m_fail_errno = EIO;
+    TEST_ASSERT (NPA_ERR_FATAL == npa_linux_xfer (SIM_ADDR, data, 1U, data, 1U));
+    m_fail_errno = 0;
+    npa_linux_close();
+    TEST_ASSERT (NPA_ERR_FATAL == npa_linux_read (SIM_ADDR, data, sizeof (data)));
+    TEST_ASSERT (NPA_ERR_NULL == npa_linux_open (NULL));
+    TEST_ASSERT (NPA_ERR_FATAL == npa_linux_open ("/nonexistent/i2c-0"));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_linux_attach (-1));
+}
+
+void test_npa_700_linux_acquisition (void)
+{
+    npa_linux_acq_t acq;
+    npa_linux_acq_counters_t counters;
+    npa_sample_t sample;
+    const npa_linux_acq_cfg_t cfg =
+    {
+        .sensors = m_sensors,
+        .num_sensors = NUM_SENSORS,
+        .period_us = PERIOD_US,
+        .temperature = true,
+        .latest = m_latest,
+        .rings = m_rings
+    };
+    TEST_ASSERT (NPA_SUCCESS == npa_linux_acq_start (&acq, &cfg));
+    sleep_ms (30U);
+    TEST_ASSERT (NPA_SUCCESS == npa_linux_acq_latest (&acq, 1U, &sample));
+    TEST_ASSERT_FLOAT_WITHIN (1.0F, 200.0F, sample.pressure_pa);
+    TEST_ASSERT_FLOAT_WITHIN (1.0F, 25.0F, sample.temperature_c);
+    TEST_ASSERT (NPA_SUCCESS == npa_linux_acq_stop (&acq));
+    TEST_ASSERT (NPA_ERR_MODE == npa_linux_acq_stop (&acq));
+    TEST_ASSERT (NPA_SUCCESS == npa_linux_acq_counters (&acq, &counters));
+    TEST_ASSERT (5U <= counters.cycles);
+    TEST_ASSERT (0U == counters.dropped);
+
+    for (size_t ii = 0U; ii < NUM_SENSORS; ii++)
+    {
+        const size_t count = npa_ring_pop_bulk (&m_rings[ii], m_popped, RING_SIZE);
+        TEST_ASSERT (counters.cycles == count);
+        TEST_ASSERT (0U == (m_popped[0U].status & NPA_ERR_FATAL));
+        TEST_ASSERT_FLOAT_WITHIN (1.0F, 100.0F * (float) (ii + 1U), m_popped[0U].pressure_pa);
+
+        // Deadlines are absolute, so wake-up jitter does not shorten the span.
+        const uint32_t span = m_popped[count - 1U].timestamp - m_popped[0U].timestamp;
+        TEST_ASSERT ( (span + PERIOD_US) >= ( (uint32_t) (count - 1U) * PERIOD_US));
+    }
+}
+
+void test_npa_700_linux_overrun (void)
+{
+    npa_linux_acq_t acq;
+    npa_linux_acq_counters_t counters;
+    const npa_linux_acq_cfg_t cfg =
+    {
+        .sensors = m_sensors,
+        .num_sensors = 1U,
+        .period_us = PERIOD_US,
+        .clock = npa_sim_now_us,
+        .latest = m_latest
+    };
+    // Each read takes 2.5 periods in real time.
+    npa_sim_set_bus_latency (2500U, 0U, true);
+    TEST_ASSERT (NPA_SUCCESS == npa_linux_acq_start (&acq, &cfg));
+    sleep_ms (20U);
+    TEST_ASSERT (NPA_SUCCESS == npa_linux_acq_stop (&acq));
+    TEST_ASSERT (NPA_SUCCESS == npa_linux_acq_counters (&acq, &counters));
+    TEST_ASSERT (2U <= counters.cycles);
+    TEST_ASSERT (2U * counters.cycles <= counters.overruns);
+}
+
+void test_npa_700_linux_acquisition_invalid (void)
+{
+    npa_linux_acq_t acq;
+    npa_sample_t sample;
+    npa_linux_acq_cfg_t cfg =
+    {
+        .sensors = m_sensors,
+        .num_sensors = NUM_SENSORS,
+        .period_us = 0U,
+        .latest = m_latest
+    };
+    TEST_ASSERT (NPA_ERR_NULL == npa_linux_acq_start (NULL, &cfg));
+    TEST_ASSERT (NPA_ERR_NULL == npa_linux_acq_start (&acq, NULL));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_linux_acq_start (&acq, &cfg));
+    cfg.latest = NULL;
+    TEST_ASSERT (NPA_ERR_NULL == npa_linux_acq_start (&acq, &cfg));
+    // No sample before first cycle.
+    memset (&acq, 0, sizeof (acq));
+    acq.cfg.num_sensors = NUM_SENSORS;
+    acq.cfg.latest = m_latest;
+    memset (m_latest, 0, sizeof (m_latest));
+    TEST_ASSERT (NPA_WARN_OLD == npa_linux_acq_latest (&acq, 0U, &sample));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_linux_acq_latest (&acq, NUM_SENSORS, &sample));
+    TEST_ASSERT (NPA_ERR_NULL == npa_linux_acq_latest (&acq, 0U, NULL));
+    TEST_ASSERT (NPA_ERR_MODE == npa_linux_acq_stop (&acq));
+}
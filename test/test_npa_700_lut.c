@@ -0,0 +1,108 @@
+#include "unity.h"
+
+#include "npa_700.h"
+#include "npa_700_lut.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+// Test is built with tables of every model but NPA_700_02WD, see project.yml.
+#define NUM_MODELS (7U) //!< Number of supported variants.
+
+static uint16_t m_counts[NPA_LUT_SIZE + 1U];
+static float m_pressure[NPA_LUT_SIZE + 1U];
+static npa_ret_t m_status[NPA_LUT_SIZE + 1U];
+
+void setUp (void)
+{
+    for (uint32_t ii = 0U; ii <= NPA_LUT_SIZE; ii++)
+    {
+        m_counts[ii] = (uint16_t) ii;
+    }
+
+    memset (m_pressure, 0, sizeof (m_pressure));
+    memset (m_status, 0, sizeof (m_status));
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_lut_tables (void)
+{
+    TEST_ASSERT_FALSE (npa_lut_has_table (NPA_700_02WD));
+
+    for (uint32_t model = 1U; model < NUM_MODELS; model++)
+    {
+        TEST_ASSERT_TRUE (npa_lut_has_table ( (npa_variant_t) model));
+    }
+
+    TEST_ASSERT_FALSE (npa_lut_has_table ( (npa_variant_t) NUM_MODELS));
+}
+
+void test_npa_700_lut_exact (void)
+{
+    for (uint32_t model = 0U; model < NUM_MODELS; model++)
+    {
+        bool exact = true;
+
+        for (uint32_t counts = 0U; counts <= NPA_LUT_SIZE; counts++)
+        {
+            float expected = -1.0F;
+            float pressure_pa = -1.0F;
+            const npa_ret_t expected_status = npa_convert_pa ( (npa_variant_t) model,
+                                              (uint16_t) counts, &expected);
+            const npa_ret_t status = npa_lut_convert_pa ( (npa_variant_t) model,
+                                     (uint16_t) counts, &pressure_pa);
+            exact = exact && (expected_status == status)
+                    && (0 == memcmp (&expected, &pressure_pa, sizeof (float)));
+        }
+
+        TEST_ASSERT_TRUE (exact);
+    }
+}
+
+void test_npa_700_lut_batch (void)
+{
+    for (uint32_t model = 0U; model < NUM_MODELS; model++)
+    {
+        npa_ret_t expected_all = NPA_SUCCESS;
+        bool exact = true;
+        m_pressure[NPA_LUT_SIZE] = -1.0F;
+        const npa_ret_t status_all = npa_lut_convert_batch ( (npa_variant_t) model,
+                                     m_counts, NPA_LUT_SIZE + 1U, m_pressure, m_status);
+
+        for (uint32_t ii = 0U; ii <= NPA_LUT_SIZE; ii++)
+        {
+            float expected = -1.0F;
+            const npa_ret_t status = npa_convert_pa ( (npa_variant_t) model, m_counts[ii],
+                                     &expected);
+            expected_all |= status;
+            exact = exact && (status == m_status[ii])
+                    && (0 == memcmp (&expected, &m_pressure[ii], sizeof (float)));
+        }
+
+        TEST_ASSERT_TRUE (exact);
+        TEST_ASSERT (expected_all == status_all);
+        TEST_ASSERT ( (NPA_ERR_PARAM | NPA_WARN_SAT) == status_all);
+    }
+}
+
+void test_npa_700_lut_errors (void)
+{
+    float pressure_pa = -1.0F;
+    TEST_ASSERT (NPA_ERR_NULL == npa_lut_convert_pa (NPA_700_001D, 0U, NULL));
+    TEST_ASSERT (NPA_ERR_NULL == npa_lut_convert_pa (NPA_700_02WD, 0U, NULL));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_lut_convert_pa ( (npa_variant_t) NUM_MODELS, 0U,
+                 &pressure_pa));
+    TEST_ASSERT (-1.0F == pressure_pa);
+    TEST_ASSERT (NPA_ERR_NULL == npa_lut_convert_batch (NPA_700_001D, NULL, 1U,
+                 m_pressure, m_status));
+    TEST_ASSERT (NPA_ERR_NULL == npa_lut_convert_batch (NPA_700_001D, m_counts, 1U, NULL,
+                 m_status));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_lut_convert_batch ( (npa_variant_t) NUM_MODELS,
+                 m_counts, 1U, m_pressure, m_status));
+    // Status array is optional.
+    TEST_ASSERT (NPA_WARN_SAT == npa_lut_convert_batch (NPA_700_001D, m_counts, 2U,
+                 m_pressure, NULL));
+}
@@ -0,0 +1,152 @@
+#include "unity.h"
+
+#include "npa_700.h"
+#include "npa_700_poll.h"
+
+#include <string.h>
+
+#define NUM_UPDATES (2000U) //!< Sensor updates simulated per run.
+
+// Simulated free-running sensor: output updates at phase + k * period.
+static uint32_t m_period_us;
+static uint32_t m_phase_us;
+static uint32_t m_last_read_us;
+static uint32_t m_reads;
+
+static npa_poll_t m_poll;
+
+static uint32_t update_index (const uint32_t time_us)
+{
+    return (time_us - m_phase_us) / m_period_us;
+}
+
+static npa_ret_t sensor_read (const uint32_t now_us)
+{
+    const bool fresh = update_index (now_us) != update_index (m_last_read_us);
+    m_last_read_us = now_us;
+    m_reads++;
+    return fresh ? NPA_SUCCESS : NPA_WARN_OLD;
+}
+
+/**
+ * Run controller against simulated sensor.
+ *
+ * @param[in] period_us  Period of sensor.
+ * @param[in] initial_us Initial guess of controller.
+ * @return Worst latency from update to fresh read in second half of run.
+ */
+static uint32_t run (const uint32_t period_us, const uint32_t initial_us)
+{
+    const npa_poll_cfg_t cfg =
+    {
+        .initial_period_us = initial_us,
+        .min_period_us = 100U,
+        .max_period_us = 1000000U
+    };
+    m_period_us = period_us;
+    m_phase_us = 37U;
+    m_last_read_us = m_phase_us;
+    m_reads = 0U;
+    uint32_t now = m_phase_us + 1U;
+    uint32_t worst_latency = 0U;
+    const uint32_t end = m_phase_us + (NUM_UPDATES * period_us);
+    TEST_ASSERT (NPA_SUCCESS == npa_poll_init (&m_poll, &cfg, now));
+
+    while (now < end)
+    {
+        TEST_ASSERT_TRUE (npa_poll_due (&m_poll, now));
+        const npa_ret_t status = sensor_read (now);
+
+        if ( (NPA_SUCCESS == status) && (now > (end / 2U)))
+        {
+            const uint32_t latency = (now - m_phase_us) % period_us;
+            worst_latency = (latency > worst_latency) ? latency : worst_latency;
+        }
+
+        now = npa_poll_update (&m_poll, status, now);
+        TEST_ASSERT (now == npa_poll_deadline (&m_poll));
+    }
+
+    return worst_latency;
+}
+
+void setUp (void)
+{
+    memset (&m_poll, 0, sizeof (m_poll));
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_poll_init (void)
+{
+    npa_poll_cfg_t cfg = { .initial_period_us = 1000U, .min_period_us = 100U, .max_period_us = 10000U };
+    TEST_ASSERT (NPA_ERR_NULL == npa_poll_init (NULL, &cfg, 0U));
+    TEST_ASSERT (NPA_ERR_NULL == npa_poll_init (&m_poll, NULL, 0U));
+    TEST_ASSERT (NPA_SUCCESS == npa_poll_init (&m_poll, &cfg, 5U));
+    TEST_ASSERT (1000U == npa_poll_period (&m_poll));
+    TEST_ASSERT (5U == npa_poll_deadline (&m_poll));
+    TEST_ASSERT_FALSE (npa_poll_due (&m_poll, 4U));
+    TEST_ASSERT_TRUE (npa_poll_due (&m_poll, 5U));
+    TEST_ASSERT_FALSE (npa_poll_due (NULL, 5U));
+    cfg.min_period_us = 0U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_poll_init (&m_poll, &cfg, 0U));
+    cfg.min_period_us = 2000U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_poll_init (&m_poll, &cfg, 0U));
+    cfg.min_period_us = 100U;
+    cfg.max_period_us = 1UL << 27U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_poll_init (&m_poll, &cfg, 0U));
+}
+
+void test_npa_700_poll_converges (void)
+{
+    static const uint32_t periods[] = { 1000U, 1700U, 5000U, 33333U };
+
+    for (size_t ii = 0U; ii < (sizeof (periods) / sizeof (periods[0])); ii++)
+    {
+        // Start from both too short and too long guess.
+        const uint32_t guesses[2U] = { periods[ii] / 4U, periods[ii] * 3U };
+
+        for (size_t jj = 0U; jj < 2U; jj++)
+        {
+            const uint32_t latency = run (periods[ii], guesses[jj]);
+            TEST_ASSERT_UINT32_WITHIN (periods[ii] / 32U, periods[ii],
+                                       npa_poll_period (&m_poll));
+            // Fresh data is read soon after each update.
+            TEST_ASSERT (latency < (periods[ii] / 10U));
+            // Fewer than three reads per update, about one stale read.
+            TEST_ASSERT (m_reads < (3U * NUM_UPDATES));
+            TEST_ASSERT (m_reads == m_poll.reads);
+        }
+    }
+}
+
+void test_npa_700_poll_errors (void)
+{
+    const npa_poll_cfg_t cfg = { .initial_period_us = 1600U, .min_period_us = 100U, .max_period_us = 10000U };
+    TEST_ASSERT (NPA_SUCCESS == npa_poll_init (&m_poll, &cfg, 0U));
+    // Bus error retries without touching estimate.
+    TEST_ASSERT (1000U + 51U == npa_poll_update (&m_poll, NPA_ERR_NACK, 1000U));
+    TEST_ASSERT (1600U == npa_poll_period (&m_poll));
+    TEST_ASSERT (0U == m_poll.stale_reads);
+    // Stale reads back off exponentially.
+    TEST_ASSERT (2000U + 51U == npa_poll_update (&m_poll, NPA_WARN_OLD, 2000U));
+    TEST_ASSERT (3000U + 101U == npa_poll_update (&m_poll, NPA_WARN_OLD, 3000U));
+    TEST_ASSERT (2U == m_poll.stale_reads);
+    // Fresh read at 3100, update between 3000 and 3100. Next read 1/64 period early.
+    TEST_ASSERT (3050U + 1600U - 25U == npa_poll_update (&m_poll, NPA_SUCCESS, 3100U));
+    TEST_ASSERT (0U == npa_poll_update (NULL, NPA_SUCCESS, 0U));
+    TEST_ASSERT (0U == npa_poll_period (NULL));
+}
+
+void test_npa_700_poll_late_read (void)
+{
+    const npa_poll_cfg_t cfg = { .initial_period_us = 1600U, .min_period_us = 100U, .max_period_us = 10000U };
+    TEST_ASSERT (NPA_SUCCESS == npa_poll_init (&m_poll, &cfg, 0U));
+    (void) npa_poll_update (&m_poll, NPA_SUCCESS, 0U);
+    // Reading 10 periods late does not schedule into the past.
+    const uint32_t deadline = npa_poll_update (&m_poll, NPA_SUCCESS, 16000U);
+    TEST_ASSERT ( (int32_t) (deadline - 16000U) > 0);
+    TEST_ASSERT_FALSE (npa_poll_due (&m_poll, 16000U));
+}
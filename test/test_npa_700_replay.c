@@ -0,0 +1,279 @@
+// mkstemp, open_memstream
+#define _POSIX_C_SOURCE 200809L
+
+#include "unity.h"
+
+#include "npa_700.h"
+#include "npa_700_capture.h"
+#include "npa_700_filter.h"
+#include "npa_700_replay.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BLOCK_SIZE   (128U)   //!< Block size of tests.
+#define NUM_STREAMS  (3U)     //!< Sensors in capture.
+#define NUM_FRAMES   (600U)   //!< Frames per sensor.
+#define CAPTURE_MAX  (65536U) //!< Storage of capture.
+#define GARBAGE_LEN  (37U)    //!< Bytes of garbage between blocks.
+#define INTERVAL_US  (1000U)  //!< Interval of captured frames.
+
+static const uint8_t m_addrs[NUM_STREAMS] = { 0x28U, 0x29U, 0x2AU };
+static uint8_t m_buffers[NUM_STREAMS][2U * BLOCK_SIZE];
+static npa_capture_t m_captures[NUM_STREAMS];
+static uint8_t m_capture[CAPTURE_MAX];
+static size_t m_capture_len;
+static size_t m_num_blocks;
+static uint8_t m_frames[NUM_STREAMS][NUM_FRAMES][NPA_FRAME_LEN_HIRES];
+
+static void store_block (const uint8_t * const block, const size_t block_len,
+                         void * const p_context)
+{
+    (void) p_context;
+    TEST_ASSERT ( (m_capture_len + block_len + GARBAGE_LEN) <= CAPTURE_MAX);
+    memcpy (&m_capture[m_capture_len], block, block_len);
+    m_capture_len += block_len;
+    m_num_blocks++;
+
+    // Garbage after fifth block must be skipped.
+    if (5U == m_num_blocks)
+    {
+        memset (&m_capture[m_capture_len], 0xA5, GARBAGE_LEN);
+        m_capture_len += GARBAGE_LEN;
+    }
+}
+
+// Interleaved capture of sensors, including saturated, stale and diagnostic frames.
+static void generate_capture (void)
+{
+    uint32_t state = 7U;
+
+    for (uint32_t ss = 0U; ss < NUM_STREAMS; ss++)
+    {
+        const npa_capture_cfg_t cfg =
+        {
+            .buffer = m_buffers[ss],
+            .block_size = BLOCK_SIZE,
+            .model = (0U == ss) ? NPA_700_001D : NPA_700_005D,
+            .addr = m_addrs[ss],
+            .emit = &store_block,
+            .p_context = NULL
+        };
+        TEST_ASSERT (NPA_SUCCESS == npa_capture_init (&m_captures[ss], &cfg));
+    }
+
+    for (uint32_t ii = 0U; ii < NUM_FRAMES; ii++)
+    {
+        for (uint32_t ss = 0U; ss < NUM_STREAMS; ss++)
+        {
+            uint8_t * const frame = m_frames[ss][ii];
+            state = (state * 1103515245U) + 12345U;
+            const uint32_t counts = 1638U + ( (ii * (ss + 1U) * 7U) % 13107U)
+                                    + ( (state >> 16U) & 0x0FU);
+            const uint32_t status = (42U == (ii % 100U)) ? 3U
+                                    : (0U == ( (state >> 20U) % 50U)) ? 2U : 0U;
+            frame[0U] = (uint8_t) ( (status << 6U) | (counts >> 8U));
+            frame[1U] = (uint8_t) (counts & 0xFFU);
+            frame[2U] = (uint8_t) (0x60U + ss);
+            frame[3U] = 0x20U;
+            TEST_ASSERT (NPA_SUCCESS == npa_capture_append (&m_captures[ss],
+                         ii * INTERVAL_US, frame, NPA_FRAME_LEN_HIRES));
+        }
+    }
+
+    for (uint32_t ss = 0U; ss < NUM_STREAMS; ss++)
+    {
+        TEST_ASSERT (NPA_SUCCESS == npa_capture_flush (&m_captures[ss]));
+    }
+}
+
+static void check_outputs (const npa_replay_index_t * const index)
+{
+    for (uint32_t ss = 0U; ss < NUM_STREAMS; ss++)
+    {
+        const npa_replay_stream_t * const stream = &index->streams[ss];
+        TEST_ASSERT (NUM_FRAMES == stream->num_outputs);
+
+        for (uint32_t ii = 0U; ii < NUM_FRAMES; ii++)
+        {
+            float pressure_pa = 0.0F;
+            float temperature_c = 0.0F;
+            const npa_ret_t status = npa_decode_frame (stream->model, m_frames[ss][ii],
+                                     NPA_FRAME_LEN_HIRES, &pressure_pa, &temperature_c);
+            TEST_ASSERT (ii * INTERVAL_US == stream->outputs[ii].timestamp);
+            TEST_ASSERT (status == stream->outputs[ii].status);
+            TEST_ASSERT (0 == memcmp (&pressure_pa, &stream->outputs[ii].pressure_pa,
+                                      sizeof (float)));
+            TEST_ASSERT (0 == memcmp (&temperature_c, &stream->outputs[ii].temperature_c,
+                                      sizeof (float)));
+        }
+    }
+}
+
+void setUp (void)
+{
+    m_capture_len = 0U;
+    m_num_blocks = 0U;
+    generate_capture();
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_replay_index (void)
+{
+    npa_replay_index_t index;
+    TEST_ASSERT (NPA_SUCCESS == npa_replay_index (&index, m_capture, m_capture_len));
+    TEST_ASSERT (NUM_STREAMS == index.num_streams);
+    TEST_ASSERT (0U < index.bad_blocks);
+    TEST_ASSERT ( (NUM_STREAMS * NUM_FRAMES) == index.num_records);
+
+    for (uint32_t ss = 0U; ss < NUM_STREAMS; ss++)
+    {
+        TEST_ASSERT (m_addrs[ss] == index.streams[ss].addr);
+        TEST_ASSERT (NUM_FRAMES == index.streams[ss].num_records);
+    }
+
+    npa_replay_free (&index);
+    TEST_ASSERT (NULL == index.streams);
+    TEST_ASSERT (NPA_ERR_NULL == npa_replay_index (NULL, m_capture, m_capture_len));
+}
+
+void test_npa_700_replay_corrupt_block (void)
+{
+    npa_replay_index_t index;
+    npa_capture_reader_t reader;
+    // Corrupt payload of first block, its records are lost.
+    TEST_ASSERT (NPA_SUCCESS == npa_capture_open (&reader, m_capture, m_capture_len));
+    const uint16_t lost = reader.header.count;
+    m_capture[NPA_CAPTURE_HEADER_LEN + 3U] ^= 0x40U;
+    TEST_ASSERT (NPA_SUCCESS == npa_replay_index (&index, m_capture, m_capture_len));
+    TEST_ASSERT (NUM_STREAMS == index.num_streams);
+    TEST_ASSERT ( ( (NUM_STREAMS * NUM_FRAMES) - lost) == index.num_records);
+    npa_replay_free (&index);
+}
+
+void test_npa_700_replay_run (void)
+{
+    npa_replay_index_t index;
+    npa_replay_result_t result;
+    const npa_filter_cfg_t filter_cfg =
+    {
+        .kernel = NPA_FILTER_BOXCAR,
+        .decimation = 4U,
+        .cic_order = 0U,
+        .fir_taps = NULL,
+        .fir_len = 0U
+    };
+    const npa_replay_cfg_t cfg = { .threads = 2U, .speed = 0.0, .filter = &filter_cfg };
+    TEST_ASSERT (NPA_SUCCESS == npa_replay_index (&index, m_capture, m_capture_len));
+    TEST_ASSERT (NPA_SUCCESS == npa_replay_run (&index, m_capture, m_capture_len, &cfg,
+                 &result));
+    TEST_ASSERT ( (NUM_STREAMS * NUM_FRAMES) == result.records);
+    check_outputs (&index);
+
+    // Pressure of a frame with fatal status is converted from its counts.
+    for (uint32_t ss = 0U; ss < NUM_STREAMS; ss++)
+    {
+        const npa_replay_output_t * const output = &index.streams[ss].outputs[42U];
+        TEST_ASSERT (NPA_ERR_FATAL == output->status);
+        TEST_ASSERT (0.0F != output->pressure_pa);
+    }
+
+    // Every fourth record has a filter output.
+    for (uint32_t ss = 0U; ss < NUM_STREAMS; ss++)
+    {
+        npa_filter_t filter;
+        TEST_ASSERT (NPA_SUCCESS == npa_filter_init (&filter, &filter_cfg));
+
+        for (uint32_t ii = 0U; ii < NUM_FRAMES; ii++)
+        {
+            uint16_t expected = NPA_REPLAY_NO_OUTPUT;
+            const uint16_t counts = (uint16_t) ( ( (m_frames[ss][ii][0U] & 0x3FU) << 8U)
+                                                 | m_frames[ss][ii][1U]);
+            (void) npa_filter_push (&filter, counts, &expected);
+            TEST_ASSERT (expected == index.streams[ss].outputs[ii].filtered);
+            TEST_ASSERT ( (3U == (ii % 4U)) == (NPA_REPLAY_NO_OUTPUT != expected));
+        }
+    }
+
+    npa_replay_free (&index);
+}
+
+void test_npa_700_replay_paced (void)
+{
+    npa_replay_index_t index;
+    npa_replay_result_t result;
+    // 600 ms of capture at 20x takes 30 ms.
+    const npa_replay_cfg_t cfg = { .threads = 0U, .speed = 20.0, .filter = NULL };
+    const uint64_t expected_ns = ( (uint64_t) (NUM_FRAMES - 1U) * INTERVAL_US * 1000U) / 20U;
+    TEST_ASSERT (NPA_SUCCESS == npa_replay_index (&index, m_capture, m_capture_len));
+    TEST_ASSERT (NPA_SUCCESS == npa_replay_run (&index, m_capture, m_capture_len, &cfg,
+                 &result));
+    TEST_ASSERT (result.elapsed_ns >= expected_ns);
+    TEST_ASSERT (result.elapsed_ns < (10U * expected_ns));
+    check_outputs (&index);
+    // Fewer threads than streams still paces every stream from the same start.
+    const npa_replay_cfg_t single = { .threads = 1U, .speed = 20.0, .filter = NULL };
+    TEST_ASSERT (NPA_SUCCESS == npa_replay_run (&index, m_capture, m_capture_len, &single,
+                 &result));
+    TEST_ASSERT (result.elapsed_ns >= expected_ns);
+    TEST_ASSERT (result.elapsed_ns < (2U * expected_ns));
+    check_outputs (&index);
+    const npa_replay_cfg_t negative = { .threads = 0U, .speed = -1.0, .filter = NULL };
+    TEST_ASSERT (NPA_ERR_PARAM == npa_replay_run (&index, m_capture, m_capture_len,
+                 &negative, &result));
+    npa_replay_free (&index);
+}
+
+void test_npa_700_replay_map_dump_compare (void)
+{
+    npa_replay_file_t file;
+    npa_replay_index_t index;
+    npa_replay_result_t result;
+    const npa_replay_cfg_t cfg = { .threads = 0U, .speed = 0.0, .filter = NULL };
+    char path[] = "/tmp/npa_replay_XXXXXX";
+    const int fd = mkstemp (path);
+    TEST_ASSERT (0 <= fd);
+    TEST_ASSERT ( (ssize_t) m_capture_len == write (fd, m_capture, m_capture_len));
+    (void) close (fd);
+    TEST_ASSERT (NPA_SUCCESS == npa_replay_map (&file, path));
+    (void) unlink (path);
+    TEST_ASSERT (m_capture_len == file.len);
+    TEST_ASSERT (NPA_SUCCESS == npa_replay_index (&index, file.data, file.len));
+    TEST_ASSERT (NPA_SUCCESS == npa_replay_run (&index, file.data, file.len, &cfg,
+                 &result));
+    // Dump of one build, then of a build with a different result for one record.
+    char * a = NULL;
+    char * b = NULL;
+    size_t a_len = 0U;
+    size_t b_len = 0U;
+    size_t differing = 0U;
+    FILE * stream = open_memstream (&a, &a_len);
+    TEST_ASSERT (NPA_SUCCESS == npa_replay_dump (&index, stream));
+    TEST_ASSERT (0 == fclose (stream));
+    TEST_ASSERT ( (NPA_REPLAY_DUMP_HEADER + (NUM_STREAMS * NUM_FRAMES
+                                             * NPA_REPLAY_DUMP_RECORD)) == a_len);
+    index.streams[1U].outputs[10U].pressure_pa += 0.5F;
+    stream = open_memstream (&b, &b_len);
+    TEST_ASSERT (NPA_SUCCESS == npa_replay_dump (&index, stream));
+    TEST_ASSERT (0 == fclose (stream));
+    TEST_ASSERT (NPA_SUCCESS == npa_replay_compare ( (uint8_t *) a, a_len, (uint8_t *) a,
+                 a_len, NULL, 0U, &differing));
+    TEST_ASSERT (0U == differing);
+    TEST_ASSERT (NPA_SUCCESS == npa_replay_compare ( (uint8_t *) a, a_len, (uint8_t *) b,
+                 b_len, NULL, 0U, &differing));
+    TEST_ASSERT (1U == differing);
+    // Truncated dump is invalid.
+    TEST_ASSERT (NPA_ERR_PARAM == npa_replay_compare ( (uint8_t *) a, a_len - 1U,
+                 (uint8_t *) b, b_len, NULL, 0U, &differing));
+    free (a);
+    free (b);
+    npa_replay_free (&index);
+    npa_replay_unmap (&file);
+    TEST_ASSERT (NULL == file.data);
+}
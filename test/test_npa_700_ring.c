@@ -0,0 +1,166 @@
+// sched_yield
+#define _POSIX_C_SOURCE 200809L
+
+#include "unity.h"
+
+#include "npa_700_ring.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+#define RING_CAPACITY  (8U)       //!< Capacity of ring in single-thread tests.
+#define STRESS_CAPACITY (64U)     //!< Capacity of ring in stress test.
+#define STRESS_SAMPLES (200000U)  //!< Samples pushed in stress test.
+#define STRESS_BULK    (16U)      //!< Maximum samples consumer pops at once.
+
+static npa_sample_t m_buffer[STRESS_CAPACITY];
+static npa_ring_t m_ring;
+
+static npa_sample_t make_sample (const uint32_t seq)
+{
+    npa_sample_t sample =
+    {
+        .timestamp = seq,
+        .pressure_pa = (float) seq,
+        .temperature_c = 25.0F,
+        .status = seq & NPA_WARN_OLD
+    };
+    return sample;
+}
+
+void setUp (void)
+{
+    memset (m_buffer, 0, sizeof (m_buffer));
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_ring_init (void)
+{
+    TEST_ASSERT (NPA_ERR_NULL == npa_ring_init (NULL, m_buffer, RING_CAPACITY));
+    TEST_ASSERT (NPA_ERR_NULL == npa_ring_init (&m_ring, NULL, RING_CAPACITY));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_ring_init (&m_ring, m_buffer, 0U));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_ring_init (&m_ring, m_buffer, 6U));
+    TEST_ASSERT (NPA_SUCCESS == npa_ring_init (&m_ring, m_buffer, 1U));
+    TEST_ASSERT (NPA_SUCCESS == npa_ring_init (&m_ring, m_buffer, RING_CAPACITY));
+    TEST_ASSERT (0U == npa_ring_count (&m_ring));
+    TEST_ASSERT (0U == npa_ring_count (NULL));
+}
+
+void test_npa_700_ring_full_empty (void)
+{
+    npa_sample_t out[RING_CAPACITY + 1U];
+    TEST_ASSERT (NPA_SUCCESS == npa_ring_init (&m_ring, m_buffer, RING_CAPACITY));
+    TEST_ASSERT (0U == npa_ring_pop_bulk (&m_ring, out, RING_CAPACITY));
+
+    for (uint32_t ii = 0U; ii < RING_CAPACITY; ii++)
+    {
+        const npa_sample_t sample = make_sample (ii);
+        TEST_ASSERT_TRUE (npa_ring_push (&m_ring, &sample));
+    }
+
+    const npa_sample_t overflow = make_sample (RING_CAPACITY);
+    TEST_ASSERT_FALSE (npa_ring_push (&m_ring, &overflow));
+    TEST_ASSERT (RING_CAPACITY == npa_ring_count (&m_ring));
+    TEST_ASSERT (RING_CAPACITY == npa_ring_pop_bulk (&m_ring, out, RING_CAPACITY + 1U));
+
+    for (uint32_t ii = 0U; ii < RING_CAPACITY; ii++)
+    {
+        const npa_sample_t expected = make_sample (ii);
+        TEST_ASSERT_EQUAL_MEMORY (&expected, &out[ii], sizeof (npa_sample_t));
+    }
+
+    TEST_ASSERT (0U == npa_ring_count (&m_ring));
+    TEST_ASSERT_FALSE (npa_ring_push (NULL, &overflow));
+    TEST_ASSERT_FALSE (npa_ring_push (&m_ring, NULL));
+    TEST_ASSERT (0U == npa_ring_pop_bulk (NULL, out, 1U));
+    TEST_ASSERT (0U == npa_ring_pop_bulk (&m_ring, NULL, 1U));
+}
+
+void test_npa_700_ring_wrap (void)
+{
+    npa_sample_t out[RING_CAPACITY];
+    uint32_t pushed = 0U;
+    uint32_t popped = 0U;
+    TEST_ASSERT (NPA_SUCCESS == npa_ring_init (&m_ring, m_buffer, RING_CAPACITY));
+
+    // Uneven push and pop sizes move the wrap point through every slot.
+    for (uint32_t round = 0U; round < 100U; round++)
+    {
+        for (uint32_t ii = 0U; ii < ( (round % 5U) + 1U); ii++)
+        {
+            const npa_sample_t sample = make_sample (pushed);
+
+            if (npa_ring_push (&m_ring, &sample))
+            {
+                pushed++;
+            }
+        }
+
+        const size_t count = npa_ring_pop_bulk (&m_ring, out, (round % 3U) + 1U);
+
+        for (size_t ii = 0U; ii < count; ii++)
+        {
+            TEST_ASSERT (popped == out[ii].timestamp);
+            popped++;
+        }
+
+        TEST_ASSERT ( (pushed - popped) == npa_ring_count (&m_ring));
+    }
+}
+
+static void * stress_producer (void * arg)
+{
+    (void) arg;
+
+    for (uint32_t seq = 0U; seq < STRESS_SAMPLES;)
+    {
+        const npa_sample_t sample = make_sample (seq);
+
+        if (npa_ring_push (&m_ring, &sample))
+        {
+            seq++;
+        }
+        else
+        {
+            // Let consumer run also on a single core host.
+            (void) sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+void test_npa_700_ring_stress (void)
+{
+    pthread_t producer;
+    npa_sample_t out[STRESS_BULK];
+    uint32_t expected = 0U;
+    bool in_order = true;
+    TEST_ASSERT (NPA_SUCCESS == npa_ring_init (&m_ring, m_buffer, STRESS_CAPACITY));
+    TEST_ASSERT (0 == pthread_create (&producer, NULL, &stress_producer, NULL));
+
+    while (expected < STRESS_SAMPLES)
+    {
+        const size_t count = npa_ring_pop_bulk (&m_ring, out, STRESS_BULK);
+
+        if (0U == count)
+        {
+            (void) sched_yield();
+        }
+
+        for (size_t ii = 0U; ii < count; ii++)
+        {
+            const npa_sample_t sample = make_sample (expected);
+            in_order = in_order && (0 == memcmp (&sample, &out[ii], sizeof (sample)));
+            expected++;
+        }
+    }
+
+    TEST_ASSERT (0 == pthread_join (producer, NULL));
+    TEST_ASSERT_TRUE (in_order);
+    TEST_ASSERT (0U == npa_ring_count (&m_ring));
+}
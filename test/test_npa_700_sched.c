@@ -0,0 +1,269 @@
+#include "unity.h"
+
+#include "npa_700.h"
+#include "npa_700_sched.h"
+
+#include <string.h>
+
+#define NUM_SENSORS (4U)     //!< Sensors in array.
+#define BASE_ADDR   (0x28U)  //!< Address of first sensor.
+#define BUS_US      (50U)    //!< Duration of one bus transfer.
+#define NUM_CYCLES  (400U)   //!< Cycles in convergence test.
+
+static const uint32_t m_conversion_us[NUM_SENSORS] = { 1000U, 2000U, 3000U, 5000U };
+
+// Virtual clock and sleep mode sensors.
+static uint32_t m_now;
+static uint32_t m_trigger_us[NUM_SENSORS];
+static bool m_fetched[NUM_SENSORS];
+static npa_ret_t m_bus_status;
+static uint32_t m_bus_reads;
+
+// Results.
+static uint32_t m_results;
+static npa_ret_t m_status[NUM_SENSORS];
+static uint32_t m_latency[NUM_SENSORS];
+static float m_pressure[NUM_SENSORS];
+
+static uint32_t clock_now (void)
+{
+    return m_now;
+}
+
+static npa_ret_t bus_write (const uint8_t i2c_addr, const uint8_t * const data,
+                            const uint8_t data_len)
+{
+    (void) i2c_addr;
+    (void) data;
+    (void) data_len;
+    return NPA_ERR_IMPL;
+}
+
+static npa_ret_t bus_read (const uint8_t i2c_addr, uint8_t * const data,
+                           const uint8_t data_len)
+{
+    const size_t index = i2c_addr - BASE_ADDR;
+    m_now += BUS_US;
+    m_bus_reads++;
+
+    if (NPA_SUCCESS != m_bus_status)
+    {
+        return m_bus_status;
+    }
+
+    if (0U == data_len)
+    {
+        m_trigger_us[index] = m_now;
+        m_fetched[index] = false;
+    }
+    else
+    {
+        const bool ready = (m_now - m_trigger_us[index]) >= m_conversion_us[index];
+        // Fresh data reads once, mid-scale pressure.
+        data[0U] = (ready && !m_fetched[index]) ? 0x20U : 0xA0U;
+        data[1U] = 0x00U;
+        m_fetched[index] = m_fetched[index] || ready;
+    }
+
+    return NPA_SUCCESS;
+}
+
+static const npa_ctx_t m_sensors[NUM_SENSORS] =
+{
+    { .write = bus_write, .read = bus_read, .npa_addr = BASE_ADDR, .model = NPA_700_001D },
+    { .write = bus_write, .read = bus_read, .npa_addr = BASE_ADDR + 1U, .model = NPA_700_001D },
+    { .write = bus_write, .read = bus_read, .npa_addr = BASE_ADDR + 2U, .model = NPA_700_001D },
+    { .write = bus_write, .read = bus_read, .npa_addr = BASE_ADDR + 3U, .model = NPA_700_001D }
+};
+
+static void sched_cb (const size_t index, const npa_ret_t status,
+                      const float pressure_pa, const uint32_t latency_us,
+                      void * const p_context)
+{
+    TEST_ASSERT (&m_results == p_context);
+    TEST_ASSERT (index < NUM_SENSORS);
+    m_results++;
+    m_status[index] = status;
+    m_latency[index] = latency_us;
+    m_pressure[index] = pressure_pa;
+}
+
+static const npa_sched_cfg_t m_cfg =
+{
+    .now_us = clock_now,
+    .callback = sched_cb,
+    .p_context = &m_results,
+    .initial_delay_us = 500U,
+    .min_delay_us = 100U,
+    .max_delay_us = 100000U,
+    .max_retries = 20U
+};
+
+static npa_sched_t m_sched;
+static npa_sched_slot_t m_slots[NUM_SENSORS];
+
+// Sleep until next fetch is due, then poll, until cycle is complete.
+static void drain (void)
+{
+    uint32_t due = 0U;
+
+    while (npa_sched_next_due (&m_sched, &due))
+    {
+        if ( (int32_t) (due - m_now) > 0)
+        {
+            m_now = due;
+        }
+
+        (void) npa_sched_poll (&m_sched);
+    }
+}
+
+static void run_cycle (void)
+{
+    TEST_ASSERT (NPA_SUCCESS == npa_sched_start (&m_sched));
+    drain();
+}
+
+void setUp (void)
+{
+    m_now = 0xFFFF0000U; // Wraps during tests.
+    m_bus_status = NPA_SUCCESS;
+    m_bus_reads = 0U;
+    m_results = 0U;
+    memset (m_fetched, 0, sizeof (m_fetched));
+    memset (m_status, 0xFF, sizeof (m_status));
+    TEST_ASSERT (NPA_SUCCESS == npa_sched_init (&m_sched, &m_cfg, m_sensors, m_slots,
+                 NUM_SENSORS));
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_sched_init (void)
+{
+    npa_sched_cfg_t cfg = m_cfg;
+    TEST_ASSERT (NPA_ERR_NULL == npa_sched_init (NULL, &cfg, m_sensors, m_slots, 1U));
+    TEST_ASSERT (NPA_ERR_NULL == npa_sched_init (&m_sched, NULL, m_sensors, m_slots, 1U));
+    TEST_ASSERT (NPA_ERR_NULL == npa_sched_init (&m_sched, &cfg, NULL, m_slots, 1U));
+    TEST_ASSERT (NPA_ERR_NULL == npa_sched_init (&m_sched, &cfg, m_sensors, NULL, 1U));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_sched_init (&m_sched, &cfg, m_sensors, m_slots, 0U));
+    cfg.min_delay_us = 1000U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_sched_init (&m_sched, &cfg, m_sensors, m_slots, 1U));
+    cfg = m_cfg;
+    cfg.max_delay_us = 0x80000000U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_sched_init (&m_sched, &cfg, m_sensors, m_slots, 1U));
+    cfg = m_cfg;
+    cfg.now_us = NULL;
+    TEST_ASSERT (NPA_ERR_NULL == npa_sched_init (&m_sched, &cfg, m_sensors, m_slots, 1U));
+    TEST_ASSERT (NPA_ERR_NULL == npa_sched_start (NULL));
+    TEST_ASSERT (0U == npa_sched_poll (NULL));
+}
+
+void test_npa_700_sched_cycle (void)
+{
+    uint32_t due = 0U;
+    npa_sched_cfg_t cfg = m_cfg;
+    // Longest conversion needs retries.
+    cfg.initial_delay_us = 4000U;
+    TEST_ASSERT (NPA_SUCCESS == npa_sched_init (&m_sched, &cfg, m_sensors, m_slots,
+                 NUM_SENSORS));
+    TEST_ASSERT_FALSE (npa_sched_next_due (&m_sched, &due));
+    TEST_ASSERT (NPA_SUCCESS == npa_sched_start (&m_sched));
+    TEST_ASSERT (NPA_ERR_BUSY == npa_sched_start (&m_sched));
+    // Triggers are back to back, first sensor is due first.
+    TEST_ASSERT_TRUE (npa_sched_next_due (&m_sched, &due));
+    TEST_ASSERT (m_slots[0U].due_us == due);
+    TEST_ASSERT (NUM_SENSORS == npa_sched_poll (&m_sched));
+    TEST_ASSERT (NUM_SENSORS == m_bus_reads);
+    drain();
+    TEST_ASSERT (NUM_SENSORS == m_results);
+
+    for (size_t ii = 0U; ii < NUM_SENSORS; ii++)
+    {
+        TEST_ASSERT (NPA_SUCCESS == m_status[ii]);
+        TEST_ASSERT (m_latency[ii] >= m_conversion_us[ii]);
+        TEST_ASSERT ( (ii < 3U) == (4000U > m_slots[ii].delay_us));
+        TEST_ASSERT_FLOAT_WITHIN (1.0F, 0.0F, m_pressure[ii]);
+    }
+}
+
+void test_npa_700_sched_converges (void)
+{
+    uint32_t stale_reads = 0U;
+
+    for (uint32_t cycle = 0U; cycle < NUM_CYCLES; cycle++)
+    {
+        m_bus_reads = 0U;
+        m_results = 0U;
+        run_cycle();
+        TEST_ASSERT (NUM_SENSORS == m_results);
+
+        if (cycle >= (NUM_CYCLES / 2U))
+        {
+            // Every cycle costs one trigger and one fetch per sensor, plus retries.
+            stale_reads += m_bus_reads - (2U * NUM_SENSORS);
+
+            for (size_t ii = 0U; ii < NUM_SENSORS; ii++)
+            {
+                TEST_ASSERT (NPA_SUCCESS == m_status[ii]);
+                // Latency within 1/8 + retry step + bus time of conversion.
+                TEST_ASSERT (m_latency[ii] < (m_conversion_us[ii] * 9U / 8U)
+                             + (m_conversion_us[ii] / 16U) + (2U * BUS_US));
+            }
+        }
+    }
+
+    for (size_t ii = 0U; ii < NUM_SENSORS; ii++)
+    {
+        TEST_ASSERT (m_slots[ii].delay_us >= m_conversion_us[ii] * 7U / 8U);
+        TEST_ASSERT (m_slots[ii].delay_us <= m_conversion_us[ii] * 9U / 8U);
+        TEST_ASSERT (m_slots[ii].stale_rate_q16 < 65536U / 4U);
+    }
+
+    // Less than one stale read per sensor per four cycles.
+    TEST_ASSERT (stale_reads < (NUM_CYCLES / 2U) * NUM_SENSORS / 4U);
+}
+
+void test_npa_700_sched_trigger_error (void)
+{
+    m_bus_status = NPA_ERR_NACK;
+    TEST_ASSERT (NPA_ERR_NACK == npa_sched_start (&m_sched));
+    TEST_ASSERT (NUM_SENSORS == m_results);
+    TEST_ASSERT (0U == npa_sched_poll (&m_sched));
+
+    for (size_t ii = 0U; ii < NUM_SENSORS; ii++)
+    {
+        TEST_ASSERT (NPA_ERR_NACK == m_status[ii]);
+    }
+}
+
+void test_npa_700_sched_fetch_error (void)
+{
+    TEST_ASSERT (NPA_SUCCESS == npa_sched_start (&m_sched));
+    m_bus_status = NPA_ERR_TOUT;
+    m_now += 10000U;
+    TEST_ASSERT (0U == npa_sched_poll (&m_sched));
+    TEST_ASSERT (NUM_SENSORS == m_results);
+
+    for (size_t ii = 0U; ii < NUM_SENSORS; ii++)
+    {
+        TEST_ASSERT (NPA_ERR_TOUT & m_status[ii]);
+        // Bus errors do not tune delay.
+        TEST_ASSERT (m_cfg.initial_delay_us == m_slots[ii].delay_us);
+    }
+}
+
+void test_npa_700_sched_retries_exhausted (void)
+{
+    npa_sched_cfg_t cfg = m_cfg;
+    cfg.max_retries = 2U;
+    cfg.max_delay_us = 600U;
+    TEST_ASSERT (NPA_SUCCESS == npa_sched_init (&m_sched, &cfg, m_sensors, m_slots, 1U));
+    run_cycle();
+    // Delay is capped below conversion time, stale data is delivered as such.
+    TEST_ASSERT (1U == m_results);
+    TEST_ASSERT (NPA_WARN_OLD == m_status[0U]);
+    TEST_ASSERT (600U == m_slots[0U].delay_us);
+    TEST_ASSERT (1U + 3U == m_bus_reads);
+}
@@ -0,0 +1,225 @@
+#include "unity.h"
+
+#include "npa_700.h"
+#include "npa_700_sim.h"
+
+#include <string.h>
+
+#define SIM_ADDR   (0x28U) //!< Address of first virtual sensor.
+#define SIM_PERIOD (1000U) //!< Update period of virtual sensors.
+
+static const npa_ctx_t m_sensor =
+{
+    .write = npa_sim_write,
+    .read = npa_sim_read,
+    .npa_addr = SIM_ADDR,
+    .model = NPA_700_001D
+};
+
+static npa_sim_sensor_cfg_t m_cfg;
+
+static float ramp (const uint32_t time_us, void * const p_context)
+{
+    const float * const slope = (const float *) p_context;
+    return (float) time_us * *slope;
+}
+
+void setUp (void)
+{
+    npa_sim_reset();
+    memset (&m_cfg, 0, sizeof (m_cfg));
+    m_cfg.addr = SIM_ADDR;
+    m_cfg.model = NPA_700_001D;
+    m_cfg.mode = NPA_SIM_FREE_RUNNING;
+    m_cfg.period_us = SIM_PERIOD;
+    m_cfg.pressure_pa = 1000.0F;
+    m_cfg.temperature_c = 25.0F;
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_sim_add (void)
+{
+    TEST_ASSERT (NPA_ERR_NULL == npa_sim_add (NULL));
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_add (&m_cfg));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_sim_add (&m_cfg));
+    m_cfg.addr++;
+    m_cfg.period_us = 0U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_sim_add (&m_cfg));
+    m_cfg.period_us = SIM_PERIOD;
+    m_cfg.model = (npa_variant_t) 7;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_sim_add (&m_cfg));
+    m_cfg.model = NPA_700_001D;
+
+    for (uint32_t ii = 1U; ii < NPA_SIM_MAX_SENSORS; ii++)
+    {
+        m_cfg.addr = (uint8_t) (SIM_ADDR + ii);
+        TEST_ASSERT (NPA_SUCCESS == npa_sim_add (&m_cfg));
+    }
+
+    m_cfg.addr = 0x10U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_sim_add (&m_cfg));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_sim_set_pressure (0x10U, 0.0F));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_sim_inject_status (SIM_ADDR, 4U, 1U));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_sim_inject_error (0x10U, NPA_ERR_NACK, 1U));
+}
+
+void test_npa_700_sim_unknown_address (void)
+{
+    float pressure = 0.0F;
+    TEST_ASSERT (NPA_ERR_NACK & npa_read_pressure (&m_sensor, &pressure));
+    TEST_ASSERT (NPA_ERR_NACK == npa_sim_write (SIM_ADDR, NULL, 0U));
+    TEST_ASSERT (0U == npa_sim_transfers (SIM_ADDR));
+}
+
+void test_npa_700_sim_free_running (void)
+{
+    float pressure = 0.0F;
+    float temperature = 0.0F;
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_add (&m_cfg));
+    TEST_ASSERT (NPA_SUCCESS == npa_read_pressure_temp_hires (&m_sensor, &pressure,
+                 &temperature));
+    TEST_ASSERT_FLOAT_WITHIN (1.0F, 1000.0F, pressure);
+    TEST_ASSERT_FLOAT_WITHIN (0.1F, 25.0F, temperature);
+    // Same update reads as stale.
+    TEST_ASSERT (NPA_WARN_OLD == npa_read_pressure (&m_sensor, &pressure));
+    TEST_ASSERT_FLOAT_WITHIN (1.0F, 1000.0F, pressure);
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_set_pressure (SIM_ADDR, -2000.0F));
+    npa_sim_advance (SIM_PERIOD);
+    TEST_ASSERT (NPA_SUCCESS == npa_read_pressure (&m_sensor, &pressure));
+    TEST_ASSERT_FLOAT_WITHIN (1.0F, -2000.0F, pressure);
+    TEST_ASSERT (3U == npa_sim_transfers (SIM_ADDR));
+}
+
+void test_npa_700_sim_sleep_mode (void)
+{
+    float pressure = 0.0F;
+    m_cfg.mode = NPA_SIM_SLEEP;
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_add (&m_cfg));
+    // Nothing converted before trigger.
+    TEST_ASSERT (NPA_WARN_OLD & npa_read_pressure (&m_sensor, &pressure));
+    TEST_ASSERT (NPA_SUCCESS == npa_sample_trigger (&m_sensor));
+    npa_sim_advance (SIM_PERIOD - 1U);
+    TEST_ASSERT (NPA_WARN_OLD & npa_read_pressure (&m_sensor, &pressure));
+    npa_sim_advance (1U);
+    TEST_ASSERT (NPA_SUCCESS == npa_read_pressure (&m_sensor, &pressure));
+    TEST_ASSERT_FLOAT_WITHIN (1.0F, 1000.0F, pressure);
+    TEST_ASSERT (NPA_WARN_OLD == npa_read_pressure (&m_sensor, &pressure));
+}
+
+void test_npa_700_sim_saturation (void)
+{
+    float pressure = 0.0F;
+    m_cfg.pressure_pa = 1.0e6F;
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_add (&m_cfg));
+    TEST_ASSERT (NPA_WARN_SAT == npa_read_pressure (&m_sensor, &pressure));
+    TEST_ASSERT (pressure > NPA_001D_SCALE_PA);
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_set_pressure (SIM_ADDR, -1.0e6F));
+    npa_sim_advance (SIM_PERIOD);
+    TEST_ASSERT (NPA_WARN_SAT == npa_read_pressure (&m_sensor, &pressure));
+    TEST_ASSERT (pressure < -NPA_001D_SCALE_PA);
+}
+
+void test_npa_700_sim_injection (void)
+{
+    float pressure = 0.0F;
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_add (&m_cfg));
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_inject_status (SIM_ADDR, NPA_SIM_STATUS_DIAG, 2U));
+    TEST_ASSERT (NPA_ERR_FATAL & npa_read_pressure (&m_sensor, &pressure));
+    TEST_ASSERT (NPA_ERR_FATAL & npa_read_pressure (&m_sensor, &pressure));
+    TEST_ASSERT (NPA_WARN_OLD == npa_read_pressure (&m_sensor, &pressure));
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_inject_status (SIM_ADDR, NPA_SIM_STATUS_COMMAND, 1U));
+    TEST_ASSERT (NPA_ERR_MODE == npa_read_pressure (&m_sensor, &pressure));
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_inject_error (SIM_ADDR, NPA_ERR_TOUT, 1U));
+    TEST_ASSERT (NPA_ERR_TOUT & npa_read_pressure (&m_sensor, &pressure));
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_write (SIM_ADDR, NULL, 0U));
+}
+
+void test_npa_700_sim_waveform (void)
+{
+    float slope = 0.5F;
+    float pressure = 0.0F;
+    m_cfg.waveform = ramp;
+    m_cfg.p_context = &slope;
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_add (&m_cfg));
+
+    // Each update samples waveform at its own time.
+    for (uint32_t update = 0U; update < 5U; update++)
+    {
+        TEST_ASSERT (NPA_SUCCESS == npa_read_pressure (&m_sensor, &pressure));
+        TEST_ASSERT_FLOAT_WITHIN (1.0F, 0.5F * (float) (update * SIM_PERIOD), pressure);
+        npa_sim_advance (SIM_PERIOD);
+    }
+}
+
+void test_npa_700_sim_noise (void)
+{
+    m_cfg.noise_counts = 3U;
+    m_cfg.pressure_pa = 0.0F;
+    m_cfg.seed = 1234U;
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_add (&m_cfg));
+    uint16_t seen_min = UINT16_MAX;
+    uint16_t seen_max = 0U;
+
+    for (uint32_t ii = 0U; ii < 1000U; ii++)
+    {
+        uint8_t frame[2U];
+        uint16_t counts = 0U;
+        TEST_ASSERT (NPA_SUCCESS == npa_sim_read (SIM_ADDR, frame, sizeof (frame)));
+        TEST_ASSERT (NPA_SUCCESS == npa_parse_frame (frame, sizeof (frame), &counts, NULL));
+        seen_min = (counts < seen_min) ? counts : seen_min;
+        seen_max = (counts > seen_max) ? counts : seen_max;
+        npa_sim_advance (SIM_PERIOD);
+    }
+
+    TEST_ASSERT (NPA_PRES_MIDDLE - 3U == seen_min);
+    TEST_ASSERT (NPA_PRES_MIDDLE + 3U == seen_max);
+}
+
+void test_npa_700_sim_bus_latency (void)
+{
+    float pressure = 0.0F;
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_add (&m_cfg));
+    npa_sim_set_bus_latency (30U, 23U, false);
+    const uint32_t start = npa_sim_now_us();
+    TEST_ASSERT (NPA_SUCCESS == npa_read_pressure (&m_sensor, &pressure));
+    TEST_ASSERT (30U + (2U * 23U) == npa_sim_now_us() - start);
+    // Failed transfers take time too.
+    TEST_ASSERT (NPA_ERR_NACK == npa_sim_read (0x10U, NULL, 0U));
+    TEST_ASSERT (30U + (2U * 23U) + 30U == npa_sim_now_us() - start);
+}
+
+void test_npa_700_sim_xfer (void)
+{
+    const npa_ctx_t sensor =
+    {
+        .write = npa_sim_write,
+        .read = npa_sim_read,
+        .npa_addr = SIM_ADDR,
+        .model = NPA_700_001D,
+        .xfer = npa_sim_xfer
+    };
+    const uint8_t command[] = { 0xA0U };
+    uint8_t separate[2U] = { 0U };
+    uint8_t combined[2U] = { 0U };
+    m_cfg.period_us = 1000000U;
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_add (&m_cfg));
+    npa_sim_set_bus_latency (30U, 23U, false);
+    uint32_t start = npa_sim_now_us();
+    TEST_ASSERT (NPA_SUCCESS == npa_write_read (&m_sensor, command, sizeof (command),
+                 separate, sizeof (separate)));
+    TEST_ASSERT ( (2U * 30U) + (3U * 23U) == npa_sim_now_us() - start);
+    start = npa_sim_now_us();
+    TEST_ASSERT (NPA_SUCCESS == npa_write_read (&sensor, command, sizeof (command),
+                 combined, sizeof (combined)));
+    TEST_ASSERT (30U + (3U * 23U) == npa_sim_now_us() - start);
+    TEST_ASSERT (3U == npa_sim_transfers (SIM_ADDR));
+    // Same register, second read is stale.
+    TEST_ASSERT ( (separate[0U] & 0x3FU) == (combined[0U] & 0x3FU));
+    TEST_ASSERT (separate[1U] == combined[1U]);
+    TEST_ASSERT (NPA_SIM_STATUS_STALE == (combined[0U] >> 6U));
+    TEST_ASSERT (NPA_ERR_NACK == npa_sim_xfer (0x10U, command, sizeof (command),
+                 combined, sizeof (combined)));
+}
@@ -0,0 +1,174 @@
+#include "unity.h"
+
+#include "npa_700.h"
+#include "npa_700_spike.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+static npa_spike_t m_spike;
+
+static npa_spike_cfg_t spike_cfg (const uint8_t window)
+{
+    const npa_spike_cfg_t cfg =
+    {
+        .window = window,
+        .threshold = 4U,
+        .mad_scale = NPA_SPIKE_SCALE_3SIGMA
+    };
+    return cfg;
+}
+
+static int compare_counts (const void * a, const void * b)
+{
+    return (int) * (const uint16_t *) a - (int) * (const uint16_t *) b;
+}
+
+static bool in_noise (const uint16_t counts)
+{
+    return (counts >= (NPA_PRES_MIDDLE - 8U)) && (counts <= (NPA_PRES_MIDDLE + 8U));
+}
+
+// +-8 counts of noise around middle.
+static uint16_t noisy (uint32_t * const state)
+{
+    *state = (*state * 1103515245U) + 12345U;
+    return (uint16_t) (NPA_PRES_MIDDLE + ( (*state >> 16U) % 17U) - 8U);
+}
+
+void setUp (void)
+{
+    const npa_spike_cfg_t cfg = spike_cfg (9U);
+    TEST_ASSERT (NPA_SUCCESS == npa_spike_init (&m_spike, &cfg));
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_spike_sorted_window (void)
+{
+    uint32_t state = 1U;
+
+    for (uint8_t window = NPA_SPIKE_MIN_WINDOW; window <= NPA_SPIKE_MAX_WINDOW;
+            window += 2U)
+    {
+        const npa_spike_cfg_t cfg = spike_cfg (window);
+        uint16_t inputs[2000U];
+        TEST_ASSERT (NPA_SUCCESS == npa_spike_init (&m_spike, &cfg));
+
+        for (uint32_t ii = 0U; ii < 2000U; ii++)
+        {
+            uint16_t expected[NPA_SPIKE_MAX_WINDOW];
+            uint16_t output = 0U;
+            state = (state * 1103515245U) + 12345U;
+            // Few distinct values exercise duplicates.
+            inputs[ii] = (uint16_t) (1000U + ( (state >> 16U) % 12U) * ( (ii % 3U) + 1U));
+            (void) npa_spike_push (&m_spike, inputs[ii], NPA_SUCCESS, &output);
+            const uint32_t count = (ii < window) ? (ii + 1U) : window;
+            memcpy (expected, &inputs[ii + 1U - count], count * sizeof (uint16_t));
+            qsort (expected, count, sizeof (uint16_t), &compare_counts);
+            TEST_ASSERT (count == m_spike.count);
+            TEST_ASSERT_EQUAL_UINT16_ARRAY (expected, m_spike.sorted, count);
+            TEST_ASSERT (expected[count / 2U] == npa_spike_median (&m_spike));
+        }
+    }
+}
+
+void test_npa_700_spike_rejects_spikes (void)
+{
+    uint32_t state = 2U;
+    uint32_t rejected = 0U;
+
+    for (uint32_t ii = 0U; ii < 10000U; ii++)
+    {
+        const bool is_spike = (50U == (ii % 97U));
+        const uint16_t counts = is_spike ? (uint16_t) (NPA_PRES_MIDDLE + 3000U)
+                                : noisy (&state);
+        uint16_t output = 0U;
+        const npa_ret_t status = npa_spike_push (&m_spike, counts, NPA_SUCCESS, &output);
+
+        if (is_spike)
+        {
+            TEST_ASSERT (NPA_WARN_SPIKE == status);
+            TEST_ASSERT (in_noise (output));
+        }
+        else if (NPA_WARN_SPIKE == status)
+        {
+            // Replaced by median, which stays within noise.
+            TEST_ASSERT (in_noise (output));
+            rejected++;
+        }
+        else
+        {
+            TEST_ASSERT (NPA_SUCCESS == status);
+            TEST_ASSERT (counts == output);
+        }
+    }
+
+    // MAD of 9 samples is noisy itself, a few samples of noise are rejected.
+    TEST_ASSERT (rejected < 100U);
+    TEST_ASSERT ( ( (10000U / 97U) + rejected) == m_spike.spikes);
+}
+
+void test_npa_700_spike_step (void)
+{
+    uint16_t output = 0U;
+    uint32_t flagged = 0U;
+
+    for (uint32_t ii = 0U; ii < 20U; ii++)
+    {
+        (void) npa_spike_push (&m_spike, NPA_PRES_MIDDLE, NPA_SUCCESS, &output);
+    }
+
+    // Step is flagged until it is the majority of window, then passes.
+    for (uint32_t ii = 0U; ii < 20U; ii++)
+    {
+        flagged += (NPA_WARN_SPIKE == npa_spike_push (&m_spike, NPA_PRES_MIDDLE + 1000U,
+                    NPA_SUCCESS, &output)) ? 1U : 0U;
+    }
+
+    TEST_ASSERT (4U == flagged);
+    TEST_ASSERT (NPA_PRES_MIDDLE + 1000U == output);
+}
+
+void test_npa_700_spike_status (void)
+{
+    uint16_t output = 0U;
+
+    for (uint32_t ii = 0U; ii < 9U; ii++)
+    {
+        TEST_ASSERT (NPA_SUCCESS == npa_spike_push (&m_spike, NPA_PRES_MIDDLE, NPA_SUCCESS,
+                     &output));
+    }
+
+    // Stale and failed samples pass unchanged and stay out of window.
+    TEST_ASSERT (NPA_WARN_OLD == npa_spike_push (&m_spike, 100U, NPA_WARN_OLD, &output));
+    TEST_ASSERT (100U == output);
+    TEST_ASSERT (NPA_ERR_NACK == npa_spike_push (&m_spike, 0U, NPA_ERR_NACK, &output));
+    TEST_ASSERT (NPA_PRES_MIDDLE == m_spike.sorted[0U]);
+    // Saturated spike keeps its saturation warning.
+    TEST_ASSERT ( (NPA_WARN_SAT | NPA_WARN_SPIKE) == npa_spike_push (&m_spike,
+                  NPA_PRES_MAX_SAT, NPA_WARN_SAT, &output));
+    TEST_ASSERT (NPA_PRES_MIDDLE == output);
+    npa_spike_reset (&m_spike);
+    TEST_ASSERT (NPA_PRES_MIDDLE == npa_spike_median (&m_spike));
+    TEST_ASSERT (NPA_SUCCESS == npa_spike_push (&m_spike, 0U, NPA_SUCCESS, &output));
+    TEST_ASSERT (0U == npa_spike_median (&m_spike));
+}
+
+void test_npa_700_spike_invalid (void)
+{
+    npa_spike_cfg_t cfg = spike_cfg (8U);
+    uint16_t output = 0U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_spike_init (&m_spike, &cfg));
+    cfg.window = NPA_SPIKE_MAX_WINDOW + 2U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_spike_init (&m_spike, &cfg));
+    cfg.window = 1U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_spike_init (&m_spike, &cfg));
+    TEST_ASSERT (NPA_ERR_NULL == npa_spike_init (NULL, &cfg));
+    TEST_ASSERT (NPA_ERR_NULL == npa_spike_init (&m_spike, NULL));
+    TEST_ASSERT (NPA_ERR_NULL == npa_spike_push (NULL, 0U, NPA_SUCCESS, &output));
+    TEST_ASSERT (NPA_ERR_NULL == npa_spike_push (&m_spike, 0U, NPA_SUCCESS, NULL));
+}
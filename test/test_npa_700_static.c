@@ -0,0 +1,140 @@
+#include "unity.h"
+
+#include "mock_i2c.h"
+
+#define NPA_STATIC_VARIANT NPA_700_030D
+#define NPA_STATIC_READ    i2c_read
+#include "npa_700_static.h"
+
+#include "npa_700.h"
+
+#include <string.h>
+
+#define NPA_ADDR (0x28U)  //!< Default address of NPA-700.
+
+static const uint8_t min_nonsat_binary[] = { 0x06U, 0x66U};
+static const uint8_t mid_binary[]        = { 0x20U, 0x00U};
+static const uint8_t max_sat_binary[]    = { 0x3FU, 0xFFU};
+static const uint8_t stale_binary[]      = { 0x99U, 0x99U};
+
+void setUp (void)
+{
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_static_sample_trigger (void)
+{
+    i2c_read_ExpectAndReturn (NPA_ADDR, NULL, 0U, NPA_SUCCESS);
+    npa_ret_t ret_code = npa_static_sample_trigger();
+    TEST_ASSERT (NPA_SUCCESS == ret_code);
+}
+
+void test_npa_700_static_read_pressure (void)
+{
+    const uint8_t * const binaries[] =
+    {
+        min_nonsat_binary,
+        mid_binary,
+        max_sat_binary,
+        stale_binary
+    };
+    const npa_ret_t expected_status[] =
+    {
+        NPA_SUCCESS,
+        NPA_SUCCESS,
+        NPA_WARN_SAT,
+        NPA_WARN_OLD
+    };
+
+    for (size_t ii = 0U; ii < (sizeof (binaries) / sizeof (binaries[0])); ii++)
+    {
+        uint8_t expect[2] = { 0xFF, 0xFF };
+        const uint16_t counts = (uint16_t) ( ( (binaries[ii][0] << 8U) + binaries[ii][1])
+                                             & 0x3FFFU);
+        float expected_pa;
+        int32_t expected_mpa;
+        float pressure_pa;
+        int32_t pressure_mpa;
+        (void) npa_convert_pa (NPA_700_030D, counts, &expected_pa);
+        (void) npa_convert_mpa (NPA_700_030D, counts, &expected_mpa);
+        i2c_read_ExpectWithArrayAndReturn (NPA_ADDR, expect, 2U, 2U, NPA_SUCCESS);
+        i2c_read_ReturnArrayThruPtr_data (binaries[ii], 2U);
+        npa_ret_t ret_code = npa_static_read_pressure (&pressure_pa);
+        TEST_ASSERT (expected_status[ii] == ret_code);
+        // Bit-exact with runtime driver.
+        TEST_ASSERT (expected_pa == pressure_pa);
+        i2c_read_ExpectWithArrayAndReturn (NPA_ADDR, expect, 2U, 2U, NPA_SUCCESS);
+        i2c_read_ReturnArrayThruPtr_data (binaries[ii], 2U);
+        ret_code = npa_static_read_pressure_mpa (&pressure_mpa);
+        TEST_ASSERT (expected_status[ii] == ret_code);
+        TEST_ASSERT (expected_mpa == pressure_mpa);
+    }
+
+    TEST_ASSERT (NPA_ERR_NULL == npa_static_read_pressure (NULL));
+    TEST_ASSERT (NPA_ERR_NULL == npa_static_read_pressure_mpa (NULL));
+}
+
+void test_npa_700_static_parse (void)
+{
+    const uint8_t config_binary[] = { 0x60U, 0x00U };
+    const uint8_t fault_binary[]  = { 0xE0U, 0x00U };
+    uint16_t counts;
+    TEST_ASSERT (NPA_ERR_MODE == npa_static_parse (config_binary, &counts));
+    TEST_ASSERT (NPA_ERR_FATAL == npa_static_parse (fault_binary, &counts));
+    TEST_ASSERT (NPA_SUCCESS == npa_static_parse (mid_binary, &counts));
+    TEST_ASSERT (NPA_PRES_MIDDLE == counts);
+}
+
+// Conversion of static driver with given scaling, against runtime driver.
+static void check_scaling (const npa_variant_t model, const float gain, const float offset,
+                           const uint64_t gain_mpa, const uint32_t offset_mpa)
+{
+    float runtime_gain;
+    float runtime_offset;
+    TEST_ASSERT (NPA_SUCCESS == npa_get_scaling (model, &runtime_gain, &runtime_offset));
+    TEST_ASSERT (0 == memcmp (&gain, &runtime_gain, sizeof (float)));
+    TEST_ASSERT (0 == memcmp (&offset, &runtime_offset, sizeof (float)));
+
+    for (uint16_t counts = 0U; counts <= 0x3FFFU; counts++)
+    {
+        int32_t expected_mpa;
+        (void) npa_convert_mpa (model, counts, &expected_mpa);
+        const uint64_t OUT2 = (2U * (uint64_t) counts) + NPA_INT_BIAS;
+        const uint64_t scaled = ( (OUT2 * gain_mpa) + ( (uint64_t) 1U << (NPA_INT_SHIFT - 1U)))
+                                >> NPA_INT_SHIFT;
+        TEST_ASSERT (expected_mpa == (int32_t) ( (int64_t) scaled - (int64_t) offset_mpa));
+    }
+}
+
+// Scaling macros are expanded where used, so each variant can be selected in turn.
+#define CHECK_STATIC_SCALING() \
+    check_scaling (NPA_STATIC_VARIANT, NPA_STATIC_GAIN, NPA_STATIC_OFFSET, \
+                   NPA_STATIC_GAIN_MPA, NPA_STATIC_OFFSET_MPA)
+
+void test_npa_700_static_scaling_all_variants (void)
+{
+#undef NPA_STATIC_VARIANT
+#define NPA_STATIC_VARIANT NPA_700_02WD
+    CHECK_STATIC_SCALING();
+#undef NPA_STATIC_VARIANT
+#define NPA_STATIC_VARIANT NPA_700_05WD
+    CHECK_STATIC_SCALING();
+#undef NPA_STATIC_VARIANT
+#define NPA_STATIC_VARIANT NPA_700_10WD
+    CHECK_STATIC_SCALING();
+#undef NPA_STATIC_VARIANT
+#define NPA_STATIC_VARIANT NPA_700_001D
+    CHECK_STATIC_SCALING();
+#undef NPA_STATIC_VARIANT
+#define NPA_STATIC_VARIANT NPA_700_005D
+    CHECK_STATIC_SCALING();
+#undef NPA_STATIC_VARIANT
+#define NPA_STATIC_VARIANT NPA_700_015D
+    CHECK_STATIC_SCALING();
+#undef NPA_STATIC_VARIANT
+#define NPA_STATIC_VARIANT NPA_700_030D
+    CHECK_STATIC_SCALING();
+}
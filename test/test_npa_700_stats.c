@@ -0,0 +1,253 @@
+// sched_yield
+#define _POSIX_C_SOURCE 200809L
+
+#include "unity.h"
+
+#include "npa_700.h"
+#include "npa_700_stats.h"
+#include "npa_700_sim.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+#define SIM_ADDR       (0x28U)   //!< Address of first virtual sensor.
+#define SIM_PERIOD     (1000U)   //!< Update period of virtual sensors.
+#define BUS_BASE_US    (100U)    //!< Latency of each transfer.
+#define BUS_BYTE_US    (10U)     //!< Latency of each byte.
+#define STRESS_RECORDS (200000U) //!< Reads recorded in stress test.
+
+static npa_stats_t m_stats;
+static npa_stats_t m_stats_other;
+
+static const npa_ctx_t m_sensor =
+{
+    .write = npa_sim_write,
+    .read = npa_sim_read,
+    .npa_addr = SIM_ADDR,
+    .model = NPA_700_001D,
+    .stats = &m_stats
+};
+
+static const npa_ctx_t m_batch[] =
+{
+    {
+        .write = npa_sim_write, .read = npa_sim_read, .npa_addr = SIM_ADDR,
+        .model = NPA_700_001D, .stats = &m_stats
+    },
+    {
+        .write = npa_sim_write, .read = npa_sim_read, .npa_addr = SIM_ADDR + 1U,
+        .model = NPA_700_001D, .stats = &m_stats_other
+    },
+    {
+        .write = npa_sim_write, .read = npa_sim_read, .npa_addr = SIM_ADDR + 1U,
+        .model = NPA_700_001D, .stats = NULL
+    }
+};
+
+static void add_sensor (const uint8_t addr)
+{
+    npa_sim_sensor_cfg_t cfg;
+    memset (&cfg, 0, sizeof (cfg));
+    cfg.addr = addr;
+    cfg.model = NPA_700_001D;
+    cfg.mode = NPA_SIM_FREE_RUNNING;
+    cfg.period_us = SIM_PERIOD;
+    cfg.pressure_pa = 1000.0F;
+    cfg.temperature_c = 25.0F;
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_add (&cfg));
+}
+
+void setUp (void)
+{
+    npa_sim_reset();
+    npa_sim_set_bus_latency (BUS_BASE_US, BUS_BYTE_US, false);
+    add_sensor (SIM_ADDR);
+    add_sensor (SIM_ADDR + 1U);
+    TEST_ASSERT (NPA_SUCCESS == npa_stats_init (&m_stats, &npa_sim_now_us));
+    TEST_ASSERT (NPA_SUCCESS == npa_stats_init (&m_stats_other, &npa_sim_now_us));
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_stats_null (void)
+{
+    npa_stats_snapshot_t snapshot;
+    TEST_ASSERT (NPA_ERR_NULL == npa_stats_init (NULL, &npa_sim_now_us));
+    TEST_ASSERT (NPA_ERR_NULL == npa_stats_snapshot (NULL, &snapshot));
+    TEST_ASSERT (NPA_ERR_NULL == npa_stats_snapshot (&m_stats, NULL));
+    TEST_ASSERT (NPA_ERR_NULL == npa_stats_reset (NULL));
+    TEST_ASSERT (0U == npa_stats_now (NULL));
+    npa_stats_record (NULL, NPA_ERR_NACK, 0U, 1U);
+    TEST_ASSERT (NPA_SUCCESS == npa_stats_snapshot (&m_stats, &snapshot));
+    TEST_ASSERT (0U == snapshot.reads);
+    TEST_ASSERT (0U == snapshot.latency_count);
+    TEST_ASSERT (0U == snapshot.latency_min_us);
+    TEST_ASSERT (0U == snapshot.latency_mean_us);
+}
+
+void test_npa_700_stats_read_paths (void)
+{
+    npa_handle_t handle;
+    npa_stats_snapshot_t snapshot;
+    float pressure_pa;
+    float temperature_c;
+    int32_t pressure_mpa;
+    npa_sim_advance (SIM_PERIOD);
+    TEST_ASSERT (NPA_SUCCESS == npa_read_pressure (&m_sensor, &pressure_pa));
+    TEST_ASSERT (NPA_WARN_OLD == npa_read_pressure_mpa (&m_sensor, &pressure_mpa));
+    TEST_ASSERT (NPA_SUCCESS == npa_prepare (&m_sensor, &handle));
+    TEST_ASSERT (&m_stats == handle.stats);
+    TEST_ASSERT (NPA_WARN_OLD == npa_handle_read_pressure (&handle, &pressure_pa));
+    npa_sim_advance (SIM_PERIOD);
+    TEST_ASSERT (NPA_SUCCESS == npa_read_pressure_temp_hires (&m_sensor, &pressure_pa,
+                 &temperature_c));
+    TEST_ASSERT (NPA_SUCCESS == npa_sample_trigger (&m_sensor));
+    TEST_ASSERT (NPA_SUCCESS == npa_stats_snapshot (&m_stats, &snapshot));
+    TEST_ASSERT (5U == snapshot.reads);
+    TEST_ASSERT (2U == snapshot.warnings[1U]);
+    TEST_ASSERT (0U == snapshot.nack);
+    TEST_ASSERT (5U == snapshot.latency_count);
+    // Trigger has no data, 4-byte read the most.
+    TEST_ASSERT (BUS_BASE_US == snapshot.latency_min_us);
+    TEST_ASSERT ( (BUS_BASE_US + (4U * BUS_BYTE_US)) == snapshot.latency_max_us);
+    TEST_ASSERT ( (BUS_BASE_US + (2U * BUS_BYTE_US)) == snapshot.latency_mean_us);
+    // 100 ... 140 us are in bin of 64 ... 127 us and bin of 128 ... 255 us.
+    TEST_ASSERT (4U == snapshot.histogram[7U]);
+    TEST_ASSERT (1U == snapshot.histogram[8U]);
+}
+
+void test_npa_700_stats_errors (void)
+{
+    npa_stats_snapshot_t snapshot;
+    float pressure_pa[3U];
+    npa_ret_t status[3U];
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_inject_error (SIM_ADDR + 1U, NPA_ERR_NACK, 1U));
+    TEST_ASSERT (NPA_SUCCESS == npa_sim_inject_status (SIM_ADDR, NPA_SIM_STATUS_DIAG, 1U));
+    (void) npa_read_pressure_batch (m_batch, 3U, pressure_pa, status);
+    TEST_ASSERT (NPA_SUCCESS == npa_stats_snapshot (&m_stats, &snapshot));
+    TEST_ASSERT (1U == snapshot.reads);
+    TEST_ASSERT (1U == snapshot.fatal);
+    TEST_ASSERT (0U == snapshot.nack);
+    TEST_ASSERT (0U == snapshot.warnings[0U]);
+    TEST_ASSERT (NPA_SUCCESS == npa_stats_snapshot (&m_stats_other, &snapshot));
+    TEST_ASSERT (1U == snapshot.reads);
+    // NACK shares the bit of saturation, but is not counted as saturated.
+    TEST_ASSERT (1U == snapshot.nack);
+    TEST_ASSERT (0U == snapshot.warnings[0U]);
+    TEST_ASSERT (0U == snapshot.fatal);
+    // Sensor without statistics shares the bus but is not counted.
+    TEST_ASSERT (1U == snapshot.latency_count);
+    // Reset is applied on next read.
+    TEST_ASSERT (NPA_SUCCESS == npa_stats_reset (&m_stats_other));
+    TEST_ASSERT (NPA_SUCCESS == npa_stats_snapshot (&m_stats_other, &snapshot));
+    TEST_ASSERT (1U == snapshot.reads);
+    TEST_ASSERT (NPA_WARN_OLD == npa_read_pressure (&m_batch[1U], &pressure_pa[0U]));
+    TEST_ASSERT (NPA_SUCCESS == npa_stats_snapshot (&m_stats_other, &snapshot));
+    TEST_ASSERT (1U == snapshot.reads);
+    TEST_ASSERT (0U == snapshot.nack);
+    TEST_ASSERT (1U == snapshot.warnings[1U]);
+}
+
+void test_npa_700_stats_latency (void)
+{
+    npa_stats_snapshot_t snapshot;
+    TEST_ASSERT (NPA_SUCCESS == npa_stats_init (&m_stats, &npa_sim_now_us));
+    npa_stats_record (&m_stats, NPA_SUCCESS, 10U, 10U);
+    npa_stats_record (&m_stats, NPA_SUCCESS, 0U, 1U);
+    // Clock wraps during transfer.
+    npa_stats_record (&m_stats, NPA_SUCCESS, UINT32_MAX, 2U);
+    npa_stats_record (&m_stats, NPA_SUCCESS, 0U, UINT32_MAX);
+    npa_stats_record (&m_stats, NPA_SUCCESS, 0U, UINT32_MAX);
+    TEST_ASSERT (NPA_SUCCESS == npa_stats_snapshot (&m_stats, &snapshot));
+    TEST_ASSERT (1U == snapshot.histogram[0U]);
+    TEST_ASSERT (1U == snapshot.histogram[1U]);
+    TEST_ASSERT (1U == snapshot.histogram[2U]);
+    TEST_ASSERT (2U == snapshot.histogram[NPA_STATS_HIST_BINS - 1U]);
+    TEST_ASSERT (0U == snapshot.latency_min_us);
+    TEST_ASSERT (UINT32_MAX == snapshot.latency_max_us);
+    // Sum exceeds 32 bits.
+    TEST_ASSERT ( (uint32_t) ( ( (2ULL * UINT32_MAX) + 4ULL) / 5ULL)
+                  == snapshot.latency_mean_us);
+    // Without clock only status is counted.
+    TEST_ASSERT (NPA_SUCCESS == npa_stats_init (&m_stats, NULL));
+    npa_stats_record (&m_stats, NPA_WARN_SAT, 0U, 100U);
+    // Timeout with saturated all-ones frame, mode and other fatal errors.
+    npa_stats_record (&m_stats, NPA_ERR_TOUT | NPA_WARN_SAT, 0U, 100U);
+    npa_stats_record (&m_stats, NPA_ERR_MODE, 0U, 100U);
+    npa_stats_record (&m_stats, NPA_ERR_FATAL, 0U, 100U);
+    TEST_ASSERT (NPA_SUCCESS == npa_stats_snapshot (&m_stats, &snapshot));
+    TEST_ASSERT (4U == snapshot.reads);
+    TEST_ASSERT (1U == snapshot.warnings[0U]);
+    TEST_ASSERT (0U == snapshot.warnings[1U]);
+    TEST_ASSERT (1U == snapshot.tout);
+    TEST_ASSERT (0U == snapshot.nack);
+    TEST_ASSERT (1U == snapshot.mode);
+    TEST_ASSERT (1U == snapshot.fatal);
+    TEST_ASSERT (0U == snapshot.latency_count);
+}
+
+static void * stress_writer (void * arg)
+{
+    (void) arg;
+
+    for (uint32_t ii = 0U; ii < STRESS_RECORDS; ii++)
+    {
+        npa_stats_record (&m_stats, (0U == (ii & 1U)) ? NPA_WARN_OLD : NPA_ERR_NACK, 0U,
+                          ii & 0xFFU);
+
+        if (0U == (ii & 0x3FFU))
+        {
+            (void) sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+void test_npa_700_stats_concurrent_snapshot (void)
+{
+    pthread_t writer;
+    npa_stats_snapshot_t snapshot;
+    bool consistent = true;
+    uint32_t snapshots = 0U;
+    TEST_ASSERT (0 == pthread_create (&writer, NULL, &stress_writer, NULL));
+
+    for (uint32_t ii = 0U; ii < (STRESS_RECORDS / 100U); ii++)
+    {
+        if (NPA_SUCCESS == npa_stats_snapshot (&m_stats, &snapshot))
+        {
+            uint32_t binned = 0U;
+
+            for (size_t bin = 0U; bin < NPA_STATS_HIST_BINS; bin++)
+            {
+                binned += snapshot.histogram[bin];
+            }
+
+            // Reads alternate between stale and NACK, and every read is timed.
+            const uint32_t stale = snapshot.warnings[1U];
+            const uint32_t nack = snapshot.nack;
+            consistent = consistent
+                         && (snapshot.reads == (stale + nack))
+                         && (0U == snapshot.warnings[0U])
+                         && ( (stale == nack) || (stale == (nack + 1U))
+                              || ( (stale + 1U) == nack))
+                         && (snapshot.latency_count == snapshot.reads)
+                         && (binned == snapshot.reads);
+            snapshots++;
+        }
+
+        if (0U == (ii % 500U))
+        {
+            TEST_ASSERT (NPA_SUCCESS == npa_stats_reset (&m_stats));
+        }
+
+        (void) sched_yield();
+    }
+
+    TEST_ASSERT (0 == pthread_join (writer, NULL));
+    TEST_ASSERT_TRUE (consistent);
+    TEST_ASSERT (0U < snapshots);
+}
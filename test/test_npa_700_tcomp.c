@@ -0,0 +1,171 @@
+#include "unity.h"
+
+#include "npa_700.h"
+#include "npa_700_tcomp.h"
+
+#include <math.h>
+#include <string.h>
+
+#define P_SHIFT  (11U) //!< 9 pressure nodes.
+#define T_SHIFT  (8U)  //!< 9 temperature nodes.
+#define GRID_LEN (NPA_TCOMP_GRID_LEN (P_SHIFT, T_SHIFT))
+
+static int16_t m_grid[GRID_LEN];
+static npa_tcomp_t m_tcomp;
+
+// Bilinear interpolation of grid in double, in fixed point counts.
+static double reference_correction (const uint16_t counts, const uint16_t temperature)
+{
+    const uint32_t p_nodes = NPA_TCOMP_P_NODES (P_SHIFT);
+    const uint32_t p_node = counts >> P_SHIFT;
+    const uint32_t t_node = temperature >> T_SHIFT;
+    const double p_frac = (double) (counts - (p_node << P_SHIFT)) / (double) (1U << P_SHIFT);
+    const double t_frac = (double) (temperature - (t_node << T_SHIFT))
+                          / (double) (1U << T_SHIFT);
+    const int16_t * const low = &m_grid[ (t_node * p_nodes) + p_node];
+    const int16_t * const high = &low[p_nodes];
+    return ( (1.0 - t_frac) * ( ( (1.0 - p_frac) * low[0U]) + (p_frac * low[1U])))
+           + (t_frac * ( ( (1.0 - p_frac) * high[0U]) + (p_frac * high[1U])));
+}
+
+void setUp (void)
+{
+    uint32_t state = 3U;
+
+    for (size_t ii = 0U; ii < GRID_LEN; ii++)
+    {
+        state = (state * 1103515245U) + 12345U;
+        m_grid[ii] = (int16_t) ( (int32_t) ( (state >> 16U) % 4001U) - 2000);
+    }
+
+    TEST_ASSERT (NPA_SUCCESS == npa_tcomp_init (&m_tcomp, m_grid, P_SHIFT, T_SHIFT));
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_tcomp_nodes (void)
+{
+    TEST_ASSERT (9U == NPA_TCOMP_P_NODES (P_SHIFT));
+    TEST_ASSERT (9U == NPA_TCOMP_T_NODES (T_SHIFT));
+    TEST_ASSERT (m_grid[0U] == npa_tcomp_correction (&m_tcomp, 0U, 0U));
+    TEST_ASSERT (m_grid[10U] == npa_tcomp_correction (&m_tcomp, 1U << P_SHIFT,
+                 1U << T_SHIFT));
+    // Full scale interpolates to the last nodes from one count below them.
+    TEST_ASSERT (fabs (reference_correction (NPA_PRES_MAX_SAT, NPA_TEMP_MAX_HIRES)
+                       - npa_tcomp_correction (&m_tcomp, NPA_PRES_MAX_SAT, NPA_TEMP_MAX_HIRES))
+                 <= 0.5);
+    // Temperature over 11 bits is clamped.
+    TEST_ASSERT (npa_tcomp_correction (&m_tcomp, 100U, NPA_TEMP_MAX_HIRES)
+                 == npa_tcomp_correction (&m_tcomp, 100U, 0xFFFFU));
+    TEST_ASSERT (0 == npa_tcomp_correction (&m_tcomp, NPA_PRES_MAX_SAT + 1U, 0U));
+}
+
+void test_npa_700_tcomp_accuracy (void)
+{
+    uint32_t state = 5U;
+    double max_error = 0.0;
+    double max_apply_error = 0.0;
+
+    for (uint32_t ii = 0U; ii < 200000U; ii++)
+    {
+        state = (state * 1103515245U) + 12345U;
+        const uint16_t counts = (uint16_t) ( (state >> 8U) & NPA_PRES_MAX_SAT);
+        state = (state * 1103515245U) + 12345U;
+        const uint16_t temperature = (uint16_t) ( (state >> 8U) & NPA_TEMP_MAX_HIRES);
+        const double expected = reference_correction (counts, temperature);
+        const double error = fabs (expected - npa_tcomp_correction (&m_tcomp, counts,
+                                   temperature));
+        double corrected = (double) counts + (expected / (double) (1U << NPA_TCOMP_FRAC_BITS));
+        corrected = (corrected < 0.0) ? 0.0 : ( (corrected > NPA_PRES_MAX_SAT)
+                                                ? NPA_PRES_MAX_SAT : corrected);
+        const double apply_error = fabs (corrected - npa_tcomp_apply (&m_tcomp, counts,
+                                         temperature));
+        max_error = (error > max_error) ? error : max_error;
+        max_apply_error = (apply_error > max_apply_error) ? apply_error : max_apply_error;
+    }
+
+    // Integer interpolation is exact up to final rounding.
+    TEST_ASSERT (max_error <= 0.5);
+    TEST_ASSERT (max_apply_error <= 0.5);
+}
+
+void test_npa_700_tcomp_apply_clamps (void)
+{
+    memset (m_grid, 0, sizeof (m_grid));
+    TEST_ASSERT (100U == npa_tcomp_apply (&m_tcomp, 100U, 500U));
+    m_grid[0U] = -125 * (1 << NPA_TCOMP_FRAC_BITS);
+    TEST_ASSERT (0U == npa_tcomp_apply (&m_tcomp, 10U, 0U));
+    m_grid[GRID_LEN - 1U] = 125 * (1 << NPA_TCOMP_FRAC_BITS);
+    TEST_ASSERT (NPA_PRES_MAX_SAT == npa_tcomp_apply (&m_tcomp, NPA_PRES_MAX_SAT,
+                 NPA_TEMP_MAX_HIRES));
+    // Half a count rounds away from zero.
+    m_grid[1U] = 8;
+    m_grid[2U] = 8;
+    TEST_ASSERT ( ( (1U << P_SHIFT) + 1001U) == npa_tcomp_apply (&m_tcomp,
+                  (1U << P_SHIFT) + 1000U, 0U));
+    m_grid[1U] = -8;
+    m_grid[2U] = -8;
+    TEST_ASSERT ( ( (1U << P_SHIFT) + 999U) == npa_tcomp_apply (&m_tcomp,
+                  (1U << P_SHIFT) + 1000U, 0U));
+    TEST_ASSERT (123U == npa_tcomp_apply (NULL, 123U, 0U));
+}
+
+void test_npa_700_tcomp_decode (void)
+{
+    // Counts 8192, 11-bit temperature 0x400.
+    const uint8_t hires[NPA_FRAME_LEN_HIRES] = { 0x20U, 0x00U, 0x80U, 0x00U };
+    const uint8_t lowres[NPA_FRAME_LEN_LOWRES] = { 0x20U, 0x00U, 0x80U };
+    const uint8_t diagnostic[NPA_FRAME_LEN_HIRES] = { 0xE0U, 0x00U, 0x80U, 0x00U };
+    const uint8_t mode[NPA_FRAME_LEN_HIRES] = { 0x60U, 0x00U, 0x80U, 0x00U };
+    float pressure_pa = 0.0F;
+    float temperature_c = 0.0F;
+    float expected_pa = 0.0F;
+    float expected_c = 0.0F;
+    float gain = 0.0F;
+    float offset = 0.0F;
+    memset (m_grid, 0, sizeof (m_grid));
+    // 10 counts at temperature row 4, i.e. 0x400.
+    m_grid[ (4U * NPA_TCOMP_P_NODES (P_SHIFT)) + 4U] = 10 * (1 << NPA_TCOMP_FRAC_BITS);
+    TEST_ASSERT (NPA_SUCCESS == npa_get_scaling (NPA_700_001D, &gain, &offset));
+    TEST_ASSERT (NPA_SUCCESS == npa_decode_frame (NPA_700_001D, hires, NPA_FRAME_LEN_HIRES,
+                 &expected_pa, &expected_c));
+    TEST_ASSERT (NPA_SUCCESS == npa_tcomp_decode (&m_tcomp, NPA_700_001D, hires,
+                 NPA_FRAME_LEN_HIRES, &pressure_pa, &temperature_c));
+    TEST_ASSERT_EQUAL_FLOAT ( (8202.0F * gain) + offset, pressure_pa);
+    TEST_ASSERT_EQUAL_FLOAT (expected_c, temperature_c);
+    TEST_ASSERT (NPA_SUCCESS == npa_decode_frame (NPA_700_001D, lowres,
+                 NPA_FRAME_LEN_LOWRES, &expected_pa, &expected_c));
+    TEST_ASSERT (NPA_SUCCESS == npa_tcomp_decode (&m_tcomp, NPA_700_001D, lowres,
+                 NPA_FRAME_LEN_LOWRES, &pressure_pa, &temperature_c));
+    TEST_ASSERT_EQUAL_FLOAT ( (8202.0F * gain) + offset, pressure_pa);
+    TEST_ASSERT_EQUAL_FLOAT (expected_c, temperature_c);
+    // Frames with fatal status are converted as by npa_decode_frame.
+    pressure_pa = 0.0F;
+    TEST_ASSERT (NPA_ERR_FATAL == npa_tcomp_decode (&m_tcomp, NPA_700_001D, diagnostic,
+                 NPA_FRAME_LEN_HIRES, &pressure_pa, NULL));
+    TEST_ASSERT_EQUAL_FLOAT ( (8202.0F * gain) + offset, pressure_pa);
+    pressure_pa = 0.0F;
+    TEST_ASSERT (NPA_ERR_MODE == npa_tcomp_decode (&m_tcomp, NPA_700_001D, mode,
+                 NPA_FRAME_LEN_HIRES, &pressure_pa, NULL));
+    TEST_ASSERT_EQUAL_FLOAT ( (8202.0F * gain) + offset, pressure_pa);
+    TEST_ASSERT (NPA_ERR_PARAM == npa_tcomp_decode (&m_tcomp, NPA_700_001D, hires,
+                 NPA_FRAME_LEN_PRES, &pressure_pa, NULL));
+    TEST_ASSERT (NPA_ERR_NULL == npa_tcomp_decode (NULL, NPA_700_001D, hires,
+                 NPA_FRAME_LEN_HIRES, &pressure_pa, NULL));
+}
+
+void test_npa_700_tcomp_invalid (void)
+{
+    TEST_ASSERT (NPA_ERR_NULL == npa_tcomp_init (NULL, m_grid, P_SHIFT, T_SHIFT));
+    TEST_ASSERT (NPA_ERR_NULL == npa_tcomp_init (&m_tcomp, NULL, P_SHIFT, T_SHIFT));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_tcomp_init (&m_tcomp, m_grid, 0U, T_SHIFT));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_tcomp_init (&m_tcomp, m_grid, NPA_TCOMP_P_BITS + 1U,
+                 T_SHIFT));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_tcomp_init (&m_tcomp, m_grid, P_SHIFT,
+                 NPA_TCOMP_T_BITS + 1U));
+    TEST_ASSERT (NPA_SUCCESS == npa_tcomp_init (&m_tcomp, m_grid, NPA_TCOMP_P_BITS,
+                 NPA_TCOMP_T_BITS));
+    TEST_ASSERT (4U == NPA_TCOMP_GRID_LEN (NPA_TCOMP_P_BITS, NPA_TCOMP_T_BITS));
+}
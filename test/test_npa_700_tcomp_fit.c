@@ -0,0 +1,137 @@
+#include "unity.h"
+
+#include "npa_700.h"
+#include "npa_700_tcomp.h"
+#include "npa_700_tcomp_fit.h"
+
+#include <math.h>
+
+#define P_SHIFT     (11U)   //!< 9 pressure nodes.
+#define T_SHIFT     (7U)    //!< 17 temperature nodes.
+#define GRID_LEN    (NPA_TCOMP_GRID_LEN (P_SHIFT, T_SHIFT))
+#define NUM_SAMPLES (20000U) //!< Samples of calibration run.
+#define T_LOW       (400U)   //!< Lowest temperature of calibration run, counts.
+#define T_HIGH      (1400U)  //!< Highest temperature of calibration run, counts.
+#define T_ZERO      (800.0)  //!< Temperature without drift, counts.
+
+static npa_tcomp_sample_t m_samples[NUM_SAMPLES];
+static int16_t m_grid[GRID_LEN];
+
+// Offset and span drift quadratic in temperature.
+static double drift (const double reference, const double temperature)
+{
+    const double dt = temperature - T_ZERO;
+    return (0.02 * dt) + (3e-5 * dt * dt) + (1e-6 * dt * (reference - NPA_PRES_MIDDLE));
+}
+
+// Sweep of reference pressure over temperature ramp, +-1 count of noise.
+static void generate_samples (void)
+{
+    uint32_t state = 9U;
+
+    for (uint32_t ii = 0U; ii < NUM_SAMPLES; ii++)
+    {
+        state = (state * 1103515245U) + 12345U;
+        const double reference = NPA_PRES_MIN_NONSAT
+                                 + (double) ( (ii * 37U) % (NPA_PRES_MAX_NONSAT
+                                              - NPA_PRES_MIN_NONSAT));
+        const uint16_t temperature = (uint16_t) (T_LOW + ( ( (uint64_t) ii * (T_HIGH - T_LOW))
+                                     / NUM_SAMPLES));
+        const double noise = (double) ( (state >> 16U) % 3U) - 1.0;
+        m_samples[ii].counts = (uint16_t) lround (reference + drift (reference, temperature)
+                               + noise);
+        m_samples[ii].temperature = temperature;
+        m_samples[ii].reference = (float) reference;
+    }
+}
+
+static npa_tcomp_fit_cfg_t fit_cfg (void)
+{
+    const npa_tcomp_fit_cfg_t cfg =
+    {
+        .p_shift = P_SHIFT,
+        .t_shift = T_SHIFT,
+        .smoothing = 1.0,
+        .max_iterations = 0U
+    };
+    return cfg;
+}
+
+void setUp (void)
+{
+    generate_samples();
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_tcomp_fit_accuracy (void)
+{
+    npa_tcomp_fit_result_t result;
+    const npa_tcomp_fit_cfg_t cfg = fit_cfg();
+    TEST_ASSERT (NPA_SUCCESS == npa_tcomp_fit (&cfg, m_samples, NUM_SAMPLES, m_grid,
+                 &result));
+    TEST_ASSERT (result.rms_before > 8.0);
+    // Noise is 0.8 counts RMS, rounding adds 0.3.
+    TEST_ASSERT (result.rms_after < 1.0);
+    TEST_ASSERT (result.max_after <= 3.0);
+    TEST_ASSERT (0U < result.iterations);
+    TEST_ASSERT (GRID_LEN >= result.iterations);
+}
+
+void test_npa_700_tcomp_fit_unseen_nodes (void)
+{
+    const npa_tcomp_fit_cfg_t cfg = fit_cfg();
+    const uint32_t p_nodes = NPA_TCOMP_P_NODES (P_SHIFT);
+    const uint32_t first_row = T_LOW >> T_SHIFT;
+    const uint32_t last_row = (T_HIGH >> T_SHIFT) + 1U;
+    int16_t low = INT16_MAX;
+    int16_t high = INT16_MIN;
+    TEST_ASSERT (NPA_SUCCESS == npa_tcomp_fit (&cfg, m_samples, NUM_SAMPLES, m_grid, NULL));
+
+    for (uint32_t ii = first_row * p_nodes; ii < ( (last_row + 1U) * p_nodes); ii++)
+    {
+        low = (m_grid[ii] < low) ? m_grid[ii] : low;
+        high = (m_grid[ii] > high) ? m_grid[ii] : high;
+    }
+
+    // Rows outside calibration run are filled by smoothing, which never overshoots.
+    for (uint32_t ii = 0U; ii < GRID_LEN; ii++)
+    {
+        const uint32_t row = ii / p_nodes;
+
+        if ( (row < first_row) || (row > last_row))
+        {
+            TEST_ASSERT ( (m_grid[ii] >= (low - 1)) && (m_grid[ii] <= (high + 1)));
+        }
+    }
+}
+
+void test_npa_700_tcomp_fit_invalid (void)
+{
+    npa_tcomp_fit_cfg_t cfg = fit_cfg();
+    TEST_ASSERT (NPA_ERR_NULL == npa_tcomp_fit (NULL, m_samples, NUM_SAMPLES, m_grid, NULL));
+    TEST_ASSERT (NPA_ERR_NULL == npa_tcomp_fit (&cfg, m_samples, NUM_SAMPLES, NULL, NULL));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_tcomp_fit (&cfg, m_samples, 0U, m_grid, NULL));
+    cfg.smoothing = -1.0;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_tcomp_fit (&cfg, m_samples, NUM_SAMPLES, m_grid,
+                 NULL));
+    cfg = fit_cfg();
+    cfg.t_shift = 0U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_tcomp_fit (&cfg, m_samples, NUM_SAMPLES, m_grid,
+                 NULL));
+    cfg = fit_cfg();
+    m_samples[10U].counts = NPA_PRES_MAX_SAT + 1U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_tcomp_fit (&cfg, m_samples, NUM_SAMPLES, m_grid,
+                 NULL));
+    // Corrections beyond int16_t are clamped.
+    generate_samples();
+
+    for (uint32_t ii = 0U; ii < NUM_SAMPLES; ii++)
+    {
+        m_samples[ii].reference += 4000.0F;
+    }
+
+    TEST_ASSERT (NPA_WARN_SAT == npa_tcomp_fit (&cfg, m_samples, NUM_SAMPLES, m_grid, NULL));
+}
@@ -0,0 +1,173 @@
+#include "unity.h"
+
+#include "npa_700.h"
+#include "npa_700_zero.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#define DRIFT_COUNTS (40U) //!< Zero offset of drifting sensor.
+
+static npa_zero_t m_zero;
+
+static npa_zero_cfg_t zero_cfg (void)
+{
+    const npa_zero_cfg_t cfg =
+    {
+        .weight_shift = 6U,
+        .band = 8U,
+        .max_offset = 100U,
+        .quiet_samples = 50U
+    };
+    return cfg;
+}
+
+// Noise of +-3 counts.
+static uint16_t noisy (const uint16_t counts, uint32_t * const state)
+{
+    *state = (*state * 1103515245U) + 12345U;
+    return (uint16_t) (counts + ( (*state >> 16U) % 7U) - 3U);
+}
+
+void setUp (void)
+{
+    const npa_zero_cfg_t cfg = zero_cfg();
+    TEST_ASSERT (NPA_SUCCESS == npa_zero_init (&m_zero, &cfg));
+}
+
+void tearDown (void)
+{
+}
+
+void test_npa_700_zero_converges (void)
+{
+    uint32_t state = 1U;
+    uint16_t corrected = 0U;
+    // Not corrected before first no-flow period.
+    TEST_ASSERT (NPA_PRES_MIDDLE + DRIFT_COUNTS == npa_zero_push (&m_zero,
+                 NPA_PRES_MIDDLE + DRIFT_COUNTS, NPA_SUCCESS));
+    TEST_ASSERT (0 == npa_zero_offset (&m_zero));
+
+    for (uint32_t ii = 0U; ii < 2000U; ii++)
+    {
+        corrected = npa_zero_push (&m_zero, noisy (NPA_PRES_MIDDLE + DRIFT_COUNTS, &state),
+                                   NPA_SUCCESS);
+    }
+
+    TEST_ASSERT ( (int32_t) DRIFT_COUNTS == npa_zero_offset (&m_zero));
+    TEST_ASSERT ( (corrected >= (NPA_PRES_MIDDLE - 3U)) && (corrected <= (NPA_PRES_MIDDLE + 3U)));
+
+    // Slow drift is followed.
+    for (uint32_t ii = 0U; ii < 4000U; ii++)
+    {
+        (void) npa_zero_push (&m_zero, noisy ( (uint16_t) (NPA_PRES_MIDDLE + DRIFT_COUNTS
+                                               + (ii / 400U)), &state), NPA_SUCCESS);
+    }
+
+    TEST_ASSERT ( (int32_t) (DRIFT_COUNTS + 9U) == npa_zero_offset (&m_zero));
+}
+
+void test_npa_700_zero_ignores_flow (void)
+{
+    uint32_t state = 2U;
+
+    for (uint32_t ii = 0U; ii < 1000U; ii++)
+    {
+        (void) npa_zero_push (&m_zero, noisy (NPA_PRES_MIDDLE + DRIFT_COUNTS, &state),
+                              NPA_SUCCESS);
+    }
+
+    TEST_ASSERT ( (int32_t) DRIFT_COUNTS == npa_zero_offset (&m_zero));
+
+    // Breaths of 3 s at 1 kHz, flow ramps through zero-band quickly.
+    for (uint32_t ii = 0U; ii < 30000U; ii++)
+    {
+        const uint32_t phase = ii % 3000U;
+        const uint32_t ramp = (phase < 1500U) ? phase : (3000U - phase);
+        const uint16_t counts = (uint16_t) (NPA_PRES_MIDDLE + DRIFT_COUNTS + (ramp * 4U));
+        TEST_ASSERT ( (uint16_t) (counts - DRIFT_COUNTS) == npa_zero_push (&m_zero,
+                      counts, NPA_SUCCESS));
+    }
+
+    // Steady pressure beyond maximum offset is not zero.
+    for (uint32_t ii = 0U; ii < 1000U; ii++)
+    {
+        (void) npa_zero_push (&m_zero, noisy (NPA_PRES_MIDDLE + 500U, &state), NPA_SUCCESS);
+    }
+
+    TEST_ASSERT ( (int32_t) DRIFT_COUNTS == npa_zero_offset (&m_zero));
+    // Samples with warnings or errors break quiet runs and do not update.
+    for (uint32_t ii = 0U; ii < 1000U; ii++)
+    {
+        (void) npa_zero_push (&m_zero, NPA_PRES_MIDDLE, (0U == (ii % 20U))
+                              ? NPA_SUCCESS : NPA_WARN_OLD);
+    }
+
+    TEST_ASSERT ( (int32_t) DRIFT_COUNTS == npa_zero_offset (&m_zero));
+}
+
+void test_npa_700_zero_apply_tare (void)
+{
+    TEST_ASSERT (NPA_ERR_MODE == npa_zero_tare (&m_zero));
+    (void) npa_zero_push (&m_zero, NPA_PRES_MIDDLE - 60U, NPA_SUCCESS);
+    TEST_ASSERT (NPA_SUCCESS == npa_zero_tare (&m_zero));
+    TEST_ASSERT (-60 == npa_zero_offset (&m_zero));
+    TEST_ASSERT (NPA_PRES_MIDDLE == npa_zero_apply (&m_zero, NPA_PRES_MIDDLE - 60U));
+    // Corrected counts are clamped to 14 bits.
+    TEST_ASSERT (NPA_PRES_MAX_SAT == npa_zero_apply (&m_zero, NPA_PRES_MAX_SAT - 10U));
+    TEST_ASSERT (60U == npa_zero_apply (&m_zero, NPA_PRES_MIN_SAT));
+
+    for (uint32_t ii = 0U; ii < 20U; ii++)
+    {
+        (void) npa_zero_push (&m_zero, NPA_PRES_MIDDLE + 300U, NPA_WARN_SAT);
+        (void) npa_zero_push (&m_zero, NPA_PRES_MIDDLE + 300U, NPA_SUCCESS);
+    }
+
+    TEST_ASSERT (NPA_ERR_PARAM == npa_zero_tare (&m_zero));
+    TEST_ASSERT (-60 == npa_zero_offset (&m_zero));
+    TEST_ASSERT (NPA_ERR_NULL == npa_zero_tare (NULL));
+    TEST_ASSERT (123U == npa_zero_apply (NULL, 123U));
+}
+
+void test_npa_700_zero_save_restore (void)
+{
+    npa_zero_saved_t saved;
+    npa_zero_saved_t corrupt;
+    npa_zero_t rebooted;
+    const npa_zero_cfg_t cfg = zero_cfg();
+    TEST_ASSERT (NPA_ERR_MODE == npa_zero_save (&m_zero, &saved));
+    (void) npa_zero_push (&m_zero, NPA_PRES_MIDDLE + 25U, NPA_SUCCESS);
+    TEST_ASSERT (NPA_SUCCESS == npa_zero_tare (&m_zero));
+    TEST_ASSERT (NPA_SUCCESS == npa_zero_save (&m_zero, &saved));
+    TEST_ASSERT (NPA_ZERO_MAGIC == saved.magic);
+
+    TEST_ASSERT (NPA_SUCCESS == npa_zero_init (&rebooted, &cfg));
+    memcpy (&corrupt, &saved, sizeof (corrupt));
+    corrupt.baseline += 1;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_zero_restore (&rebooted, &corrupt));
+    memset (&corrupt, 0xFF, sizeof (corrupt));
+    TEST_ASSERT (NPA_ERR_PARAM == npa_zero_restore (&rebooted, &corrupt));
+    TEST_ASSERT (0 == npa_zero_offset (&rebooted));
+    TEST_ASSERT (NPA_SUCCESS == npa_zero_restore (&rebooted, &saved));
+    TEST_ASSERT (25 == npa_zero_offset (&rebooted));
+    TEST_ASSERT (NPA_PRES_MIDDLE == npa_zero_push (&rebooted, NPA_PRES_MIDDLE + 25U,
+                 NPA_SUCCESS));
+    TEST_ASSERT (NPA_ERR_NULL == npa_zero_restore (&rebooted, NULL));
+    TEST_ASSERT (NPA_ERR_NULL == npa_zero_save (NULL, &saved));
+}
+
+void test_npa_700_zero_invalid (void)
+{
+    npa_zero_cfg_t cfg = zero_cfg();
+    TEST_ASSERT (NPA_ERR_NULL == npa_zero_init (NULL, &cfg));
+    TEST_ASSERT (NPA_ERR_NULL == npa_zero_init (&m_zero, NULL));
+    cfg.weight_shift = NPA_ZERO_MAX_SHIFT + 1U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_zero_init (&m_zero, &cfg));
+    cfg = zero_cfg();
+    cfg.quiet_samples = 0U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_zero_init (&m_zero, &cfg));
+    cfg = zero_cfg();
+    cfg.band = 0U;
+    TEST_ASSERT (NPA_ERR_PARAM == npa_zero_init (&m_zero, &cfg));
+    TEST_ASSERT (100U == npa_zero_push (NULL, 100U, NPA_SUCCESS));
+}